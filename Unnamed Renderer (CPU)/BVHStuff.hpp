@@ -0,0 +1,1153 @@
+// BVHStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef BVH_STUFF
+	#define BVH_STUFF
+#endif
+
+#include "SceneStuff.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+namespace BVHStuff {
+
+	// Axis-aligned bounding box, empty until something is grown into it.
+	struct BoundingBox {
+		float3 Min{ +FLT_MAX, +FLT_MAX, +FLT_MAX };
+		float3 Max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+		void Grow(const float3& Point) {
+			this->Min = { std::min(this->Min.x, Point.x), std::min(this->Min.y, Point.y), std::min(this->Min.z, Point.z) };
+			this->Max = { std::max(this->Max.x, Point.x), std::max(this->Max.y, Point.y), std::max(this->Max.z, Point.z) };
+		}
+
+		// Growing by an empty box leaves this one unchanged.
+		void Grow(const BoundingBox& Box) {
+			this->Min = { std::min(this->Min.x, Box.Min.x), std::min(this->Min.y, Box.Min.y), std::min(this->Min.z, Box.Min.z) };
+			this->Max = { std::max(this->Max.x, Box.Max.x), std::max(this->Max.y, Box.Max.y), std::max(this->Max.z, Box.Max.z) };
+		}
+
+		bool IsEmpty() const {
+			return this->Min.x > this->Max.x || this->Min.y > this->Max.y || this->Min.z > this->Max.z;
+		}
+
+		float3 GetCentroid() const {
+			return (this->Min + this->Max) * 0.50f;
+		}
+
+		float3 GetExtent() const {
+			return this->Max - this->Min;
+		}
+
+		float GetSurfaceArea() const {
+			if (this->IsEmpty()) {
+				return 0.0f;
+			}
+
+			float3 Extent{ this->GetExtent() };
+			return 2.0f * (Extent.x * Extent.y + Extent.y * Extent.z + Extent.z * Extent.x);
+		}
+	};
+
+	/*
+		NODE LAYOUT:
+			Nodes are stored depth-first, so an interior node's left child directly follows it.
+			ReferenceCount == 0 - Interior node, RightChildOrFirstReference is the index of its right child.
+			ReferenceCount > 0 - Leaf node, its references are References[RightChildOrFirstReference, RightChildOrFirstReference + ReferenceCount).
+	*/
+	struct BVHNode {
+		float3 BoundsMin;
+		uint RightChildOrFirstReference;
+		float3 BoundsMax;
+		uint ReferenceCount;
+	};
+
+	/*
+		MOTION NODE LAYOUT:
+			A BVHNode whose bounds are stored at the open and the close of a frame's shutter, for paths traced at different times within it.
+			Both boxes bound everything below the node at their instant, and interpolating between them bounds it at any instant in between.
+			The topology is the same as the BVH's Nodes, which hold the union of both boxes.
+	*/
+	struct MotionBVHNode {
+		float3 OpenBoundsMin;
+		uint RightChildOrFirstReference;
+		float3 OpenBoundsMax;
+		uint ReferenceCount;
+		float3 CloseBoundsMin;
+		uint Padding00;
+		float3 CloseBoundsMax;
+		uint Padding01;
+	};
+
+	/*
+		PRIMITIVE REFERENCES:
+			A reference packs the PrimitiveId into its top three bits and the primitive's index into the rest.
+			Ordering references numerically matches the order in which the brute-force intersector visits the primitives, which the traversal uses to
+			break ties between equally distant hits the same way.
+	*/
+	constexpr uint ReferenceIndexBits{ 29u };
+	constexpr uint ReferenceIndexMask{ (1u << ReferenceIndexBits) - 1u };
+
+	inline uint CreateReference(uint PrimitiveId, uint Index) {
+		return (PrimitiveId << ReferenceIndexBits) | Index;
+	}
+
+	inline uint GetReferencePrimitiveId(uint Reference) {
+		return Reference >> ReferenceIndexBits;
+	}
+
+	inline uint GetReferenceIndex(uint Reference) {
+		return Reference & ReferenceIndexMask;
+	}
+
+	/*
+		TWO-LEVEL LAYOUT:
+			The BVH's Nodes are the top level, over every primitive of the scene, where an Instance is a single primitive bounded by its transformed
+			prototype. Each Prototype has a bottom-level tree of its own over its object-space triangles, which every instance of it is traced through.
+			Those trees are concatenated into PrototypeNodes and PrototypeReferences, indexed like the Nodes and References of a standalone tree but
+			offset to where they start, and their references are plain indices into the scene's PrototypeIndices.
+			PrototypeRootNodes holds the index of each prototype's root node, or NoPrototypeRootNode for a prototype without triangles.
+	*/
+	constexpr uint NoPrototypeRootNode{ 0xFFFFFFFFu };
+
+	// Bounding volume hierarchy over a scene's Spheres, Rectangles, Triangles, mesh triangles and Instances, along with the trees of its Prototypes.
+	// Besides the tree itself, it keeps what a refit needs to update the tree in place while the primitives move but the topology stays the same.
+	struct BVH {
+		CPUStuff::MappableVector<BVHNode> Nodes{};
+		CPUStuff::MappableVector<uint> References{};
+		CPUStuff::MappableVector<MotionBVHNode> MotionNodes{};// The Nodes' bounds at the open and close of the shutter, while it is open.
+		CPUStuff::MappableVector<uint2> SubtreeNodeRanges{};// [First, End) node ranges of the subtrees below the top of the tree.
+		CPUStuff::MappableVector<uint> TopNodeIndices{};// Interior nodes above those subtrees, parents before children.
+		CPUStuff::MappableVector<BVHNode> PrototypeNodes{};
+		CPUStuff::MappableVector<uint> PrototypeReferences{};
+		CPUStuff::MappableVector<uint> PrototypeRootNodes{};
+		uint4 PrimitiveCounts{};// Sphere, Rectangle, Triangle and mesh triangle counts that the tree was built over.
+		uint InstanceCount{ 0u };// Instance count that the tree was built over.
+		float BuildSAHCost{ 0.0f };// SAH cost of the tree right after its last full build.
+	};
+
+	constexpr uint MaxLeafReferenceCount{ 8u };
+	constexpr uint LBVHMaxLeafReferenceCount{ 4u };
+	constexpr uint SAHBinCount{ 16u };
+	constexpr float SAHTraversalCost{ 1.0f };
+	constexpr float SAHIntersectionCost{ 1.0f };
+
+	// Past this depth the builder only splits at the median, which keeps the tree shallow enough for the fixed traversal stack.
+	constexpr uint MaxSAHDepth{ 32u };
+	constexpr uint MaxTraversalStackSize{ 64u };
+
+	// Grows a box slightly, so that hits whose distance carries rounding error are still inside the bounds of their primitive.
+	inline void PadBoundingBox(BoundingBox& Box) {
+		float Magnitude{ std::max({ fabsf(Box.Min.x), fabsf(Box.Min.y), fabsf(Box.Min.z), fabsf(Box.Max.x), fabsf(Box.Max.y), fabsf(Box.Max.z) }) };
+		float Padding{ Magnitude * 1e-4f + 1e-4f };
+
+		Box.Min = Box.Min - float3{ Padding, Padding, Padding };
+		Box.Max = Box.Max + float3{ Padding, Padding, Padding };
+	}
+
+	inline BoundingBox GetSphereBounds(const Sphere& CurrentSphere) {
+		float Radius{ fabsf(CurrentSphere.WSRadius) };
+
+		BoundingBox Box{};
+		Box.Grow(CurrentSphere.WSOrigin - float3{ Radius, Radius, Radius });
+		Box.Grow(CurrentSphere.WSOrigin + float3{ Radius, Radius, Radius });
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	// The rectangle test accepts points whose projections onto Q2 - Q1 and Q3 - Q1 lie within those edges' squared lengths, so the accepted region is
+	// the parallelogram solved from the edges' Gram matrix (Q4 is never tested). For perpendicular edges, its corners are Q1, Q2, Q3 and Q2 + Q3 - Q1.
+	inline BoundingBox GetRectangleBounds(const Rectangle& CurrentRectangle) {
+		float3 DS21{ CurrentRectangle.Q2 - CurrentRectangle.Q1 };
+		float3 DS31{ CurrentRectangle.Q3 - CurrentRectangle.Q1 };
+
+		float G11{ dot(DS21, DS21) }, G12{ dot(DS21, DS31) }, G22{ dot(DS31, DS31) };
+		float Determinant{ G11 * G22 - G12 * G12 };
+
+		BoundingBox Box{};
+		Box.Grow(CurrentRectangle.Q1);
+
+		// Degenerate rectangles have no surface normal, so they can never be hit.
+		if (Determinant > 0.0f) {
+			float2 Corners[3]{ { G11, 0.0f }, { 0.0f, G22 }, { G11, G22 } };
+
+			for (const float2& Corner: Corners) {
+				float a{ (G22 * Corner.x - G12 * Corner.y) / Determinant };
+				float b{ (G11 * Corner.y - G12 * Corner.x) / Determinant };
+
+				Box.Grow(CurrentRectangle.Q1 + DS21 * a + DS31 * b);
+			}
+		}
+
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	inline BoundingBox GetTriangleBounds(const Triangle& CurrentTriangle) {
+		BoundingBox Box{};
+		Box.Grow(CurrentTriangle.V1);
+		Box.Grow(CurrentTriangle.V2);
+		Box.Grow(CurrentTriangle.V3);
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	// Bounds of a mesh triangle at a given interpolation step, or at the scene's current state with a negative step.
+	inline BoundingBox GetMeshTriangleBounds(const SceneStuff::Scene& Scene, uint Index, float CurrentStep = -1.0f) {
+		const uint3& Indices{ Scene.MeshIndices[Index] };
+		BoundingBox Box{};
+
+		if (CurrentStep < 0.0f) {
+			Box.Grow(Scene.MeshVertices[Indices.x]);
+			Box.Grow(Scene.MeshVertices[Indices.y]);
+			Box.Grow(Scene.MeshVertices[Indices.z]);
+		} else {
+			Box.Grow(SceneStuff::InterpolateMeshVertex(CurrentStep, Scene, Indices.x));
+			Box.Grow(SceneStuff::InterpolateMeshVertex(CurrentStep, Scene, Indices.y));
+			Box.Grow(SceneStuff::InterpolateMeshVertex(CurrentStep, Scene, Indices.z));
+		}
+
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	// Bounds of a prototype triangle, in the object space of its prototype.
+	inline BoundingBox GetPrototypeTriangleBounds(const SceneStuff::Scene& Scene, uint Index) {
+		const uint3& Indices{ Scene.PrototypeIndices[Index] };
+		BoundingBox Box{};
+		Box.Grow(Scene.PrototypeVertices[Indices.x]);
+		Box.Grow(Scene.PrototypeVertices[Indices.y]);
+		Box.Grow(Scene.PrototypeVertices[Indices.z]);
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	// Bounds of an instance, as the box around the eight corners of its prototype's bounds carried into world space. Empty if the prototype is.
+	inline BoundingBox GetInstanceBounds(const SceneStuff::Scene& Scene, uint Index) {
+		const Instance& CurrentInstance{ Scene.Instances[Index] };
+		const Prototype& CurrentPrototype{ Scene.Prototypes[CurrentInstance.PrototypeIndex] };
+		BoundingBox Box{};
+
+		if (CurrentPrototype.TriangleCount == 0u) {
+			return Box;
+		}
+
+		for (uint Corner{ 0u }; Corner < 8u; Corner++) {
+			const float3 Point{ (Corner & 1u) ? CurrentPrototype.BoundsMax.x : CurrentPrototype.BoundsMin.x,
+				(Corner & 2u) ? CurrentPrototype.BoundsMax.y : CurrentPrototype.BoundsMin.y,
+				(Corner & 4u) ? CurrentPrototype.BoundsMax.z : CurrentPrototype.BoundsMin.z };
+			Box.Grow(SceneStuff::TransformPoint(CurrentInstance.WorldFromObject, Point));
+		}
+
+		PadBoundingBox(Box);
+		return Box;
+	}
+
+	constexpr uint RectangleMotionSampleCount{ 33u };
+
+	// Bounds of a primitive at the open and the close of a shutter, interpolated from its Start and End keyframes.
+	// Spheres, Triangles and mesh vertices move linearly, so interpolating between their boxes at those two instants bounds them at any instant in between.
+	inline void GetSphereMotionBounds(const Sphere& CurrentSphere, const SceneStuff::ShutterInterval& Shutter, BoundingBox& OpenBounds,
+		BoundingBox& CloseBounds) {
+		Sphere Keyframe{};
+		SceneStuff::InterpolateSphereGeometry(Shutter.Open, CurrentSphere, Keyframe);
+		OpenBounds = GetSphereBounds(Keyframe);
+		SceneStuff::InterpolateSphereGeometry(Shutter.Close, CurrentSphere, Keyframe);
+		CloseBounds = GetSphereBounds(Keyframe);
+	}
+
+	// A translating Rectangle's accepted region moves with Q1, so its boxes interpolate like a Triangle's. Otherwise the region's corners move along
+	// curves (their Gram matrix changes), so both boxes are the union of the region sampled across the shutter, grown by the largest step between
+	// two samples to cover the curves between them.
+	inline void GetRectangleMotionBounds(
+		const Rectangle& CurrentRectangle, const SceneStuff::ShutterInterval& Shutter, BoundingBox& OpenBounds, BoundingBox& CloseBounds) {
+		Rectangle OpenKeyframe{}, CloseKeyframe{};
+		SceneStuff::InterpolateRectangleGeometry(Shutter.Open, CurrentRectangle, OpenKeyframe);
+		SceneStuff::InterpolateRectangleGeometry(Shutter.Close, CurrentRectangle, CloseKeyframe);
+		OpenBounds = GetRectangleBounds(OpenKeyframe);
+		CloseBounds = GetRectangleBounds(CloseKeyframe);
+
+		float3 EdgeChange21{ (CloseKeyframe.Q2 - CloseKeyframe.Q1) - (OpenKeyframe.Q2 - OpenKeyframe.Q1) };
+		float3 EdgeChange31{ (CloseKeyframe.Q3 - CloseKeyframe.Q1) - (OpenKeyframe.Q3 - OpenKeyframe.Q1) };
+		float Tolerance{ 1e-6f * std::max({ fabsf(OpenBounds.Min.x), fabsf(OpenBounds.Min.y), fabsf(OpenBounds.Min.z), fabsf(OpenBounds.Max.x),
+									 fabsf(OpenBounds.Max.y), fabsf(OpenBounds.Max.z), 1.0f }) };
+
+		if (std::max({ fabsf(EdgeChange21.x), fabsf(EdgeChange21.y), fabsf(EdgeChange21.z), fabsf(EdgeChange31.x), fabsf(EdgeChange31.y),
+				fabsf(EdgeChange31.z) }) <= Tolerance) {
+			return;
+		}
+
+		BoundingBox SweptBounds{ OpenBounds }, PreviousBounds{ OpenBounds };
+		float MaxStep{ 0.0f };
+
+		for (uint i{ 1u }; i < RectangleMotionSampleCount; i++) {
+			float CurrentStep{ LinearInterpolation(( float )i / ( float )(RectangleMotionSampleCount - 1u), Shutter.Open, Shutter.Close) };
+			Rectangle Keyframe{};
+			SceneStuff::InterpolateRectangleGeometry(CurrentStep, CurrentRectangle, Keyframe);
+			BoundingBox Bounds{ GetRectangleBounds(Keyframe) };
+
+			float3 MinStep{ Bounds.Min - PreviousBounds.Min }, MaxBoundsStep{ Bounds.Max - PreviousBounds.Max };
+			MaxStep = std::max({ MaxStep, fabsf(MinStep.x), fabsf(MinStep.y), fabsf(MinStep.z), fabsf(MaxBoundsStep.x), fabsf(MaxBoundsStep.y),
+				fabsf(MaxBoundsStep.z) });
+
+			SweptBounds.Grow(Bounds);
+			PreviousBounds = Bounds;
+		}
+
+		SweptBounds.Min = SweptBounds.Min - float3{ MaxStep, MaxStep, MaxStep };
+		SweptBounds.Max = SweptBounds.Max + float3{ MaxStep, MaxStep, MaxStep };
+		OpenBounds = SweptBounds;
+		CloseBounds = SweptBounds;
+	}
+
+	inline void GetTriangleMotionBounds(
+		const Triangle& CurrentTriangle, const SceneStuff::ShutterInterval& Shutter, BoundingBox& OpenBounds, BoundingBox& CloseBounds) {
+		Triangle Keyframe{};
+		SceneStuff::InterpolateTriangleGeometry(Shutter.Open, CurrentTriangle, Keyframe);
+		OpenBounds = GetTriangleBounds(Keyframe);
+		SceneStuff::InterpolateTriangleGeometry(Shutter.Close, CurrentTriangle, Keyframe);
+		CloseBounds = GetTriangleBounds(Keyframe);
+	}
+
+	inline BoundingBox GetReferenceBounds(const SceneStuff::Scene& Scene, uint Reference) {
+		uint Index{ GetReferenceIndex(Reference) };
+
+		switch (GetReferencePrimitiveId(Reference)) {
+			case 0:
+				return GetSphereBounds(Scene.Spheres[Index]);
+			case 1:
+				return GetRectangleBounds(Scene.Rectangles[Index]);
+			case 2:
+				return GetTriangleBounds(Scene.Triangles[Index]);
+			case 3:
+				return GetMeshTriangleBounds(Scene, Index);
+			default:
+				return GetInstanceBounds(Scene, Index);
+		}
+	}
+
+	inline void GetReferenceMotionBounds(
+		const SceneStuff::Scene& Scene, uint Reference, const SceneStuff::ShutterInterval& Shutter, BoundingBox& OpenBounds, BoundingBox& CloseBounds) {
+		uint Index{ GetReferenceIndex(Reference) };
+
+		switch (GetReferencePrimitiveId(Reference)) {
+			case 0:
+				GetSphereMotionBounds(Scene.Spheres[Index], Shutter, OpenBounds, CloseBounds);
+				break;
+			case 1:
+				GetRectangleMotionBounds(Scene.Rectangles[Index], Shutter, OpenBounds, CloseBounds);
+				break;
+			case 2:
+				GetTriangleMotionBounds(Scene.Triangles[Index], Shutter, OpenBounds, CloseBounds);
+				break;
+			case 3:
+				OpenBounds = GetMeshTriangleBounds(Scene, Index, Shutter.Open);
+				CloseBounds = GetMeshTriangleBounds(Scene, Index, Shutter.Close);
+				break;
+			default:
+				// Instances are static.
+				OpenBounds = GetInstanceBounds(Scene, Index);
+				CloseBounds = OpenBounds;
+				break;
+		}
+	}
+
+	// A primitive reference with the bounds that it is binned by while building.
+	struct BuildReference {
+		BoundingBox Bounds;
+		float3 Centroid;
+		uint Reference;
+	};
+
+	// Runs Function(Begin, End, ChunkIndex) over [Begin, End) split into ChunkCount nearly equal chunks, spread across a thread pool.
+	template<typename FunctionType>
+	inline void ParallelForChunks(CPUStuff::ThreadPool& ThreadPool, uint Begin, uint End, uint ChunkCount, FunctionType Function) {
+		const uint64_t Count{ End - Begin };
+
+		ThreadPool.ParallelFor(ChunkCount, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (uint ChunkIndex{ ( uint )BeginIndex }; ChunkIndex < ( uint )EndIndex; ChunkIndex++) {
+				Function(Begin + ( uint )(Count * ChunkIndex / ChunkCount), Begin + ( uint )(Count * (ChunkIndex + 1u) / ChunkCount), ChunkIndex);
+			}
+		});
+	}
+
+	// While the shutter is open, each primitive is binned by the union of its bounds at the shutter's open and close.
+	inline void GetBuildReferences(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, CPUStuff::ThreadPool& ThreadPool,
+		std::vector<BuildReference>& BuildReferences) {
+		const uint SphereCount{ ( uint )Scene.Spheres.size() }, RectangleCount{ ( uint )Scene.Rectangles.size() };
+		const uint TriangleCount{ ( uint )Scene.Triangles.size() }, MeshTriangleCount{ ( uint )Scene.MeshIndices.size() };
+		const uint ReferenceCount{ SphereCount + RectangleCount + TriangleCount + MeshTriangleCount + ( uint )Scene.Instances.size() };
+
+		BuildReferences.resize(ReferenceCount);
+
+		ThreadPool.ParallelFor(ReferenceCount, 4096, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (uint i{ ( uint )BeginIndex }; i < ( uint )EndIndex; i++) {
+				BuildReference& CurrentReference{ BuildReferences[i] };
+
+				if (i < SphereCount) {
+					CurrentReference.Reference = CreateReference(0u, i);
+				} else if (i < SphereCount + RectangleCount) {
+					CurrentReference.Reference = CreateReference(1u, i - SphereCount);
+				} else if (i < SphereCount + RectangleCount + TriangleCount) {
+					CurrentReference.Reference = CreateReference(2u, i - SphereCount - RectangleCount);
+				} else if (i < SphereCount + RectangleCount + TriangleCount + MeshTriangleCount) {
+					CurrentReference.Reference = CreateReference(3u, i - SphereCount - RectangleCount - TriangleCount);
+				} else {
+					CurrentReference.Reference = CreateReference(4u, i - SphereCount - RectangleCount - TriangleCount - MeshTriangleCount);
+				}
+
+				if (Shutter.IsOpen()) {
+					BoundingBox CloseBounds{};
+					GetReferenceMotionBounds(Scene, CurrentReference.Reference, Shutter, CurrentReference.Bounds, CloseBounds);
+					CurrentReference.Bounds.Grow(CloseBounds);
+				} else {
+					CurrentReference.Bounds = GetReferenceBounds(Scene, CurrentReference.Reference);
+				}
+
+				CurrentReference.Centroid = CurrentReference.Bounds.GetCentroid();
+			}
+		});
+	}
+
+	inline float GetAxis(const float3& Vector, uint Axis) {
+		return Axis == 0u ? Vector.x : (Axis == 1u ? Vector.y : Vector.z);
+	}
+
+	/*
+		BUILD TYPE:
+			BinnedSAH - Top-down binned surface area heuristic splits, the slower build that gives the faster tree to trace.
+			LBVH - Splits a Morton-ordered list at the highest differing bit, the faster build that gives a slower tree to trace.
+	*/
+	enum class BVHBuildType { BinnedSAH, LBVH };
+
+	inline const char* GetBVHBuildTypeName(BVHBuildType BuildType) {
+		return BuildType == BVHBuildType::LBVH ? "lbvh" : "sah";
+	}
+
+	inline bool GetBVHBuildType(const char* Name, BVHBuildType& BuildType) {
+		for (BVHBuildType CurrentBuildType: { BVHBuildType::BinnedSAH, BVHBuildType::LBVH }) {
+			if (strcmp(Name, GetBVHBuildTypeName(CurrentBuildType)) == 0) {
+				BuildType = CurrentBuildType;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Timing and quality of a BVH build.
+	struct BVHBuildStats {
+		double BuildSeconds{ 0.0 };
+		float SAHCost{ 0.0f };// Expected cost of tracing a random ray through the tree, in units of SAHIntersectionCost.
+		uint NodeCount{ 0u };
+		uint LeafCount{ 0u };
+	};
+
+	// The state shared by every stage of a build.
+	struct BuildContext {
+		BVHBuildType BuildType{ BVHBuildType::BinnedSAH };
+		CPUStuff::ThreadPool& ThreadPool;
+		std::vector<BuildReference> BuildReferences{};
+		std::vector<uint> MortonCodes{};// Sorted, and in the same order as BuildReferences, for LBVH builds.
+		uint ChunkCount{ 1u };
+	};
+
+	// The bounds of a range of references, and of their centroids.
+	struct RangeBounds {
+		BoundingBox Bounds{};
+		BoundingBox CentroidBounds{};
+
+		void Grow(const RangeBounds& Other) {
+			this->Bounds.Grow(Other.Bounds);
+			this->CentroidBounds.Grow(Other.CentroidBounds);
+		}
+	};
+
+	inline RangeBounds GetRangeBounds(const BuildContext& Context, uint Begin, uint End) {
+		RangeBounds Bounds{};
+
+		for (uint i{ Begin }; i < End; i++) {
+			Bounds.Bounds.Grow(Context.BuildReferences[i].Bounds);
+			Bounds.CentroidBounds.Grow(Context.BuildReferences[i].Centroid);
+		}
+
+		return Bounds;
+	}
+
+	// Reduces GetRangeBounds over the thread pool, for the large ranges at the top of the tree.
+	inline RangeBounds GetRangeBoundsParallel(BuildContext& Context, uint Begin, uint End) {
+		std::vector<RangeBounds> ChunkBounds(Context.ChunkCount);
+
+		ParallelForChunks(Context.ThreadPool, Begin, End, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint ChunkIndex) {
+			ChunkBounds[ChunkIndex] = GetRangeBounds(Context, ChunkBegin, ChunkEnd);
+		});
+
+		RangeBounds Bounds{};
+
+		for (const RangeBounds& CurrentChunkBounds: ChunkBounds) {
+			Bounds.Grow(CurrentChunkBounds);
+		}
+
+		return Bounds;
+	}
+
+	// The references of a range sorted into SAHBinCount bins by centroid, along each of the three axes.
+	struct SAHBins {
+		BoundingBox Bounds[3][SAHBinCount]{};
+		uint Counts[3][SAHBinCount]{};
+
+		void Grow(const SAHBins& Other) {
+			for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+				for (uint Bin{ 0u }; Bin < SAHBinCount; Bin++) {
+					this->Bounds[Axis][Bin].Grow(Other.Bounds[Axis][Bin]);
+					this->Counts[Axis][Bin] += Other.Counts[Axis][Bin];
+				}
+			}
+		}
+	};
+
+	inline uint GetBinIndex(const float3& Centroid, uint Axis, const BoundingBox& CentroidBounds) {
+		float AxisMin{ GetAxis(CentroidBounds.Min, Axis) };
+		float AxisExtent{ GetAxis(CentroidBounds.Max, Axis) - AxisMin };
+
+		return std::min(( uint )((GetAxis(Centroid, Axis) - AxisMin) * (( float )SAHBinCount / AxisExtent)), SAHBinCount - 1u);
+	}
+
+	inline void BinReferences(const BuildContext& Context, uint Begin, uint End, const BoundingBox& CentroidBounds, SAHBins& Bins) {
+		for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+			if (GetAxis(CentroidBounds.Max, Axis) <= GetAxis(CentroidBounds.Min, Axis)) {
+				continue;
+			}
+
+			for (uint i{ Begin }; i < End; i++) {
+				uint Bin{ GetBinIndex(Context.BuildReferences[i].Centroid, Axis, CentroidBounds) };
+
+				Bins.Bounds[Axis][Bin].Grow(Context.BuildReferences[i].Bounds);
+				Bins.Counts[Axis][Bin]++;
+			}
+		}
+	}
+
+	// A candidate split of a node's references into two children.
+	struct SplitCandidate {
+		float Cost{ FLT_MAX };
+		uint Axis{ 0u };
+		uint Bin{ 0u };
+	};
+
+	// Finds the cheapest binned surface area heuristic split over all three axes.
+	inline SplitCandidate FindSAHSplit(const SAHBins& Bins, uint Count) {
+		SplitCandidate BestSplit{};
+
+		for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+			// Sweep from the right to gather each split's right-hand cost, then from the left to complete it.
+			float RightCosts[SAHBinCount]{};
+			BoundingBox RightBounds{};
+			uint RightCount{ 0u };
+
+			for (uint Bin{ SAHBinCount - 1u }; Bin > 0u; Bin--) {
+				RightBounds.Grow(Bins.Bounds[Axis][Bin]);
+				RightCount += Bins.Counts[Axis][Bin];
+				RightCosts[Bin] = RightBounds.GetSurfaceArea() * ( float )RightCount;
+			}
+
+			BoundingBox LeftBounds{};
+			uint LeftCount{ 0u };
+
+			for (uint Bin{ 1u }; Bin < SAHBinCount; Bin++) {
+				LeftBounds.Grow(Bins.Bounds[Axis][Bin - 1u]);
+				LeftCount += Bins.Counts[Axis][Bin - 1u];
+
+				float Cost{ LeftBounds.GetSurfaceArea() * ( float )LeftCount + RightCosts[Bin] };
+
+				if (LeftCount > 0u && LeftCount < Count && Cost < BestSplit.Cost) {
+					BestSplit = { Cost, Axis, Bin };
+				}
+			}
+		}
+
+		return BestSplit;
+	}
+
+	// Partitions BuildReferences[Begin, End) with the binned surface area heuristic, returning where the right child starts, or Begin to make a leaf.
+	// Bins on the thread pool when Parallel is set.
+	inline uint SplitSAH(BuildContext& Context, uint Begin, uint End, uint Depth, const RangeBounds& Bounds, bool Parallel) {
+		const uint Count{ End - Begin };
+
+		if (Count <= 1u) {
+			return Begin;
+		}
+
+		SplitCandidate Split{};
+
+		if (Depth < MaxSAHDepth) {
+			SAHBins Bins{};
+
+			if (Parallel) {
+				std::vector<SAHBins> ChunkBins(Context.ChunkCount);
+
+				ParallelForChunks(Context.ThreadPool, Begin, End, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint ChunkIndex) {
+					BinReferences(Context, ChunkBegin, ChunkEnd, Bounds.CentroidBounds, ChunkBins[ChunkIndex]);
+				});
+
+				for (const SAHBins& CurrentChunkBins: ChunkBins) {
+					Bins.Grow(CurrentChunkBins);
+				}
+			} else {
+				BinReferences(Context, Begin, End, Bounds.CentroidBounds, Bins);
+			}
+
+			Split = FindSAHSplit(Bins, Count);
+		}
+
+		float LeafCost{ SAHIntersectionCost * ( float )Count };
+		float SplitCost{ SAHTraversalCost + SAHIntersectionCost * Split.Cost / std::max(Bounds.Bounds.GetSurfaceArea(), FLT_MIN) };
+
+		if (Split.Cost < FLT_MAX && (SplitCost < LeafCost || Count > MaxLeafReferenceCount)) {
+			return ( uint )(std::partition(Context.BuildReferences.begin() + Begin, Context.BuildReferences.begin() + End,
+								[&](const BuildReference& Reference) {
+									return GetBinIndex(Reference.Centroid, Split.Axis, Bounds.CentroidBounds) < Split.Bin;
+								}) -
+				Context.BuildReferences.begin());
+		} else if (Count > MaxLeafReferenceCount) {
+			// No useful SAH split (coincident centroids or too deep), so split at the median of the widest centroid axis.
+			float3 Extent{ Bounds.CentroidBounds.GetExtent() };
+			uint Axis{ Extent.x >= Extent.y && Extent.x >= Extent.z ? 0u : (Extent.y >= Extent.z ? 1u : 2u) };
+			uint Middle{ Begin + Count / 2u };
+
+			std::nth_element(Context.BuildReferences.begin() + Begin, Context.BuildReferences.begin() + Middle, Context.BuildReferences.begin() + End,
+				[&](const BuildReference& A, const BuildReference& B) {
+					return GetAxis(A.Centroid, Axis) < GetAxis(B.Centroid, Axis);
+				});
+
+			return Middle;
+		}
+
+		return Begin;
+	}
+
+	// Splits the Morton-ordered BuildReferences[Begin, End) at the first code that has the highest bit differing across the range set, returning where the
+	// right child starts, or Begin to make a leaf. Ranges of identical codes are split in the middle.
+	inline uint SplitMorton(const BuildContext& Context, uint Begin, uint End) {
+		const uint Count{ End - Begin };
+
+		if (Count <= LBVHMaxLeafReferenceCount) {
+			return Begin;
+		}
+
+		const uint FirstCode{ Context.MortonCodes[Begin] }, LastCode{ Context.MortonCodes[End - 1u] };
+
+		if (FirstCode == LastCode) {
+			return Begin + Count / 2u;
+		}
+
+		uint HighestDifferingBit{ 31u };
+
+		while (((FirstCode ^ LastCode) >> HighestDifferingBit) == 0u) {
+			HighestDifferingBit--;
+		}
+
+		return ( uint )(std::partition_point(Context.MortonCodes.begin() + Begin, Context.MortonCodes.begin() + End,
+							[&](uint Code) {
+								return ((Code >> HighestDifferingBit) & 1u) == 0u;
+							}) -
+			Context.MortonCodes.begin());
+	}
+
+	// Spreads the low 10 bits of a value out to every third bit.
+	inline uint ExpandMortonBits(uint Value) {
+		Value = (Value * 0x00010001u) & 0xFF0000FFu;
+		Value = (Value * 0x00000101u) & 0x0F00F00Fu;
+		Value = (Value * 0x00000011u) & 0xC30C30C3u;
+		Value = (Value * 0x00000005u) & 0x49249249u;
+		return Value;
+	}
+
+	// 30-bit Morton code of a centroid, quantized to 1024 steps per axis within the scene's centroid bounds.
+	inline uint GetMortonCode(const float3& Centroid, const BoundingBox& CentroidBounds) {
+		float3 Extent{ CentroidBounds.GetExtent() };
+		float3 Offset{ Centroid - CentroidBounds.Min };
+
+		auto Quantize = [](float Value, float AxisExtent) {
+			return AxisExtent > 0.0f ? std::min(( uint )(Value / AxisExtent * 1024.0f), 1023u) : 0u;
+		};
+
+		return (ExpandMortonBits(Quantize(Offset.x, Extent.x)) << 2u) | (ExpandMortonBits(Quantize(Offset.y, Extent.y)) << 1u) |
+			ExpandMortonBits(Quantize(Offset.z, Extent.z));
+	}
+
+	// Computes every reference's Morton code, then sorts the references by it with a parallel least-significant-digit radix sort.
+	inline void SortByMortonCode(BuildContext& Context, const BoundingBox& CentroidBounds) {
+		const uint ReferenceCount{ ( uint )Context.BuildReferences.size() };
+		const uint DigitBits{ 8u }, DigitCount{ 1u << DigitBits };
+
+		std::vector<uint> Codes(ReferenceCount), SortedCodes(ReferenceCount);
+		std::vector<uint> Indices(ReferenceCount), SortedIndices(ReferenceCount);
+		std::vector<uint> Histograms(( size_t )Context.ChunkCount * DigitCount);
+
+		ParallelForChunks(Context.ThreadPool, 0u, ReferenceCount, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint) {
+			for (uint i{ ChunkBegin }; i < ChunkEnd; i++) {
+				Codes[i] = GetMortonCode(Context.BuildReferences[i].Centroid, CentroidBounds);
+				Indices[i] = i;
+			}
+		});
+
+		for (uint Shift{ 0u }; Shift < 32u; Shift += DigitBits) {
+			ParallelForChunks(Context.ThreadPool, 0u, ReferenceCount, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint ChunkIndex) {
+				uint* Histogram{ Histograms.data() + ( size_t )ChunkIndex * DigitCount };
+				std::fill(Histogram, Histogram + DigitCount, 0u);
+
+				for (uint i{ ChunkBegin }; i < ChunkEnd; i++) {
+					Histogram[(Codes[i] >> Shift) & (DigitCount - 1u)]++;
+				}
+			});
+
+			// Turn the counts into each chunk's first output slot per digit, ordered by digit then by chunk so that the sort stays stable.
+			uint Offset{ 0u };
+
+			for (uint Digit{ 0u }; Digit < DigitCount; Digit++) {
+				for (uint ChunkIndex{ 0u }; ChunkIndex < Context.ChunkCount; ChunkIndex++) {
+					uint& Slot{ Histograms[( size_t )ChunkIndex * DigitCount + Digit] };
+					uint SlotCount{ Slot };
+					Slot = Offset;
+					Offset += SlotCount;
+				}
+			}
+
+			ParallelForChunks(Context.ThreadPool, 0u, ReferenceCount, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint ChunkIndex) {
+				uint* Histogram{ Histograms.data() + ( size_t )ChunkIndex * DigitCount };
+
+				for (uint i{ ChunkBegin }; i < ChunkEnd; i++) {
+					uint Slot{ Histogram[(Codes[i] >> Shift) & (DigitCount - 1u)]++ };
+					SortedCodes[Slot] = Codes[i];
+					SortedIndices[Slot] = Indices[i];
+				}
+			});
+
+			Codes.swap(SortedCodes);
+			Indices.swap(SortedIndices);
+		}
+
+		std::vector<BuildReference> SortedReferences(ReferenceCount);
+
+		ParallelForChunks(Context.ThreadPool, 0u, ReferenceCount, Context.ChunkCount, [&](uint ChunkBegin, uint ChunkEnd, uint) {
+			for (uint i{ ChunkBegin }; i < ChunkEnd; i++) {
+				SortedReferences[i] = Context.BuildReferences[Indices[i]];
+			}
+		});
+
+		Context.BuildReferences.swap(SortedReferences);
+		Context.MortonCodes.swap(Codes);
+	}
+
+	// Splits BuildReferences[Begin, End) with the build's heuristic, returning where the right child starts, or Begin to make a leaf.
+	inline uint SplitRange(BuildContext& Context, uint Begin, uint End, uint Depth, bool Parallel) {
+		if (Context.BuildType == BVHBuildType::LBVH) {
+			return SplitMorton(Context, Begin, End);
+		}
+
+		RangeBounds Bounds{ Parallel ? GetRangeBoundsParallel(Context, Begin, End) : GetRangeBounds(Context, Begin, End) };
+		return SplitSAH(Context, Begin, End, Depth, Bounds, Parallel);
+	}
+
+	// Recursively builds BuildReferences[Begin, End) into a depth-first subtree at the end of Nodes, returning its bounds.
+	// Interior nodes index their right child relative to the start of Nodes, leaves index BuildReferences directly.
+	inline BoundingBox BuildSubtree(BuildContext& Context, std::vector<BVHNode>& Nodes, uint Begin, uint End, uint Depth) {
+		uint NodeIndex{ ( uint )Nodes.size() };
+		Nodes.push_back({});
+
+		uint Middle{ SplitRange(Context, Begin, End, Depth, false) };
+		BoundingBox Bounds{};
+
+		if (Middle == Begin || Middle == End) {
+			for (uint i{ Begin }; i < End; i++) {
+				Bounds.Grow(Context.BuildReferences[i].Bounds);
+			}
+
+			Nodes[NodeIndex] = { Bounds.Min, Begin, Bounds.Max, End - Begin };
+
+			return Bounds;
+		}
+
+		Bounds.Grow(BuildSubtree(Context, Nodes, Begin, Middle, Depth + 1u));
+		uint RightChildIndex{ ( uint )Nodes.size() };
+		Bounds.Grow(BuildSubtree(Context, Nodes, Middle, End, Depth + 1u));
+
+		Nodes[NodeIndex] = { Bounds.Min, RightChildIndex, Bounds.Max, 0u };
+
+		return Bounds;
+	}
+
+	// A node near the root, split on the calling thread, whose ranges below SubtreeReferenceCount become subtrees that are built in parallel.
+	struct TopNode {
+		uint Begin{ 0u };
+		uint End{ 0u };
+		uint Depth{ 0u };
+		uint LeftChild{ 0u };
+		uint RightChild{ 0u };
+		bool IsSubtree{ false };
+		BoundingBox Bounds{};
+		std::vector<BVHNode> SubtreeNodes{};
+	};
+
+	inline uint BuildTopNode(BuildContext& Context, std::vector<TopNode>& TopNodes, uint Begin, uint End, uint Depth, uint SubtreeReferenceCount) {
+		uint TopNodeIndex{ ( uint )TopNodes.size() };
+		TopNodes.push_back({ Begin, End, Depth });
+
+		uint Middle{ End - Begin > SubtreeReferenceCount ? SplitRange(Context, Begin, End, Depth, true) : Begin };
+
+		if (Middle == Begin || Middle == End) {
+			TopNodes[TopNodeIndex].IsSubtree = true;
+
+			return TopNodeIndex;
+		}
+
+		uint LeftChild{ BuildTopNode(Context, TopNodes, Begin, Middle, Depth + 1u, SubtreeReferenceCount) };
+		uint RightChild{ BuildTopNode(Context, TopNodes, Middle, End, Depth + 1u, SubtreeReferenceCount) };
+
+		TopNodes[TopNodeIndex].LeftChild = LeftChild;
+		TopNodes[TopNodeIndex].RightChild = RightChild;
+
+		return TopNodeIndex;
+	}
+
+	// Appends a top node and everything below it to the BVH depth-first, returning the index that it landed at.
+	inline uint EmitTopNode(std::vector<TopNode>& TopNodes, uint TopNodeIndex, BVH& BVH) {
+		uint NodeIndex{ ( uint )BVH.Nodes.size() };
+
+		if (TopNodes[TopNodeIndex].IsSubtree) {
+			for (BVHNode Node: TopNodes[TopNodeIndex].SubtreeNodes) {
+				if (Node.ReferenceCount == 0u) {
+					Node.RightChildOrFirstReference += NodeIndex;
+				}
+
+				BVH.Nodes.push_back(Node);
+			}
+
+			BVH.SubtreeNodeRanges.push_back({ NodeIndex, ( uint )BVH.Nodes.size() });
+
+			return NodeIndex;
+		}
+
+		BVH.Nodes.push_back({});
+		BVH.TopNodeIndices.push_back(NodeIndex);
+
+		EmitTopNode(TopNodes, TopNodes[TopNodeIndex].LeftChild, BVH);
+		uint RightChildIndex{ EmitTopNode(TopNodes, TopNodes[TopNodeIndex].RightChild, BVH) };
+
+		TopNode& CurrentTopNode{ TopNodes[TopNodeIndex] };
+		CurrentTopNode.Bounds = TopNodes[CurrentTopNode.LeftChild].Bounds;
+		CurrentTopNode.Bounds.Grow(TopNodes[CurrentTopNode.RightChild].Bounds);
+
+		BVH.Nodes[NodeIndex] = { CurrentTopNode.Bounds.Min, RightChildIndex, CurrentTopNode.Bounds.Max, 0u };
+
+		return NodeIndex;
+	}
+
+	// A node's traversal or intersection cost, weighted by its surface area.
+	inline double GetNodeSAHCost(const BVHNode& Node) {
+		BoundingBox Bounds{ Node.BoundsMin, Node.BoundsMax };
+		return Bounds.GetSurfaceArea() * (Node.ReferenceCount > 0u ? SAHIntersectionCost * Node.ReferenceCount : SAHTraversalCost);
+	}
+
+	inline float GetNormalizedSAHCost(const BVH& BVH, double NodeSAHCostSum) {
+		BoundingBox RootBounds{ BVH.Nodes[0].BoundsMin, BVH.Nodes[0].BoundsMax };
+		return ( float )(NodeSAHCostSum / std::max(( double )RootBounds.GetSurfaceArea(), ( double )FLT_MIN));
+	}
+
+	// Expected cost of tracing a ray through a BVH: each node's traversal or intersection cost, weighted by the chance that a random ray hitting the
+	// root also hits that node (the ratio of their surface areas).
+	inline float GetSAHCost(const BVH& BVH) {
+		if (BVH.Nodes.empty()) {
+			return 0.0f;
+		}
+
+		double Cost{ 0.0 };
+
+		for (const BVHNode& Node: BVH.Nodes) {
+			Cost += GetNodeSAHCost(Node);
+		}
+
+		return GetNormalizedSAHCost(BVH, Cost);
+	}
+
+	// Recomputes a node's bounds from its references, or from its children (which must be refit first), returning its SAH cost.
+	// While the shutter is open, its motion node gets its bounds at the open and close, and the node itself their union.
+	inline double RefitNode(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, BVH& BVH, uint NodeIndex) {
+		BVHNode& Node{ BVH.Nodes[NodeIndex] };
+		BoundingBox Bounds{};
+
+		if (Shutter.IsOpen()) {
+			BoundingBox OpenBounds{}, CloseBounds{};
+
+			if (Node.ReferenceCount > 0u) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					BoundingBox ReferenceOpenBounds{}, ReferenceCloseBounds{};
+					GetReferenceMotionBounds(Scene, BVH.References[Node.RightChildOrFirstReference + i], Shutter, ReferenceOpenBounds, ReferenceCloseBounds);
+					OpenBounds.Grow(ReferenceOpenBounds);
+					CloseBounds.Grow(ReferenceCloseBounds);
+				}
+			} else {
+				for (uint ChildIndex: { NodeIndex + 1u, Node.RightChildOrFirstReference }) {
+					const MotionBVHNode& Child{ BVH.MotionNodes[ChildIndex] };
+					OpenBounds.Grow({ Child.OpenBoundsMin, Child.OpenBoundsMax });
+					CloseBounds.Grow({ Child.CloseBoundsMin, Child.CloseBoundsMax });
+				}
+			}
+
+			BVH.MotionNodes[NodeIndex] = { OpenBounds.Min, Node.RightChildOrFirstReference, OpenBounds.Max, Node.ReferenceCount, CloseBounds.Min, 0u,
+				CloseBounds.Max, 0u };
+
+			Bounds.Grow(OpenBounds);
+			Bounds.Grow(CloseBounds);
+		} else if (Node.ReferenceCount > 0u) {
+			for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+				Bounds.Grow(GetReferenceBounds(Scene, BVH.References[Node.RightChildOrFirstReference + i]));
+			}
+		} else {
+			const BVHNode& LeftChild{ BVH.Nodes[NodeIndex + 1u] };
+			const BVHNode& RightChild{ BVH.Nodes[Node.RightChildOrFirstReference] };
+
+			Bounds.Grow({ LeftChild.BoundsMin, LeftChild.BoundsMax });
+			Bounds.Grow({ RightChild.BoundsMin, RightChild.BoundsMax });
+		}
+
+		Node.BoundsMin = Bounds.Min;
+		Node.BoundsMax = Bounds.Max;
+
+		return GetNodeSAHCost(Node);
+	}
+
+	// Refits every node of a BVH bottom-up, returning the sum of their SAH costs. Children always follow their parents, so each subtree is refit in
+	// parallel by walking its node range backwards, and then the few nodes above them are walked the same way.
+	inline double RefitNodes(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, CPUStuff::ThreadPool& ThreadPool, BVH& BVH) {
+		BVH.MotionNodes.resize(Shutter.IsOpen() ? BVH.Nodes.size() : 0u);
+
+		std::vector<double> SubtreeSAHCosts(BVH.SubtreeNodeRanges.size());
+
+		ThreadPool.ParallelFor(( int64_t )BVH.SubtreeNodeRanges.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				const uint2& NodeRange{ BVH.SubtreeNodeRanges[i] };
+
+				for (uint NodeIndex{ NodeRange.y }; NodeIndex-- > NodeRange.x;) {
+					SubtreeSAHCosts[i] += RefitNode(Scene, Shutter, BVH, NodeIndex);
+				}
+			}
+		});
+
+		double SAHCost{ 0.0 };
+
+		for (double SubtreeSAHCost: SubtreeSAHCosts) {
+			SAHCost += SubtreeSAHCost;
+		}
+
+		for (size_t i{ BVH.TopNodeIndices.size() }; i-- > 0u;) {
+			SAHCost += RefitNode(Scene, Shutter, BVH, BVH.TopNodeIndices[i]);
+		}
+
+		return SAHCost;
+	}
+
+	// Builds the tree over a context's BuildReferences into a BVH's Nodes, References, SubtreeNodeRanges and TopNodeIndices, spread across a thread pool.
+	// The top of the tree is split on the calling thread, with the binning (or Morton sort) of its large ranges in parallel, until there are a few
+	// ranges per thread left. Those are then built as independent subtrees, in parallel, and stitched together depth-first. No references, no nodes.
+	inline void BuildTree(BuildContext& Context, BVH& BVH) {
+		CPUStuff::ThreadPool& ThreadPool{ Context.ThreadPool };
+		const uint ReferenceCount{ ( uint )Context.BuildReferences.size() };
+
+		BVH.Nodes.clear();
+		BVH.References.resize(ReferenceCount);
+		BVH.SubtreeNodeRanges.clear();
+		BVH.TopNodeIndices.clear();
+
+		if (ReferenceCount == 0u) {
+			return;
+		}
+
+		if (Context.BuildType == BVHBuildType::LBVH) {
+			SortByMortonCode(Context, GetRangeBoundsParallel(Context, 0u, ReferenceCount).CentroidBounds);
+		}
+
+		const uint SubtreeReferenceCount{ std::max(ReferenceCount / (ThreadPool.GetThreadCount() * 16u), 1024u) };
+
+		std::vector<TopNode> TopNodes{};
+		BuildTopNode(Context, TopNodes, 0u, ReferenceCount, 0u, SubtreeReferenceCount);
+
+		std::vector<uint> SubtreeIndices{};
+
+		for (uint i{ 0u }; i < ( uint )TopNodes.size(); i++) {
+			if (TopNodes[i].IsSubtree) {
+				SubtreeIndices.push_back(i);
+			}
+		}
+
+		ThreadPool.ParallelFor(( int64_t )SubtreeIndices.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				TopNode& Subtree{ TopNodes[SubtreeIndices[i]] };
+				Subtree.SubtreeNodes.reserve(( size_t )(Subtree.End - Subtree.Begin) * 2u);
+				Subtree.Bounds = BuildSubtree(Context, Subtree.SubtreeNodes, Subtree.Begin, Subtree.End, Subtree.Depth);
+			}
+		});
+
+		BVH.Nodes.reserve(( size_t )ReferenceCount * 2u);
+		EmitTopNode(TopNodes, 0u, BVH);
+
+		ThreadPool.ParallelFor(ReferenceCount, 16384, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (uint i{ ( uint )BeginIndex }; i < ( uint )EndIndex; i++) {
+				BVH.References[i] = Context.BuildReferences[i].Reference;
+			}
+		});
+	}
+
+	inline void GetBuildStats(const BVH& BVH, BVHBuildStats& BuildStats) {
+		BuildStats.SAHCost = GetSAHCost(BVH);
+		BuildStats.NodeCount = ( uint )BVH.Nodes.size();
+		BuildStats.LeafCount = ( uint )std::count_if(BVH.Nodes.begin(), BVH.Nodes.end(), [](const BVHNode& Node) {
+			return Node.ReferenceCount > 0u;
+		});
+	}
+
+	// Builds a BVH over the current (interpolated) state of a scene's primitives with BuildTree(), leaving its prototype trees as they are.
+	// While the shutter is open, the tree is built over the primitives' bounds across the whole shutter, and its motion nodes are then fit to their
+	// bounds at its open and close. A scene without primitives gets no nodes at all.
+	inline void BuildBVH(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, CPUStuff::ThreadPool& ThreadPool, BVHBuildType BuildType,
+		BVH& BVH, BVHBuildStats& BuildStats) {
+		CPUStuff::Timer BuildTimer{};
+		BuildContext Context{ BuildType, ThreadPool };
+		Context.ChunkCount = ThreadPool.GetThreadCount() * 4u;
+
+		GetBuildReferences(Scene, Shutter, ThreadPool, Context.BuildReferences);
+		BuildTree(Context, BVH);
+
+		BVH.MotionNodes.clear();
+		BVH.PrimitiveCounts = { ( uint )Scene.Spheres.size(), ( uint )Scene.Rectangles.size(), ( uint )Scene.Triangles.size(),
+			( uint )Scene.MeshIndices.size() };
+		BVH.InstanceCount = ( uint )Scene.Instances.size();
+
+		if (!BVH.Nodes.empty() && Shutter.IsOpen()) {
+			RefitNodes(Scene, Shutter, ThreadPool, BVH);
+		}
+
+		BuildStats.BuildSeconds = BuildTimer.GetElapsedSeconds();
+		GetBuildStats(BVH, BuildStats);
+		BVH.BuildSAHCost = BuildStats.SAHCost;
+	}
+
+	// Builds the tree of every prototype of a scene into a BVH's prototype arrays, one after the other, each spread across the thread pool.
+	// Prototypes never move, so their trees only need building again when the scene's prototypes change. Returns false, leaving them untouched,
+	// if the prototype and triangle counts still match the trees. BuildStats gets the time and size of all of them, and the SAH cost of the last.
+	inline bool UpdatePrototypeBVHs(
+		const SceneStuff::Scene& Scene, CPUStuff::ThreadPool& ThreadPool, BVHBuildType BuildType, BVH& BVH, BVHBuildStats& BuildStats) {
+		if (BVH.PrototypeRootNodes.size() == Scene.Prototypes.size() && BVH.PrototypeReferences.size() == Scene.PrototypeIndices.size()) {
+			return false;
+		}
+
+		CPUStuff::Timer BuildTimer{};
+		BuildStats = {};
+
+		BVH.PrototypeNodes.clear();
+		BVH.PrototypeReferences.clear();
+		BVH.PrototypeRootNodes.clear();
+		BVH.PrototypeReferences.reserve(Scene.PrototypeIndices.size());
+
+		for (const Prototype& CurrentPrototype: Scene.Prototypes) {
+			BuildContext Context{ BuildType, ThreadPool };
+			Context.ChunkCount = ThreadPool.GetThreadCount() * 4u;
+			Context.BuildReferences.resize(CurrentPrototype.TriangleCount);
+
+			ThreadPool.ParallelFor(CurrentPrototype.TriangleCount, 4096, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (uint i{ ( uint )BeginIndex }; i < ( uint )EndIndex; i++) {
+					BuildReference& CurrentReference{ Context.BuildReferences[i] };
+					CurrentReference.Reference = CurrentPrototype.FirstTriangle + i;
+					CurrentReference.Bounds = GetPrototypeTriangleBounds(Scene, CurrentReference.Reference);
+					CurrentReference.Centroid = CurrentReference.Bounds.GetCentroid();
+				}
+			});
+
+			BVHStuff::BVH PrototypeBVH{};
+			BuildTree(Context, PrototypeBVH);
+
+			const uint NodeOffset{ ( uint )BVH.PrototypeNodes.size() }, ReferenceOffset{ ( uint )BVH.PrototypeReferences.size() };
+			BVH.PrototypeRootNodes.push_back(PrototypeBVH.Nodes.empty() ? NoPrototypeRootNode : NodeOffset);
+
+			for (BVHNode Node: PrototypeBVH.Nodes) {
+				Node.RightChildOrFirstReference += Node.ReferenceCount > 0u ? ReferenceOffset : NodeOffset;
+				BVH.PrototypeNodes.push_back(Node);
+			}
+
+			for (uint Reference: PrototypeBVH.References) {
+				BVH.PrototypeReferences.push_back(Reference);
+			}
+
+			GetBuildStats(PrototypeBVH, BuildStats);
+		}
+
+		BuildStats.BuildSeconds = BuildTimer.GetElapsedSeconds();
+		BuildStats.NodeCount = ( uint )BVH.PrototypeNodes.size();
+		BuildStats.LeafCount = ( uint )std::count_if(BVH.PrototypeNodes.begin(), BVH.PrototypeNodes.end(), [](const BVHNode& Node) {
+			return Node.ReferenceCount > 0u;
+		});
+
+		return true;
+	}
+
+	// Updates a BVH's bounds in place for primitives that have moved since it was built (or for a new shutter interval), keeping its topology.
+	// Returns false, leaving the BVH untouched, if the scene's primitive counts no longer match the tree.
+	inline bool RefitBVH(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, CPUStuff::ThreadPool& ThreadPool, BVH& BVH,
+		BVHBuildStats& BuildStats) {
+		if (BVH.PrimitiveCounts.x != ( uint )Scene.Spheres.size() || BVH.PrimitiveCounts.y != ( uint )Scene.Rectangles.size() ||
+			BVH.PrimitiveCounts.z != ( uint )Scene.Triangles.size() || BVH.PrimitiveCounts.w != ( uint )Scene.MeshIndices.size() ||
+			BVH.InstanceCount != ( uint )Scene.Instances.size()) {
+			return false;
+		}
+
+		CPUStuff::Timer RefitTimer{};
+		double SAHCost{ RefitNodes(Scene, Shutter, ThreadPool, BVH) };
+
+		BuildStats.BuildSeconds = RefitTimer.GetElapsedSeconds();
+		BuildStats.SAHCost = BVH.Nodes.empty() ? 0.0f : GetNormalizedSAHCost(BVH, SAHCost);
+		BuildStats.NodeCount = ( uint )BVH.Nodes.size();
+
+		return true;
+	}
+
+	/*
+		UPDATE TYPE:
+			Refit - The BVH's bounds were updated in place.
+			Rebuild - The BVH was built from scratch, because it was new, its topology changed, or refitting had degraded it too far.
+	*/
+	enum class BVHUpdateType { Refit, Rebuild };
+
+	// Brings a BVH up to date with a scene's current state. It is refit while that keeps its SAH cost within RebuildThreshold times the cost right
+	// after its last build, and rebuilt otherwise. A RebuildThreshold of zero or less rebuilds every time.
+	inline BVHUpdateType UpdateBVH(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, CPUStuff::ThreadPool& ThreadPool,
+		BVHBuildType BuildType, float RebuildThreshold, BVH& BVH, BVHBuildStats& BuildStats) {
+		// Time of a refit that degraded the tree too far, counted into the rebuild's, and zero rather than whatever BuildStats held on the way in.
+		double RefitSeconds{ 0.0 };
+
+		if (RebuildThreshold > 0.0f && !BVH.Nodes.empty() && RefitBVH(Scene, Shutter, ThreadPool, BVH, BuildStats)) {
+			if (BuildStats.SAHCost <= BVH.BuildSAHCost * RebuildThreshold) {
+				return BVHUpdateType::Refit;
+			}
+
+			RefitSeconds = BuildStats.BuildSeconds;
+		}
+
+		BuildBVH(Scene, Shutter, ThreadPool, BuildType, BVH, BuildStats);
+		BuildStats.BuildSeconds += RefitSeconds;
+
+		return BVHUpdateType::Rebuild;
+	}
+
+	// Total size of a BVH's nodes, motion nodes and references, along with those of its prototype trees, in bytes.
+	inline uint64_t GetBVHSizeInBytes(const BVH& BVH) {
+		return BVH.Nodes.capacity() * sizeof(BVHNode) + BVH.MotionNodes.capacity() * sizeof(MotionBVHNode) + BVH.References.capacity() * sizeof(uint) +
+			BVH.PrototypeNodes.capacity() * sizeof(BVHNode) + (BVH.PrototypeReferences.capacity() + BVH.PrototypeRootNodes.capacity()) * sizeof(uint);
+	}
+
+}
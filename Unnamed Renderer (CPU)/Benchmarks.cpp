@@ -0,0 +1,2085 @@
+// Benchmarks.cpp - Throughput and memory benchmarks for the CPU backend.
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#include "PathTracerStuff.hpp"
+#include "SceneCacheStuff.hpp"
+#include "SceneFileStuff.hpp"
+#include <cstring>
+#include <filesystem>
+
+// Settings shared by every benchmark, overridable from the command line.
+struct BenchmarkSettings {
+	SceneStuff::RenderSettings RenderSettings{};
+	uint ThreadCount{ 0u };
+};
+
+// Renders one frame of the stock scene with the given mode and reports its throughput and memory use.
+void ReportRenderMode(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool, PathTracerStuff::RenderMode RenderMode, const char* ModeName) {
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateDefaultScene(Settings.RenderSettings, Scene);
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = RenderMode;
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+
+	printf("  %-12s %10.3f s %12.3f MRays/s %12.3f MSamples/s %12.1f MiB resources %12.1f MiB peak RSS\n", ModeName, Stats.RenderSeconds,
+		Stats.GetRaysPerSecond() / 1.0e6, ( double )Stats.SampleCount / Stats.RenderSeconds / 1.0e6,
+		( double )Renderer.GetResourceSizeInBytes() / (1024.0 * 1024.0), ( double )CPUStuff::GetPeakResidentSetSizeInBytes() / (1024.0 * 1024.0));
+}
+
+// Fused single-pass and Wavefront tracing versus the Intersection Map passes, on the stock scene.
+// The modes without an Intersection Map run first, since peak RSS can only grow over the life of the process.
+void BenchmarkRenderModes(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	ReportRenderMode(Settings, ThreadPool, PathTracerStuff::RenderMode::Fused, "fused");
+	ReportRenderMode(Settings, ThreadPool, PathTracerStuff::RenderMode::Wavefront, "wavefront");
+	ReportRenderMode(Settings, ThreadPool, PathTracerStuff::RenderMode::ThreePass, "three-pass");
+}
+
+// Russian roulette against tracing every sample until it terminates or reaches MaxRecursionDepth, in both render modes.
+void BenchmarkPathTermination(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const PathTracerStuff::RenderMode RenderModes[]{ PathTracerStuff::RenderMode::Fused, PathTracerStuff::RenderMode::ThreePass };
+
+	for (PathTracerStuff::RenderMode RenderMode: RenderModes) {
+		double FrameSeconds[2]{};
+
+		for (uint RussianRouletteEnabled{ 0u }; RussianRouletteEnabled < 2u; RussianRouletteEnabled++) {
+			SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+
+			if (!RussianRouletteEnabled) {
+				RenderSettings.RussianRouletteDepth = RenderSettings.MaxRecursionDepth;
+			}
+
+			SceneStuff::Scene Scene{};
+			SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+
+			PathTracerStuff::RendererConfig RendererConfig{};
+			RendererConfig.Mode = RenderMode;
+
+			PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+			PathTracerStuff::RenderStats Stats{};
+			Renderer.RenderFrame(Scene, Stats);
+			FrameSeconds[RussianRouletteEnabled] = Stats.RenderSeconds;
+
+			printf("  %-12s %-16s %10.3f s %12.3f MRays/s %10.2f paths/sample %10.2fx fewer paths than full depth\n",
+				RenderMode == PathTracerStuff::RenderMode::Fused ? "fused" : "three-pass", RussianRouletteEnabled ? "russian-roulette" : "terminators-only",
+				Stats.RenderSeconds, Stats.GetRaysPerSecond() / 1.0e6, Stats.GetAveragePathLength(), Stats.GetPathTerminationSpeedup());
+		}
+
+		printf("  %-12s %-16s %10.2fx faster\n", "", "", FrameSeconds[1] > 0.0 ? FrameSeconds[0] / FrameSeconds[1] : 0.0);
+	}
+}
+
+// Root mean square difference between two Final Frames, over their RGB channels in [0, 1].
+double GetFrameRMSE(const CPUStuff::R8G8B8A8Uint* pFrame, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame) {
+	double SquaredErrorSum{ 0.0 };
+
+	for (size_t i{ 0u }; i < ReferenceFrame.size(); i++) {
+		const double dR{ (( double )pFrame[i].R - ( double )ReferenceFrame[i].R) / 255.0 };
+		const double dG{ (( double )pFrame[i].G - ( double )ReferenceFrame[i].G) / 255.0 };
+		const double dB{ (( double )pFrame[i].B - ( double )ReferenceFrame[i].B) / 255.0 };
+		SquaredErrorSum += dR * dR + dG * dG + dB * dB;
+	}
+
+	return sqrt(SquaredErrorSum / (( double )ReferenceFrame.size() * 3.0));
+}
+
+// RMSE of each sampler against a high sample-count reference, at 64, 256 and 1024 SPP.
+// Renders at a quarter of the benchmark's resolution, in fused mode, since the reference alone takes 8192 SPP.
+void BenchmarkSamplerConvergence(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint ReferenceSamplesPerPixel{ 8192u };
+	const uint SamplesPerPixelSteps[]{ 64u, 256u, 1024u };
+	const SamplerStuff::SamplerType SamplerTypes[]{ SamplerStuff::SamplerType::Independent, SamplerStuff::SamplerType::Stratified,
+		SamplerStuff::SamplerType::Sobol, SamplerStuff::SamplerType::BlueNoise };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 4u);
+	RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 4u);
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+	// The reference uses a differently seeded Sobol sampler, so its error is uncorrelated with that of the Sobol renders.
+	RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+
+	PathTracerStuff::RendererConfig ReferenceConfig{};
+	ReferenceConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	ReferenceConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+	ReferenceConfig.SamplerSeed = 1u;
+
+	PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+	PathTracerStuff::RenderStats ReferenceStats{};
+	ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+	const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+	printf("  %ux%u, reference: %u SPP in %.3f s\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, ReferenceSamplesPerPixel,
+		ReferenceStats.RenderSeconds);
+	printf("  %-12s %12s %12s %12s %24s\n", "sampler", "RMSE@64", "RMSE@256", "RMSE@1024", "SPP saved vs independent");
+
+	double IndependentRMSE{ 0.0 };
+
+	for (SamplerStuff::SamplerType SamplerType: SamplerTypes) {
+		double RMSE[3]{};
+
+		for (uint i{ 0u }; i < 3u; i++) {
+			RenderSettings.SamplesPerPixel = SamplesPerPixelSteps[i];
+			SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+
+			PathTracerStuff::RendererConfig RendererConfig{};
+			RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+			RendererConfig.SamplerType = SamplerType;
+
+			PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+			PathTracerStuff::RenderStats Stats{};
+			Renderer.RenderFrame(Scene, Stats);
+			RMSE[i] = GetFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame);
+		}
+
+		if (SamplerType == SamplerStuff::SamplerType::Independent) {
+			IndependentRMSE = RMSE[2];
+		}
+
+		// Monte Carlo error falls as 1 / sqrt(SPP), so the squared RMSE ratio estimates the sample count that reaches the same error.
+		const double EquivalentFraction{ IndependentRMSE > 0.0 ? (RMSE[2] * RMSE[2]) / (IndependentRMSE * IndependentRMSE) : 0.0 };
+
+		printf("  %-12s %12.5f %12.5f %12.5f %23.1f%%\n", SamplerStuff::GetSamplerName(SamplerType), RMSE[0], RMSE[1], RMSE[2],
+			(1.0 - EquivalentFraction) * 100.0);
+	}
+}
+
+// Checks that each sampler's first two dimensions are uniform over [0, 1), for square and non-square sample counts.
+// Bins them over 4096 pixels into as many columns and rows as the Stratified grid has, and reports the chi-squared statistic per degree of freedom.
+void BenchmarkSamplerMarginals(const BenchmarkSettings&, CPUStuff::ThreadPool& ThreadPool) {
+	const uint SampleCounts[]{ 5u, 16u, 3000u };
+	const uint2 PixelDimensions{ 64u, 64u };
+	const double MaxChiSquaredPerBin{ 2.0 };
+	const SamplerStuff::SamplerType SamplerTypes[]{ SamplerStuff::SamplerType::Independent, SamplerStuff::SamplerType::Stratified,
+		SamplerStuff::SamplerType::Sobol, SamplerStuff::SamplerType::BlueNoise };
+
+	printf("  %ux%u pixels, %.1f chi-squared per degree of freedom at most\n", PixelDimensions.x, PixelDimensions.y, MaxChiSquaredPerBin);
+	printf("  %-12s %8s %10s %14s %14s %10s\n", "sampler", "SPP", "bins", "x chi2/dof", "y chi2/dof", "uniform");
+
+	for (SamplerStuff::SamplerType SamplerType: SamplerTypes) {
+		const SamplerStuff::Sampler Sampler{ SamplerStuff::CreateSampler(SamplerType) };
+
+		for (uint SampleCount: SampleCounts) {
+			const uint Columns{ std::max(1u, ( uint )sqrtf(( float )SampleCount)) };
+			const uint Rows{ (SampleCount + Columns - 1u) / Columns };
+			const uint BinCounts[2]{ Columns, Rows };
+			std::vector<uint64_t> Bins[2]{ std::vector<uint64_t>(Columns), std::vector<uint64_t>(Rows) };
+
+			// Each pixel is a separate pattern, so its samples are binned on its own thread, and the bins summed afterwards.
+			std::vector<std::vector<uint64_t>> PixelBins(( size_t )PixelDimensions.x * PixelDimensions.y);
+
+			ThreadPool.ParallelFor(( int64_t )PixelBins.size(), 64, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (uint PixelIndex{ ( uint )BeginIndex }; PixelIndex < ( uint )EndIndex; PixelIndex++) {
+					const uint2 Pixel{ PixelIndex % PixelDimensions.x, PixelIndex / PixelDimensions.x };
+					std::vector<uint64_t>& CurrentBins{ PixelBins[PixelIndex] };
+					CurrentBins.assign(( size_t )Columns + Rows, 0u);
+
+					for (uint SampleIndex{ 0u }; SampleIndex < SampleCount; SampleIndex++) {
+						for (uint Dimension{ 0u }; Dimension < 2u; Dimension++) {
+							const float Sample{ SamplerStuff::GetSample(Sampler, Pixel, SampleIndex, SampleCount, Dimension) };
+							const uint Bin{ std::min(( uint )(Sample * ( float )BinCounts[Dimension]), BinCounts[Dimension] - 1u) };
+							CurrentBins[(Dimension == 0u ? 0u : Columns) + Bin]++;
+						}
+					}
+				}
+			});
+
+			for (const std::vector<uint64_t>& CurrentBins: PixelBins) {
+				for (uint Bin{ 0u }; Bin < Columns; Bin++) {
+					Bins[0][Bin] += CurrentBins[Bin];
+				}
+
+				for (uint Bin{ 0u }; Bin < Rows; Bin++) {
+					Bins[1][Bin] += CurrentBins[( size_t )Columns + Bin];
+				}
+			}
+
+			double ChiSquaredPerBin[2]{};
+
+			for (uint Dimension{ 0u }; Dimension < 2u; Dimension++) {
+				const double ExpectedCount{ ( double )SampleCount * ( double )PixelBins.size() / ( double )BinCounts[Dimension] };
+				double ChiSquared{ 0.0 };
+
+				for (uint64_t Count: Bins[Dimension]) {
+					ChiSquared += (( double )Count - ExpectedCount) * (( double )Count - ExpectedCount) / ExpectedCount;
+				}
+
+				ChiSquaredPerBin[Dimension] = BinCounts[Dimension] > 1u ? ChiSquared / ( double )(BinCounts[Dimension] - 1u) : 0.0;
+			}
+
+			const bool IsUniform{ ChiSquaredPerBin[0] <= MaxChiSquaredPerBin && ChiSquaredPerBin[1] <= MaxChiSquaredPerBin };
+
+			printf("  %-12s %8u %4ux%-5u %14.3f %14.3f %10s\n", SamplerStuff::GetSamplerName(SamplerType), SampleCount, Columns, Rows, ChiSquaredPerBin[0],
+				ChiSquaredPerBin[1], IsUniform ? "yes" : "NO");
+		}
+	}
+}
+
+// Rays/s of the BVH on random scenes of 16 to 1M primitives, against brute force where that finishes in reasonable time.
+// Renders a single frame at 1/16th of the benchmark's SPP, in fused mode, and checks that both produce the same Final Frame.
+void BenchmarkBVHScaling(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 16u, 256u, 4096u, 65536u, 1048576u };
+	const uint MaxBruteForcePrimitiveCount{ 4096u };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.SamplesPerPixel = std::max(1u, RenderSettings.SamplesPerPixel / 16u);
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+	printf("  %ux%u, %u SPP\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, RenderSettings.SamplesPerPixel);
+	printf("  %-12s %12s %14s %18s %10s %12s\n", "primitives", "build", "BVH MRays/s", "brute MRays/s", "speedup", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		SceneStuff::Scene Scene{};
+		SceneStuff::CreateRandomScene(RenderSettings, PrimitiveCount, 1u, Scene);
+
+		PathTracerStuff::RendererConfig RendererConfig{};
+		RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+
+		PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats Stats{};
+		Renderer.RenderFrame(Scene, Stats);
+
+		// Build time is reported separately, so it is left out of the BVH's trace throughput.
+		PathTracerStuff::RenderStats TraceStats{ Stats };
+		TraceStats.RenderSeconds -= Stats.AccelerationBuildSeconds;
+
+		printf("  %-12u %10.3f s %14.3f", PrimitiveCount, Stats.AccelerationBuildSeconds, TraceStats.GetRaysPerSecond() / 1.0e6);
+
+		if (PrimitiveCount > MaxBruteForcePrimitiveCount) {
+			printf(" %18s %10s %12s\n", "-", "-", "-");
+			continue;
+		}
+
+		RendererConfig.AccelerationStructure = PathTracerStuff::AccelerationStructureType::BruteForce;
+
+		PathTracerStuff::Renderer BruteForceRenderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats BruteForceStats{};
+		BruteForceRenderer.RenderFrame(Scene, BruteForceStats);
+
+		const bool FramesAreIdentical{ memcmp(Renderer.GetFinalFrame(), BruteForceRenderer.GetFinalFrame(), PixelCount * sizeof(CPUStuff::R8G8B8A8Uint)) == 0 };
+
+		printf(" %18.3f %9.2fx %12s\n", BruteForceStats.GetRaysPerSecond() / 1.0e6, BruteForceStats.RenderSeconds / TraceStats.RenderSeconds,
+			FramesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// Build time, tree quality and trace speed of each BVH builder on random scenes, with the speedup of building on the whole thread pool over one thread.
+// Traces a single frame at 1/16th of the benchmark's SPP, in fused mode.
+void BenchmarkBVHBuild(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 65536u, 1048576u };
+	const BVHStuff::BVHBuildType BuildTypes[]{ BVHStuff::BVHBuildType::BinnedSAH, BVHStuff::BVHBuildType::LBVH };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.SamplesPerPixel = std::max(1u, RenderSettings.SamplesPerPixel / 16u);
+
+	CPUStuff::ThreadPool SingleThreadPool{ 1u };
+
+	printf("  %ux%u, %u SPP\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, RenderSettings.SamplesPerPixel);
+	printf("  %-12s %-8s %12s %16s %10s %12s %14s %12s\n", "primitives", "builder", "build", "1-thread build", "speedup", "SAH cost", "MRays/s",
+		"build+trace");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		SceneStuff::Scene Scene{};
+		SceneStuff::CreateRandomScene(RenderSettings, PrimitiveCount, 1u, Scene);
+
+		for (BVHStuff::BVHBuildType BuildType: BuildTypes) {
+			BVHStuff::BVH BVH{};
+			BVHStuff::BVHBuildStats SingleThreadBuildStats{};
+			BVHStuff::BuildBVH(Scene, SceneStuff::ShutterInterval{}, SingleThreadPool, BuildType, BVH, SingleThreadBuildStats);
+
+			PathTracerStuff::RendererConfig RendererConfig{};
+			RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+			RendererConfig.BVHBuildType = BuildType;
+
+			PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+			PathTracerStuff::RenderStats Stats{};
+			Renderer.RenderFrame(Scene, Stats);
+
+			PathTracerStuff::RenderStats TraceStats{ Stats };
+			TraceStats.RenderSeconds -= Stats.AccelerationBuildSeconds;
+
+			printf("  %-12u %-8s %10.3f s %14.3f s %9.2fx %12.1f %14.3f %10.3f s\n", PrimitiveCount, BVHStuff::GetBVHBuildTypeName(BuildType),
+				Stats.AccelerationBuildSeconds, SingleThreadBuildStats.BuildSeconds, SingleThreadBuildStats.BuildSeconds / Stats.AccelerationBuildSeconds,
+				Stats.AccelerationSAHCost, TraceStats.GetRaysPerSecond() / 1.0e6, Stats.RenderSeconds);
+		}
+	}
+}
+
+// Per-frame setup time over an animation of a random scene, split into interpolating the scene and updating its BVH, when rebuilding the BVH every
+// frame versus refitting it with the Renderer's default rebuild threshold. The SAH cost of the last frame's tree shows what refitting costs in quality.
+void BenchmarkBVHRefit(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCount{ 65536u };
+	const uint FrameCount{ 32u };
+	const float RebuildThresholds[]{ 0.0f, PathTracerStuff::RendererConfig{}.BVHRebuildThreshold };
+
+	printf("  %u primitives, %u frames\n", PrimitiveCount, FrameCount);
+	printf("  %-10s %16s %16s %16s %10s %10s %16s %16s\n", "update", "interpolate", "first build", "later updates", "rebuilds", "refits",
+		"first SAH cost", "last SAH cost");
+
+	for (float RebuildThreshold: RebuildThresholds) {
+		SceneStuff::Scene Scene{};
+		SceneStuff::CreateRandomScene(Settings.RenderSettings, PrimitiveCount, 1u, Scene);
+
+		BVHStuff::BVH BVH{};
+		BVHStuff::BVHBuildStats BuildStats{};
+		float FirstSAHCost{ 0.0f };
+		uint RebuildCount{ 0u };
+		double InterpolationSeconds{ 0.0 }, FirstBuildSeconds{ 0.0 }, UpdateSeconds{ 0.0 };
+
+		for (uint CurrentRenderIndex{ 0u }; CurrentRenderIndex < FrameCount; CurrentRenderIndex++) {
+			CPUStuff::Timer SetupTimer{};
+			SceneStuff::InterpolateScene(SceneStuff::GetGlobalTickInRadians(CurrentRenderIndex, FrameCount), Scene);
+			InterpolationSeconds += SetupTimer.GetElapsedSeconds();
+
+			BuildStats = {};
+
+			if (BVHStuff::UpdateBVH(Scene, SceneStuff::ShutterInterval{}, ThreadPool, BVHStuff::BVHBuildType::BinnedSAH, RebuildThreshold, BVH, BuildStats) ==
+				BVHStuff::BVHUpdateType::Rebuild) {
+				RebuildCount++;
+			}
+
+			if (CurrentRenderIndex == 0u) {
+				FirstBuildSeconds = BuildStats.BuildSeconds;
+				FirstSAHCost = BuildStats.SAHCost;
+			} else {
+				UpdateSeconds += BuildStats.BuildSeconds;
+			}
+		}
+
+		printf("  %-10s %13.3f ms %13.3f ms %13.3f ms %10u %10u %16.1f %16.1f\n", RebuildThreshold > 0.0f ? "refit" : "rebuild",
+			InterpolationSeconds * 1000.0 / FrameCount, FirstBuildSeconds * 1000.0, UpdateSeconds * 1000.0 / (FrameCount - 1u), RebuildCount,
+			FrameCount - RebuildCount, FirstSAHCost, BuildStats.SAHCost);
+	}
+}
+
+// Motion blur of the stock scene's mid-animation frame, traced in a single pass at a random time per path through the motion BVH, against averaging
+// static sub-frames at evenly spaced times across the same shutter. Both spend the benchmark's SPP (at least 64) per pixel, and are compared with a
+// 16 times higher SPP motion-blurred reference, at a quarter of the benchmark's resolution, in fused mode.
+// The sub-frames are averaged from their Final Frames by undoing and redoing RP3's gamma, like presented frames would be, so the 8-bit rounding and
+// clamping of each sub-frame (which bites on bright, sparsely sampled pixels) adds to their RMSE.
+void BenchmarkMotionBlur(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const float GlobalTickInRadians{ 1.0f };
+	const float ShutterLength{ 0.25f };
+	const uint SubFrameCounts[]{ 4u, 16u, 64u };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 4u);
+	RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 4u);
+	const uint SamplesPerPixel{ std::max(RenderSettings.SamplesPerPixel, 64u) };
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+	const SceneStuff::ShutterInterval Shutter{ SceneStuff::GetShutterInterval(GlobalTickInRadians, ShutterLength) };
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	RendererConfig.ShutterLength = ShutterLength;
+
+	// The reference is seeded differently, so that its error is uncorrelated with that of the single-pass render.
+	RenderSettings.SamplesPerPixel = SamplesPerPixel * 16u;
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+	SceneStuff::InterpolateScene(GlobalTickInRadians, Scene);
+
+	PathTracerStuff::RendererConfig ReferenceConfig{ RendererConfig };
+	ReferenceConfig.SamplerSeed = 1u;
+
+	PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+	PathTracerStuff::RenderStats ReferenceStats{};
+	ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+	const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+	printf("  %ux%u, shutter [%.3f, %.3f], reference: %u SPP in %.3f s\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y,
+		Shutter.Open, Shutter.Close, RenderSettings.SamplesPerPixel, ReferenceStats.RenderSeconds);
+	printf("  %-12s %12s %14s %12s %12s %14s\n", "method", "sub-frames", "SPP/sub-frame", "time", "RMSE", "relative time");
+
+	RenderSettings.SamplesPerPixel = SamplesPerPixel;
+	SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+	SceneStuff::InterpolateScene(GlobalTickInRadians, Scene);
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+
+	const double SinglePassSeconds{ Stats.RenderSeconds };
+
+	printf("  %-12s %12u %14u %10.3f s %12.5f %13.2fx\n", "motion-bvh", 1u, SamplesPerPixel, Stats.RenderSeconds,
+		GetFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame), 1.0);
+
+	for (uint SubFrameCount: SubFrameCounts) {
+		if (SamplesPerPixel % SubFrameCount != 0u) {
+			continue;
+		}
+
+		RenderSettings.SamplesPerPixel = SamplesPerPixel / SubFrameCount;
+		SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+
+		std::vector<double> LinearFrame(PixelCount * 3u);
+		std::vector<CPUStuff::R8G8B8A8Uint> AverageFrame(PixelCount);
+		CPUStuff::Timer SubFrameTimer{};
+
+		for (uint SubFrameIndex{ 0u }; SubFrameIndex < SubFrameCount; SubFrameIndex++) {
+			const float CurrentStep{ LinearInterpolation((( float )SubFrameIndex + 0.50f) / ( float )SubFrameCount, Shutter.Open, Shutter.Close) };
+			SceneStuff::InterpolateScene(CurrentStep * 2.0f, Scene);
+
+			// Each sub-frame is seeded differently, so that their samples are not all taken at the same offsets into the pixels.
+			PathTracerStuff::RendererConfig SubFrameConfig{};
+			SubFrameConfig.Mode = PathTracerStuff::RenderMode::Fused;
+			SubFrameConfig.SamplerSeed = SubFrameIndex + 2u;
+
+			PathTracerStuff::Renderer SubFrameRenderer{ ThreadPool, SubFrameConfig };
+			PathTracerStuff::RenderStats SubFrameStats{};
+			SubFrameRenderer.RenderFrame(Scene, SubFrameStats);
+
+			const CPUStuff::R8G8B8A8Uint* pSubFrame{ SubFrameRenderer.GetFinalFrame() };
+
+			for (size_t i{ 0u }; i < PixelCount; i++) {
+				const double Channels[3]{ pSubFrame[i].R / 255.0, pSubFrame[i].G / 255.0, pSubFrame[i].B / 255.0 };
+
+				for (uint Channel{ 0u }; Channel < 3u; Channel++) {
+					LinearFrame[i * 3u + Channel] += Channels[Channel] * Channels[Channel];
+				}
+			}
+		}
+
+		for (size_t i{ 0u }; i < PixelCount; i++) {
+			AverageFrame[i].R = CPUStuff::FloatToUnorm8(( float )sqrt(LinearFrame[i * 3u + 0u] / SubFrameCount));
+			AverageFrame[i].G = CPUStuff::FloatToUnorm8(( float )sqrt(LinearFrame[i * 3u + 1u] / SubFrameCount));
+			AverageFrame[i].B = CPUStuff::FloatToUnorm8(( float )sqrt(LinearFrame[i * 3u + 2u] / SubFrameCount));
+		}
+
+		const double SubFrameSeconds{ SubFrameTimer.GetElapsedSeconds() };
+
+		printf("  %-12s %12u %14u %10.3f s %12.5f %13.2fx\n", "sub-frames", SubFrameCount, RenderSettings.SamplesPerPixel, SubFrameSeconds,
+			GetFrameRMSE(AverageFrame.data(), ReferenceFrame), SubFrameSeconds / SinglePassSeconds);
+	}
+}
+
+// Single-threaded throughput of the closest-sphere search, one ray at a time against 16 to 4096 random spheres: the brute-force search's per-Sphere
+// test over the scene's Spheres, against each packed kernel that the CPU supports. Every kernel has to find the same sphere at the same distance.
+void BenchmarkSphereSIMD(const BenchmarkSettings& Settings, CPUStuff::ThreadPool&) {
+	const uint SphereCounts[]{ 16u, 256u, 4096u };
+	const uint TestCount{ 1u << 24u };
+	const SIMDStuff::SIMDLevel Levels[]{ SIMDStuff::SIMDLevel::Scalar, SIMDStuff::SIMDLevel::AVX2, SIMDStuff::SIMDLevel::AVX512 };
+
+	printf("  %u sphere tests per kernel, CPU supports %s\n", TestCount, SIMDStuff::GetSIMDLevelName(SIMDStuff::GetSupportedSIMDLevel()));
+	printf("  %-10s %-14s %14s %12s %12s %12s\n", "spheres", "kernel", "MTests/s", "speedup", "hit rate", "identical");
+
+	for (uint SphereCount: SphereCounts) {
+		SceneStuff::Scene Scene{};
+		SceneStuff::CreateRandomScene(Settings.RenderSettings, SphereCount * 3u, 1u, Scene);
+
+		PathTracerStuff::PipelineResources Resources{};
+		Resources.RootConstants = Scene.RootConstants;
+		const float PathMinDistance{ Scene.RootConstants.PathMinDistance };
+		const float PathMaxDistance{ Scene.RootConstants.PathMaxDistance };
+
+		// Paths from the camera's focal origin towards random points of the volume that the random scene fills.
+		const uint PathCount{ TestCount / SphereCount };
+		std::vector<Path> Paths(PathCount);
+		std::mt19937 MersenneTwisterEngine{ 2u };
+		std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+
+		for (Path& CurrentPath: Paths) {
+			const float3 Target{ -20.0f + 40.0f * UnitDistribution(MersenneTwisterEngine), -12.0f + 24.0f * UnitDistribution(MersenneTwisterEngine),
+				+8.0f + 40.0f * UnitDistribution(MersenneTwisterEngine) };
+			CurrentPath.WSOrigin = Scene.RootConstants.WSCameraFocalOrigin;
+			CurrentPath.WSDirection = normalize(Target - CurrentPath.WSOrigin);
+			CurrentPath.Time = 0.0f;
+		}
+
+		std::vector<uint> ReferenceIndices(PathCount, ~0u);
+		std::vector<float> ReferenceDistances(PathCount, PathMaxDistance);
+		uint HitCount{ 0u };
+		CPUStuff::Timer Timer{};
+
+		for (uint i{ 0u }; i < PathCount; i++) {
+			float t;
+
+			for (uint SphereIndex{ 0u }; SphereIndex < SphereCount; SphereIndex++) {
+				if (PathTracerStuff::IntersectSphere(Resources, Scene.Spheres[SphereIndex], Paths[i], t) && t < ReferenceDistances[i]) {
+					ReferenceDistances[i] = t;
+					ReferenceIndices[i] = SphereIndex;
+				}
+			}
+
+			HitCount += ReferenceIndices[i] != ~0u ? 1u : 0u;
+		}
+
+		const double ReferenceSeconds{ Timer.GetElapsedSeconds() };
+		const double TotalTestCount{ ( double )PathCount * SphereCount };
+
+		printf("  %-10u %-14s %14.1f %11.2fx %11.1f%% %12s\n", SphereCount, "sphere-loop", TotalTestCount / ReferenceSeconds / 1.0e6, 1.0,
+			100.0 * HitCount / PathCount, "-");
+
+		SIMDStuff::PackedSpheres Packed{};
+		SIMDStuff::PackSpheres(Scene.Spheres, Packed);
+
+		for (SIMDStuff::SIMDLevel Level: Levels) {
+			if (Level > SIMDStuff::GetSupportedSIMDLevel()) {
+				continue;
+			}
+
+			const SIMDStuff::FindClosestSphereFunction FindClosestSphere{ SIMDStuff::GetFindClosestSphere(Level) };
+			bool HitsAreIdentical{ true };
+			HitCount = 0u;
+			Timer.Reset();
+
+			for (uint i{ 0u }; i < PathCount; i++) {
+				float ClosestHitDistance{ PathMaxDistance };
+				uint SphereIndex{ FindClosestSphere(Packed, Paths[i].WSOrigin, Paths[i].WSDirection, PathMinDistance, ClosestHitDistance) };
+
+				HitsAreIdentical &= SphereIndex == ReferenceIndices[i] && ClosestHitDistance == ReferenceDistances[i];
+				HitCount += SphereIndex != ~0u ? 1u : 0u;
+			}
+
+			const double Seconds{ Timer.GetElapsedSeconds() };
+
+			printf("  %-10u %-14s %14.1f %11.2fx %11.1f%% %12s\n", SphereCount, (std::string{ "packed-" } + SIMDStuff::GetSIMDLevelName(Level)).c_str(),
+				TotalTestCount / Seconds / 1.0e6, ReferenceSeconds / Seconds, 100.0 * HitCount / PathCount, HitsAreIdentical ? "yes" : "NO");
+		}
+	}
+}
+
+// Camera-path throughput through the BVH, tracing each path on its own against packets of RayPacketSize paths, on the stock scene and random scenes.
+// Frames are rendered a single bounce deep, so that only camera paths are cast, at the benchmark's SPP in fused mode, and have to come out identical.
+void BenchmarkRayPackets(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 0u, 4096u, 65536u, 1048576u };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.MaxRecursionDepth = 1u;
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+	printf("  %ux%u, %u SPP, camera paths only, %s packets of %u\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y,
+		RenderSettings.SamplesPerPixel, SIMDStuff::GetSIMDLevelName(SIMDStuff::GetSupportedSIMDLevel()), SIMDStuff::RayPacketSize);
+	printf("  %-12s %18s %18s %10s %12s\n", "primitives", "single MRays/s", "packet MRays/s", "speedup", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		SceneStuff::Scene Scene{};
+
+		if (PrimitiveCount > 0u) {
+			SceneStuff::CreateRandomScene(RenderSettings, PrimitiveCount, 1u, Scene);
+		} else {
+			SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+		}
+
+		PathTracerStuff::RendererConfig RendererConfig{};
+		RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+		RendererConfig.CameraRayPackets = false;
+
+		// Build time is left out of the trace throughput of both.
+		PathTracerStuff::Renderer SingleRenderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats SingleStats{};
+		SingleRenderer.RenderFrame(Scene, SingleStats);
+		SingleStats.RenderSeconds -= SingleStats.AccelerationBuildSeconds;
+
+		RendererConfig.CameraRayPackets = true;
+
+		PathTracerStuff::Renderer PacketRenderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats PacketStats{};
+		PacketRenderer.RenderFrame(Scene, PacketStats);
+		PacketStats.RenderSeconds -= PacketStats.AccelerationBuildSeconds;
+
+		const bool FramesAreIdentical{
+			memcmp(SingleRenderer.GetFinalFrame(), PacketRenderer.GetFinalFrame(), PixelCount * sizeof(CPUStuff::R8G8B8A8Uint)) == 0
+		};
+
+		printf("  %-12s %18.3f %18.3f %9.2fx %12s\n", PrimitiveCount > 0u ? std::to_string(PrimitiveCount).c_str() : "stock",
+			SingleStats.GetRaysPerSecond() / 1.0e6, PacketStats.GetRaysPerSecond() / 1.0e6, SingleStats.RenderSeconds / PacketStats.RenderSeconds,
+			FramesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// Cost of one path-rectangle test on 10K random quads, deriving the plane basis from the Rectangle on every test, as every test did before
+// RectangleRecords were precomputed, versus testing the precomputed RectangleRecord.
+void BenchmarkRectangles(const BenchmarkSettings&, CPUStuff::ThreadPool& ThreadPool) {
+	const uint RectangleCount{ 10240u };
+	const uint TestCount{ 1u << 24u };
+	const float3 Origin{ 0.0f, 0.0f, -10.0f };
+	const float MinDistance{ 0.001f };
+
+	std::mt19937 MersenneTwisterEngine{ 4u };
+	std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+	std::uniform_real_distribution<float> EdgeDistribution{ -4.0f, +4.0f };
+	CPUStuff::MappableVector<Rectangle> Rectangles(RectangleCount);
+	std::vector<float3> Directions(RectangleCount);
+
+	// Randomly oriented quads of the volume that the random scene fills, each path heading for a point near its quad, so that about half of the tests hit.
+	for (uint i{ 0u }; i < RectangleCount; i++) {
+		Rectangle& CurrentRectangle{ Rectangles[i] };
+		const float3 DS21{ EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine) };
+		const float3 Axis{ EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine) };
+		const float3 DS31{ normalize(cross(DS21, Axis)) * (4.0f * UnitDistribution(MersenneTwisterEngine)) };
+
+		CurrentRectangle.Q1 = { -20.0f + 40.0f * UnitDistribution(MersenneTwisterEngine), -12.0f + 24.0f * UnitDistribution(MersenneTwisterEngine),
+			+8.0f + 40.0f * UnitDistribution(MersenneTwisterEngine) };
+		CurrentRectangle.Q2 = CurrentRectangle.Q1 + DS21;
+		CurrentRectangle.Q3 = CurrentRectangle.Q1 + DS31;
+		CurrentRectangle.Q4 = CurrentRectangle.Q2 + DS31;
+		CurrentRectangle.PrimitiveId = 1u;
+
+		const float a{ UnitDistribution(MersenneTwisterEngine) * 1.4f }, b{ UnitDistribution(MersenneTwisterEngine) * 1.4f };
+		Directions[i] = normalize(CurrentRectangle.Q1 + a * DS21 + b * DS31 - Origin);
+	}
+
+	CPUStuff::Timer Timer{};
+	std::vector<RectangleStuff::RectangleRecord> Records{};
+	RectangleStuff::CreateRectangleRecords(Rectangles, ThreadPool, Records);
+	const double RecordSeconds{ Timer.GetElapsedSeconds() };
+
+	printf("  %u tests per kernel over %u rectangles (%zu-byte Rectangles, %zu-byte RectangleRecords, %.3f ms to create them)\n", TestCount,
+		RectangleCount, sizeof(Rectangle), sizeof(RectangleStuff::RectangleRecord), RecordSeconds * 1.0e3);
+	printf("  %-16s %12s %12s %12s %12s\n", "kernel", "ns/test", "speedup", "hit rate", "identical");
+
+	std::vector<float> ReferenceDistances(RectangleCount);
+	double ReferenceSeconds{ 0.0 };
+
+	for (uint Kernel{ 0u }; Kernel < 2u; Kernel++) {
+		const char* KernelNames[]{ "derived", "precomputed" };
+		bool HitsAreIdentical{ true };
+		uint HitCount{ 0u };
+		Timer.Reset();
+
+		for (uint Test{ 0u }; Test < TestCount; Test++) {
+			const uint i{ Test % RectangleCount };
+			float t{ -1.0f };
+			bool IsHit;
+
+			if (Kernel == 0u) {
+				RectangleStuff::RectangleRecord Record;
+				RectangleStuff::CreateRectangleRecord(Rectangles[i], Record);
+				IsHit = RectangleStuff::IntersectRectangle(Record, Origin, Directions[i], MinDistance, t);
+			} else {
+				IsHit = RectangleStuff::IntersectRectangle(Records[i], Origin, Directions[i], MinDistance, t);
+			}
+
+			t = IsHit ? t : -1.0f;
+			HitCount += IsHit ? 1u : 0u;
+
+			if (Kernel == 0u) {
+				ReferenceDistances[i] = t;
+			} else {
+				HitsAreIdentical &= t == ReferenceDistances[i];
+			}
+		}
+
+		const double Seconds{ Timer.GetElapsedSeconds() };
+		ReferenceSeconds = Kernel == 0u ? Seconds : ReferenceSeconds;
+
+		printf("  %-16s %12.2f %11.2fx %11.1f%% %12s\n", KernelNames[Kernel], Seconds * 1.0e9 / TestCount, ReferenceSeconds / Seconds,
+			100.0 * HitCount / TestCount, Kernel == 1u ? (HitsAreIdentical ? "yes" : "NO") : "-");
+	}
+}
+
+// Random triangles of the volume that the random scene fills, each with edges of up to MaxEdgeLength.
+void CreateRandomTriangles(uint TriangleCount, float MaxEdgeLength, std::mt19937& MersenneTwisterEngine, CPUStuff::MappableVector<Triangle>& Triangles) {
+	std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+	std::uniform_real_distribution<float> EdgeDistribution{ -MaxEdgeLength, +MaxEdgeLength };
+	Triangles.assign(TriangleCount, Triangle{});
+
+	for (Triangle& CurrentTriangle: Triangles) {
+		CurrentTriangle.V1 = { -20.0f + 40.0f * UnitDistribution(MersenneTwisterEngine), -12.0f + 24.0f * UnitDistribution(MersenneTwisterEngine),
+			+8.0f + 40.0f * UnitDistribution(MersenneTwisterEngine) };
+		CurrentTriangle.V2 = CurrentTriangle.V1 +
+			float3{ EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine) };
+		CurrentTriangle.V3 = CurrentTriangle.V1 +
+			float3{ EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine), EdgeDistribution(MersenneTwisterEngine) };
+		CurrentTriangle.PrimitiveId = 2u;
+	}
+}
+
+// Cost of one path-triangle test, and paths slipping through the shared edges and vertices of a mesh, for each triangle intersector.
+// "legacy-derived" rebuilds the normal and plane from the Triangle on every test, as every test did before TriangleRecords were precomputed.
+void BenchmarkTriangles(const BenchmarkSettings&, CPUStuff::ThreadPool& ThreadPool) {
+	const uint TriangleCount{ 65536u };
+	const uint TestCount{ 1u << 24u };
+	const float3 Origin{ 0.0f, 0.0f, -10.0f };
+	const float MinDistance{ 0.001f };
+
+	std::mt19937 MersenneTwisterEngine{ 3u };
+	std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+	CPUStuff::MappableVector<Triangle> Triangles{};
+	CreateRandomTriangles(TriangleCount, 4.0f, MersenneTwisterEngine, Triangles);
+
+	std::vector<TriangleStuff::TriangleRecord> Records{};
+	TriangleStuff::CreateTriangleRecords(Triangles, ThreadPool, Records);
+
+	// Each path heads for a point near its triangle, so that about a quarter of the tests hit.
+	std::vector<float3> Directions(TriangleCount);
+
+	for (uint i{ 0u }; i < TriangleCount; i++) {
+		const Triangle& CurrentTriangle{ Triangles[i] };
+		const float a{ UnitDistribution(MersenneTwisterEngine) * 1.4f }, b{ UnitDistribution(MersenneTwisterEngine) * 1.4f };
+		Directions[i] = normalize(CurrentTriangle.V1 + a * (CurrentTriangle.V2 - CurrentTriangle.V1) + b * (CurrentTriangle.V3 - CurrentTriangle.V1) - Origin);
+	}
+
+	printf("  %u tests per kernel over %u triangles (%zu-byte Triangles, %zu-byte TriangleRecords)\n", TestCount, TriangleCount, sizeof(Triangle),
+		sizeof(TriangleStuff::TriangleRecord));
+	printf("  %-16s %12s %12s %12s %12s\n", "kernel", "ns/test", "speedup", "hit rate", "identical");
+
+	std::vector<float> ReferenceDistances(TriangleCount);
+	double ReferenceSeconds{ 0.0 };
+
+	for (uint Kernel{ 0u }; Kernel < 3u; Kernel++) {
+		const char* KernelNames[]{ "legacy-derived", "legacy", "watertight" };
+		bool HitsAreIdentical{ true };
+		uint HitCount{ 0u };
+		CPUStuff::Timer Timer{};
+
+		for (uint Test{ 0u }; Test < TestCount; Test++) {
+			const uint i{ Test & (TriangleCount - 1u) };
+			float t{ -1.0f };
+			bool IsHit;
+
+			if (Kernel == 0u) {
+				TriangleStuff::TriangleRecord Record;
+				TriangleStuff::CreateTriangleRecord(Triangles[i], Record);
+				IsHit = TriangleStuff::IntersectTriangleLegacy(Record, Origin, Directions[i], MinDistance, t);
+			} else if (Kernel == 1u) {
+				IsHit = TriangleStuff::IntersectTriangleLegacy(Records[i], Origin, Directions[i], MinDistance, t);
+			} else {
+				IsHit = TriangleStuff::IntersectTriangleWatertight(Records[i], Origin, Directions[i], MinDistance, t);
+			}
+
+			t = IsHit ? t : -1.0f;
+			HitCount += IsHit ? 1u : 0u;
+
+			if (Kernel == 0u) {
+				ReferenceDistances[i] = t;
+			} else if (Kernel == 1u) {
+				HitsAreIdentical &= t == ReferenceDistances[i];
+			}
+		}
+
+		const double Seconds{ Timer.GetElapsedSeconds() };
+		ReferenceSeconds = Kernel == 0u ? Seconds : ReferenceSeconds;
+
+		printf("  %-16s %12.2f %11.2fx %11.1f%% %12s\n", KernelNames[Kernel], Seconds * 1.0e9 / TestCount, ReferenceSeconds / Seconds,
+			100.0 * HitCount / TestCount, Kernel == 1u ? (HitsAreIdentical ? "yes" : "NO") : "-");
+	}
+
+	// A height field of GridSize x GridSize quads, two triangles each, whose shared vertices are jittered off the grid. Paths are aimed at points
+	// along its interior edges and at its interior vertices from random origins above it, so every one of them has to hit some triangle.
+	const uint GridSize{ 32u };
+	const uint PointsPerEdge{ 7u };
+	const float GridOffset{ 100.0f };
+	std::vector<float3> Vertices((GridSize + 1u) * (GridSize + 1u));
+
+	for (uint y{ 0u }; y <= GridSize; y++) {
+		for (uint x{ 0u }; x <= GridSize; x++) {
+			const float Jitter{ (x > 0u && x < GridSize && y > 0u && y < GridSize) ? 0.3f : 0.0f };
+			Vertices[y * (GridSize + 1u) + x] = { GridOffset + ( float )x + Jitter * (UnitDistribution(MersenneTwisterEngine) - 0.5f),
+				GridOffset + ( float )y + Jitter * (UnitDistribution(MersenneTwisterEngine) - 0.5f), UnitDistribution(MersenneTwisterEngine) };
+		}
+	}
+
+	std::vector<TriangleStuff::TriangleRecord> MeshRecords{};
+	std::vector<float3> Targets{};
+
+	for (uint y{ 0u }; y < GridSize; y++) {
+		for (uint x{ 0u }; x < GridSize; x++) {
+			const float3& V00{ Vertices[y * (GridSize + 1u) + x] };
+			const float3& V10{ Vertices[y * (GridSize + 1u) + x + 1u] };
+			const float3& V01{ Vertices[(y + 1u) * (GridSize + 1u) + x] };
+			const float3& V11{ Vertices[(y + 1u) * (GridSize + 1u) + x + 1u] };
+
+			Triangle MeshTriangle{};
+			TriangleStuff::TriangleRecord Record;
+			MeshTriangle.V1 = V00, MeshTriangle.V2 = V10, MeshTriangle.V3 = V11;
+			TriangleStuff::CreateTriangleRecord(MeshTriangle, Record);
+			MeshRecords.push_back(Record);
+			MeshTriangle.V1 = V00, MeshTriangle.V2 = V11, MeshTriangle.V3 = V01;
+			TriangleStuff::CreateTriangleRecord(MeshTriangle, Record);
+			MeshRecords.push_back(Record);
+
+			// The quad's diagonal, and its left and bottom edges where they are shared with another quad.
+			for (uint Point{ 1u }; Point <= PointsPerEdge; Point++) {
+				const float Fraction{ ( float )Point / (PointsPerEdge + 1u) };
+				Targets.push_back(V00 + Fraction * (V11 - V00));
+
+				if (x > 0u) {
+					Targets.push_back(V00 + Fraction * (V01 - V00));
+				}
+
+				if (y > 0u) {
+					Targets.push_back(V00 + Fraction * (V10 - V00));
+				}
+			}
+
+			if (x > 0u && y > 0u) {
+				Targets.push_back(V00);
+			}
+		}
+	}
+
+	std::vector<float3> Origins(Targets.size()), TargetDirections(Targets.size());
+
+	for (size_t i{ 0u }; i < Targets.size(); i++) {
+		Origins[i] = Targets[i] + float3{ -8.0f + 16.0f * UnitDistribution(MersenneTwisterEngine), -8.0f + 16.0f * UnitDistribution(MersenneTwisterEngine),
+										  -10.0f - 10.0f * UnitDistribution(MersenneTwisterEngine) };
+		TargetDirections[i] = normalize(Targets[i] - Origins[i]);
+	}
+
+	printf("  %zu paths through the shared edges and vertices of a %ux%u-quad jittered mesh of %zu triangles\n", Targets.size(), GridSize, GridSize,
+		MeshRecords.size());
+	printf("  %-16s %12s %12s\n", "kernel", "leaks", "leak rate");
+
+	for (TriangleStuff::TriangleIntersector Intersector: { TriangleStuff::TriangleIntersector::Legacy, TriangleStuff::TriangleIntersector::Watertight }) {
+		uint LeakCount{ 0u };
+
+		for (size_t i{ 0u }; i < Targets.size(); i++) {
+			bool IsHit{ false };
+
+			for (const TriangleStuff::TriangleRecord& Record: MeshRecords) {
+				float t;
+				IsHit |= TriangleStuff::IntersectTriangle(Intersector, Record, Origins[i], TargetDirections[i], MinDistance, t);
+			}
+
+			LeakCount += IsHit ? 0u : 1u;
+		}
+
+		printf("  %-16s %12u %11.3f%%\n", TriangleStuff::GetTriangleIntersectorName(Intersector), LeakCount, 100.0 * LeakCount / Targets.size());
+	}
+}
+
+// Renders a scene with a given renderer, returning its throughput with the time to build the BVH and records left out.
+double GetTraceRaysPerSecond(CPUStuff::ThreadPool& ThreadPool, const PathTracerStuff::RendererConfig& RendererConfig, SceneStuff::Scene& Scene,
+	std::vector<CPUStuff::R8G8B8A8Uint>& FinalFrame) {
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+
+	const size_t PixelCount{ ( size_t )Scene.RootConstants.TSGridDimensions.x * Scene.RootConstants.TSGridDimensions.y };
+	FinalFrame.assign(Renderer.GetFinalFrame(), Renderer.GetFinalFrame() + PixelCount);
+
+	Stats.RenderSeconds -= Stats.AccelerationBuildSeconds;
+	return Stats.GetRaysPerSecond();
+}
+
+// Memory per triangle and rays/s of the indexed meshes of the mesh scene, against the same triangles as independent Triangles, which have to
+// render identically. Meshes are measured both static and with per-vertex keyframes; a Triangle always carries its keyframes and its record.
+void BenchmarkMeshes(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint TriangleCounts[]{ 65536u, 1048576u };
+
+	printf("  %-12s %14s %14s %14s %16s %16s %10s\n", "triangles", "static B/tri", "animated B/tri", "Triangle B/tri", "mesh MRays/s", "Triangle MRays/s",
+		"identical");
+
+	for (uint RequestedTriangleCount: TriangleCounts) {
+		SceneStuff::Scene MeshScene{};
+		SceneStuff::CreateMeshScene(Settings.RenderSettings, RequestedTriangleCount, 1u, MeshScene);
+
+		const uint TriangleCount{ ( uint )MeshScene.MeshIndices.size() };
+		const double AnimatedBytesPerTriangle{ ( double )SceneStuff::GetMeshesSizeInBytes(MeshScene) / TriangleCount };
+
+		// The same triangles, each with its own keyframes, sharing the materials of their meshes.
+		SceneStuff::Scene TriangleScene{};
+		TriangleScene.Triangles.resize(TriangleCount);
+		TriangleScene.Materials = MeshScene.Materials;
+
+		for (uint i{ 0u }; i < TriangleCount; i++) {
+			const Mesh& CurrentMesh{ MeshScene.Meshes[SceneStuff::GetMeshIndex(MeshScene.Meshes.data(), ( uint )MeshScene.Meshes.size(), i)] };
+			const uint3& Indices{ MeshScene.MeshIndices[i] };
+			Triangle& CurrentTriangle{ TriangleScene.Triangles[i] };
+
+			CurrentTriangle.V1Start = MeshScene.MeshVerticesStart[Indices.x];
+			CurrentTriangle.V2Start = MeshScene.MeshVerticesStart[Indices.y];
+			CurrentTriangle.V3Start = MeshScene.MeshVerticesStart[Indices.z];
+			CurrentTriangle.V1End = MeshScene.MeshVerticesEnd[Indices.x];
+			CurrentTriangle.V2End = MeshScene.MeshVerticesEnd[Indices.y];
+			CurrentTriangle.V3End = MeshScene.MeshVerticesEnd[Indices.z];
+			CurrentTriangle.PrimitiveId = 2u;
+			CurrentTriangle.ObjectId = i;
+			CurrentTriangle.MaterialIndex = CurrentMesh.MaterialIndex;
+		}
+
+		SceneStuff::SetRootConstants(Settings.RenderSettings, TriangleScene);
+		SceneStuff::InterpolateScene(0.0f, TriangleScene);
+
+		// Dropping the keyframes leaves the meshes static at their current state.
+		MeshScene.MeshVerticesStart.clear();
+		MeshScene.MeshVerticesEnd.clear();
+		const double StaticBytesPerTriangle{ ( double )SceneStuff::GetMeshesSizeInBytes(MeshScene) / TriangleCount };
+		const double TriangleBytesPerTriangle{ ( double )(sizeof(Triangle) + sizeof(TriangleStuff::TriangleRecord)) };
+
+		PathTracerStuff::RendererConfig RendererConfig{};
+		std::vector<CPUStuff::R8G8B8A8Uint> MeshFrame{}, TriangleFrame{};
+		const double MeshRaysPerSecond{ GetTraceRaysPerSecond(ThreadPool, RendererConfig, MeshScene, MeshFrame) };
+		const double TriangleRaysPerSecond{ GetTraceRaysPerSecond(ThreadPool, RendererConfig, TriangleScene, TriangleFrame) };
+		const bool FramesAreIdentical{ memcmp(MeshFrame.data(), TriangleFrame.data(), MeshFrame.size() * sizeof(CPUStuff::R8G8B8A8Uint)) == 0 };
+
+		printf("  %-12u %14.1f %14.1f %14.1f %16.3f %16.3f %10s\n", TriangleCount, StaticBytesPerTriangle, AnimatedBytesPerTriangle, TriangleBytesPerTriangle,
+			MeshRaysPerSecond / 1.0e6, TriangleRaysPerSecond / 1.0e6, FramesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// Load time of the mesh scene's triangles, of 1M and 10M, written out as binary PLY and as OBJ and imported back, which has to reproduce them exactly.
+// The files have just been written, so this measures parsing from the page cache rather than the disk.
+void BenchmarkImport(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint TriangleCounts[]{ 1048576u, 10485760u };
+
+	printf("  %-12s %-8s %12s %12s %14s %12s %10s\n", "triangles", "format", "file MiB", "seconds", "MTriangles/s", "MiB/s", "identical");
+
+	for (uint RequestedTriangleCount: TriangleCounts) {
+		SceneStuff::Scene SourceScene{};
+		SceneStuff::CreateMeshScene(Settings.RenderSettings, RequestedTriangleCount, 1u, SourceScene);
+
+		for (ImportStuff::MeshFileFormat Format: { ImportStuff::MeshFileFormat::PLY, ImportStuff::MeshFileFormat::OBJ }) {
+			const std::string FileName{ std::string{ "UnnamedRendererImport." } + ImportStuff::GetMeshFileFormatName(Format) };
+			const std::string FilePath{ (std::filesystem::temp_directory_path() / FileName).string() };
+
+			if (!ImportStuff::ExportMesh(FilePath.c_str(), Format, SourceScene.MeshVertices.data(), ( uint )SourceScene.MeshVertices.size(),
+					SourceScene.MeshIndices.data(), ( uint )SourceScene.MeshIndices.size(), 0u)) {
+				CPUStuff::FailBail(FilePath.c_str(), "Failed to write a mesh file");
+			}
+
+			SceneStuff::Scene ImportedScene{};
+			ImportStuff::ImportStats Stats{};
+
+			if (!ImportStuff::ImportMesh(FilePath.c_str(), 0u, ThreadPool, ImportedScene, Stats)) {
+				CPUStuff::FailBail(Stats.ErrorMessage, FilePath.c_str());
+			}
+
+			std::filesystem::remove(FilePath);
+
+			const bool MeshesAreIdentical{ ImportedScene.MeshVertices.size() == SourceScene.MeshVertices.size() &&
+				ImportedScene.MeshIndices.size() == SourceScene.MeshIndices.size() &&
+				memcmp(ImportedScene.MeshVertices.data(), SourceScene.MeshVertices.data(), SourceScene.MeshVertices.size() * sizeof(float3)) == 0 &&
+				memcmp(ImportedScene.MeshIndices.data(), SourceScene.MeshIndices.data(), SourceScene.MeshIndices.size() * sizeof(uint3)) == 0 };
+			const double FileSizeInMiB{ ( double )Stats.FileSizeInBytes / (1024.0 * 1024.0) };
+
+			printf("  %-12u %-8s %12.1f %12.3f %14.2f %12.1f %10s\n", Stats.TriangleCount, ImportStuff::GetMeshFileFormatName(Format), FileSizeInMiB,
+				Stats.Seconds, Stats.TriangleCount / Stats.Seconds / 1.0e6, FileSizeInMiB / Stats.Seconds, MeshesAreIdentical ? "yes" : "NO");
+		}
+	}
+}
+
+// Load time of random scenes of 64K and 1M primitives, saved to a scene file and loaded back, which has to reproduce them exactly.
+// The files have just been written, so this measures parsing from the page cache rather than the disk.
+void BenchmarkSceneFile(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 65536u, 1048576u };
+	const std::string FilePath{ (std::filesystem::temp_directory_path() / "UnnamedRendererBenchmark.scene").string() };
+
+	printf("  %-12s %12s %12s %12s %15s %12s %10s\n", "primitives", "file MiB", "save s", "load s", "MPrimitives/s", "MiB/s", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		SceneStuff::Scene SourceScene{};
+		SceneStuff::CreateRandomScene(Settings.RenderSettings, PrimitiveCount, 1u, SourceScene);
+
+		CPUStuff::Timer SaveTimer{};
+
+		if (!SceneFileStuff::SaveScene(FilePath.c_str(), Settings.RenderSettings, SourceScene)) {
+			CPUStuff::FailBail(FilePath.c_str(), "Failed to write a scene file");
+		}
+
+		const double SaveSeconds{ SaveTimer.GetElapsedSeconds() };
+		SceneStuff::RenderSettings LoadedSettings{};
+		SceneStuff::Scene LoadedScene{};
+		SceneFileStuff::SceneFileStats Stats{};
+
+		if (!SceneFileStuff::LoadSceneSettings(FilePath.c_str(), LoadedSettings, Stats) ||
+			!SceneFileStuff::LoadScene(FilePath.c_str(), LoadedSettings, ThreadPool, LoadedScene, Stats)) {
+			CPUStuff::FailBail(Stats.ErrorMessage, FilePath.c_str());
+		}
+
+		std::filesystem::remove(FilePath);
+
+		const bool ScenesAreIdentical{ LoadedScene.Spheres.size() == SourceScene.Spheres.size() &&
+			LoadedScene.Rectangles.size() == SourceScene.Rectangles.size() && LoadedScene.Triangles.size() == SourceScene.Triangles.size() &&
+			memcmp(LoadedScene.Spheres.data(), SourceScene.Spheres.data(), SourceScene.Spheres.size() * sizeof(Sphere)) == 0 &&
+			memcmp(LoadedScene.Rectangles.data(), SourceScene.Rectangles.data(), SourceScene.Rectangles.size() * sizeof(Rectangle)) == 0 &&
+			memcmp(LoadedScene.Triangles.data(), SourceScene.Triangles.data(), SourceScene.Triangles.size() * sizeof(Triangle)) == 0 &&
+			memcmp(&LoadedScene.RootConstants, &SourceScene.RootConstants, sizeof(InlineRootConstants)) == 0 };
+		const double FileSizeInMiB{ ( double )Stats.FileSizeInBytes / (1024.0 * 1024.0) };
+
+		printf("  %-12u %12.1f %12.3f %12.3f %15.2f %12.1f %10s\n", PrimitiveCount, FileSizeInMiB, SaveSeconds, Stats.Seconds,
+			PrimitiveCount / Stats.Seconds / 1.0e6, FileSizeInMiB / Stats.Seconds, ScenesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// Startup time of random scenes from their scene file, parsing it and building the BVH every time ("text"), doing so once and writing a scene cache
+// ("cold"), and mapping that cache on every later start ("warm"), along with the first frame rendered from the parsed and from the mapped scene.
+// The cache's pages are in the OS's file cache by then, as they are for repeated render jobs on a machine.
+void BenchmarkSceneCache(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 65536u, 1048576u };
+	const std::string SceneFilePath{ (std::filesystem::temp_directory_path() / "UnnamedRendererBenchmark.scene").string() };
+	const std::string CacheFilePath{ (std::filesystem::temp_directory_path() / "UnnamedRendererBenchmark.cache").string() };
+	const BVHStuff::BVHBuildType BuildType{ BVHStuff::BVHBuildType::BinnedSAH };
+
+	printf("  %-12s %12s %12s %12s %12s %12s %10s %14s %14s %10s\n", "primitives", "cache MiB", "text s", "cold s", "warm s", "hash s", "speedup",
+		"text frame s", "warm frame s", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		{
+			SceneStuff::Scene SourceScene{};
+			SceneStuff::CreateRandomScene(Settings.RenderSettings, PrimitiveCount, 1u, SourceScene);
+
+			if (!SceneFileStuff::SaveScene(SceneFilePath.c_str(), Settings.RenderSettings, SourceScene)) {
+				CPUStuff::FailBail(SceneFilePath.c_str(), "Failed to write a scene file");
+			}
+		}
+
+		std::filesystem::remove(CacheFilePath);
+
+		// Text: what every start did before, parsing the scene and building its BVH.
+		SceneStuff::Scene TextScene{};
+		BVHStuff::BVH TextBVH{};
+		SceneFileStuff::SceneFileStats SceneFileStats{};
+		BVHStuff::BVHBuildStats BuildStats{};
+		CPUStuff::Timer TextTimer{};
+
+		if (!SceneFileStuff::LoadScene(SceneFilePath.c_str(), Settings.RenderSettings, ThreadPool, TextScene, SceneFileStats)) {
+			CPUStuff::FailBail(SceneFileStats.ErrorMessage, SceneFilePath.c_str());
+		}
+
+		BVHStuff::BuildBVH(TextScene, SceneStuff::ShutterInterval{}, ThreadPool, BuildType, TextBVH, BuildStats);
+		const double TextSeconds{ TextTimer.GetElapsedSeconds() };
+
+		// Cold: the first start, which also writes the cache.
+		double ColdSeconds{ 0.0 };
+		SceneCacheStuff::SceneCacheStats CacheStats{};
+
+		{
+			SceneStuff::Scene ColdScene{};
+			BVHStuff::BVH ColdBVH{};
+			SceneCacheStuff::SceneCache ColdCache{};
+			CPUStuff::Timer ColdTimer{};
+
+			if (ColdCache.Open(CacheFilePath.c_str(), SceneFilePath.c_str(), BuildType, ColdScene, ColdBVH, CacheStats)) {
+				CPUStuff::FailBail(CacheFilePath.c_str(), "A scene cache was opened before it was written");
+			}
+
+			if (!SceneFileStuff::LoadScene(SceneFilePath.c_str(), Settings.RenderSettings, ThreadPool, ColdScene, SceneFileStats)) {
+				CPUStuff::FailBail(SceneFileStats.ErrorMessage, SceneFilePath.c_str());
+			}
+
+			if (!SceneCacheStuff::SaveSceneCache(CacheFilePath.c_str(), SceneFilePath.c_str(), SceneFileStats.MeshFilePaths, ColdScene, BuildType, ThreadPool,
+					ColdBVH, CacheStats)) {
+				CPUStuff::FailBail(CacheStats.ErrorMessage, CacheFilePath.c_str());
+			}
+
+			ColdSeconds = ColdTimer.GetElapsedSeconds();
+		}
+
+		// Warm: every later start, validating the cache against the scene file and mapping it.
+		SceneCacheStuff::SceneCache WarmCache{};
+		SceneStuff::Scene WarmScene{};
+		BVHStuff::BVH WarmBVH{};
+		CPUStuff::Timer WarmTimer{};
+
+		if (!WarmCache.Open(CacheFilePath.c_str(), SceneFilePath.c_str(), BuildType, WarmScene, WarmBVH, CacheStats)) {
+			CPUStuff::FailBail(CacheStats.ErrorMessage, CacheFilePath.c_str());
+		}
+
+		SceneStuff::SetRootConstants(Settings.RenderSettings, WarmScene);
+		const double WarmSeconds{ WarmTimer.GetElapsedSeconds() };
+
+		// The first frame of each, the warm one traced straight from the cache's pages.
+		PathTracerStuff::Renderer TextRenderer{ ThreadPool }, WarmRenderer{ ThreadPool };
+		PathTracerStuff::RenderStats TextStats{}, WarmStats{};
+		TextRenderer.SetPrebuiltBVH(std::move(TextBVH));
+		TextRenderer.RenderFrame(TextScene, TextStats);
+		WarmRenderer.SetPrebuiltBVH(std::move(WarmBVH));
+		WarmRenderer.RenderFrame(WarmScene, WarmStats);
+
+		const size_t PixelCount{ ( size_t )Settings.RenderSettings.PSViewPortDimensions.x * Settings.RenderSettings.PSViewPortDimensions.y };
+		const bool FramesAreIdentical{ memcmp(TextRenderer.GetFinalFrame(), WarmRenderer.GetFinalFrame(), PixelCount * sizeof(CPUStuff::R8G8B8A8Uint)) == 0 };
+
+		std::filesystem::remove(SceneFilePath);
+		std::filesystem::remove(CacheFilePath);
+
+		printf("  %-12u %12.1f %12.3f %12.3f %12.4f %12.4f %9.0fx %14.3f %14.3f %10s\n", PrimitiveCount,
+			( double )CacheStats.FileSizeInBytes / (1024.0 * 1024.0), TextSeconds, ColdSeconds, WarmSeconds, CacheStats.HashSeconds, TextSeconds / WarmSeconds,
+			TextStats.RenderSeconds, WarmStats.RenderSeconds, FramesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// A primitive with its material inline, as every primitive carried its color, scalar and Material ID before the material table.
+template<typename PrimitiveType> struct InlineMaterialPrimitive {
+	PrimitiveType Geometry;
+	Material InlineMaterial;
+};
+
+// The material of a hit through the inline layout: a switch on the kind of primitive, then a fetch from its wide record.
+float GetInlineMaterialSample(const InlineMaterialPrimitive<Sphere>* Spheres, const InlineMaterialPrimitive<Rectangle>* Rectangles,
+	const InlineMaterialPrimitive<Triangle>* Triangles, const IntersectionRecord& HitRecord) {
+	const Material* HitMaterial{ &Spheres[HitRecord.ObjectId].InlineMaterial };
+
+	if (HitRecord.PrimitiveId == 1) {
+		HitMaterial = &Rectangles[HitRecord.ObjectId].InlineMaterial;
+	} else if (HitRecord.PrimitiveId == 2) {
+		HitMaterial = &Triangles[HitRecord.ObjectId].InlineMaterial;
+	}
+
+	return HitMaterial->Color.x + HitMaterial->Color.y + HitMaterial->Color.z + HitMaterial->MaterialScalar + ( float )HitMaterial->MaterialId;
+}
+
+// Shading fetches per hit on random scenes of 64K and 1M primitives: the Color, MaterialScalar and Material ID of random hits, read from the material
+// table by MaterialIndex versus from materials kept inline in each primitive. Scenes either give every primitive its own material, or share 64.
+void BenchmarkMaterials(const BenchmarkSettings& Settings, CPUStuff::ThreadPool&) {
+	const uint PrimitiveCounts[]{ 65536u, 1048576u };
+	const uint SharedMaterialCount{ 64u };
+	const uint HitCount{ 1u << 24u };
+
+	printf("  %-12s %-10s %14s %14s %12s %12s %10s\n", "primitives", "materials", "inline B/prim", "table B/prim", "inline ns", "table ns", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		for (bool IsShared: { false, true }) {
+			SceneStuff::Scene Scene{};
+			SceneStuff::CreateRandomScene(Settings.RenderSettings, PrimitiveCount, 1u, Scene);
+
+			if (IsShared) {
+				Scene.Materials.resize(SharedMaterialCount);
+
+				for (Sphere& CurrentSphere: Scene.Spheres) {
+					CurrentSphere.MaterialIndex %= SharedMaterialCount;
+				}
+
+				for (Rectangle& CurrentRectangle: Scene.Rectangles) {
+					CurrentRectangle.MaterialIndex %= SharedMaterialCount;
+				}
+
+				for (Triangle& CurrentTriangle: Scene.Triangles) {
+					CurrentTriangle.MaterialIndex %= SharedMaterialCount;
+				}
+			}
+
+			SceneStuff::InterpolateScene(0.0f, Scene);
+
+			std::vector<InlineMaterialPrimitive<Sphere>> InlineSpheres(Scene.Spheres.size());
+			std::vector<InlineMaterialPrimitive<Rectangle>> InlineRectangles(Scene.Rectangles.size());
+			std::vector<InlineMaterialPrimitive<Triangle>> InlineTriangles(Scene.Triangles.size());
+
+			for (size_t i{ 0u }; i < Scene.Spheres.size(); i++) {
+				InlineSpheres[i] = { Scene.Spheres[i], Scene.Materials[Scene.Spheres[i].MaterialIndex] };
+			}
+
+			for (size_t i{ 0u }; i < Scene.Rectangles.size(); i++) {
+				InlineRectangles[i] = { Scene.Rectangles[i], Scene.Materials[Scene.Rectangles[i].MaterialIndex] };
+			}
+
+			for (size_t i{ 0u }; i < Scene.Triangles.size(); i++) {
+				InlineTriangles[i] = { Scene.Triangles[i], Scene.Materials[Scene.Triangles[i].MaterialIndex] };
+			}
+
+			// Random hits, filled in the way FillIntersectionRecord fills them.
+			std::mt19937 MersenneTwisterEngine{ 2u };
+			std::vector<IntersectionRecord> HitRecords(HitCount);
+
+			for (IntersectionRecord& HitRecord: HitRecords) {
+				uint Index{ ( uint )(MersenneTwisterEngine() % PrimitiveCount) };
+				HitRecord = {};
+
+				if (Index < Scene.Spheres.size()) {
+					HitRecord.MaterialIndex = Scene.Spheres[Index].MaterialIndex;
+				} else if ((Index -= ( uint )Scene.Spheres.size()) < Scene.Rectangles.size()) {
+					HitRecord.PrimitiveId = 1u;
+					HitRecord.MaterialIndex = Scene.Rectangles[Index].MaterialIndex;
+				} else {
+					Index -= ( uint )Scene.Rectangles.size();
+					HitRecord.PrimitiveId = 2u;
+					HitRecord.MaterialIndex = Scene.Triangles[Index].MaterialIndex;
+				}
+
+				HitRecord.ObjectId = Index;
+			}
+
+			PathTracerStuff::PipelineResources Resources{};
+			Resources.Materials = Scene.Materials.data();
+
+			CPUStuff::Timer Timer{};
+			float InlineSum{ 0.0f };
+
+			for (const IntersectionRecord& HitRecord: HitRecords) {
+				InlineSum += GetInlineMaterialSample(InlineSpheres.data(), InlineRectangles.data(), InlineTriangles.data(), HitRecord);
+			}
+
+			const double InlineSeconds{ Timer.GetElapsedSeconds() };
+			float TableSum{ 0.0f };
+			Timer.Reset();
+
+			for (const IntersectionRecord& HitRecord: HitRecords) {
+				const float3 Color{ PathTracerStuff::GetColor(Resources, HitRecord) };
+				TableSum += Color.x + Color.y + Color.z + PathTracerStuff::GetMaterialScalar(Resources, HitRecord) +
+					( float )Resources.Materials[HitRecord.MaterialIndex].MaterialId;
+			}
+
+			const double TableSeconds{ Timer.GetElapsedSeconds() };
+
+			const double InlineBytes{ ( double )(InlineSpheres.size() * sizeof(InlineMaterialPrimitive<Sphere>) +
+				InlineRectangles.size() * sizeof(InlineMaterialPrimitive<Rectangle>) + InlineTriangles.size() * sizeof(InlineMaterialPrimitive<Triangle>)) };
+			const double TableBytes{ ( double )(Scene.Spheres.size() * sizeof(Sphere) + Scene.Rectangles.size() * sizeof(Rectangle) +
+				Scene.Triangles.size() * sizeof(Triangle) + SceneStuff::GetMaterialsSizeInBytes(Scene)) };
+
+			printf("  %-12u %-10s %14.1f %14.1f %12.2f %12.2f %10s\n", PrimitiveCount, IsShared ? "64 shared" : "own", InlineBytes / PrimitiveCount,
+				TableBytes / PrimitiveCount, InlineSeconds * 1.0e9 / HitCount, TableSeconds * 1.0e9 / HitCount, InlineSum == TableSum ? "yes" : "NO");
+		}
+	}
+}
+
+// Fused megakernel versus Wavefront rendering, on the stock scene and on random scenes whose material table cycles through all five surface
+// materials, so that neighbouring paths keep hitting different ones. Both have to render identically.
+void BenchmarkWavefront(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint PrimitiveCounts[]{ 0u, 65536u, 1048576u };
+	const size_t PixelCount{ ( size_t )Settings.RenderSettings.PSViewPortDimensions.x * Settings.RenderSettings.PSViewPortDimensions.y };
+
+	printf("  %ux%u, %u SPP\n", Settings.RenderSettings.PSViewPortDimensions.x, Settings.RenderSettings.PSViewPortDimensions.y,
+		Settings.RenderSettings.SamplesPerPixel);
+	printf("  %-12s %18s %18s %10s %14s %12s\n", "primitives", "fused MRays/s", "wavefront MRays/s", "speedup", "queues MiB", "identical");
+
+	for (uint PrimitiveCount: PrimitiveCounts) {
+		SceneStuff::Scene Scene{};
+
+		if (PrimitiveCount > 0u) {
+			SceneStuff::CreateRandomScene(Settings.RenderSettings, PrimitiveCount, 1u, Scene);
+
+			for (size_t i{ 0u }; i < Scene.Materials.size(); i++) {
+				Material& CurrentMaterial{ Scene.Materials[i] };
+				CurrentMaterial.MaterialId = 1u + ( uint )(i % 5u);
+
+				if (CurrentMaterial.MaterialId == 3u) {
+					CurrentMaterial.MaterialScalarStart = CurrentMaterial.MaterialScalarEnd = CurrentMaterial.MaterialScalar = 1.5f;
+				}
+			}
+		} else {
+			SceneStuff::CreateDefaultScene(Settings.RenderSettings, Scene);
+		}
+
+		PathTracerStuff::RendererConfig RendererConfig{};
+		RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+
+		// Build time is left out of the trace throughput of both.
+		PathTracerStuff::Renderer FusedRenderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats FusedStats{};
+		FusedRenderer.RenderFrame(Scene, FusedStats);
+		FusedStats.RenderSeconds -= FusedStats.AccelerationBuildSeconds;
+
+		RendererConfig.Mode = PathTracerStuff::RenderMode::Wavefront;
+
+		PathTracerStuff::Renderer WavefrontRenderer{ ThreadPool, RendererConfig };
+		PathTracerStuff::RenderStats WavefrontStats{};
+		WavefrontRenderer.RenderFrame(Scene, WavefrontStats);
+		WavefrontStats.RenderSeconds -= WavefrontStats.AccelerationBuildSeconds;
+
+		const bool FramesAreIdentical{
+			memcmp(FusedRenderer.GetFinalFrame(), WavefrontRenderer.GetFinalFrame(), PixelCount * sizeof(CPUStuff::R8G8B8A8Uint)) == 0
+		};
+
+		printf("  %-12s %18.3f %18.3f %9.2fx %14.1f %12s\n", PrimitiveCount > 0u ? std::to_string(PrimitiveCount).c_str() : "stock",
+			FusedStats.GetRaysPerSecond() / 1.0e6, WavefrontStats.GetRaysPerSecond() / 1.0e6, FusedStats.RenderSeconds / WavefrontStats.RenderSeconds,
+			( double )(WavefrontRenderer.GetResourceSizeInBytes() - FusedRenderer.GetResourceSizeInBytes()) / (1024.0 * 1024.0),
+			FramesAreIdentical ? "yes" : "NO");
+	}
+}
+
+// The stock scene for the nee benchmark, whose Diffuse Light Rectangles and Triangles are shrunk about their centers to SmallLightScale of their size
+// while their materials are brightened to keep their power, unless SmallLightScale is 1.
+void CreateLightSamplingScene(const SceneStuff::RenderSettings& RenderSettings, float SmallLightScale, SceneStuff::Scene& Scene) {
+	SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+
+	if (SmallLightScale == 1.0f) {
+		return;
+	}
+
+	std::vector<uint8_t> MaterialsBrightened(Scene.Materials.size(), 0u);
+	const auto Shrink{ [&](float3* Points[], uint PointCount) {
+		float3 Center{};
+
+		for (uint i{ 0u }; i < PointCount; i++) {
+			Center = Center + *Points[i] / ( float )PointCount;
+		}
+
+		for (uint i{ 0u }; i < PointCount; i++) {
+			*Points[i] = Center + (*Points[i] - Center) * SmallLightScale;
+		}
+	} };
+	const auto Brighten{ [&](uint MaterialIndex) {
+		Material& LightMaterial{ Scene.Materials[MaterialIndex] };
+
+		if (MaterialsBrightened[MaterialIndex] == 0u) {
+			const float Brightness{ 1.0f / (SmallLightScale * SmallLightScale) };
+			LightMaterial.ColorStart = LightMaterial.ColorStart * Brightness;
+			LightMaterial.ColorEnd = LightMaterial.ColorEnd * Brightness;
+			MaterialsBrightened[MaterialIndex] = 1u;
+		}
+	} };
+
+	for (Rectangle& CurrentRectangle: Scene.Rectangles) {
+		if (Scene.Materials[CurrentRectangle.MaterialIndex].MaterialId == 5u) {
+			float3* StartPoints[]{ &CurrentRectangle.Q1Start, &CurrentRectangle.Q2Start, &CurrentRectangle.Q3Start, &CurrentRectangle.Q4Start };
+			float3* EndPoints[]{ &CurrentRectangle.Q1End, &CurrentRectangle.Q2End, &CurrentRectangle.Q3End, &CurrentRectangle.Q4End };
+			Shrink(StartPoints, 4u);
+			Shrink(EndPoints, 4u);
+			Brighten(CurrentRectangle.MaterialIndex);
+		}
+	}
+
+	for (Triangle& CurrentTriangle: Scene.Triangles) {
+		if (Scene.Materials[CurrentTriangle.MaterialIndex].MaterialId == 5u) {
+			float3* StartPoints[]{ &CurrentTriangle.V1Start, &CurrentTriangle.V2Start, &CurrentTriangle.V3Start };
+			float3* EndPoints[]{ &CurrentTriangle.V1End, &CurrentTriangle.V2End, &CurrentTriangle.V3End };
+			Shrink(StartPoints, 3u);
+			Shrink(EndPoints, 3u);
+			Brighten(CurrentTriangle.MaterialIndex);
+		}
+	}
+
+	SceneStuff::InterpolateScene(0.0f, Scene);
+}
+
+// Renders one frame of a nee benchmark scene in fused mode, with or without next-event estimation, and returns its RMSE against a reference frame,
+// along with how long it took.
+double GetLightSamplingRMSE(CPUStuff::ThreadPool& ThreadPool, const SceneStuff::RenderSettings& RenderSettings, float SmallLightScale,
+	LightStuff::LightSamplingType LightSampling, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame, double& RenderSeconds) {
+	SceneStuff::Scene Scene{};
+	CreateLightSamplingScene(RenderSettings, SmallLightScale, Scene);
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	RendererConfig.LightSampling = LightSampling;
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+	RenderSeconds = Stats.RenderSeconds;
+
+	return GetFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame);
+}
+
+// Next-event estimation against gathering only the light that bounces happen to hit, at 64 and 256 SPP and at equal render time. Runs on the stock
+// scene, on the stock scene at night, where the sky is black and only its Diffuse Lights light it, and at night with those lights shrunk to a
+// quarter of their size at the same power. Renders at a quarter of the benchmark's resolution, in fused mode, against a reference with next-event
+// estimation at 4096 SPP.
+void BenchmarkNextEventEstimation(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint ReferenceSamplesPerPixel{ 4096u };
+	const uint SamplesPerPixelSteps[]{ 64u, 256u };
+	const char* SceneNames[]{ "stock", "night", "small" };
+
+	printf("  %-8s %6s %14s %10s %14s %10s %10s %10s %14s\n", "scene", "SPP", "hit-only RMSE", "seconds", "nee RMSE", "seconds", "equal-time",
+		"nee RMSE", "equal-quality");
+	printf("  %-8s %6s %14s %10s %14s %10s %10s %10s %14s\n", "", "", "", "", "", "", "nee SPP", "", "speedup");
+
+	for (uint SceneIndex{ 0u }; SceneIndex < 3u; SceneIndex++) {
+		const float SmallLightScale{ SceneIndex == 2u ? 0.25f : 1.0f };
+		SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+		RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 4u);
+		RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 4u);
+		const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+		if (SceneIndex > 0u) {
+			RenderSettings.SkyTopColor = RenderSettings.SkyBottomColor = float3{ 0.0f, 0.0f, 0.0f };
+		}
+
+		// The reference uses a Sobol sampler, so its error is uncorrelated with that of the independent renders.
+		RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+		SceneStuff::Scene Scene{};
+		CreateLightSamplingScene(RenderSettings, SmallLightScale, Scene);
+
+		PathTracerStuff::RendererConfig ReferenceConfig{};
+		ReferenceConfig.Mode = PathTracerStuff::RenderMode::Fused;
+		ReferenceConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+		ReferenceConfig.SamplerSeed = 1u;
+		ReferenceConfig.LightSampling = LightStuff::LightSamplingType::NextEvent;
+
+		PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+		PathTracerStuff::RenderStats ReferenceStats{};
+		ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+		const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+		for (uint SamplesPerPixel: SamplesPerPixelSteps) {
+			double HitOnlySeconds, NextEventSeconds, EqualTimeSeconds;
+			RenderSettings.SamplesPerPixel = SamplesPerPixel;
+			const double HitOnlyRMSE{ GetLightSamplingRMSE(
+				ThreadPool, RenderSettings, SmallLightScale, LightStuff::LightSamplingType::None, ReferenceFrame, HitOnlySeconds) };
+			const double NextEventRMSE{ GetLightSamplingRMSE(
+				ThreadPool, RenderSettings, SmallLightScale, LightStuff::LightSamplingType::NextEvent, ReferenceFrame, NextEventSeconds) };
+
+			// Shadow paths make every sample dearer, so next-event estimation gets as many samples as fit in the time that the hit-only render took.
+			RenderSettings.SamplesPerPixel = std::max(1u, ( uint )(SamplesPerPixel * HitOnlySeconds / NextEventSeconds + 0.5));
+			const double EqualTimeRMSE{ GetLightSamplingRMSE(
+				ThreadPool, RenderSettings, SmallLightScale, LightStuff::LightSamplingType::NextEvent, ReferenceFrame, EqualTimeSeconds) };
+
+			// Error falls as 1 / sqrt(time), so the squared RMSE ratio, corrected for any difference in time, is the speedup to equal error.
+			printf("  %-8s %6u %14.5f %10.3f %14.5f %10.3f %10u %10.5f %13.2fx\n", SceneNames[SceneIndex], SamplesPerPixel, HitOnlyRMSE, HitOnlySeconds,
+				NextEventRMSE, NextEventSeconds, RenderSettings.SamplesPerPixel, EqualTimeRMSE,
+				EqualTimeRMSE > 0.0 ? (HitOnlyRMSE * HitOnlyRMSE) / (EqualTimeRMSE * EqualTimeRMSE) * EqualTimeSeconds / HitOnlySeconds : 0.0);
+		}
+	}
+}
+
+// The scenes of the mis benchmark: CreateGlossyScene(), or the stock scene at night, with its Metallic spheres given a little fuzz.
+void CreateMultipleImportanceScene(const SceneStuff::RenderSettings& RenderSettings, uint SceneIndex, SceneStuff::Scene& Scene) {
+	if (SceneIndex == 0u) {
+		SceneStuff::CreateGlossyScene(RenderSettings, Scene);
+		return;
+	}
+
+	SceneStuff::RenderSettings NightSettings{ RenderSettings };
+	NightSettings.SkyTopColor = NightSettings.SkyBottomColor = float3{ 0.0f, 0.0f, 0.0f };
+	SceneStuff::CreateDefaultScene(NightSettings, Scene);
+
+	for (Sphere& CurrentSphere: Scene.Spheres) {
+		Material& CurrentMaterial{ Scene.Materials[CurrentSphere.MaterialIndex] };
+
+		if (CurrentMaterial.MaterialId == 4u) {
+			CurrentMaterial.MaterialScalarStart = CurrentMaterial.MaterialScalarEnd = std::max(CurrentMaterial.MaterialScalarStart, 0.05f);
+		}
+	}
+
+	SceneStuff::InterpolateScene(0.0f, Scene);
+}
+
+// Renders one frame of a mis benchmark scene in fused mode with a given light sampling, and returns its RMSE against a reference frame, along with
+// how long it took.
+double GetMultipleImportanceRMSE(CPUStuff::ThreadPool& ThreadPool, const SceneStuff::RenderSettings& RenderSettings, uint SceneIndex,
+	LightStuff::LightSamplingType LightSampling, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame, double& RenderSeconds) {
+	SceneStuff::Scene Scene{};
+	CreateMultipleImportanceScene(RenderSettings, SceneIndex, Scene);
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	RendererConfig.LightSampling = LightSampling;
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+	RenderSeconds = Stats.RenderSeconds;
+
+	return GetFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame);
+}
+
+// Multiple importance sampling against next-event estimation and against gathering only the light that bounces happen to hit, at 16, 64 and 256 SPP.
+// Runs on the glossy room of CreateGlossyScene(), and on the stock scene at night with fuzzy Metallic spheres. Renders at a quarter of the
+// benchmark's resolution, in fused mode, against a reference with multiple importance sampling at 4096 SPP.
+void BenchmarkMultipleImportanceSampling(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint ReferenceSamplesPerPixel{ 4096u };
+	const uint SamplesPerPixelSteps[]{ 16u, 64u, 256u };
+	const char* SceneNames[]{ "glossy", "night" };
+	const LightStuff::LightSamplingType LightSamplingTypes[]{ LightStuff::LightSamplingType::None, LightStuff::LightSamplingType::NextEvent,
+		LightStuff::LightSamplingType::MultipleImportance };
+
+	printf("  %-8s %6s %14s %10s %14s %10s %14s %10s %14s\n", "scene", "SPP", "hit-only RMSE", "seconds", "nee RMSE", "seconds", "mis RMSE", "seconds",
+		"variance");
+	printf("  %-8s %6s %14s %10s %14s %10s %14s %10s %14s\n", "", "", "", "", "", "", "", "", "vs nee");
+
+	for (uint SceneIndex{ 0u }; SceneIndex < 2u; SceneIndex++) {
+		SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+		RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 4u);
+		RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 4u);
+		const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+		// The reference uses a Sobol sampler, so its error is uncorrelated with that of the independent renders.
+		RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+		SceneStuff::Scene Scene{};
+		CreateMultipleImportanceScene(RenderSettings, SceneIndex, Scene);
+
+		PathTracerStuff::RendererConfig ReferenceConfig{};
+		ReferenceConfig.Mode = PathTracerStuff::RenderMode::Fused;
+		ReferenceConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+		ReferenceConfig.SamplerSeed = 1u;
+		ReferenceConfig.LightSampling = LightStuff::LightSamplingType::MultipleImportance;
+
+		PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+		PathTracerStuff::RenderStats ReferenceStats{};
+		ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+		const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+		for (uint SamplesPerPixel: SamplesPerPixelSteps) {
+			double RMSEs[3], Seconds[3];
+			RenderSettings.SamplesPerPixel = SamplesPerPixel;
+
+			for (uint i{ 0u }; i < 3u; i++) {
+				RMSEs[i] = GetMultipleImportanceRMSE(ThreadPool, RenderSettings, SceneIndex, LightSamplingTypes[i], ReferenceFrame, Seconds[i]);
+			}
+
+			// At a fixed SPP, the squared RMSE ratio is how many times lower the variance is than next-event estimation's.
+			printf("  %-8s %6u %14.5f %10.3f %14.5f %10.3f %14.5f %10.3f %13.2fx\n", SceneNames[SceneIndex], SamplesPerPixel, RMSEs[0], Seconds[0], RMSEs[1],
+				Seconds[1], RMSEs[2], Seconds[2], RMSEs[2] > 0.0 ? (RMSEs[1] * RMSEs[1]) / (RMSEs[2] * RMSEs[2]) : 0.0);
+		}
+	}
+}
+
+// A Renderer whose pipeline resources can be traced outside of its passes, once a frame has set them up.
+class TraversalRenderer : public PathTracerStuff::Renderer {
+  public:
+	using PathTracerStuff::Renderer::GetPipelineResources;
+	using PathTracerStuff::Renderer::Renderer;
+};
+
+// Shadow paths from the first hits of a frame's camera paths, off the Sky and the lights, towards points sampled on the lights by power, or
+// towards random points in the root bounds of the BVH when the scene has no lights, each with the distance it is tested to.
+void CreateShadowPaths(const PathTracerStuff::PipelineResources& Resources, const BVHStuff::BVHNode& RootNode, std::vector<Path>& ShadowPaths,
+	std::vector<float>& MaxDistances) {
+	const InlineRootConstants& RootConstants{ Resources.RootConstants };
+	PathTracerStuff::PipelineResources SampleResources{ Resources };
+	std::mt19937 MersenneTwisterEngine{ 3u };
+	std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+
+	for (uint SampleIndex{ 0u }; SampleIndex < RootConstants.SamplesPerPixel; SampleIndex++) {
+		SampleResources.RootConstants.CurrentSampleIndex = SampleIndex;
+
+		for (uint y{ 0u }; y < RootConstants.TSGridDimensions.y; y++) {
+			for (uint x{ 0u }; x < RootConstants.TSGridDimensions.x; x++) {
+				Path CameraPath;
+				IntersectionRecord HitRecord;
+				PathTracerStuff::CreateCameraPath(SampleResources, uint2{ x, y }, CameraPath);
+				PathTracerStuff::CreateIntersectionRecord(SampleResources, CameraPath, HitRecord);
+
+				if (HitRecord.MaterialId == 0u || HitRecord.MaterialId == 5u) {
+					continue;
+				}
+
+				const LightStuff::LightList& Lights{ *Resources.Lights };
+				const float2 RandomValues{ UnitDistribution(MersenneTwisterEngine), UnitDistribution(MersenneTwisterEngine) };
+				const float RandomValue{ UnitDistribution(MersenneTwisterEngine) };
+				PathTracerStuff::LightSample Sample;
+
+				if (!Lights.References.empty()) {
+					float SelectionProbability;
+					const uint LightIndex{ LightStuff::SelectLightByPower(Lights, RandomValue, SelectionProbability) };
+
+					if (!PathTracerStuff::SampleLight(Resources, Lights.References[LightIndex], HitRecord.WSIntersectionPoint, HitRecord.Time, RandomValues,
+							Sample)) {
+						continue;
+					}
+				} else {
+					const float3 Target{ RootNode.BoundsMin +
+						(RootNode.BoundsMax - RootNode.BoundsMin) * float3{ RandomValues.x, RandomValues.y, RandomValue } };
+					Sample.WSDistance = length(Target - HitRecord.WSIntersectionPoint);
+					Sample.WSDirection = (Target - HitRecord.WSIntersectionPoint) / Sample.WSDistance;
+				}
+
+				ShadowPaths.push_back(Path{ HitRecord.WSIntersectionPoint, Sample.WSDirection, HitRecord.Time });
+				MaxDistances.push_back(Sample.WSDistance * PathTracerStuff::ShadowPathDistanceScale);
+			}
+		}
+	}
+}
+
+// Shadow paths/s of the any-hit occlusion query against finding the closest hit along the same paths and comparing its distance, as shadow paths
+// were tested before, on one thread. Runs on the stock and glossy scenes, through the BVH and brute force, and through the BVH on random scenes and
+// instances, with the shadow paths of a frame at a quarter of the benchmark's SPP. Both have to agree on every shadow path.
+void BenchmarkShadowRays(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const char* SceneNames[]{ "stock", "glossy", "65536", "1048576", "1024 inst" };
+	const uint RepeatCount{ 3u };
+	const PathTracerStuff::AccelerationStructureType AccelerationStructures[]{ PathTracerStuff::AccelerationStructureType::BVH,
+		PathTracerStuff::AccelerationStructureType::BruteForce };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.SamplesPerPixel = std::max(1u, RenderSettings.SamplesPerPixel / 4u);
+	RenderSettings.MaxRecursionDepth = 1u;
+
+	printf("  %ux%u, %u SPP of shadow paths\n", RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, RenderSettings.SamplesPerPixel);
+	printf("  %-10s %-12s %12s %10s %18s %18s %10s %10s\n", "scene", "accel", "paths", "occluded", "closest MPaths/s", "any-hit MPaths/s", "speedup",
+		"identical");
+
+	for (uint SceneIndex{ 0u }; SceneIndex < 5u; SceneIndex++) {
+		SceneStuff::Scene Scene{};
+
+		switch (SceneIndex) {
+			case 0: {
+				SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+				break;
+			}
+			case 1: {
+				SceneStuff::CreateGlossyScene(RenderSettings, Scene);
+				break;
+			}
+			case 2:
+			case 3: {
+				SceneStuff::CreateRandomScene(RenderSettings, SceneIndex == 2u ? 65536u : 1048576u, 1u, Scene);
+				break;
+			}
+			default: {
+				SceneStuff::CreateInstanceScene(RenderSettings, 1024u, SceneStuff::InstancePrototypeTriangleCount, 1u, Scene);
+				break;
+			}
+		}
+
+		std::vector<Path> ShadowPaths{};
+		std::vector<float> MaxDistances{};
+
+		for (PathTracerStuff::AccelerationStructureType AccelerationStructure: AccelerationStructures) {
+			// Brute force is only measured on the small scenes.
+			if (AccelerationStructure == PathTracerStuff::AccelerationStructureType::BruteForce && SceneIndex > 1u) {
+				continue;
+			}
+
+			PathTracerStuff::RendererConfig RendererConfig{};
+			RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+			RendererConfig.AccelerationStructure = AccelerationStructure;
+			RendererConfig.LightSampling = LightStuff::LightSamplingType::NextEvent;
+
+			TraversalRenderer Renderer{ ThreadPool, RendererConfig };
+			PathTracerStuff::RenderStats Stats{};
+			Renderer.RenderFrame(Scene, Stats);
+			const PathTracerStuff::PipelineResources Resources{ Renderer.GetPipelineResources(Scene) };
+
+			// The shadow paths are made through the BVH, which is set up first, and reused for brute force.
+			if (ShadowPaths.empty()) {
+				CreateShadowPaths(Resources, Resources.BVHNodes[0], ShadowPaths, MaxDistances);
+			}
+
+			// Each search is timed at its best of RepeatCount passes over the shadow paths, alternating between the two.
+			const size_t PathCount{ ShadowPaths.size() };
+			std::vector<uint8_t> ClosestOccluded(PathCount);
+			double ClosestSeconds{ INFINITY }, AnyHitSeconds{ INFINITY };
+			size_t OccludedCount{ 0u };
+			bool ResultsAreIdentical{ true };
+
+			for (uint Repeat{ 0u }; Repeat < RepeatCount; Repeat++) {
+				CPUStuff::Timer Timer{};
+
+				for (size_t i{ 0u }; i < PathCount; i++) {
+					float ClosestHitDistance{ MaxDistances[i] };
+					uint ClosestPrototypeTriangle{ 0u };
+					PathTracerStuff::FindClosestHit(Resources, ShadowPaths[i], ClosestHitDistance, ClosestPrototypeTriangle);
+					ClosestOccluded[i] = ClosestHitDistance < MaxDistances[i] ? 1u : 0u;
+				}
+
+				ClosestSeconds = std::min(ClosestSeconds, Timer.GetElapsedSeconds());
+				OccludedCount = 0u;
+				Timer.Reset();
+
+				for (size_t i{ 0u }; i < PathCount; i++) {
+					const bool IsOccluded{ PathTracerStuff::IsOccluded(Resources, ShadowPaths[i], MaxDistances[i]) };
+					OccludedCount += IsOccluded ? 1u : 0u;
+					ResultsAreIdentical &= IsOccluded == (ClosestOccluded[i] != 0u);
+				}
+
+				AnyHitSeconds = std::min(AnyHitSeconds, Timer.GetElapsedSeconds());
+			}
+
+			const char* AccelerationStructureName{ AccelerationStructure == PathTracerStuff::AccelerationStructureType::BVH ? "bvh" : "brute-force" };
+
+			printf("  %-10s %-12s %12zu %9.1f%% %18.3f %18.3f %9.2fx %10s\n", SceneNames[SceneIndex], AccelerationStructureName, PathCount,
+				100.0 * OccludedCount / std::max(PathCount, ( size_t )1u), PathCount / ClosestSeconds / 1.0e6, PathCount / AnyHitSeconds / 1.0e6,
+				ClosestSeconds / AnyHitSeconds, ResultsAreIdentical ? "yes" : "NO");
+		}
+	}
+}
+
+constexpr uint LightTreeLightCount{ 10000u };
+
+// Renders one frame of the light-tree benchmark's scene in fused mode with a given light sampling and selection, and returns its RMSE against a
+// reference frame, along with how long it took.
+double GetLightSelectionRMSE(CPUStuff::ThreadPool& ThreadPool, const SceneStuff::RenderSettings& RenderSettings, LightStuff::LightSamplingType LightSampling,
+	LightStuff::LightSelectionType LightSelection, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame, double& RenderSeconds) {
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateManyLightScene(RenderSettings, LightTreeLightCount, 1u, Scene);
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	RendererConfig.LightSampling = LightSampling;
+	RendererConfig.LightSelection = LightSelection;
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+	PathTracerStuff::RenderStats Stats{};
+	Renderer.RenderFrame(Scene, Stats);
+	RenderSeconds = Stats.RenderSeconds;
+
+	return GetFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame);
+}
+
+// Light tree selection against selection by power, under next-event estimation and multiple importance sampling, at 16, 64 and 256 SPP. Runs on
+// the 10K lights of CreateManyLightScene(), at a quarter of the benchmark's resolution, in fused mode, against a reference with next-event
+// estimation and tree selection at 4096 SPP. Also reports how long the tree takes to build each frame, and its size.
+void BenchmarkLightTree(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint ReferenceSamplesPerPixel{ 4096u };
+	const uint SamplesPerPixelSteps[]{ 16u, 64u, 256u };
+	const LightStuff::LightSamplingType LightSamplingTypes[]{ LightStuff::LightSamplingType::NextEvent, LightStuff::LightSamplingType::MultipleImportance };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 4u);
+	RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 4u);
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+	// The reference uses a Sobol sampler, so its error is uncorrelated with that of the independent renders.
+	RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateManyLightScene(RenderSettings, LightTreeLightCount, 1u, Scene);
+
+	for (LightStuff::LightSelectionType LightSelection: { LightStuff::LightSelectionType::Power, LightStuff::LightSelectionType::Tree }) {
+		LightStuff::LightList Lights{};
+		CPUStuff::Timer BuildTimer{};
+		LightStuff::BuildLightList(Scene, LightSelection, SceneStuff::ShutterInterval{}, Lights);
+		const double BuildSeconds{ BuildTimer.GetElapsedSeconds() };
+
+		printf("  %s selection: %zu lights, %zu tree nodes, built in %.2f ms, %.1f KiB.\n", LightStuff::GetLightSelectionName(LightSelection),
+			Lights.References.size(), Lights.TreeNodes.size(), BuildSeconds * 1000.0, ( double )LightStuff::GetLightListSizeInBytes(Lights) / 1024.0);
+	}
+
+	PathTracerStuff::RendererConfig ReferenceConfig{};
+	ReferenceConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	ReferenceConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+	ReferenceConfig.SamplerSeed = 1u;
+	ReferenceConfig.LightSampling = LightStuff::LightSamplingType::NextEvent;
+	ReferenceConfig.LightSelection = LightStuff::LightSelectionType::Tree;
+
+	PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+	PathTracerStuff::RenderStats ReferenceStats{};
+	ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+	const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+	printf("  %-8s %6s %14s %10s %14s %10s %14s %14s\n", "sampling", "SPP", "power RMSE", "seconds", "tree RMSE", "seconds", "variance", "equal-quality");
+	printf("  %-8s %6s %14s %10s %14s %10s %14s %14s\n", "", "", "", "", "", "", "vs power", "speedup");
+
+	for (LightStuff::LightSamplingType LightSampling: LightSamplingTypes) {
+		for (uint SamplesPerPixel: SamplesPerPixelSteps) {
+			double PowerSeconds, TreeSeconds;
+			RenderSettings.SamplesPerPixel = SamplesPerPixel;
+			const double PowerRMSE{ GetLightSelectionRMSE(
+				ThreadPool, RenderSettings, LightSampling, LightStuff::LightSelectionType::Power, ReferenceFrame, PowerSeconds) };
+			const double TreeRMSE{ GetLightSelectionRMSE(
+				ThreadPool, RenderSettings, LightSampling, LightStuff::LightSelectionType::Tree, ReferenceFrame, TreeSeconds) };
+
+			// Walking the tree makes every sample dearer, so the variance ratio is corrected by the time ratio for the speedup to equal error.
+			const double VarianceRatio{ TreeRMSE > 0.0 ? (PowerRMSE * PowerRMSE) / (TreeRMSE * TreeRMSE) : 0.0 };
+			printf("  %-8s %6u %14.5f %10.3f %14.5f %10.3f %13.2fx %13.2fx\n", LightStuff::GetLightSamplingName(LightSampling), SamplesPerPixel, PowerRMSE,
+				PowerSeconds, TreeRMSE, TreeSeconds, VarianceRatio, VarianceRatio * PowerSeconds / TreeSeconds);
+		}
+	}
+}
+
+constexpr uint ReservoirFrameCount{ 4u };
+
+// Root mean square difference between two Final Frames over the pixels of a mask, over their RGB channels in [0, 1].
+double GetMaskedFrameRMSE(
+	const CPUStuff::R8G8B8A8Uint* pFrame, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame, const std::vector<bool>& PixelMask) {
+	double SquaredErrorSum{ 0.0 };
+	size_t PixelCount{ 0u };
+
+	for (size_t i{ 0u }; i < ReferenceFrame.size(); i++) {
+		if (!PixelMask[i]) {
+			continue;
+		}
+
+		const double dR{ (( double )pFrame[i].R - ( double )ReferenceFrame[i].R) / 255.0 };
+		const double dG{ (( double )pFrame[i].G - ( double )ReferenceFrame[i].G) / 255.0 };
+		const double dB{ (( double )pFrame[i].B - ( double )ReferenceFrame[i].B) / 255.0 };
+		SquaredErrorSum += dR * dR + dG * dG + dB * dB;
+		PixelCount++;
+	}
+
+	return PixelCount > 0u ? sqrt(SquaredErrorSum / (( double )PixelCount * 3.0)) : 0.0;
+}
+
+// Pixels of the light-tree benchmark's scene that no camera path sees a light in, at a given resolution and SPP. Lights seen straight from the
+// camera alias alike under any light sampling, and would drown out its own error. A depth of 2 gathers the light of nothing but those.
+void GetUnlitPixelMask(CPUStuff::ThreadPool& ThreadPool, SceneStuff::RenderSettings RenderSettings, std::vector<bool>& PixelMask) {
+	RenderSettings.MaxRecursionDepth = 2u;
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateManyLightScene(RenderSettings, LightTreeLightCount, 1u, Scene);
+
+	PathTracerStuff::RendererConfig MaskConfig{};
+	MaskConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	MaskConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+	MaskConfig.SamplerSeed = 1u;
+
+	PathTracerStuff::Renderer MaskRenderer{ ThreadPool, MaskConfig };
+	PathTracerStuff::RenderStats MaskStats{};
+	MaskRenderer.RenderFrame(Scene, MaskStats);
+
+	PixelMask.resize(( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y);
+
+	for (size_t i{ 0u }; i < PixelMask.size(); i++) {
+		const CPUStuff::R8G8B8A8Uint& Texel{ MaskRenderer.GetFinalFrame()[i] };
+		PixelMask[i] = Texel.R == 0u && Texel.G == 0u && Texel.B == 0u;
+	}
+}
+
+// Renders FrameCount frames of the light-tree benchmark's scene with one Renderer in fused mode and tree selection, so that reservoirs carry over
+// from frame to frame, and returns the RMSE of the last against a reference frame over the pixels of a mask, along with that of the first, if asked
+// for, and how long the last took.
+double GetReservoirRMSE(CPUStuff::ThreadPool& ThreadPool, const SceneStuff::RenderSettings& RenderSettings, LightStuff::LightSamplingType LightSampling,
+	uint FrameCount, const std::vector<CPUStuff::R8G8B8A8Uint>& ReferenceFrame, const std::vector<bool>& PixelMask, double* pFirstRMSE,
+	double& RenderSeconds) {
+	SceneStuff::Scene Scene{};
+	SceneStuff::CreateManyLightScene(RenderSettings, LightTreeLightCount, 1u, Scene);
+
+	PathTracerStuff::RendererConfig RendererConfig{};
+	RendererConfig.Mode = PathTracerStuff::RenderMode::Fused;
+	RendererConfig.LightSampling = LightSampling;
+	RendererConfig.LightSelection = LightStuff::LightSelectionType::Tree;
+
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+
+	for (uint i{ 0u }; i < FrameCount; i++) {
+		PathTracerStuff::RenderStats Stats{};
+		Renderer.RenderFrame(Scene, Stats);
+		RenderSeconds = Stats.RenderSeconds;
+
+		if (i == 0u && pFirstRMSE != nullptr) {
+			*pFirstRMSE = GetMaskedFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame, PixelMask);
+		}
+	}
+
+	return GetMaskedFrameRMSE(Renderer.GetFinalFrame(), ReferenceFrame, PixelMask);
+}
+
+// Reservoir resampling against next-event estimation with light tree selection, at 1, 4 and 16 SPP, for direct light alone (a depth of 3) and for
+// full paths. Runs on the 10K lights of CreateManyLightScene(), at half of the benchmark's resolution, since reservoirs are reused across pixels, in
+// fused mode, against a reference with next-event estimation at 1024 SPP. Reservoir resampling is measured on the first frame, and on the last of
+// ReservoirFrameCount frames of the unchanging scene, once its reservoirs have carried over from the frames before.
+void BenchmarkReservoirs(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint ReferenceSamplesPerPixel{ 1024u };
+	const uint SamplesPerPixelSteps[]{ 1u, 4u, 16u };
+	const uint MaxRecursionDepths[]{ 3u, Settings.RenderSettings.MaxRecursionDepth };
+
+	SceneStuff::RenderSettings RenderSettings{ Settings.RenderSettings };
+	RenderSettings.PSViewPortDimensions.x = std::max(1u, RenderSettings.PSViewPortDimensions.x / 2u);
+	RenderSettings.PSViewPortDimensions.y = std::max(1u, RenderSettings.PSViewPortDimensions.y / 2u);
+	RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+	const size_t PixelCount{ ( size_t )RenderSettings.PSViewPortDimensions.x * RenderSettings.PSViewPortDimensions.y };
+
+	std::vector<bool> PixelMask{};
+	GetUnlitPixelMask(ThreadPool, RenderSettings, PixelMask);
+
+	printf("  %-6s %6s %12s %10s %14s %14s %10s %14s %14s\n", "depth", "SPP", "nee RMSE", "seconds", "restir RMSE", "restir RMSE", "seconds",
+		"variance", "equal-quality");
+	printf("  %-6s %6s %12s %10s %14s %14s %10s %14s %14s\n", "", "", "", "", "first frame", "last frame", "", "vs nee", "speedup");
+
+	for (uint MaxRecursionDepth: MaxRecursionDepths) {
+		RenderSettings.MaxRecursionDepth = MaxRecursionDepth;
+
+		// The reference uses a Sobol sampler, so its error is uncorrelated with that of the independent renders.
+		RenderSettings.SamplesPerPixel = ReferenceSamplesPerPixel;
+		SceneStuff::Scene Scene{};
+		SceneStuff::CreateManyLightScene(RenderSettings, LightTreeLightCount, 1u, Scene);
+
+		PathTracerStuff::RendererConfig ReferenceConfig{};
+		ReferenceConfig.Mode = PathTracerStuff::RenderMode::Fused;
+		ReferenceConfig.SamplerType = SamplerStuff::SamplerType::Sobol;
+		ReferenceConfig.SamplerSeed = 1u;
+		ReferenceConfig.LightSampling = LightStuff::LightSamplingType::NextEvent;
+		ReferenceConfig.LightSelection = LightStuff::LightSelectionType::Tree;
+
+		PathTracerStuff::Renderer ReferenceRenderer{ ThreadPool, ReferenceConfig };
+		PathTracerStuff::RenderStats ReferenceStats{};
+		ReferenceRenderer.RenderFrame(Scene, ReferenceStats);
+		const std::vector<CPUStuff::R8G8B8A8Uint> ReferenceFrame(ReferenceRenderer.GetFinalFrame(), ReferenceRenderer.GetFinalFrame() + PixelCount);
+
+		for (uint SamplesPerPixel: SamplesPerPixelSteps) {
+			double NextEventSeconds, FirstReservoirRMSE, ReservoirSeconds;
+			RenderSettings.SamplesPerPixel = SamplesPerPixel;
+
+			// Without reservoirs, every frame of the unchanging scene renders alike.
+			const double NextEventRMSE{ GetReservoirRMSE(
+				ThreadPool, RenderSettings, LightStuff::LightSamplingType::NextEvent, 1u, ReferenceFrame, PixelMask, nullptr, NextEventSeconds) };
+			const double ReservoirRMSE{ GetReservoirRMSE(ThreadPool, RenderSettings, LightStuff::LightSamplingType::Reservoir, ReservoirFrameCount,
+				ReferenceFrame, PixelMask, &FirstReservoirRMSE, ReservoirSeconds) };
+
+			// The reservoir passes make every sample dearer, so the variance ratio is corrected by the time ratio for the speedup to equal error.
+			const double VarianceRatio{ ReservoirRMSE > 0.0 ? (NextEventRMSE * NextEventRMSE) / (ReservoirRMSE * ReservoirRMSE) : 0.0 };
+			printf("  %-6u %6u %12.5f %10.3f %14.5f %14.5f %10.3f %13.2fx %13.2fx\n", MaxRecursionDepth, SamplesPerPixel, NextEventRMSE, NextEventSeconds,
+				FirstReservoirRMSE, ReservoirRMSE, ReservoirSeconds, VarianceRatio, VarianceRatio * NextEventSeconds / ReservoirSeconds);
+		}
+	}
+}
+
+struct Benchmark {
+	const char* Name;
+	const char* Description;
+	void (*Function)(const BenchmarkSettings&, CPUStuff::ThreadPool&);
+};
+
+// A scene's triangles, memory and BVH setup time, built the way the Renderer builds them: the top-level tree over every primitive and Instance,
+// and the trees of its prototypes.
+struct InstancingResult {
+	uint64_t TriangleCount{ 0u };
+	uint64_t SizeInBytes{ 0u };
+	double BuildSeconds{ 0.0 };
+	double RaysPerSecond{ 0.0 };
+};
+
+void MeasureInstancing(CPUStuff::ThreadPool& ThreadPool, SceneStuff::Scene& Scene, InstancingResult& Result) {
+	BVHStuff::BVH BVH{};
+	BVHStuff::BVHBuildStats BuildStats{};
+	BVHStuff::BuildBVH(Scene, SceneStuff::ShutterInterval{}, ThreadPool, BVHStuff::BVHBuildType::BinnedSAH, BVH, BuildStats);
+	Result.BuildSeconds = BuildStats.BuildSeconds;
+	BVHStuff::UpdatePrototypeBVHs(Scene, ThreadPool, BVHStuff::BVHBuildType::BinnedSAH, BVH, BuildStats);
+	Result.BuildSeconds += BuildStats.BuildSeconds;
+
+	Result.SizeInBytes = SceneStuff::GetMeshesSizeInBytes(Scene) + SceneStuff::GetInstancesSizeInBytes(Scene) + BVHStuff::GetBVHSizeInBytes(BVH);
+
+	for (const Instance& CurrentInstance: Scene.Instances) {
+		Result.TriangleCount += Scene.Prototypes[CurrentInstance.PrototypeIndex].TriangleCount;
+	}
+
+	Result.TriangleCount += Scene.MeshIndices.size();
+
+	std::vector<CPUStuff::R8G8B8A8Uint> FinalFrame{};
+	Result.RaysPerSecond = GetTraceRaysPerSecond(ThreadPool, PathTracerStuff::RendererConfig{}, Scene, FinalFrame);
+}
+
+// Memory, BVH setup time and rays/s of 1K to 1M instances of a 10K-triangle prototype, against the same instances flattened into one mesh each where
+// that still fits in memory. An instance costs its transforms and a top-level leaf, whatever the size of its prototype.
+void BenchmarkInstancing(const BenchmarkSettings& Settings, CPUStuff::ThreadPool& ThreadPool) {
+	const uint InstanceCounts[]{ 64u, 1024u, 65536u, 1048576u };
+	constexpr uint64_t MaxFlattenedTriangleCount{ 1048576u };
+
+	printf("  %-10s %14s %12s %12s %14s %14s %14s %14s\n", "instances", "triangles", "MiB", "build s", "MRays/s", "flat MiB", "flat build s",
+		"flat MRays/s");
+
+	for (uint InstanceCount: InstanceCounts) {
+		SceneStuff::Scene InstanceScene{};
+		SceneStuff::CreateInstanceScene(Settings.RenderSettings, InstanceCount, SceneStuff::InstancePrototypeTriangleCount, 1u, InstanceScene);
+
+		InstancingResult Instanced{};
+		MeasureInstancing(ThreadPool, InstanceScene, Instanced);
+
+		printf("  %-10u %14llu %12.1f %12.3f %14.3f", InstanceCount, ( unsigned long long )Instanced.TriangleCount,
+			( double )Instanced.SizeInBytes / (1024.0 * 1024.0), Instanced.BuildSeconds, Instanced.RaysPerSecond / 1.0e6);
+
+		if (Instanced.TriangleCount > MaxFlattenedTriangleCount) {
+			printf(" %14s %14s %14s\n", "-", "-", "-");
+			continue;
+		}
+
+		// Every instance as a mesh of its own, its prototype's vertices carried into world space, and its material shared with it.
+		SceneStuff::Scene FlatScene{};
+		FlatScene.Materials = InstanceScene.Materials;
+		std::vector<float3> Vertices{};
+		std::vector<uint3> Indices{};
+
+		for (const Instance& CurrentInstance: InstanceScene.Instances) {
+			const Prototype& CurrentPrototype{ InstanceScene.Prototypes[CurrentInstance.PrototypeIndex] };
+			Vertices.clear();
+			Indices.clear();
+
+			for (uint i{ 0u }; i < CurrentPrototype.VertexCount; i++) {
+				const float3& PrototypeVertex{ InstanceScene.PrototypeVertices[CurrentPrototype.FirstVertex + i] };
+				Vertices.push_back(SceneStuff::TransformPoint(CurrentInstance.WorldFromObject, PrototypeVertex));
+			}
+
+			for (uint i{ 0u }; i < CurrentPrototype.TriangleCount; i++) {
+				const uint3& Triangle{ InstanceScene.PrototypeIndices[CurrentPrototype.FirstTriangle + i] };
+				Indices.push_back(
+					{ Triangle.x - CurrentPrototype.FirstVertex, Triangle.y - CurrentPrototype.FirstVertex, Triangle.z - CurrentPrototype.FirstVertex });
+			}
+
+			SceneStuff::AddMesh(Vertices, {}, Indices, CurrentInstance.MaterialIndex, FlatScene);
+		}
+
+		SceneStuff::SetRootConstants(Settings.RenderSettings, FlatScene);
+		SceneStuff::InterpolateScene(0.0f, FlatScene);
+
+		InstancingResult Flattened{};
+		MeasureInstancing(ThreadPool, FlatScene, Flattened);
+
+		printf(" %14.1f %14.3f %14.3f\n", ( double )Flattened.SizeInBytes / (1024.0 * 1024.0), Flattened.BuildSeconds, Flattened.RaysPerSecond / 1.0e6);
+	}
+}
+
+const Benchmark Benchmarks[]{
+	{ "render-modes", "Fused single-pass and wavefront versus three-pass rendering: rays/s and peak RSS.", BenchmarkRenderModes },
+	{ "path-termination", "Early path termination with and without Russian roulette: paths/sample and frame time.", BenchmarkPathTermination },
+	{ "sampler-convergence", "RMSE against a reference image at 64/256/1024 SPP for each sampler, at a quarter resolution.", BenchmarkSamplerConvergence },
+	{ "sampler-marginals", "Uniformity of each sampler's first two dimensions at 5/16/3000 SPP, as chi-squared per degree of freedom over 4096 pixels.",
+		BenchmarkSamplerMarginals },
+	{ "bvh-build", "SAH versus LBVH builds on 64K and 1M random primitives: build time, parallel speedup, SAH cost and rays/s.", BenchmarkBVHBuild },
+	{ "bvh-refit", "Per-frame BVH setup time over an animation of 64K random primitives, rebuilding versus refitting.", BenchmarkBVHRefit },
+	{ "bvh-scaling", "BVH build time and rays/s on random scenes of 16 to 1M primitives, against brute force up to 4096.", BenchmarkBVHScaling },
+	{ "motion-blur", "Single-pass motion blur through the motion BVH versus averaging 4/16/64 static sub-frames: time and RMSE.", BenchmarkMotionBlur },
+	{ "sphere-simd", "Closest-sphere search per ray against 16/256/4096 random spheres, per-Sphere loop versus each packed SIMD kernel.", BenchmarkSphereSIMD },
+	{ "ray-packets", "Camera-path throughput through the BVH, single paths versus packets, on the stock scene and 4K to 1M random primitives.",
+		BenchmarkRayPackets },
+	{ "rectangles", "Cost per path-rectangle test on 10K random quads, deriving the plane basis per test versus precomputed RectangleRecords.",
+		BenchmarkRectangles },
+	{ "triangles", "Cost per path-triangle test of each triangle intersector, and paths leaking through the shared edges of a jittered mesh.",
+		BenchmarkTriangles },
+	{ "meshes", "Bytes per triangle and rays/s of indexed meshes of 64K and 1M triangles, against the same independent Triangles.", BenchmarkMeshes },
+	{ "import", "Load time of 1M and 10M triangle meshes from binary PLY and OBJ files, memory-mapped and parsed in parallel.", BenchmarkImport },
+	{ "scene-file", "Save and load time of random scenes of 64K and 1M primitives through the text scene format.", BenchmarkSceneFile },
+	{ "scene-cache", "Cold and warm startup of random scenes of 64K and 1M primitives, parsing and building versus mapping a compiled scene cache.",
+		BenchmarkSceneCache },
+	{ "instancing", "Memory, BVH build time and rays/s of 64 to 1M instances of a 10K-triangle prototype, against flattened mesh copies.",
+		BenchmarkInstancing },
+	{ "materials", "Shading fetch cost per hit and bytes per primitive on random scenes, material table versus materials inline in each primitive.",
+		BenchmarkMaterials },
+	{ "wavefront", "Fused megakernel versus material-sorted Wavefront rendering: rays/s on the stock scene and 64K/1M primitives of all five materials.",
+		BenchmarkWavefront },
+	{ "nee", "Next-event estimation versus hit-only light gathering: RMSE at 64/256 SPP and at equal time, by day, by night and with small lights.",
+		BenchmarkNextEventEstimation },
+	{ "mis", "Multiple importance sampling versus next-event estimation and hit-only light gathering: RMSE at 16/64/256 SPP on glossy scenes.",
+		BenchmarkMultipleImportanceSampling },
+	{ "shadow-rays", "Shadow paths/s of the any-hit occlusion query versus a closest-hit search, on the stock and glossy scenes, random scenes and instances.",
+		BenchmarkShadowRays },
+	{ "light-tree", "Light tree versus power-proportional light selection on 10K small lights: RMSE and time at 16/64/256 SPP, under nee and mis.",
+		BenchmarkLightTree },
+	{ "restir", "Reservoir resampling versus next-event estimation on 10K small lights: RMSE and time at 1/4/16 SPP, for direct light and full paths.",
+		BenchmarkReservoirs },
+};
+
+uint ParseUnsignedArgument(const char* ArgumentName, const char* ArgumentValue) {
+	char* pEnd{ nullptr };
+	unsigned long Value{ strtoul(ArgumentValue, &pEnd, 10) };
+
+	if (pEnd == ArgumentValue || *pEnd != '\0') {
+		CPUStuff::FailBail(ArgumentValue, ArgumentName);
+	}
+
+	return ( uint )Value;
+}
+
+void PrintUsage() {
+	printf("Usage: UnnamedRendererBenchmarks <benchmark|all> [--width <pixels>] [--height <pixels>] [--spp <count>] [--depth <count>] [--threads <count>]\n");
+	printf("Defaults to 320x180, 16 SPP and 30 bounces on all cores.\n\n");
+
+	for (const Benchmark& CurrentBenchmark: Benchmarks) {
+		printf("  %-24s %s\n", CurrentBenchmark.Name, CurrentBenchmark.Description);
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2 || strcmp(argv[1], "--help") == 0) {
+		PrintUsage();
+		return argc < 2 ? -1 : 0;
+	}
+
+	BenchmarkSettings Settings{};
+	Settings.RenderSettings.PSViewPortDimensions = { 320u, 180u, 1u };
+	Settings.RenderSettings.SamplesPerPixel = 16u;
+
+	for (int i{ 2 }; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--width") == 0) {
+			Settings.RenderSettings.PSViewPortDimensions.x = ParseUnsignedArgument(argv[i], argv[i + 1]);
+		} else if (strcmp(argv[i], "--height") == 0) {
+			Settings.RenderSettings.PSViewPortDimensions.y = ParseUnsignedArgument(argv[i], argv[i + 1]);
+		} else if (strcmp(argv[i], "--spp") == 0) {
+			Settings.RenderSettings.SamplesPerPixel = ParseUnsignedArgument(argv[i], argv[i + 1]);
+		} else if (strcmp(argv[i], "--depth") == 0) {
+			Settings.RenderSettings.MaxRecursionDepth = ParseUnsignedArgument(argv[i], argv[i + 1]);
+		} else if (strcmp(argv[i], "--threads") == 0) {
+			Settings.ThreadCount = ParseUnsignedArgument(argv[i], argv[i + 1]);
+		} else {
+			PrintUsage();
+			CPUStuff::FailBail("Unknown argument.", argv[i]);
+		}
+	}
+
+	CPUStuff::ThreadPool ThreadPool{ Settings.ThreadCount };
+	bool BenchmarkFound{ false };
+
+	printf("%ux%u, %u SPP, %u bounces, %u thread(s).\n", Settings.RenderSettings.PSViewPortDimensions.x, Settings.RenderSettings.PSViewPortDimensions.y,
+		Settings.RenderSettings.SamplesPerPixel, Settings.RenderSettings.MaxRecursionDepth, ThreadPool.GetThreadCount());
+
+	for (const Benchmark& CurrentBenchmark: Benchmarks) {
+		if (strcmp(argv[1], "all") == 0 || strcmp(argv[1], CurrentBenchmark.Name) == 0) {
+			printf("\n%s: %s\n", CurrentBenchmark.Name, CurrentBenchmark.Description);
+			CurrentBenchmark.Function(Settings, ThreadPool);
+			BenchmarkFound = true;
+		}
+	}
+
+	if (!BenchmarkFound) {
+		PrintUsage();
+		CPUStuff::FailBail("Unknown benchmark.", argv[1]);
+	}
+
+	return 0;
+}
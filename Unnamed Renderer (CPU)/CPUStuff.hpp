@@ -0,0 +1,675 @@
+// CPUStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef CPU_STUFF
+	#define CPU_STUFF
+#endif
+
+#ifndef _USE_MATH_DEFINES
+	#define _USE_MATH_DEFINES
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <math.h>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+	#include <Psapi.h>
+	#pragma comment(lib, "psapi.lib")
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/resource.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// For matching types between Host and the HLSL code that the CPU kernels are ported from.
+#ifndef DIRECTX_STUFF
+typedef uint32_t uint;
+
+struct uint2 {
+	uint32_t x{}, y{};
+};
+
+struct uint3 {
+	uint32_t x{}, y{}, z{};
+};
+
+struct uint4 {
+	uint32_t x{}, y{}, z{}, w{};
+};
+
+struct int2 {
+	int32_t x{}, y{};
+};
+
+struct int3 {
+	int32_t x{}, y{}, z{};
+};
+
+struct float2 {
+	float x{}, y{};
+};
+
+struct float3 {
+	float x{}, y{}, z{};
+};
+
+struct float4 {
+	float x{}, y{}, z{}, w{};
+};
+#endif
+
+// HLSL-style vector arithmetic, so that the ported kernels read like their shader counterparts.
+inline float3 operator+(const float3& A, const float3& B) {
+	return float3{ A.x + B.x, A.y + B.y, A.z + B.z };
+}
+
+inline float3 operator-(const float3& A, const float3& B) {
+	return float3{ A.x - B.x, A.y - B.y, A.z - B.z };
+}
+
+inline float3 operator-(const float3& A) {
+	return float3{ -A.x, -A.y, -A.z };
+}
+
+inline float3 operator*(const float3& A, const float3& B) {
+	return float3{ A.x * B.x, A.y * B.y, A.z * B.z };
+}
+
+inline float3 operator*(const float3& A, float B) {
+	return float3{ A.x * B, A.y * B, A.z * B };
+}
+
+inline float3 operator*(float A, const float3& B) {
+	return float3{ A * B.x, A * B.y, A * B.z };
+}
+
+inline float3 operator/(const float3& A, float B) {
+	return float3{ A.x / B, A.y / B, A.z / B };
+}
+
+inline float dot(const float3& A, const float3& B) {
+	return A.x * B.x + A.y * B.y + A.z * B.z;
+}
+
+inline float3 cross(const float3& A, const float3& B) {
+	return float3{ A.y * B.z - A.z * B.y, A.z * B.x - A.x * B.z, A.x * B.y - A.y * B.x };
+}
+
+inline float length(const float3& A) {
+	return sqrtf(dot(A, A));
+}
+
+inline float3 normalize(const float3& A) {
+	return A / length(A);
+}
+
+inline bool isnan(const float3& A) {
+	return isnan(A.x) || isnan(A.y) || isnan(A.z);
+}
+
+// Calculates a value blended between two extremes, given a current-step value.
+inline float LinearInterpolation(float CurrentStep, float StartValue = -1.0f, float EndValue = +1.0f) {
+	double BlendedValue;
+
+	BlendedValue = ((1.0 - ( double )CurrentStep) * ( double )StartValue) + (( double )CurrentStep * ( double )EndValue);
+
+	return ( float )BlendedValue;
+}
+
+// Calculates a vector blended between two extremes, given a current-step value.
+inline float3 LinearInterpolation(float CurrentStep, const float3& StartValue, const float3& EndValue) {
+	return float3{ LinearInterpolation(CurrentStep, StartValue.x, EndValue.x), LinearInterpolation(CurrentStep, StartValue.y, EndValue.y),
+		LinearInterpolation(CurrentStep, StartValue.z, EndValue.z) };
+}
+
+namespace CPUStuff {
+
+	// General Utilities.
+
+	inline void FailBail(const char* ErrorMessage, const char* ErrorTitle) {
+		fprintf(stderr, "%s: %s\n", ErrorTitle, ErrorMessage);
+		exit(-1);
+	}
+
+	// Peak resident set size of the current process, in bytes.
+	inline uint64_t GetPeakResidentSetSizeInBytes() {
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS MemoryCounters{};
+
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &MemoryCounters, sizeof(MemoryCounters)) == 0) {
+			return 0u;
+		}
+
+		return ( uint64_t )MemoryCounters.PeakWorkingSetSize;
+#else
+		rusage ResourceUsage{};
+
+		if (getrusage(RUSAGE_SELF, &ResourceUsage) != 0) {
+			return 0u;
+		}
+
+		return ( uint64_t )ResourceUsage.ru_maxrss * 1024u;
+#endif
+	}
+
+	// Wall-clock stopwatch.
+	class Timer {
+	  protected:
+		std::chrono::steady_clock::time_point StartTime{};
+
+	  public:
+		Timer() {
+			this->Reset();
+		}
+
+		void Reset() {
+			this->StartTime = std::chrono::steady_clock::now();
+		}
+
+		double GetElapsedSeconds() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->StartTime).count();
+		}
+	};
+
+	// View of a whole file, mapped into memory rather than read, so that it can be parsed in place and in parallel.
+	// A copy-on-write mapping can also be written to, with each page it writes becoming private to the process and the file left untouched.
+	class MappedFile {
+	  protected:
+		char* pData{ nullptr };
+		uint64_t Size{ 0u };
+#ifdef _WIN32
+		HANDLE FileHandle{ INVALID_HANDLE_VALUE };
+		HANDLE MappingHandle{ nullptr };
+#else
+		int FileDescriptor{ -1 };
+#endif
+
+	  public:
+		MappedFile() = default;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Maps a file, returning false if it cannot be opened or mapped. An empty file maps to no data.
+		bool Open(const char* FilePath, bool CopyOnWrite = false) {
+			this->Close();
+#ifdef _WIN32
+			this->FileHandle = CreateFileA(FilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			LARGE_INTEGER FileSize{};
+
+			if (this->FileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->FileHandle, &FileSize)) {
+				this->Close();
+				return false;
+			}
+
+			this->Size = ( uint64_t )FileSize.QuadPart;
+
+			if (this->Size > 0u) {
+				this->MappingHandle = CreateFileMappingA(this->FileHandle, nullptr, CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+				this->pData = this->MappingHandle != nullptr
+					? ( char* )MapViewOfFile(this->MappingHandle, CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0)
+					: nullptr;
+			}
+#else
+			this->FileDescriptor = open(FilePath, O_RDONLY);
+			struct stat FileStatus {};
+
+			if (this->FileDescriptor < 0 || fstat(this->FileDescriptor, &FileStatus) != 0) {
+				this->Close();
+				return false;
+			}
+
+			this->Size = ( uint64_t )FileStatus.st_size;
+
+			if (this->Size > 0u) {
+				void* pMapping{ mmap(nullptr, this->Size, CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, this->FileDescriptor, 0) };
+				this->pData = pMapping != MAP_FAILED ? ( char* )pMapping : nullptr;
+
+				if (this->pData != nullptr) {
+					madvise(pMapping, this->Size, MADV_WILLNEED);
+				}
+			}
+#endif
+			if (this->Size > 0u && this->pData == nullptr) {
+				this->Close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void Close() {
+#ifdef _WIN32
+			if (this->pData != nullptr) {
+				UnmapViewOfFile(this->pData);
+			}
+
+			if (this->MappingHandle != nullptr) {
+				CloseHandle(this->MappingHandle);
+			}
+
+			if (this->FileHandle != INVALID_HANDLE_VALUE) {
+				CloseHandle(this->FileHandle);
+			}
+
+			this->MappingHandle = nullptr;
+			this->FileHandle = INVALID_HANDLE_VALUE;
+#else
+			if (this->pData != nullptr) {
+				munmap(this->pData, this->Size);
+			}
+
+			if (this->FileDescriptor >= 0) {
+				close(this->FileDescriptor);
+			}
+
+			this->FileDescriptor = -1;
+#endif
+			this->pData = nullptr;
+			this->Size = 0u;
+		}
+
+		const char* GetData() {
+			return this->pData;
+		}
+
+		// Only valid to write through for a copy-on-write mapping.
+		char* GetWritableData() {
+			return this->pData;
+		}
+
+		uint64_t GetSize() {
+			return this->Size;
+		}
+
+		~MappedFile() {
+			this->Close();
+		}
+	};
+
+	// Array that either owns its elements, like a std::vector, or views elements that live elsewhere, such as in a MappedFile, without copying them.
+	// Elements of a view are read and written in place. Anything that could change its size first copies them into storage of its own.
+	template<typename ElementType> class MappableVector {
+	  protected:
+		std::vector<ElementType> Storage{};
+		ElementType* pView{ nullptr };
+		size_t ViewSize{ 0u };
+
+		void Detach() {
+			if (this->pView != nullptr) {
+				this->Storage.assign(this->pView, this->pView + this->ViewSize);
+				this->pView = nullptr;
+				this->ViewSize = 0u;
+			}
+		}
+
+	  public:
+		MappableVector() = default;
+
+		MappableVector(size_t Size) : Storage(Size) {
+		}
+
+		MappableVector(const MappableVector& Other) : Storage(Other.begin(), Other.end()) {
+		}
+
+		MappableVector(MappableVector&& Other) noexcept
+			: Storage{ std::move(Other.Storage) }, pView{ std::exchange(Other.pView, nullptr) }, ViewSize{ std::exchange(Other.ViewSize, 0u) } {
+		}
+
+		MappableVector& operator=(const MappableVector& Other) {
+			if (this != &Other) {
+				this->pView = nullptr;
+				this->ViewSize = 0u;
+				this->Storage.assign(Other.begin(), Other.end());
+			}
+
+			return *this;
+		}
+
+		MappableVector& operator=(MappableVector&& Other) noexcept {
+			if (this != &Other) {
+				this->Storage = std::move(Other.Storage);
+				this->pView = std::exchange(Other.pView, nullptr);
+				this->ViewSize = std::exchange(Other.ViewSize, 0u);
+			}
+
+			return *this;
+		}
+
+		// Views Size elements at pElements, which must outlive this array or its next size change, dropping whatever it held.
+		void View(ElementType* pElements, size_t Size) {
+			this->Storage.clear();
+			this->Storage.shrink_to_fit();
+			this->pView = Size > 0u ? pElements : nullptr;
+			this->ViewSize = Size;
+		}
+
+		bool IsView() const {
+			return this->pView != nullptr;
+		}
+
+		size_t size() const {
+			return this->pView != nullptr ? this->ViewSize : this->Storage.size();
+		}
+
+		// Elements held in storage of its own, which is none for a view.
+		size_t capacity() const {
+			return this->Storage.capacity();
+		}
+
+		bool empty() const {
+			return this->size() == 0u;
+		}
+
+		ElementType* data() {
+			return this->pView != nullptr ? this->pView : this->Storage.data();
+		}
+
+		const ElementType* data() const {
+			return this->pView != nullptr ? this->pView : this->Storage.data();
+		}
+
+		ElementType& operator[](size_t Index) {
+			return this->data()[Index];
+		}
+
+		const ElementType& operator[](size_t Index) const {
+			return this->data()[Index];
+		}
+
+		ElementType* begin() {
+			return this->data();
+		}
+
+		ElementType* end() {
+			return this->data() + this->size();
+		}
+
+		const ElementType* begin() const {
+			return this->data();
+		}
+
+		const ElementType* end() const {
+			return this->data() + this->size();
+		}
+
+		ElementType& back() {
+			return this->data()[this->size() - 1u];
+		}
+
+		const ElementType& back() const {
+			return this->data()[this->size() - 1u];
+		}
+
+		void resize(size_t Size) {
+			this->Detach();
+			this->Storage.resize(Size);
+		}
+
+		void reserve(size_t Capacity) {
+			this->Detach();
+			this->Storage.reserve(Capacity);
+		}
+
+		void shrink_to_fit() {
+			this->Storage.shrink_to_fit();
+		}
+
+		void clear() {
+			this->pView = nullptr;
+			this->ViewSize = 0u;
+			this->Storage.clear();
+		}
+
+		void push_back(const ElementType& Element) {
+			this->Detach();
+			this->Storage.push_back(Element);
+		}
+
+		template<typename... ArgumentTypes> ElementType& emplace_back(ArgumentTypes&&... Arguments) {
+			this->Detach();
+			return this->Storage.emplace_back(std::forward<ArgumentTypes>(Arguments)...);
+		}
+
+		void assign(size_t Count, const ElementType& Element) {
+			this->pView = nullptr;
+			this->ViewSize = 0u;
+			this->Storage.assign(Count, Element);
+		}
+
+		template<typename IteratorType, std::enable_if_t<!std::is_integral_v<IteratorType>, int> = 0> void assign(IteratorType First, IteratorType Last) {
+			this->pView = nullptr;
+			this->ViewSize = 0u;
+			this->Storage.assign(First, Last);
+		}
+	};
+
+	// 64-bit hash of a block of bytes, fed through four independent multiply-rotate lanes of eight bytes each so that it runs at memory speed.
+	// Not cryptographic: it only has to tell files apart that have changed, for caches keyed by their contents.
+	inline uint64_t HashBytes(const void* pBytes, uint64_t Size, uint64_t Seed = 0u) {
+		constexpr uint64_t Prime1{ 0x9E3779B185EBCA87ull }, Prime2{ 0xC2B2AE3D27D4EB4Full }, Prime3{ 0x165667B19E3779F9ull };
+		const uint8_t* p{ ( const uint8_t* )pBytes };
+		const uint8_t* const pEnd{ p + Size };
+
+		auto Rotate = [](uint64_t Value, uint Bits) {
+			return (Value << Bits) | (Value >> (64u - Bits));
+		};
+
+		auto Round = [&](uint64_t Lane, uint64_t Word) {
+			return Rotate(Lane + Word * Prime2, 31u) * Prime1;
+		};
+
+		auto ReadWord = [](const uint8_t* pWord) {
+			uint64_t Word{};
+			memcpy(&Word, pWord, sizeof(Word));
+			return Word;
+		};
+
+		uint64_t Lanes[4]{ Seed + Prime1 + Prime2, Seed + Prime2, Seed, Seed - Prime1 };
+
+		for (; pEnd - p >= 32; p += 32) {
+			for (uint i{ 0u }; i < 4u; i++) {
+				Lanes[i] = Round(Lanes[i], ReadWord(p + i * 8u));
+			}
+		}
+
+		uint64_t Hash{ Rotate(Lanes[0], 1u) + Rotate(Lanes[1], 7u) + Rotate(Lanes[2], 12u) + Rotate(Lanes[3], 18u) + Size };
+
+		for (; pEnd - p >= 8; p += 8) {
+			Hash = Rotate(Hash ^ Round(0u, ReadWord(p)), 27u) * Prime1 + Prime3;
+		}
+
+		for (; p < pEnd; p++) {
+			Hash = Rotate(Hash ^ (*p * Prime3), 11u) * Prime1;
+		}
+
+		Hash ^= Hash >> 33u;
+		Hash *= Prime2;
+		Hash ^= Hash >> 29u;
+		Hash *= Prime3;
+		Hash ^= Hash >> 32u;
+
+		return Hash;
+	}
+
+	// Fixed set of worker threads that execute index ranges of a single job at a time.
+	// The calling thread participates as thread 0, so a pool of N threads spawns N - 1 workers.
+	// ParallelFor() is not reentrant: a job must not call back into the pool that runs it.
+	class ThreadPool {
+	  protected:
+		std::vector<std::thread> Workers{};
+		std::mutex JobMutex{};
+		std::condition_variable JobAvailable{};
+		std::condition_variable JobComplete{};
+		std::function<void(int64_t, int64_t, uint)> Job{};
+		std::atomic<int64_t> NextIndex{ 0 };
+		int64_t IndexCount{ 0 };
+		int64_t GrainSize{ 1 };
+		uint64_t JobGeneration{ 0u };
+		uint PendingWorkerCount{ 0u };
+		bool ShuttingDown{ false };
+
+		void RunJob(uint ThreadIndex) {
+			while (true) {
+				int64_t BeginIndex{ this->NextIndex.fetch_add(this->GrainSize) };
+
+				if (BeginIndex >= this->IndexCount) {
+					break;
+				}
+
+				this->Job(BeginIndex, std::min(BeginIndex + this->GrainSize, this->IndexCount), ThreadIndex);
+			}
+		}
+
+		void WorkerMain(uint ThreadIndex) {
+			uint64_t LastJobGeneration{ 0u };
+
+			while (true) {
+				{
+					std::unique_lock<std::mutex> Lock{ this->JobMutex };
+					this->JobAvailable.wait(Lock, [&] {
+						return this->ShuttingDown || this->JobGeneration != LastJobGeneration;
+					});
+
+					if (this->ShuttingDown) {
+						return;
+					}
+
+					LastJobGeneration = this->JobGeneration;
+				}
+
+				this->RunJob(ThreadIndex);
+
+				std::unique_lock<std::mutex> Lock{ this->JobMutex };
+
+				if (--this->PendingWorkerCount == 0u) {
+					this->JobComplete.notify_one();
+				}
+			}
+		}
+
+	  public:
+		ThreadPool(uint ThreadCount = 0u) {
+			if (ThreadCount == 0u) {
+				ThreadCount = std::max(1u, ( uint )std::thread::hardware_concurrency());
+			}
+
+			for (uint i{ 1u }; i < ThreadCount; i++) {
+				this->Workers.emplace_back(&ThreadPool::WorkerMain, this, i);
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		uint GetThreadCount() {
+			return ( uint )this->Workers.size() + 1u;
+		}
+
+		// Calls Function(BeginIndex, EndIndex, ThreadIndex) over [0, IndexCount) in chunks of GrainSize, and waits for completion.
+		void ParallelFor(int64_t IndexCount, int64_t GrainSize, std::function<void(int64_t, int64_t, uint)> Function) {
+			if (IndexCount <= 0) {
+				return;
+			}
+
+			{
+				std::unique_lock<std::mutex> Lock{ this->JobMutex };
+				this->Job = std::move(Function);
+				this->IndexCount = IndexCount;
+				this->GrainSize = std::max(( int64_t )1, GrainSize);
+				this->NextIndex = 0;
+				this->PendingWorkerCount = ( uint )this->Workers.size();
+				this->JobGeneration++;
+			}
+
+			this->JobAvailable.notify_all();
+
+			this->RunJob(0u);
+
+			std::unique_lock<std::mutex> Lock{ this->JobMutex };
+			this->JobComplete.wait(Lock, [&] {
+				return this->PendingWorkerCount == 0u;
+			});
+
+			this->Job = nullptr;
+		}
+
+		~ThreadPool() {
+			{
+				std::unique_lock<std::mutex> Lock{ this->JobMutex };
+				this->ShuttingDown = true;
+			}
+
+			this->JobAvailable.notify_all();
+
+			for (auto& Worker: this->Workers) {
+				Worker.join();
+			}
+		}
+	};
+
+	struct R8G8B8A8Uint {
+		uint8_t R{}, G{}, B{}, A{};
+	};
+
+	// Converts a float to a UNORM8 value the same way the FinalFrame "unorm float4" UAV does.
+	inline uint8_t FloatToUnorm8(float Value) {
+		if (!(Value > 0.0f)) {
+			return 0u;
+		} else if (Value >= 1.0f) {
+			return 255u;
+		}
+
+		return ( uint8_t )(Value * 255.0f + 0.50f);
+	}
+
+	// Stores an R8G8B8A8 frame as a binary PPM (P6) image, dropping the alpha channel.
+	inline bool WriteFrameToPPM(const char* FilePath, uint Width, uint Height, const R8G8B8A8Uint* pFrame) {
+		FILE* pFile{ fopen(FilePath, "wb") };
+
+		if (pFile == nullptr) {
+			return false;
+		}
+
+		fprintf(pFile, "P6\n%u %u\n255\n", Width, Height);
+
+		std::vector<uint8_t> Row(( size_t )Width * 3u);
+
+		for (uint y{ 0u }; y < Height; y++) {
+			for (uint x{ 0u }; x < Width; x++) {
+				const R8G8B8A8Uint& Pixel{ pFrame[( size_t )y * Width + x] };
+				Row[( size_t )x * 3u + 0u] = Pixel.R;
+				Row[( size_t )x * 3u + 1u] = Pixel.G;
+				Row[( size_t )x * 3u + 2u] = Pixel.B;
+			}
+
+			fwrite(Row.data(), 1u, Row.size(), pFile);
+		}
+
+		return fclose(pFile) == 0;
+	}
+
+}
@@ -0,0 +1,928 @@
+// ImportStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef IMPORT_STUFF
+	#define IMPORT_STUFF
+#endif
+
+#include "BVHStuff.hpp"
+#include <cstring>
+
+namespace ImportStuff {
+
+	/*
+		MESH FILE FORMATS:
+			PLY - Binary PLY, little or big endian. Vertices are read from the x, y and z properties of the "vertex" element, and triangles from the
+				"vertex_indices" (or "vertex_index") list of the "face" element, with larger polygons split into fans. Files of triangles only are
+				read in parallel, others are walked face by face.
+			OBJ - Wavefront OBJ. Only "v" and "f" statements are read, with any texture-coordinate and normal indices of a face ignored and
+				polygons split into fans. The file is split into chunks at line breaks, which are counted, and then parsed, in parallel.
+			Either way the file is mapped rather than read, and its vertices and indices are parsed in place, straight into the scene's mesh buffers.
+	*/
+	enum class MeshFileFormat : uint { PLY, OBJ };
+
+	inline const char* GetMeshFileFormatName(MeshFileFormat Format) {
+		switch (Format) {
+			case MeshFileFormat::PLY: {
+				return "ply";
+			}
+			case MeshFileFormat::OBJ: {
+				return "obj";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// What a mesh import read, and how long it took. ErrorMessage is set when it failed.
+	struct ImportStats {
+		MeshFileFormat Format{ MeshFileFormat::OBJ };
+		uint64_t FileSizeInBytes{ 0u };
+		uint VertexCount{ 0u };
+		uint TriangleCount{ 0u };
+		double Seconds{ 0.0 };
+		const char* ErrorMessage{ nullptr };
+	};
+
+	// Text parsing, over [p, End) of a mapped file, which has no terminating null to stop at.
+
+	inline bool IsSpace(char Character) {
+		return Character == ' ' || Character == '\t' || Character == '\r';
+	}
+
+	inline void SkipSpaces(const char*& p, const char* End) {
+		while (p < End && IsSpace(*p)) {
+			p++;
+		}
+	}
+
+	inline const char* GetLineEnd(const char* p, const char* End) {
+		const char* pLineEnd{ ( const char* )memchr(p, '\n', ( size_t )(End - p)) };
+		return pLineEnd != nullptr ? pLineEnd : End;
+	}
+
+	inline bool IsDigit(char Character) {
+		return ( unsigned char )(Character - '0') < 10u;
+	}
+
+	// Parses a decimal floating-point number, returning false if there is none. Up to 19 significant digits are kept, and scaled by an exact power of
+	// ten wherever double precision holds one, so that numbers printed with enough digits read back as the very same float.
+	inline bool ParseFloat(const char*& p, const char* End, float& Value) {
+		static constexpr double PowersOfTen[]{ 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+			1e19, 1e20, 1e21, 1e22 };
+		const char* pStart{ p };
+		bool IsNegative{ false };
+
+		if (p < End && (*p == '-' || *p == '+')) {
+			IsNegative = *p == '-';
+			p++;
+		}
+
+		// Digits are accumulated without checks first, since 19 of them always fit, and only longer numbers are parsed again digit by digit.
+		const char* pDigits{ p };
+		uint64_t Mantissa{ 0u };
+		int Exponent{ 0 };
+
+		for (; p < End && IsDigit(*p); p++) {
+			Mantissa = Mantissa * 10u + ( uint64_t )(*p - '0');
+		}
+
+		uint DigitCount{ ( uint )(p - pDigits) };
+
+		if (p < End && *p == '.') {
+			const char* pFraction{ ++p };
+
+			for (; p < End && IsDigit(*p); p++) {
+				Mantissa = Mantissa * 10u + ( uint64_t )(*p - '0');
+			}
+
+			Exponent = -( int )(p - pFraction);
+			DigitCount += ( uint )(p - pFraction);
+		}
+
+		if (DigitCount == 0u) {
+			p = pStart;
+			return false;
+		}
+
+		if (DigitCount > 19u) {
+			const char* pDigitsEnd{ p };
+			uint SignificantDigitCount{ 0u };
+			bool IsFraction{ false };
+			Mantissa = 0u;
+			Exponent = 0;
+
+			for (p = pDigits; p < pDigitsEnd; p++) {
+				if (*p == '.') {
+					IsFraction = true;
+				} else if (SignificantDigitCount < 19u) {
+					Mantissa = Mantissa * 10u + ( uint64_t )(*p - '0');
+					SignificantDigitCount += Mantissa > 0u ? 1u : 0u;
+					Exponent -= IsFraction ? 1 : 0;
+				} else {
+					Exponent += IsFraction ? 0 : 1;
+				}
+			}
+		}
+
+		if (p < End && (*p == 'e' || *p == 'E')) {
+			const char* pExponent{ p + 1 };
+			bool ExponentIsNegative{ false };
+			int ExplicitExponent{ 0 };
+
+			if (pExponent < End && (*pExponent == '-' || *pExponent == '+')) {
+				ExponentIsNegative = *pExponent == '-';
+				pExponent++;
+			}
+
+			if (pExponent < End && IsDigit(*pExponent)) {
+				for (; pExponent < End && IsDigit(*pExponent); pExponent++) {
+					ExplicitExponent = std::min(ExplicitExponent * 10 + (*pExponent - '0'), 100000);
+				}
+
+				Exponent += ExponentIsNegative ? -ExplicitExponent : ExplicitExponent;
+				p = pExponent;
+			}
+		}
+
+		double Result{ ( double )Mantissa };
+
+		if (Exponent >= 0 && Exponent <= 22) {
+			Result *= PowersOfTen[Exponent];
+		} else if (Exponent < 0 && Exponent >= -22) {
+			Result /= PowersOfTen[-Exponent];
+		} else if (Mantissa != 0u) {
+			Result *= pow(10.0, ( double )Exponent);
+		}
+
+		Value = ( float )(IsNegative ? -Result : Result);
+		return true;
+	}
+
+	// Parses a decimal integer, returning false if there is none.
+	inline bool ParseInteger(const char*& p, const char* End, int64_t& Value) {
+		const char* pStart{ p };
+		bool IsNegative{ false };
+
+		if (p < End && (*p == '-' || *p == '+')) {
+			IsNegative = *p == '-';
+			p++;
+		}
+
+		uint64_t Magnitude{ 0u };
+		const char* pDigits{ p };
+
+		for (; p < End && IsDigit(*p); p++) {
+			Magnitude = std::min(Magnitude * 10u + ( uint64_t )(*p - '0'), ( uint64_t )1 << 40u);
+		}
+
+		if (p == pDigits) {
+			p = pStart;
+			return false;
+		}
+
+		Value = IsNegative ? -( int64_t )Magnitude : ( int64_t )Magnitude;
+		return true;
+	}
+
+	// Whether [p, End) starts with a given keyword, followed by a space or the end of its line.
+	inline bool StartsWithKeyword(const char* p, const char* End, const char* Keyword) {
+		const size_t KeywordLength{ strlen(Keyword) };
+		return ( size_t )(End - p) >= KeywordLength && memcmp(p, Keyword, KeywordLength) == 0 &&
+			(( size_t )(End - p) == KeywordLength || IsSpace(p[KeywordLength]) || p[KeywordLength] == '\n');
+	}
+
+	// Reads the next space-separated token of a line.
+	inline bool ReadToken(const char*& p, const char* LineEnd, const char*& Token, size_t& TokenLength) {
+		SkipSpaces(p, LineEnd);
+		Token = p;
+
+		while (p < LineEnd && !IsSpace(*p)) {
+			p++;
+		}
+
+		TokenLength = ( size_t )(p - Token);
+		return TokenLength > 0u;
+	}
+
+	inline bool TokenIs(const char* Token, size_t TokenLength, const char* Name) {
+		return strlen(Name) == TokenLength && memcmp(Token, Name, TokenLength) == 0;
+	}
+
+	// How large a scene's mesh buffers were before an import, to shrink them back to if it fails.
+	struct MeshReservation {
+		size_t MeshCount;
+		size_t TriangleCount;
+		size_t VertexCount;
+
+		explicit MeshReservation(const SceneStuff::Scene& Scene)
+			: MeshCount{ Scene.Meshes.size() }, TriangleCount{ Scene.MeshIndices.size() }, VertexCount{ Scene.MeshVertices.size() } {
+		}
+
+		void Rollback(SceneStuff::Scene& Scene) {
+			Scene.Meshes.resize(this->MeshCount);
+			Scene.MeshIndices.resize(this->TriangleCount);
+			Scene.MeshVertices.resize(this->VertexCount);
+
+			if (!Scene.MeshVerticesStart.empty()) {
+				Scene.MeshVerticesStart.resize(this->VertexCount);
+				Scene.MeshVerticesEnd.resize(this->VertexCount);
+			}
+		}
+	};
+
+	// Copies a freshly parsed mesh's vertices into the scene's keyframes, if it stores them, since imported meshes are static.
+	inline void CopyMeshKeyframes(const Mesh& NewMesh, SceneStuff::Scene& Scene) {
+		if (!Scene.MeshVerticesStart.empty()) {
+			std::copy(Scene.MeshVertices.begin() + NewMesh.FirstVertex, Scene.MeshVertices.begin() + NewMesh.FirstVertex + NewMesh.VertexCount,
+				Scene.MeshVerticesStart.begin() + NewMesh.FirstVertex);
+			std::copy(Scene.MeshVertices.begin() + NewMesh.FirstVertex, Scene.MeshVertices.begin() + NewMesh.FirstVertex + NewMesh.VertexCount,
+				Scene.MeshVerticesEnd.begin() + NewMesh.FirstVertex);
+		}
+	}
+
+	/*
+		PLY PROPERTY TYPES:
+			Int8/UInt8/Int16/UInt16/Int32/UInt32/Float32/Float64, also named char/uchar/short/ushort/int/uint/float/double.
+	*/
+	enum class PLYType : uint { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Unknown };
+
+	inline PLYType GetPLYType(const char* Token, size_t TokenLength) {
+		const char* Names[][2]{ { "char", "int8" }, { "uchar", "uint8" }, { "short", "int16" }, { "ushort", "uint16" }, { "int", "int32" },
+			{ "uint", "uint32" }, { "float", "float32" }, { "double", "float64" } };
+
+		for (uint i{ 0u }; i < ( uint )PLYType::Unknown; i++) {
+			if (TokenIs(Token, TokenLength, Names[i][0]) || TokenIs(Token, TokenLength, Names[i][1])) {
+				return ( PLYType )i;
+			}
+		}
+
+		return PLYType::Unknown;
+	}
+
+	inline uint GetPLYTypeSize(PLYType Type) {
+		const uint Sizes[]{ 1u, 1u, 2u, 2u, 4u, 4u, 4u, 8u, 0u };
+		return Sizes[( uint )Type];
+	}
+
+	// Reads one value of a PLY property, swapping its bytes when the file's endianness differs from the host's.
+	inline double ReadPLYValue(const char* p, PLYType Type, bool SwapBytes) {
+		unsigned char Bytes[8];
+		const uint Size{ GetPLYTypeSize(Type) };
+		memcpy(Bytes, p, Size);
+
+		if (SwapBytes) {
+			std::reverse(Bytes, Bytes + Size);
+		}
+
+		switch (Type) {
+			case PLYType::Int8: {
+				int8_t Value;
+				memcpy(&Value, Bytes, 1u);
+				return Value;
+			}
+			case PLYType::UInt8: {
+				return Bytes[0];
+			}
+			case PLYType::Int16: {
+				int16_t Value;
+				memcpy(&Value, Bytes, 2u);
+				return Value;
+			}
+			case PLYType::UInt16: {
+				uint16_t Value;
+				memcpy(&Value, Bytes, 2u);
+				return Value;
+			}
+			case PLYType::Int32: {
+				int32_t Value;
+				memcpy(&Value, Bytes, 4u);
+				return Value;
+			}
+			case PLYType::UInt32: {
+				uint32_t Value;
+				memcpy(&Value, Bytes, 4u);
+				return Value;
+			}
+			case PLYType::Float32: {
+				float Value;
+				memcpy(&Value, Bytes, 4u);
+				return Value;
+			}
+			default: {
+				double Value;
+				memcpy(&Value, Bytes, 8u);
+				return Value;
+			}
+		}
+	}
+
+	struct PLYProperty {
+		PLYType Type{ PLYType::Unknown };
+		PLYType CountType{ PLYType::Unknown };// Set for list properties only.
+		uint Offset{ 0u };// Byte offset within the element, while every property before it has a fixed size.
+		const char* Name{ nullptr };
+		size_t NameLength{ 0u };
+	};
+
+	struct PLYElement {
+		const char* Name{ nullptr };
+		size_t NameLength{ 0u };
+		uint64_t Count{ 0u };
+		std::vector<PLYProperty> Properties{};
+		uint Size{ 0u };// Bytes per element, when it has no list properties.
+		bool HasLists{ false };
+	};
+
+	// Bytes taken up by one property of an element starting at p, or zero if a list property runs past End.
+	inline uint64_t GetPLYPropertySize(const PLYProperty& Property, const char* p, const char* End, bool SwapBytes) {
+		if (Property.CountType == PLYType::Unknown) {
+			return GetPLYTypeSize(Property.Type);
+		}
+
+		if (( uint64_t )(End - p) < GetPLYTypeSize(Property.CountType)) {
+			return 0u;
+		}
+
+		const double Count{ ReadPLYValue(p, Property.CountType, SwapBytes) };
+		return GetPLYTypeSize(Property.CountType) + ( uint64_t )std::max(Count, 0.0) * GetPLYTypeSize(Property.Type);
+	}
+
+	// Bytes taken up by an element starting at p, up to one of its properties or all of them, or zero if it runs past End.
+	inline uint64_t GetPLYElementSize(const PLYElement& Element, const PLYProperty* pLastProperty, const char* p, const char* End, bool SwapBytes) {
+		uint64_t Size{ 0u };
+
+		for (const PLYProperty& Property: Element.Properties) {
+			if (&Property == pLastProperty) {
+				break;
+			}
+
+			const uint64_t PropertySize{ GetPLYPropertySize(Property, p + Size, End, SwapBytes) };
+
+			if (PropertySize == 0u) {
+				return 0u;
+			}
+
+			Size += PropertySize;
+		}
+
+		return ( uint64_t )(End - p) >= Size ? Size : 0u;
+	}
+
+	inline bool ImportPLY(const char* pData, const char* End, uint MaterialIndex, CPUStuff::ThreadPool& ThreadPool, SceneStuff::Scene& Scene,
+		ImportStats& Stats) {
+		// Header.
+		std::vector<PLYElement> Elements{};
+		bool IsBinary{ false }, SwapBytes{ false };
+		const char* p{ pData };
+		bool HeaderIsComplete{ false };
+		uint16_t EndiannessProbe{ 1u };
+		unsigned char HostIsLittleEndian;
+		memcpy(&HostIsLittleEndian, &EndiannessProbe, 1u);
+
+		while (p < End && !HeaderIsComplete) {
+			const char* LineEnd{ GetLineEnd(p, End) };
+			const char* Token;
+			size_t TokenLength;
+
+			if (ReadToken(p, LineEnd, Token, TokenLength)) {
+				if (TokenIs(Token, TokenLength, "format")) {
+					ReadToken(p, LineEnd, Token, TokenLength);
+					IsBinary = TokenIs(Token, TokenLength, "binary_little_endian") || TokenIs(Token, TokenLength, "binary_big_endian");
+					SwapBytes = TokenIs(Token, TokenLength, "binary_big_endian") == (HostIsLittleEndian != 0u);
+				} else if (TokenIs(Token, TokenLength, "element")) {
+					PLYElement Element{};
+					int64_t Count{ -1 };
+					ReadToken(p, LineEnd, Element.Name, Element.NameLength);
+					SkipSpaces(p, LineEnd);
+
+					if (!ParseInteger(p, LineEnd, Count) || Count < 0) {
+						Stats.ErrorMessage = "Malformed PLY element";
+						return false;
+					}
+
+					Element.Count = ( uint64_t )Count;
+					Elements.push_back(Element);
+				} else if (TokenIs(Token, TokenLength, "property")) {
+					PLYProperty Property{};
+					ReadToken(p, LineEnd, Token, TokenLength);
+
+					if (TokenIs(Token, TokenLength, "list")) {
+						ReadToken(p, LineEnd, Token, TokenLength);
+						Property.CountType = GetPLYType(Token, TokenLength);
+						ReadToken(p, LineEnd, Token, TokenLength);
+						Property.Type = GetPLYType(Token, TokenLength);
+
+						if (Property.CountType == PLYType::Unknown) {
+							Stats.ErrorMessage = "Unknown PLY property type";
+							return false;
+						}
+					} else {
+						Property.Type = GetPLYType(Token, TokenLength);
+					}
+
+					ReadToken(p, LineEnd, Property.Name, Property.NameLength);
+
+					if (Property.Type == PLYType::Unknown || Elements.empty()) {
+						Stats.ErrorMessage = Elements.empty() ? "PLY property outside of an element" : "Unknown PLY property type";
+						return false;
+					}
+
+					PLYElement& Element{ Elements.back() };
+					Property.Offset = Element.Size;
+					Element.Size += Property.CountType == PLYType::Unknown ? GetPLYTypeSize(Property.Type) : 0u;
+					Element.HasLists |= Property.CountType != PLYType::Unknown;
+					Element.Properties.push_back(Property);
+				} else if (TokenIs(Token, TokenLength, "end_header")) {
+					HeaderIsComplete = true;
+				}
+			}
+
+			p = LineEnd < End ? LineEnd + 1 : End;
+		}
+
+		if (!HeaderIsComplete || !IsBinary) {
+			Stats.ErrorMessage = HeaderIsComplete ? "Only binary PLY files are supported" : "Incomplete PLY header";
+			return false;
+		}
+
+		// Elements, of which only the vertices and faces are read, while every other element is skipped.
+		const PLYElement* pVertices{ nullptr };
+		const PLYElement* pFaces{ nullptr };
+		const char* pVertexData{ nullptr };
+		const char* pFaceData{ nullptr };
+
+		for (const PLYElement& Element: Elements) {
+			if (TokenIs(Element.Name, Element.NameLength, "vertex")) {
+				pVertices = &Element;
+				pVertexData = p;
+			} else if (TokenIs(Element.Name, Element.NameLength, "face")) {
+				pFaces = &Element;
+				pFaceData = p;
+			}
+
+			if (!Element.HasLists) {
+				if (( uint64_t )(End - p) / std::max(Element.Size, 1u) < Element.Count) {
+					Stats.ErrorMessage = "Truncated PLY file";
+					return false;
+				}
+
+				p += Element.Count * Element.Size;
+			} else if (&Element != pFaces || &Element != &Elements.back()) {
+				for (uint64_t i{ 0u }; i < Element.Count; i++) {
+					const uint64_t Size{ GetPLYElementSize(Element, nullptr, p, End, SwapBytes) };
+
+					if (Size == 0u) {
+						Stats.ErrorMessage = "Truncated PLY file";
+						return false;
+					}
+
+					p += Size;
+				}
+			}
+		}
+
+		if (pVertices == nullptr || pVertices->HasLists || pFaces == nullptr) {
+			Stats.ErrorMessage = "A PLY mesh needs a vertex element without lists, and a face element";
+			return false;
+		}
+
+		if (pVertices->Count + Scene.MeshVertices.size() > 0xFFFFFFFFu) {
+			Stats.ErrorMessage = "Too many vertices or triangles";
+			return false;
+		}
+
+		const PLYProperty* pCoordinates[3]{};
+		const PLYProperty* pIndices{ nullptr };
+
+		for (const PLYProperty& Property: pVertices->Properties) {
+			for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+				if (Property.NameLength == 1u && Property.Name[0] == "xyz"[Axis]) {
+					pCoordinates[Axis] = &Property;
+				}
+			}
+		}
+
+		for (const PLYProperty& Property: pFaces->Properties) {
+			if (Property.CountType != PLYType::Unknown &&
+				(TokenIs(Property.Name, Property.NameLength, "vertex_indices") || TokenIs(Property.Name, Property.NameLength, "vertex_index"))) {
+				pIndices = &Property;
+			}
+		}
+
+		if (pCoordinates[0] == nullptr || pCoordinates[1] == nullptr || pCoordinates[2] == nullptr || pIndices == nullptr) {
+			Stats.ErrorMessage = "A PLY mesh needs x, y and z vertex properties, and a vertex_indices face list";
+			return false;
+		}
+
+		// Faces of triangles only have a fixed size, so they are first checked for that in parallel, and then read in parallel.
+		const uint VertexCount{ ( uint )pVertices->Count };
+		const PLYElement& Faces{ *pFaces };
+		bool FacesAreTriangles{ Faces.Properties.size() >= 1u };
+		uint TriangleFaceSize{ 0u }, CountOffset{ 0u }, IndicesOffset{ 0u };
+
+		for (const PLYProperty& Property: Faces.Properties) {
+			if (&Property == pIndices) {
+				CountOffset = TriangleFaceSize;
+				IndicesOffset = TriangleFaceSize + GetPLYTypeSize(Property.CountType);
+				TriangleFaceSize += GetPLYTypeSize(Property.CountType) + 3u * GetPLYTypeSize(Property.Type);
+			} else {
+				FacesAreTriangles &= Property.CountType == PLYType::Unknown;
+				TriangleFaceSize += GetPLYTypeSize(Property.Type);
+			}
+		}
+
+		FacesAreTriangles &= TriangleFaceSize > 0u && ( uint64_t )(End - pFaceData) / std::max(TriangleFaceSize, 1u) >= Faces.Count;
+
+		if (FacesAreTriangles) {
+			std::atomic<bool> AllFacesAreTriangles{ true };
+
+			ThreadPool.ParallelFor(( int64_t )Faces.Count, 1 << 16, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (int64_t i{ BeginIndex }; i < EndIndex && AllFacesAreTriangles.load(std::memory_order_relaxed); i++) {
+					if (ReadPLYValue(pFaceData + ( uint64_t )i * TriangleFaceSize + CountOffset, pIndices->CountType, SwapBytes) != 3.0) {
+						AllFacesAreTriangles = false;
+					}
+				}
+			});
+
+			FacesAreTriangles = AllFacesAreTriangles;
+		}
+
+		// Otherwise the faces are walked one by one, first to count their triangles, which also validates their sizes.
+		uint64_t TriangleCount{ FacesAreTriangles ? Faces.Count : 0u };
+
+		if (!FacesAreTriangles) {
+			const char* pFace{ pFaceData };
+
+			for (uint64_t i{ 0u }; i < Faces.Count; i++) {
+				const uint64_t Size{ GetPLYElementSize(Faces, nullptr, pFace, End, SwapBytes) };
+				const uint64_t ListOffset{ GetPLYElementSize(Faces, pIndices, pFace, End, SwapBytes) };
+
+				if (Size == 0u) {
+					Stats.ErrorMessage = "Truncated PLY file";
+					return false;
+				}
+
+				const double CornerCount{ ReadPLYValue(pFace + ListOffset, pIndices->CountType, SwapBytes) };
+				TriangleCount += CornerCount >= 3.0 ? ( uint64_t )CornerCount - 2u : 0u;
+				pFace += Size;
+			}
+		}
+
+		if (TriangleCount + Scene.MeshIndices.size() > BVHStuff::ReferenceIndexMask + 1u) {
+			Stats.ErrorMessage = "Too many triangles";
+			return false;
+		}
+
+		const Mesh& NewMesh{ SceneStuff::ReserveMesh(VertexCount, ( uint )TriangleCount, MaterialIndex, Scene) };
+		const uint FirstVertex{ NewMesh.FirstVertex }, FirstTriangle{ NewMesh.FirstTriangle };
+
+		// Native floats and unsigned indices, by far the most common, are copied rather than converted.
+		const bool CoordinatesAreNative{ !SwapBytes && pCoordinates[0]->Type == PLYType::Float32 && pCoordinates[1]->Type == PLYType::Float32 &&
+			pCoordinates[2]->Type == PLYType::Float32 };
+		const bool IndicesAreNative{ !SwapBytes && (pIndices->Type == PLYType::Int32 || pIndices->Type == PLYType::UInt32) };
+
+		ThreadPool.ParallelFor(VertexCount, 1 << 16, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				const char* pVertex{ pVertexData + ( uint64_t )i * pVertices->Size };
+				float3& Vertex{ Scene.MeshVertices[FirstVertex + i] };
+
+				if (CoordinatesAreNative) {
+					memcpy(&Vertex.x, pVertex + pCoordinates[0]->Offset, sizeof(float));
+					memcpy(&Vertex.y, pVertex + pCoordinates[1]->Offset, sizeof(float));
+					memcpy(&Vertex.z, pVertex + pCoordinates[2]->Offset, sizeof(float));
+				} else {
+					Vertex = { ( float )ReadPLYValue(pVertex + pCoordinates[0]->Offset, pCoordinates[0]->Type, SwapBytes),
+						( float )ReadPLYValue(pVertex + pCoordinates[1]->Offset, pCoordinates[1]->Type, SwapBytes),
+						( float )ReadPLYValue(pVertex + pCoordinates[2]->Offset, pCoordinates[2]->Type, SwapBytes) };
+				}
+			}
+		});
+
+		std::atomic<bool> IndicesAreValid{ true };
+
+		auto GetVertexIndex = [&](const char* pIndex) {
+			const double Index{ ReadPLYValue(pIndex, pIndices->Type, SwapBytes) };
+
+			if (!(Index >= 0.0 && Index < ( double )VertexCount)) {
+				IndicesAreValid = false;
+				return FirstVertex;
+			}
+
+			return FirstVertex + ( uint )Index;
+		};
+
+		if (FacesAreTriangles) {
+			const uint IndexSize{ GetPLYTypeSize(pIndices->Type) };
+
+			ThreadPool.ParallelFor(( int64_t )TriangleCount, 1 << 16, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+					const char* pIndex{ pFaceData + ( uint64_t )i * TriangleFaceSize + IndicesOffset };
+					uint3& Indices{ Scene.MeshIndices[FirstTriangle + i] };
+
+					if (IndicesAreNative) {
+						// Negative Int32 indices wrap around to out of range ones.
+						memcpy(&Indices, pIndex, sizeof(uint3));
+
+						if (Indices.x >= VertexCount || Indices.y >= VertexCount || Indices.z >= VertexCount) {
+							IndicesAreValid = false;
+						}
+
+						Indices = { FirstVertex + Indices.x, FirstVertex + Indices.y, FirstVertex + Indices.z };
+					} else {
+						Indices = { GetVertexIndex(pIndex), GetVertexIndex(pIndex + IndexSize), GetVertexIndex(pIndex + 2u * IndexSize) };
+					}
+				}
+			});
+		} else {
+			const char* pFace{ pFaceData };
+			uint TriangleIndex{ FirstTriangle };
+
+			for (uint64_t i{ 0u }; i < Faces.Count; i++) {
+				const uint64_t ListOffset{ GetPLYElementSize(Faces, pIndices, pFace, End, SwapBytes) };
+
+				const uint CornerCount{ ( uint )ReadPLYValue(pFace + ListOffset, pIndices->CountType, SwapBytes) };
+				const char* pIndex{ pFace + ListOffset + GetPLYTypeSize(pIndices->CountType) };
+				const uint IndexSize{ GetPLYTypeSize(pIndices->Type) };
+
+				for (uint Corner{ 2u }; Corner < CornerCount; Corner++) {
+					Scene.MeshIndices[TriangleIndex++] = { GetVertexIndex(pIndex), GetVertexIndex(pIndex + (Corner - 1u) * IndexSize),
+						GetVertexIndex(pIndex + Corner * IndexSize) };
+				}
+
+				pFace += GetPLYElementSize(Faces, nullptr, pFace, End, SwapBytes);
+			}
+		}
+
+		if (!IndicesAreValid) {
+			Stats.ErrorMessage = "PLY face index out of range";
+			return false;
+		}
+
+		CopyMeshKeyframes(Scene.Meshes.back(), Scene);
+		Stats.VertexCount = VertexCount;
+		Stats.TriangleCount = ( uint )TriangleCount;
+		return true;
+	}
+
+	// A chunk of a text file, starting at a line break, so that no line straddles two chunks.
+	struct TextChunk {
+		const char* pBegin{ nullptr };
+		const char* pEnd{ nullptr };
+	};
+
+	constexpr uint64_t TextChunkSizeInBytes{ 1u << 20u };
+
+	// Splits a text file into chunks at the first line break past every TextChunkSizeInBytes, for its lines to be parsed in parallel.
+	inline std::vector<TextChunk> SplitIntoTextChunks(const char* pData, const char* End) {
+		const uint64_t FileSize{ ( uint64_t )(End - pData) };
+		std::vector<TextChunk> Chunks((FileSize + TextChunkSizeInBytes - 1u) / TextChunkSizeInBytes);
+
+		for (uint64_t i{ 0u }; i < Chunks.size(); i++) {
+			Chunks[i].pBegin = i == 0u ? pData : std::max(Chunks[i - 1u].pBegin, GetLineEnd(pData + i * TextChunkSizeInBytes - 1u, End) + 1);
+			Chunks[i].pBegin = std::min(Chunks[i].pBegin, End);
+		}
+
+		for (uint64_t i{ 0u }; i < Chunks.size(); i++) {
+			Chunks[i].pEnd = i + 1u < Chunks.size() ? Chunks[i + 1u].pBegin : End;
+		}
+
+		return Chunks;
+	}
+
+	// Calls Function(p, LineEnd) for every line of a chunk, with p past the line's leading spaces.
+	template<typename F> inline void ForEachLine(const TextChunk& Chunk, F Function) {
+		for (const char* p{ Chunk.pBegin }; p < Chunk.pEnd;) {
+			const char* LineEnd{ GetLineEnd(p, Chunk.pEnd) };
+			const char* pNextLine{ LineEnd < Chunk.pEnd ? LineEnd + 1 : Chunk.pEnd };
+			SkipSpaces(p, LineEnd);
+			Function(p, LineEnd);
+			p = pNextLine;
+		}
+	}
+
+	// How many vertices and triangles a chunk of an OBJ file holds, and how many come before it.
+	struct OBJChunk {
+		TextChunk Text{};
+		uint64_t VertexCount{ 0u };
+		uint64_t TriangleCount{ 0u };
+		uint64_t FirstVertex{ 0u };
+		uint64_t FirstTriangle{ 0u };
+	};
+
+	// Number of corners of an OBJ face, with p past its "f".
+	inline uint GetOBJCornerCount(const char* p, const char* LineEnd) {
+		uint CornerCount{ 0u };
+		const char* Token;
+		size_t TokenLength;
+
+		while (ReadToken(p, LineEnd, Token, TokenLength)) {
+			CornerCount++;
+		}
+
+		return CornerCount;
+	}
+
+	inline bool ImportOBJ(const char* pData, const char* End, uint MaterialIndex, CPUStuff::ThreadPool& ThreadPool, SceneStuff::Scene& Scene,
+		ImportStats& Stats) {
+		const std::vector<TextChunk> TextChunks{ SplitIntoTextChunks(pData, End) };
+		std::vector<OBJChunk> Chunks(TextChunks.size());
+
+		for (size_t i{ 0u }; i < Chunks.size(); i++) {
+			Chunks[i].Text = TextChunks[i];
+		}
+
+		// Counting.
+		ThreadPool.ParallelFor(( int64_t )Chunks.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				OBJChunk& Chunk{ Chunks[i] };
+
+				ForEachLine(Chunk.Text, [&](const char* p, const char* LineEnd) {
+					if (StartsWithKeyword(p, LineEnd, "v")) {
+						Chunk.VertexCount++;
+					} else if (StartsWithKeyword(p, LineEnd, "f")) {
+						const uint CornerCount{ GetOBJCornerCount(p + 1, LineEnd) };
+						Chunk.TriangleCount += CornerCount >= 3u ? CornerCount - 2u : 0u;
+					}
+				});
+			}
+		});
+
+		uint64_t VertexCount{ 0u }, TriangleCount{ 0u };
+
+		for (OBJChunk& Chunk: Chunks) {
+			Chunk.FirstVertex = VertexCount;
+			Chunk.FirstTriangle = TriangleCount;
+			VertexCount += Chunk.VertexCount;
+			TriangleCount += Chunk.TriangleCount;
+		}
+
+		if (VertexCount + Scene.MeshVertices.size() > 0xFFFFFFFFu || TriangleCount + Scene.MeshIndices.size() > BVHStuff::ReferenceIndexMask + 1u) {
+			Stats.ErrorMessage = "Too many vertices or triangles";
+			return false;
+		}
+
+		// Parsing, with every chunk writing its vertices and triangles straight into its own range of the scene's buffers.
+		const Mesh& NewMesh{ SceneStuff::ReserveMesh(( uint )VertexCount, ( uint )TriangleCount, MaterialIndex, Scene) };
+		const uint FirstVertex{ NewMesh.FirstVertex }, FirstTriangle{ NewMesh.FirstTriangle };
+		std::atomic<const char*> ErrorMessage{ nullptr };
+
+		ThreadPool.ParallelFor(( int64_t )Chunks.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				const OBJChunk& Chunk{ Chunks[i] };
+				uint64_t VertexIndex{ Chunk.FirstVertex }, TriangleIndex{ Chunk.FirstTriangle };
+
+				// OBJ indices count from 1, or back from the last vertex before their face when negative.
+				auto GetVertexIndex = [&](const char* Token, const char* TokenEnd) {
+					int64_t Index{ 0 };
+					const int64_t ResolvedIndex{ ParseInteger(Token, TokenEnd, Index) ? (Index < 0 ? ( int64_t )VertexIndex + Index : Index - 1) : -1 };
+
+					if (ResolvedIndex < 0 || ResolvedIndex >= ( int64_t )VertexCount) {
+						ErrorMessage = "Malformed OBJ face, or its index out of range";
+						return FirstVertex;
+					}
+
+					return FirstVertex + ( uint )ResolvedIndex;
+				};
+
+				ForEachLine(Chunk.Text, [&](const char* p, const char* LineEnd) {
+					if (StartsWithKeyword(p, LineEnd, "v")) {
+						float Coordinates[3]{};
+						p++;
+
+						for (float& Coordinate: Coordinates) {
+							SkipSpaces(p, LineEnd);
+
+							if (!ParseFloat(p, LineEnd, Coordinate)) {
+								ErrorMessage = "Malformed OBJ vertex";
+							}
+						}
+
+						Scene.MeshVertices[FirstVertex + VertexIndex++] = { Coordinates[0], Coordinates[1], Coordinates[2] };
+					} else if (StartsWithKeyword(p, LineEnd, "f")) {
+						const char* Token;
+						size_t TokenLength;
+						uint CornerCount{ 0u }, FirstCorner{ 0u }, PreviousCorner{ 0u };
+						p++;
+
+						// Split into a fan, of the first corner with every pair of consecutive ones after it.
+						while (ReadToken(p, LineEnd, Token, TokenLength)) {
+							const uint Corner{ GetVertexIndex(Token, Token + TokenLength) };
+
+							if (CornerCount == 0u) {
+								FirstCorner = Corner;
+							} else if (CornerCount >= 2u) {
+								Scene.MeshIndices[FirstTriangle + TriangleIndex++] = { FirstCorner, PreviousCorner, Corner };
+							}
+
+							PreviousCorner = Corner;
+							CornerCount++;
+						}
+					}
+				});
+			}
+		});
+
+		if (ErrorMessage.load() != nullptr) {
+			Stats.ErrorMessage = ErrorMessage.load();
+			return false;
+		}
+
+		CopyMeshKeyframes(Scene.Meshes.back(), Scene);
+		Stats.VertexCount = ( uint )VertexCount;
+		Stats.TriangleCount = ( uint )TriangleCount;
+		return true;
+	}
+
+	// Writes the vertices and triangles of a mesh to a binary little endian PLY or an OBJ file, with FirstVertex subtracted from every index, printing
+	// OBJ floats with enough digits to read back exactly.
+	inline bool ExportMesh(const char* FilePath, MeshFileFormat Format, const float3* pVertices, uint VertexCount, const uint3* pIndices, uint TriangleCount,
+		uint FirstVertex) {
+		FILE* pFile{ fopen(FilePath, "wb") };
+
+		if (pFile == nullptr) {
+			return false;
+		}
+
+		if (Format == MeshFileFormat::PLY) {
+			fprintf(pFile, "ply\nformat binary_little_endian 1.0\nelement vertex %u\nproperty float x\nproperty float y\nproperty float z\n", VertexCount);
+			fprintf(pFile, "element face %u\nproperty list uchar uint vertex_indices\nend_header\n", TriangleCount);
+			fwrite(pVertices, sizeof(float3), VertexCount, pFile);
+
+			for (uint i{ 0u }; i < TriangleCount; i++) {
+				const unsigned char CornerCount{ 3u };
+				const uint3 Indices{ pIndices[i].x - FirstVertex, pIndices[i].y - FirstVertex, pIndices[i].z - FirstVertex };
+				fwrite(&CornerCount, 1u, 1u, pFile);
+				fwrite(&Indices, sizeof(uint3), 1u, pFile);
+			}
+		} else {
+			for (uint i{ 0u }; i < VertexCount; i++) {
+				fprintf(pFile, "v %.9g %.9g %.9g\n", pVertices[i].x, pVertices[i].y, pVertices[i].z);
+			}
+
+			for (uint i{ 0u }; i < TriangleCount; i++) {
+				fprintf(pFile, "f %u %u %u\n", pIndices[i].x - FirstVertex + 1u, pIndices[i].y - FirstVertex + 1u, pIndices[i].z - FirstVertex + 1u);
+			}
+		}
+
+		return fclose(pFile) == 0;
+	}
+
+	// Scales and moves a static mesh so that its bounds are centered on Center, with their largest extent equal to Size, to frame an imported model.
+	inline void FitMesh(const Mesh& CurrentMesh, const float3& Center, float Size, SceneStuff::Scene& Scene) {
+		BVHStuff::BoundingBox Bounds{};
+
+		for (uint i{ CurrentMesh.FirstVertex }; i < CurrentMesh.FirstVertex + CurrentMesh.VertexCount; i++) {
+			Bounds.Grow(Scene.MeshVertices[i]);
+		}
+
+		const float3 Extent{ Bounds.GetExtent() };
+		const float Scale{ Size / std::max(std::max(std::max(Extent.x, Extent.y), Extent.z), 1e-20f) };
+		const float3 BoundsCenter{ Bounds.GetCentroid() };
+
+		for (uint i{ CurrentMesh.FirstVertex }; i < CurrentMesh.FirstVertex + CurrentMesh.VertexCount; i++) {
+			Scene.MeshVertices[i] = Center + (Scene.MeshVertices[i] - BoundsCenter) * Scale;
+		}
+
+		CopyMeshKeyframes(CurrentMesh, Scene);
+	}
+
+	// Maps a PLY or OBJ file, told apart by the PLY magic number, and appends its mesh to a scene, shaded with a given material.
+	// Returns false, with the scene as it was and Stats.ErrorMessage set, if the file cannot be read or holds no valid mesh.
+	inline bool ImportMesh(const char* FilePath, uint MaterialIndex, CPUStuff::ThreadPool& ThreadPool, SceneStuff::Scene& Scene, ImportStats& Stats) {
+		CPUStuff::Timer ImportTimer{};
+		CPUStuff::MappedFile File{};
+		Stats = {};
+
+		if (!File.Open(FilePath)) {
+			Stats.ErrorMessage = "Could not open or map the file";
+			return false;
+		}
+
+		const char* pData{ File.GetData() };
+		const char* End{ pData + File.GetSize() };
+		Stats.FileSizeInBytes = File.GetSize();
+		Stats.Format = File.GetSize() >= 4u && memcmp(pData, "ply", 3u) == 0 && (pData[3] == '\n' || pData[3] == '\r') ? MeshFileFormat::PLY :
+																														   MeshFileFormat::OBJ;
+
+		MeshReservation Reservation{ Scene };
+		const bool Succeeded{ Stats.Format == MeshFileFormat::PLY ? ImportPLY(pData, End, MaterialIndex, ThreadPool, Scene, Stats) :
+																	ImportOBJ(pData, End, MaterialIndex, ThreadPool, Scene, Stats) };
+
+		if (Succeeded && Stats.TriangleCount == 0u) {
+			Stats.ErrorMessage = "The file holds no triangles";
+		}
+
+		if (Stats.ErrorMessage != nullptr) {
+			Reservation.Rollback(Scene);
+		}
+
+		Stats.Seconds = ImportTimer.GetElapsedSeconds();
+		return Stats.ErrorMessage == nullptr;
+	}
+
+}
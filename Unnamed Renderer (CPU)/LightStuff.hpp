@@ -0,0 +1,638 @@
+// LightStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef LIGHT_STUFF
+	#define LIGHT_STUFF
+#endif
+
+#include "BVHStuff.hpp"
+#include "RectangleStuff.hpp"
+#include "SceneStuff.hpp"
+#include "TriangleStuff.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace LightStuff {
+
+	/*
+		LIGHT SAMPLING:
+			None - Paths only gather the light of the Diffuse Lights that their bounces happen to hit, as on the GPU.
+			NextEvent - Every Diffuse hit also samples a point on one of the Diffuse Light Spheres, Rectangles and Triangles, chosen by power, and
+				gathers its light unless a shadow path towards it is blocked. Hits on those lights after a Diffuse hit then add nothing, since
+				their light was already gathered. Mesh triangles and Instances are left to be hit, like every light under None.
+			MultipleImportance - Every Diffuse hit, and every Metallic hit with any fuzz, samples a light the same way, and hits on those lights after
+				such a hit are kept too. Each of the two estimates is weighted by the power heuristic of the densities that light sampling and the
+				hit's own scattering give its direction, so that each covers the lights that it samples best.
+			Reservoir - Like NextEvent, except that the first Diffuse hit of every camera path gathers the light of the point kept in its pixel's
+				LightReservoir, resampled from many candidates of its own and reused from the reservoirs of nearby pixels and of the previous
+				sample, and of the previous frame, while the shutter is closed.
+	*/
+	enum class LightSamplingType : uint { None, NextEvent, MultipleImportance, Reservoir };
+
+	inline const char* GetLightSamplingName(LightSamplingType Type) {
+		switch (Type) {
+			case LightSamplingType::None: {
+				return "none";
+			}
+			case LightSamplingType::NextEvent: {
+				return "nee";
+			}
+			case LightSamplingType::MultipleImportance: {
+				return "mis";
+			}
+			case LightSamplingType::Reservoir: {
+				return "restir";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Looks a light sampling type up by its name, returning false if there is none.
+	inline bool GetLightSamplingType(const char* Name, LightSamplingType& Type) {
+		const LightSamplingType LightSamplingTypes[]{ LightSamplingType::None, LightSamplingType::NextEvent, LightSamplingType::MultipleImportance,
+			LightSamplingType::Reservoir };
+
+		for (LightSamplingType CurrentType: LightSamplingTypes) {
+			if (strcmp(Name, GetLightSamplingName(CurrentType)) == 0) {
+				Type = CurrentType;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*
+		LIGHT SELECTION:
+			Power - Every hit picks a light with a probability proportional to its power, wherever the hit is.
+			Tree - Every hit walks down a light tree from its root, picking each node's left or right child with a probability proportional to the
+				importance of that child's lights to the hit: their power over their squared distance, and how far they could be facing it. Lights
+				that are near the hit, or that face it, are then picked more often than the far and the turned away, however many lights there are.
+	*/
+	enum class LightSelectionType : uint { Power, Tree };
+
+	inline const char* GetLightSelectionName(LightSelectionType Type) {
+		switch (Type) {
+			case LightSelectionType::Power: {
+				return "power";
+			}
+			case LightSelectionType::Tree: {
+				return "tree";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Looks a light selection type up by its name, returning false if there is none.
+	inline bool GetLightSelectionType(const char* Name, LightSelectionType& Type) {
+		for (LightSelectionType CurrentType: { LightSelectionType::Power, LightSelectionType::Tree }) {
+			if (strcmp(Name, GetLightSelectionName(CurrentType)) == 0) {
+				Type = CurrentType;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	constexpr uint NoLightIndex{ 0xFFFFFFFF };
+
+	/*
+		LIGHT TREE LAYOUT:
+			Nodes are stored depth-first, so an interior node's left child directly follows it, like BVHStuff's nodes.
+			LightCount == 0 - Interior node, RightChildOrLight is the index of its right child.
+			LightCount == 1 - Leaf node, RightChildOrLight is the index of its light in the LightList.
+			Every node bounds its lights' surfaces with a box, and their normals with a double cone of directions within acosf(CosTheta) of either
+			way along Axis, since the lights emit from both of their sides. A CosTheta of zero holds every direction.
+	*/
+	struct LightTreeNode {
+		float3 BoundsMin{ +FLT_MAX, +FLT_MAX, +FLT_MAX };
+		float3 BoundsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		float3 Axis{ 0.0f, 1.0f, 0.0f };
+		float CosTheta{ 1.0f };
+		float Power{ 0.0f };
+		uint RightChildOrLight{ 0u };
+		uint LightCount{ 0u };
+	};
+
+	// The Diffuse Lights of a frame that can be sampled, each one picked as its LightSelectionType describes.
+	struct LightList {
+		std::vector<uint> References{};// Packed like BVHStuff's references.
+		std::vector<float> Powers{};
+		std::vector<float> CumulativePowers{};// Running sum of Powers, ending at TotalPower.
+		float TotalPower{ 0.0f };
+		std::vector<uint> LightIndices[3]{};// Index of each Sphere, Rectangle and Triangle in the list, by PrimitiveId, or NoLightIndex.
+		LightSelectionType Selection{ LightSelectionType::Power };
+		std::vector<LightTreeNode> TreeNodes{};// Only built under the Tree selection.
+		std::vector<uint64_t> TreeBitTrails{};// Turns from the root to each light's leaf, bit i set where level i turns right.
+	};
+
+	// Average of a light's color channels, at the brightest of its keyframes and its current state, so that a light which only lights up
+	// within the shutter is still picked.
+	inline float GetLightRadiance(const Material& LightMaterial) {
+		const float3 Colors[3]{ LightMaterial.ColorStart, LightMaterial.ColorEnd, LightMaterial.Color };
+		float Radiance{ 0.0f };
+
+		for (const float3& Color: Colors) {
+			Radiance = std::max(Radiance, (Color.x + Color.y + Color.z) / 3.0f);
+		}
+
+		return Radiance;
+	}
+
+	// Power of a light at the scene's current state, its radiance times its area.
+	inline float GetLightPower(const Sphere& CurrentSphere, const Material& LightMaterial) {
+		return GetLightRadiance(LightMaterial) * 4.0f * ( float )M_PI * CurrentSphere.WSRadius * CurrentSphere.WSRadius;
+	}
+
+	inline float GetLightPower(const Rectangle& CurrentRectangle, const Material& LightMaterial) {
+		RectangleStuff::RectangleRecord Record;
+		RectangleStuff::CreateRectangleRecord(CurrentRectangle, Record);
+		return GetLightRadiance(LightMaterial) * RectangleStuff::GetRectangleArea(Record);
+	}
+
+	inline float GetLightPower(const Triangle& CurrentTriangle, const Material& LightMaterial) {
+		TriangleStuff::TriangleRecord Record;
+		TriangleStuff::CreateTriangleRecord(CurrentTriangle, Record);
+		return GetLightRadiance(LightMaterial) * TriangleStuff::GetTriangleArea(Record);
+	}
+
+	// Adds every primitive of a kind whose material is a Diffuse Light, and which emits any light, to a LightList.
+	template<typename PrimitiveType>
+	inline void AddLights(const CPUStuff::MappableVector<PrimitiveType>& Primitives, uint PrimitiveId, const SceneStuff::Scene& Scene, LightList& Lights) {
+		Lights.LightIndices[PrimitiveId].assign(Primitives.size(), NoLightIndex);
+
+		for (size_t i{ 0u }; i < Primitives.size(); i++) {
+			const Material& CurrentMaterial{ Scene.Materials[Primitives[i].MaterialIndex] };
+
+			if (CurrentMaterial.MaterialId != 5u) {
+				continue;
+			}
+
+			const float Power{ GetLightPower(Primitives[i], CurrentMaterial) };
+
+			if (Power > 0.0f && std::isfinite(Power)) {
+				Lights.LightIndices[PrimitiveId][i] = ( uint )Lights.References.size();
+				Lights.TotalPower += Power;
+				Lights.References.push_back(BVHStuff::CreateReference(PrimitiveId, ( uint )i));
+				Lights.Powers.push_back(Power);
+				Lights.CumulativePowers.push_back(Lights.TotalPower);
+			}
+		}
+	}
+
+	constexpr float OneMinusEpsilon{ 0x1.fffffep-1f };// Largest float below 1, for random values rescaled after each choice.
+
+	// Grows a double cone of normals, flipping the other cone's axis towards this one's first, to the smallest double cone that holds both.
+	inline void GrowNormalCone(float3& Axis, float& CosTheta, float3 OtherAxis, float OtherCosTheta) {
+		if (dot(Axis, OtherAxis) < 0.0f) {
+			OtherAxis = -OtherAxis;
+		}
+
+		// Whether either cone holds the other is found from the cosine of the sum of angles, since most growths while binning change nothing.
+		const float CosThetaBetween{ std::min(dot(Axis, OtherAxis), 1.0f) }, SinThetaBetween{ sqrtf(1.0f - CosThetaBetween * CosThetaBetween) };
+		const float SinTheta{ sqrtf(std::max(1.0f - CosTheta * CosTheta, 0.0f)) };
+		const float OtherSinTheta{ sqrtf(std::max(1.0f - OtherCosTheta * OtherCosTheta, 0.0f)) };
+
+		if (CosTheta <= 0.0f || CosThetaBetween * OtherCosTheta - SinThetaBetween * OtherSinTheta >= CosTheta) {
+			return;
+		}
+
+		if (OtherCosTheta <= 0.0f || CosThetaBetween * CosTheta - SinThetaBetween * SinTheta >= OtherCosTheta) {
+			Axis = OtherAxis;
+			CosTheta = OtherCosTheta;
+			return;
+		}
+
+		const float Theta{ acosf(std::min(CosTheta, 1.0f)) }, OtherTheta{ acosf(std::min(OtherCosTheta, 1.0f)) }, ThetaBetween{ acosf(CosThetaBetween) };
+
+		// Past a right angle either way, a double cone already holds every direction.
+		const float GrownTheta{ (Theta + ThetaBetween + OtherTheta) * 0.50f };
+		const float3 RotationAxis{ cross(Axis, OtherAxis) };
+		const float RotationAxisLength{ length(RotationAxis) };
+
+		if (GrownTheta >= ( float )M_PI_2 || !(RotationAxisLength > 0.0f)) {
+			CosTheta = 0.0f;
+			return;
+		}
+
+		// Turns the axis towards the other one, about their common perpendicular.
+		const float Rotation{ GrownTheta - Theta };
+		Axis = normalize(Axis * cosf(Rotation) + cross(RotationAxis / RotationAxisLength, Axis) * sinf(Rotation));
+		CosTheta = cosf(GrownTheta);
+	}
+
+	// Grows a node to hold another's lights, where an empty node (BoundsMin above BoundsMax) holds none.
+	inline void GrowLightTreeNode(LightTreeNode& Node, const LightTreeNode& Other) {
+		if (Other.BoundsMin.x > Other.BoundsMax.x) {
+			return;
+		}
+
+		if (Node.BoundsMin.x > Node.BoundsMax.x) {
+			Node.Axis = Other.Axis;
+			Node.CosTheta = Other.CosTheta;
+		} else {
+			GrowNormalCone(Node.Axis, Node.CosTheta, Other.Axis, Other.CosTheta);
+		}
+
+		BVHStuff::BoundingBox Bounds{ Node.BoundsMin, Node.BoundsMax };
+		Bounds.Grow(BVHStuff::BoundingBox{ Other.BoundsMin, Other.BoundsMax });
+		Node.BoundsMin = Bounds.Min;
+		Node.BoundsMax = Bounds.Max;
+		Node.Power += Other.Power;
+	}
+
+	// Leaf of a light in a LightList, bounding it at the scene's current state, or across a shutter while that is open. The normal cone of a light that
+	// turns within the shutter holds every direction, as does a Sphere's.
+	inline LightTreeNode CreateLightTreeLeaf(
+		const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, const LightList& Lights, uint LightIndex) {
+		const uint Index{ BVHStuff::GetReferenceIndex(Lights.References[LightIndex]) };
+		BVHStuff::BoundingBox Bounds{}, CloseBounds{};
+		float3 Axis{ 0.0f, 1.0f, 0.0f }, CloseAxis{ Axis };
+		float CosTheta{ 0.0f };
+
+		switch (BVHStuff::GetReferencePrimitiveId(Lights.References[LightIndex])) {
+			case 0: {
+				if (Shutter.IsOpen()) {
+					BVHStuff::GetSphereMotionBounds(Scene.Spheres[Index], Shutter, Bounds, CloseBounds);
+				} else {
+					Bounds = BVHStuff::GetSphereBounds(Scene.Spheres[Index]);
+				}
+
+				break;
+			}
+			case 1: {
+				Rectangle OpenKeyframe{ Scene.Rectangles[Index] }, CloseKeyframe{ OpenKeyframe };
+
+				if (Shutter.IsOpen()) {
+					SceneStuff::InterpolateRectangleGeometry(Shutter.Open, Scene.Rectangles[Index], OpenKeyframe);
+					SceneStuff::InterpolateRectangleGeometry(Shutter.Close, Scene.Rectangles[Index], CloseKeyframe);
+					BVHStuff::GetRectangleMotionBounds(Scene.Rectangles[Index], Shutter, Bounds, CloseBounds);
+				} else {
+					Bounds = BVHStuff::GetRectangleBounds(OpenKeyframe);
+				}
+
+				RectangleStuff::RectangleRecord OpenRecord, CloseRecord;
+				RectangleStuff::CreateRectangleRecord(OpenKeyframe, OpenRecord);
+				RectangleStuff::CreateRectangleRecord(CloseKeyframe, CloseRecord);
+				Axis = OpenRecord.Normal;
+				CloseAxis = CloseRecord.Normal;
+				CosTheta = 1.0f;
+
+				break;
+			}
+			default: {
+				Triangle OpenKeyframe{ Scene.Triangles[Index] }, CloseKeyframe{ OpenKeyframe };
+
+				if (Shutter.IsOpen()) {
+					SceneStuff::InterpolateTriangleGeometry(Shutter.Open, Scene.Triangles[Index], OpenKeyframe);
+					SceneStuff::InterpolateTriangleGeometry(Shutter.Close, Scene.Triangles[Index], CloseKeyframe);
+					BVHStuff::GetTriangleMotionBounds(Scene.Triangles[Index], Shutter, Bounds, CloseBounds);
+				} else {
+					Bounds = BVHStuff::GetTriangleBounds(OpenKeyframe);
+				}
+
+				TriangleStuff::TriangleRecord OpenRecord, CloseRecord;
+				TriangleStuff::CreateTriangleRecord(OpenKeyframe, OpenRecord);
+				TriangleStuff::CreateTriangleRecord(CloseKeyframe, CloseRecord);
+				Axis = OpenRecord.Normal;
+				CloseAxis = CloseRecord.Normal;
+				CosTheta = 1.0f;
+
+				break;
+			}
+		}
+
+		if (!(fabsf(dot(Axis, CloseAxis)) >= 1.0f - 1e-6f)) {
+			CosTheta = 0.0f;
+		}
+
+		Bounds.Grow(CloseBounds);
+		return LightTreeNode{ Bounds.Min, Bounds.Max, Axis, CosTheta, Lights.Powers[LightIndex], LightIndex, 1u };
+	}
+
+	// Solid angle of the directions that a double cone of normals could emit light into, each normal lighting its hemispheres with the cosine of
+	// their angle to it, as Conty Estevez and Kulla measure a node's orientation for the surface area orientation heuristic.
+	inline float GetOrientationMeasure(float CosTheta) {
+		const float Theta{ acosf(std::clamp(CosTheta, 0.0f, 1.0f)) };
+		const float EmissionTheta{ std::min(Theta + ( float )M_PI_2, ( float )M_PI) };
+		const float SinTheta{ sqrtf(std::max(1.0f - CosTheta * CosTheta, 0.0f)) };
+
+		return 2.0f * ( float )M_PI * (1.0f - CosTheta) +
+			( float )M_PI_2 * (2.0f * EmissionTheta * SinTheta - cosf(Theta - 2.0f * EmissionTheta) - 2.0f * Theta * SinTheta + CosTheta);
+	}
+
+	// Surface area orientation heuristic cost of a node, zero for an empty one.
+	inline float GetLightTreeNodeCost(const LightTreeNode& Node) {
+		return Node.Power * GetOrientationMeasure(Node.CosTheta) * BVHStuff::BoundingBox{ Node.BoundsMin, Node.BoundsMax }.GetSurfaceArea();
+	}
+
+	// Splits Leaves[Begin, End) in two with the binned surface area orientation heuristic, or at the median of the widest axis of their centroids
+	// past BVHStuff::MaxSAHDepth, and returns where the second half begins.
+	inline uint SplitLightTree(std::vector<LightTreeNode>& Leaves, uint Begin, uint End, uint Depth) {
+		auto GetLeafCentroid = [](const LightTreeNode& Leaf) {
+			return (Leaf.BoundsMin + Leaf.BoundsMax) * 0.50f;
+		};
+
+		BVHStuff::BoundingBox CentroidBounds{};
+
+		for (uint i{ Begin }; i < End; i++) {
+			CentroidBounds.Grow(GetLeafCentroid(Leaves[i]));
+		}
+
+		float BestCost{ FLT_MAX };
+		uint BestAxis{ 0u }, BestBin{ 0u };
+
+		for (uint Axis{ 0u }; Axis < 3u && Depth < BVHStuff::MaxSAHDepth; Axis++) {
+			if (!(BVHStuff::GetAxis(CentroidBounds.Max, Axis) > BVHStuff::GetAxis(CentroidBounds.Min, Axis))) {
+				continue;
+			}
+
+			LightTreeNode Bins[BVHStuff::SAHBinCount]{}, RightNodes[BVHStuff::SAHBinCount]{};
+
+			for (uint i{ Begin }; i < End; i++) {
+				GrowLightTreeNode(Bins[BVHStuff::GetBinIndex(GetLeafCentroid(Leaves[i]), Axis, CentroidBounds)], Leaves[i]);
+			}
+
+			for (uint Bin{ BVHStuff::SAHBinCount - 1u }; Bin > 0u; Bin--) {
+				RightNodes[Bin - 1u] = Bin < BVHStuff::SAHBinCount - 1u ? RightNodes[Bin] : LightTreeNode{};
+				GrowLightTreeNode(RightNodes[Bin - 1u], Bins[Bin]);
+			}
+
+			// RightNodes[Bin - 1] holds the bins from Bin on, for a split in front of Bin. A split behind an empty bin is the same as the one before it.
+			LightTreeNode LeftNode{};
+
+			for (uint Bin{ 1u }; Bin < BVHStuff::SAHBinCount; Bin++) {
+				GrowLightTreeNode(LeftNode, Bins[Bin - 1u]);
+
+				if (Bins[Bin - 1u].Power > 0.0f && RightNodes[Bin - 1u].Power > 0.0f) {
+					const float Cost{ GetLightTreeNodeCost(LeftNode) + GetLightTreeNodeCost(RightNodes[Bin - 1u]) };
+
+					if (Cost < BestCost) {
+						BestCost = Cost;
+						BestAxis = Axis;
+						BestBin = Bin;
+					}
+				}
+			}
+		}
+
+		if (BestCost < FLT_MAX) {
+			return ( uint )(std::partition(Leaves.begin() + Begin, Leaves.begin() + End, [&](const LightTreeNode& Leaf) {
+				return BVHStuff::GetBinIndex(GetLeafCentroid(Leaf), BestAxis, CentroidBounds) < BestBin;
+			}) - Leaves.begin());
+		}
+
+		const float3 Extent{ CentroidBounds.GetExtent() };
+		const uint Axis{ Extent.x >= Extent.y && Extent.x >= Extent.z ? 0u : (Extent.y >= Extent.z ? 1u : 2u) };
+		const uint Middle{ Begin + (End - Begin) / 2u };
+
+		std::nth_element(Leaves.begin() + Begin, Leaves.begin() + Middle, Leaves.begin() + End, [&](const LightTreeNode& A, const LightTreeNode& B) {
+			return BVHStuff::GetAxis(GetLeafCentroid(A), Axis) < BVHStuff::GetAxis(GetLeafCentroid(B), Axis);
+		});
+
+		return Middle;
+	}
+
+	// Appends the subtree of Leaves[Begin, End) to the LightList's tree, recording the turns down to each of its lights, and returns its root.
+	inline LightTreeNode BuildLightTreeNode(std::vector<LightTreeNode>& Leaves, uint Begin, uint End, uint Depth, uint64_t BitTrail, LightList& Lights) {
+		if (End - Begin == 1u) {
+			Lights.TreeNodes.push_back(Leaves[Begin]);
+			Lights.TreeBitTrails[Leaves[Begin].RightChildOrLight] = BitTrail;
+			return Leaves[Begin];
+		}
+
+		const uint Middle{ SplitLightTree(Leaves, Begin, End, Depth) };
+		const uint NodeIndex{ ( uint )Lights.TreeNodes.size() };
+		Lights.TreeNodes.emplace_back();
+
+		LightTreeNode Node{ BuildLightTreeNode(Leaves, Begin, Middle, Depth + 1u, BitTrail, Lights) };
+		const uint RightChild{ ( uint )Lights.TreeNodes.size() };
+		GrowLightTreeNode(Node, BuildLightTreeNode(Leaves, Middle, End, Depth + 1u, BitTrail | (1ull << Depth), Lights));
+		Node.RightChildOrLight = RightChild;
+		Node.LightCount = 0u;
+
+		Lights.TreeNodes[NodeIndex] = Node;
+		return Node;
+	}
+
+	// Builds the tree of a LightList's lights, at the scene's current state or across a shutter while that is open.
+	inline void BuildLightTree(const SceneStuff::Scene& Scene, const SceneStuff::ShutterInterval& Shutter, LightList& Lights) {
+		std::vector<LightTreeNode> Leaves(Lights.References.size());
+
+		for (uint i{ 0u }; i < ( uint )Leaves.size(); i++) {
+			Leaves[i] = CreateLightTreeLeaf(Scene, Shutter, Lights, i);
+		}
+
+		Lights.TreeNodes.reserve(Leaves.size() * 2u);
+		Lights.TreeBitTrails.assign(Leaves.size(), 0u);
+
+		if (!Leaves.empty()) {
+			BuildLightTreeNode(Leaves, 0u, ( uint )Leaves.size(), 0u, 0u, Lights);
+		}
+	}
+
+	// Importance of a node's lights to a point, their power over their squared distance, by the cosine of the smallest angle between their normals
+	// and the direction to the point that the node's cone and bounds allow, after Conty Estevez and Kulla. Unlike theirs, it leaves out the point's
+	// own orientation, so that the probability of picking a light from where a path started can be found again from the path's hit. Never zero for a
+	// node of any power, since the cone is double and the padded bounds have some size.
+	inline float GetLightTreeImportance(const LightTreeNode& Node, const float3& WSPoint) {
+		const float3 HalfExtent{ (Node.BoundsMax - Node.BoundsMin) * 0.50f };
+		const float3 ToPoint{ WSPoint - (Node.BoundsMin + HalfExtent) };
+		const float DistanceSquared{ dot(ToPoint, ToPoint) }, RadiusSquared{ dot(HalfExtent, HalfExtent) };
+
+		if (Node.CosTheta <= 0.0f || DistanceSquared <= RadiusSquared) {
+			return Node.Power / std::max(DistanceSquared, RadiusSquared);
+		}
+
+		// Angle between the cone's axis and the direction to the point, less the cone's own angle, then less the angle that the bounds span.
+		const float CosThetaW{ std::min(fabsf(dot(Node.Axis, ToPoint)) / sqrtf(DistanceSquared), 1.0f) };
+		const float SinThetaW{ sqrtf(std::max(1.0f - CosThetaW * CosThetaW, 0.0f)) };
+		const float SinTheta{ sqrtf(std::max(1.0f - Node.CosTheta * Node.CosTheta, 0.0f)) };
+		const float CosThetaX{ CosThetaW >= Node.CosTheta ? 1.0f : CosThetaW * Node.CosTheta + SinThetaW * SinTheta };
+		const float SinThetaX{ CosThetaW >= Node.CosTheta ? 0.0f : SinThetaW * Node.CosTheta - CosThetaW * SinTheta };
+		const float SinThetaBSquared{ RadiusSquared / DistanceSquared };
+		const float CosThetaB{ sqrtf(1.0f - SinThetaBSquared) }, SinThetaB{ sqrtf(SinThetaBSquared) };
+		const float CosThetaPrime{ CosThetaX >= CosThetaB ? 1.0f : CosThetaX * CosThetaB + SinThetaX * SinThetaB };
+
+		return Node.Power * std::max(CosThetaPrime, 0.0f) / DistanceSquared;
+	}
+
+	// Probability of an interior node's left child, from the importance of both of its children to a point, or a negative value if neither has any.
+	inline float GetLeftChildProbability(const LightList& Lights, uint NodeIndex, const float3& WSPoint) {
+		const float LeftImportance{ GetLightTreeImportance(Lights.TreeNodes[NodeIndex + 1u], WSPoint) };
+		const float RightImportance{ GetLightTreeImportance(Lights.TreeNodes[Lights.TreeNodes[NodeIndex].RightChildOrLight], WSPoint) };
+		const float Importance{ LeftImportance + RightImportance };
+
+		return Importance > 0.0f && std::isfinite(Importance) ? LeftImportance / Importance : -1.0f;
+	}
+
+	// Picks a light of a non-empty LightList's tree for a point with a uniform value in [0, 1), along with the probability that it was picked with,
+	// or returns NoLightIndex if no light has any importance to the point.
+	inline uint SelectLightFromTree(const LightList& Lights, const float3& WSPoint, float RandomValue, float& SelectionProbability) {
+		uint NodeIndex{ 0u };
+		SelectionProbability = 1.0f;
+
+		while (Lights.TreeNodes[NodeIndex].LightCount == 0u) {
+			const float LeftProbability{ GetLeftChildProbability(Lights, NodeIndex, WSPoint) };
+
+			if (LeftProbability < 0.0f) {
+				return NoLightIndex;
+			}
+
+			// The value is rescaled to [0, 1) within the chosen child's share, for the next level to choose with.
+			if (RandomValue < LeftProbability) {
+				RandomValue = std::min(RandomValue / LeftProbability, OneMinusEpsilon);
+				SelectionProbability *= LeftProbability;
+				NodeIndex++;
+			} else {
+				RandomValue = std::min((RandomValue - LeftProbability) / (1.0f - LeftProbability), OneMinusEpsilon);
+				SelectionProbability *= 1.0f - LeftProbability;
+				NodeIndex = Lights.TreeNodes[NodeIndex].RightChildOrLight;
+			}
+		}
+
+		return Lights.TreeNodes[NodeIndex].RightChildOrLight;
+	}
+
+	// Probability that SelectLightFromTree() picks a light of the list for a point, following its bit trail down the tree.
+	inline float GetTreeSelectionProbability(const LightList& Lights, const float3& WSPoint, uint LightIndex) {
+		const uint64_t BitTrail{ Lights.TreeBitTrails[LightIndex] };
+		float SelectionProbability{ 1.0f };
+
+		for (uint NodeIndex{ 0u }, Depth{ 0u }; Lights.TreeNodes[NodeIndex].LightCount == 0u; Depth++) {
+			const float LeftProbability{ GetLeftChildProbability(Lights, NodeIndex, WSPoint) };
+
+			if (LeftProbability < 0.0f) {
+				return 0.0f;
+			}
+
+			if (((BitTrail >> Depth) & 1u) == 0u) {
+				SelectionProbability *= LeftProbability;
+				NodeIndex++;
+			} else {
+				SelectionProbability *= 1.0f - LeftProbability;
+				NodeIndex = Lights.TreeNodes[NodeIndex].RightChildOrLight;
+			}
+		}
+
+		return SelectionProbability;
+	}
+
+	// Gathers the Diffuse Light Spheres, Rectangles and Triangles of the scene's current state into a LightList, and builds their tree under the
+	// Tree selection, bounding them across the shutter while that is open.
+	inline void BuildLightList(const SceneStuff::Scene& Scene, LightSelectionType Selection, const SceneStuff::ShutterInterval& Shutter, LightList& Lights) {
+		Lights.References.clear();
+		Lights.Powers.clear();
+		Lights.CumulativePowers.clear();
+		Lights.TotalPower = 0.0f;
+		Lights.Selection = Selection;
+		Lights.TreeNodes.clear();
+		Lights.TreeBitTrails.clear();
+
+		AddLights(Scene.Spheres, 0u, Scene, Lights);
+		AddLights(Scene.Rectangles, 1u, Scene, Lights);
+		AddLights(Scene.Triangles, 2u, Scene, Lights);
+
+		if (Selection == LightSelectionType::Tree) {
+			BuildLightTree(Scene, Shutter, Lights);
+		}
+	}
+
+	// Picks a light of a non-empty LightList by power with a uniform value in [0, 1), along with the probability that it was picked with.
+	inline uint SelectLightByPower(const LightList& Lights, float RandomValue, float& SelectionProbability) {
+		const uint LightCount{ ( uint )Lights.References.size() };
+		uint LightIndex{ ( uint )(std::upper_bound(Lights.CumulativePowers.begin(), Lights.CumulativePowers.end(), RandomValue * Lights.TotalPower) -
+			Lights.CumulativePowers.begin()) };
+
+		LightIndex = std::min(LightIndex, LightCount - 1u);
+		SelectionProbability = Lights.Powers[LightIndex] / Lights.TotalPower;
+
+		return LightIndex;
+	}
+
+	// Picks a light of a non-empty LightList for a point, as its selection describes, or returns NoLightIndex if it could pick none.
+	inline uint SelectLight(const LightList& Lights, const float3& WSPoint, float RandomValue, float& SelectionProbability) {
+		if (Lights.Selection == LightSelectionType::Tree) {
+			return SelectLightFromTree(Lights, WSPoint, RandomValue, SelectionProbability);
+		}
+
+		return SelectLightByPower(Lights, RandomValue, SelectionProbability);
+	}
+
+	// Index in the list of a Sphere (0), Rectangle (1) or Triangle (2), NoLightIndex if it is not in it.
+	inline uint GetLightIndex(const LightList& Lights, uint PrimitiveId, uint Index) {
+		return PrimitiveId <= 2u && Index < Lights.LightIndices[PrimitiveId].size() ? Lights.LightIndices[PrimitiveId][Index] : NoLightIndex;
+	}
+
+	// Probability that SelectLight() picks a given Sphere (0), Rectangle (1) or Triangle (2) for a point, zero if it is not in the list.
+	inline float GetSelectionProbability(const LightList& Lights, const float3& WSPoint, uint PrimitiveId, uint Index) {
+		const uint LightIndex{ GetLightIndex(Lights, PrimitiveId, Index) };
+
+		if (LightIndex == NoLightIndex) {
+			return 0.0f;
+		}
+
+		if (Lights.Selection == LightSelectionType::Tree) {
+			return GetTreeSelectionProbability(Lights, WSPoint, LightIndex);
+		}
+
+		return Lights.Powers[LightIndex] / Lights.TotalPower;
+	}
+
+	constexpr uint NoLightReference{ 0xFFFFFFFF };
+
+	// A point on a light kept by weighted reservoir sampling, out of a stream of candidates each weighted by its target density over the
+	// density it was sampled with. The point is kept as its light's packed reference and its coordinates on the light, which are sampled
+	// uniformly by area, so that it maps to the same place on the light for any shading point, and follows the light from frame to frame.
+	struct LightReservoir {
+		uint Reference{ NoLightReference };
+		float2 Coordinates{};
+		float WeightSum{ 0.0f };
+		float SampleCount{ 0.0f };// Candidates that the reservoir stands for, M.
+		float ContributionWeight{ 0.0f };// Estimate of the reciprocal of the density that the point was kept with, W.
+	};
+
+	// First hit of a pixel's camera path that its LightReservoir was resampled for, which reservoirs reused from elsewhere are weighed against.
+	struct ReservoirSurface {
+		float3 WSPoint{};
+		float3 WSNormal{};
+		float WStDistance{ 0.0f };
+		uint IsValid{ 0u };// Whether the hit is Diffuse, and gathers the light of its pixel's reservoir.
+	};
+
+	// Streams a candidate that stands for SampleCount candidates into a reservoir, keeping it with probability Weight / WeightSum for a
+	// uniform value in [0, 1). Returns whether it was kept.
+	inline bool UpdateReservoir(LightReservoir& Reservoir, uint Reference, float2 Coordinates, float Weight, float SampleCount, float RandomValue) {
+		Reservoir.WeightSum += Weight;
+		Reservoir.SampleCount += SampleCount;
+
+		if (!(Weight > 0.0f) || !(RandomValue * Reservoir.WeightSum < Weight)) {
+			return false;
+		}
+
+		Reservoir.Reference = Reference;
+		Reservoir.Coordinates = Coordinates;
+		return true;
+	}
+
+	inline uint64_t GetLightListSizeInBytes(const LightList& Lights) {
+		uint64_t SizeInBytes{ Lights.References.capacity() * sizeof(uint) + (Lights.Powers.capacity() + Lights.CumulativePowers.capacity()) * sizeof(float) };
+
+		SizeInBytes += Lights.TreeNodes.capacity() * sizeof(LightTreeNode) + Lights.TreeBitTrails.capacity() * sizeof(uint64_t);
+
+		for (const std::vector<uint>& LightIndices: Lights.LightIndices) {
+			SizeInBytes += LightIndices.capacity() * sizeof(uint);
+		}
+
+		return SizeInBytes;
+	}
+
+}
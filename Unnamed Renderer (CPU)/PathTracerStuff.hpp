@@ -0,0 +1,2849 @@
+// PathTracerStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef PATH_TRACER_STUFF
+	#define PATH_TRACER_STUFF
+#endif
+
+#include "BVHStuff.hpp"
+#include "LightStuff.hpp"
+#include "RectangleStuff.hpp"
+#include "SIMDStuff.hpp"
+#include "SamplerStuff.hpp"
+#include "SceneStuff.hpp"
+#include "TriangleStuff.hpp"
+
+/*
+	COORDINATE SPACES:
+		TS - Thread-Space
+		PS - Pixel-Space
+		WS - World-Space
+*/
+
+// Represents a Path, besides the tMin/tMax values.
+struct Path {
+	float3 WSOrigin;
+	float3 WSDirection;
+	float Time;// Interpolation step that the Path is traced at, which only differs between Paths while the shutter is open.
+};
+
+// Represents the Light Energy being carried by a given Path.
+// 0.0f <= (r, g, b) <= +1.0f
+struct PathPayload {
+	float r, g, b;
+};
+
+// MaterialIndex of the Sky, which has no entry in the material table.
+constexpr uint NoMaterialIndex{ 0xFFFFFFFFu };
+
+// Represents an Intersection between a Path and a Scene Object.
+struct IntersectionRecord {
+	float WStDistance;// World-space distance between path origin and intersection point.
+	float3 WSIntersectionPoint;// World-space coordinates of the intersection.
+	float3 WSIncomingPathDirection;// World-space direction of the intersecting path.
+	uint PrimitiveId;// Identifier for which type of primitive it is.
+	uint ObjectId;// Unique identifier of the intersected primitive.
+	uint MaterialIndex;// Entry of the intersected primitive's material in the material table, or NoMaterialIndex for the Sky.
+	uint MaterialId;// Material identifier of the intersected primitive's material.
+	uint CurrentRecursionDepth;// Current path-depth.
+	float Time;// Interpolation step of the intersecting path.
+	uint PrototypeTriangleIndex;// Triangle of its prototype that an intersected Instance was hit on.
+};
+
+namespace PathTracerStuff {
+
+	// Host-side equivalents of the Global Pipeline Resources that the three Compute Shaders bind.
+	struct PipelineResources {
+		const Sphere* Spheres{ nullptr };
+		const Rectangle* Rectangles{ nullptr };
+		const Triangle* Triangles{ nullptr };
+		const Mesh* Meshes{ nullptr };
+		const uint3* MeshIndices{ nullptr };
+		const float3* MeshVertices{ nullptr };
+		const float3* MeshVerticesStart{ nullptr };// Null while every mesh is static.
+		const float3* MeshVerticesEnd{ nullptr };
+		uint MeshCount{ 0u };
+		uint MeshTriangleCount{ 0u };
+		const Instance* Instances{ nullptr };
+		const Material* Materials{ nullptr };// Shared by every kind of primitive, which refer to them by MaterialIndex.
+		const uint3* PrototypeIndices{ nullptr };
+		const float3* PrototypeVertices{ nullptr };
+		uint InstanceCount{ 0u };
+		// Every Instance is traced through the tree of its prototype, whatever the acceleration structure.
+		const BVHStuff::BVHNode* PrototypeBVHNodes{ nullptr };
+		const uint* PrototypeBVHReferences{ nullptr };
+		const uint* PrototypeBVHRootNodes{ nullptr };
+		float4* IntersectionMap01{ nullptr };
+		float4* IntersectionMap02{ nullptr };
+		uint4* IntersectionMap03{ nullptr };
+		float4* IntersectionMap04{ nullptr };// Light gathered from the Lights at each hit, and the weight of the Payload behind it, only while they are set.
+		float4* AccumulationFrame{ nullptr };
+		CPUStuff::R8G8B8A8Uint* FinalFrame{ nullptr };
+		InlineRootConstants RootConstants{};
+		SamplerStuff::Sampler Sampler{};
+		const BVHStuff::BVHNode* BVHNodes{ nullptr };// When null, every path is tested against every primitive.
+		const uint* BVHReferences{ nullptr };
+		const BVHStuff::MotionBVHNode* MotionBVHNodes{ nullptr };// Walked instead of BVHNodes while the shutter is open.
+		SceneStuff::ShutterInterval Shutter{};// While open, each camera path is traced at its own time within it.
+		const SIMDStuff::PackedSpheres* PackedSpheres{ nullptr };// When set, the brute-force search tests the Spheres with FindClosestSphere.
+		SIMDStuff::FindClosestSphereFunction FindClosestSphere{ nullptr };
+		SIMDStuff::IntersectRayPacketFunction IntersectRayPacket{ nullptr };// Tests packets of camera paths against the BVHNodes.
+		const RectangleStuff::RectangleRecord* RectangleRecords{ nullptr };// When null, each Rectangle's record is derived whenever it is tested.
+		const TriangleStuff::TriangleRecord* TriangleRecords{ nullptr };// When null, each Triangle's record is derived whenever it is tested.
+		TriangleStuff::TriangleIntersector TriangleIntersector{ TriangleStuff::TriangleIntersector::Watertight };
+		const LightStuff::LightList* Lights{ nullptr };// When set, hits sample these lights explicitly, as LightSampling describes.
+		LightStuff::LightSamplingType LightSampling{ LightStuff::LightSamplingType::None };
+		LightStuff::LightReservoir* Reservoirs{ nullptr };// When set, the first Diffuse hit of each camera path gathers light from its pixel's reservoir.
+		LightStuff::LightReservoir* TemporalReservoirs{ nullptr };
+		LightStuff::ReservoirSurface* ReservoirSurfaces{ nullptr };
+		uint ReservoirFrameIndex{ 0u };// Frames rendered with the reservoirs so far, so that each frame resamples them with other random values.
+	};
+
+	// Linear index of a texel within a resource that is laid out like a RWTexture3D of TSGridDimensions.xy.
+	inline size_t GetTexelIndex(const PipelineResources& Resources, uint x, uint y, uint z) {
+		return (( size_t )z * Resources.RootConstants.TSGridDimensions.y + y) * Resources.RootConstants.TSGridDimensions.x + x;
+	}
+
+	/*
+		RANDOM DIMENSIONS:
+			Every random value is fetched from the sampler by (pixel, sample index, dimension) when it is needed, so no random state is stored.
+			Each bounce starts on a multiple of four, so that the Sobol samplers stratify its scattering dimensions together.
+			0, 1 - Pixel offset of the camera path.
+			2 - Time of the camera path within the shutter interval.
+			4 + (Depth * 8) + 0, 1, 2 - Scattering direction at a path-depth.
+			4 + (Depth * 8) + 3 - Reflection/refraction choice at a path-depth.
+			4 + (Depth * 8) + 4 - Russian roulette decision at a path-depth.
+			4 + (Depth * 8) + 5, 6 - Point sampled on a light at a path-depth.
+			4 + (Depth * 8) + 7 - Light chosen at a path-depth.
+			Past the last path-depth, the reservoir passes take DimensionsPerReservoirPass dimensions for each frame, from GetReservoirDimension().
+	*/
+	constexpr uint PixelOffsetDimension{ 0u };
+	constexpr uint ShutterTimeDimension{ 2u };
+	constexpr uint FirstBounceDimension{ 4u };
+	constexpr uint DimensionsPerBounce{ 8u };
+
+	// Acquires a uniformly distributed value in [0, 1) for the current thread's pixel and sample, in a given dimension.
+	inline float GetRandomFloat(const PipelineResources& Resources, uint2 GridThreadId, uint Dimension) {
+		return SamplerStuff::GetSample(
+			Resources.Sampler, GridThreadId, Resources.RootConstants.CurrentSampleIndex, Resources.RootConstants.SamplesPerPixel, Dimension);
+	}
+
+	// First dimension of the random values consumed by a bounce at a given path-depth.
+	inline uint GetBounceDimension(uint CurrentRecursionDepth) {
+		return FirstBounceDimension + CurrentRecursionDepth * DimensionsPerBounce;
+	}
+
+	// Acquires a random vector with components in [-1, +1), for scattering a Path at a given path-depth.
+	inline float3 GetRandomDirection(const PipelineResources& Resources, uint2 GridThreadId, uint CurrentRecursionDepth) {
+		uint Dimension{ GetBounceDimension(CurrentRecursionDepth) };
+		float3 RandomDirection{ GetRandomFloat(Resources, GridThreadId, Dimension), GetRandomFloat(Resources, GridThreadId, Dimension + 1u),
+			GetRandomFloat(Resources, GridThreadId, Dimension + 2u) };
+
+		return RandomDirection * 2.0f - float3{ 1.0f, 1.0f, 1.0f };
+	}
+
+	// Acquires a uniformly distributed value in [0, 1) for the Russian roulette decision at a given path-depth.
+	inline float GetRussianRouletteChance(const PipelineResources& Resources, uint2 GridThreadId, uint CurrentRecursionDepth) {
+		return GetRandomFloat(Resources, GridThreadId, GetBounceDimension(CurrentRecursionDepth) + 4u);
+	}
+
+	// Acquires a random offset value for random distributed multi-sampling.
+	inline void GetRandomOffsetIntoPixel(const PipelineResources& Resources, uint2 GridThreadId, float2& RandomOffset) {
+		RandomOffset.x = GetRandomFloat(Resources, GridThreadId, PixelOffsetDimension);
+		RandomOffset.y = GetRandomFloat(Resources, GridThreadId, PixelOffsetDimension + 1u);
+	}
+
+	// Acquires the time that the current thread's camera path, and every path that it scatters into, is traced at.
+	// While the shutter is closed, the scene is only ever seen at its current state, so the time is unused.
+	inline float GetPathTime(const PipelineResources& Resources, uint2 GridThreadId) {
+		if (!Resources.Shutter.IsOpen()) {
+			return Resources.Shutter.Open;
+		}
+
+		return LinearInterpolation(GetRandomFloat(Resources, GridThreadId, ShutterTimeDimension), Resources.Shutter.Open, Resources.Shutter.Close);
+	}
+
+	// Where a given time lies within the shutter interval, from 0 at its open to 1 at its close.
+	inline float GetShutterFraction(const PipelineResources& Resources, float Time) {
+		if (!Resources.Shutter.IsOpen()) {
+			return 0.0f;
+		}
+
+		return std::min(std::max((Time - Resources.Shutter.Open) / (Resources.Shutter.Close - Resources.Shutter.Open), 0.0f), 1.0f);
+	}
+
+	// A primitive's geometry as it is at a given time. While the shutter is closed that is the primitive itself, otherwise its geometry is
+	// interpolated between its keyframes into Moving, and nothing else of Moving is set.
+	inline const Sphere& GetSphere(const PipelineResources& Resources, uint Index, float Time, Sphere& Moving) {
+		if (!Resources.Shutter.IsOpen()) {
+			return Resources.Spheres[Index];
+		}
+
+		SceneStuff::InterpolateSphereGeometry(Time, Resources.Spheres[Index], Moving);
+		return Moving;
+	}
+
+	inline const Rectangle& GetRectangle(const PipelineResources& Resources, uint Index, float Time, Rectangle& Moving) {
+		if (!Resources.Shutter.IsOpen()) {
+			return Resources.Rectangles[Index];
+		}
+
+		SceneStuff::InterpolateRectangleGeometry(Time, Resources.Rectangles[Index], Moving);
+		return Moving;
+	}
+
+	inline const Triangle& GetTriangle(const PipelineResources& Resources, uint Index, float Time, Triangle& Moving) {
+		if (!Resources.Shutter.IsOpen()) {
+			return Resources.Triangles[Index];
+		}
+
+		SceneStuff::InterpolateTriangleGeometry(Time, Resources.Triangles[Index], Moving);
+		return Moving;
+	}
+
+	// The vertices of a mesh triangle as they are at a given time.
+	inline void GetMeshTriangle(const PipelineResources& Resources, uint Index, float Time, float3& V1, float3& V2, float3& V3) {
+		const uint3& Indices{ Resources.MeshIndices[Index] };
+
+		if (!Resources.Shutter.IsOpen() || Resources.MeshVerticesStart == nullptr) {
+			V1 = Resources.MeshVertices[Indices.x];
+			V2 = Resources.MeshVertices[Indices.y];
+			V3 = Resources.MeshVertices[Indices.z];
+			return;
+		}
+
+		V1 = LinearInterpolation(Time, Resources.MeshVerticesStart[Indices.x], Resources.MeshVerticesEnd[Indices.x]);
+		V2 = LinearInterpolation(Time, Resources.MeshVerticesStart[Indices.y], Resources.MeshVerticesEnd[Indices.y]);
+		V3 = LinearInterpolation(Time, Resources.MeshVerticesStart[Indices.z], Resources.MeshVerticesEnd[Indices.z]);
+	}
+
+	// The object-space vertices of a prototype triangle.
+	inline void GetPrototypeTriangle(const PipelineResources& Resources, uint Index, float3& V1, float3& V2, float3& V3) {
+		const uint3& Indices{ Resources.PrototypeIndices[Index] };
+		V1 = Resources.PrototypeVertices[Indices.x];
+		V2 = Resources.PrototypeVertices[Indices.y];
+		V3 = Resources.PrototypeVertices[Indices.z];
+	}
+
+	inline const Mesh& GetMesh(const PipelineResources& Resources, uint TriangleIndex) {
+		return Resources.Meshes[SceneStuff::GetMeshIndex(Resources.Meshes, Resources.MeshCount, TriangleIndex)];
+	}
+
+	// A Rectangle's record as it is at a given time, which is its precomputed one while the shutter is closed, otherwise derived into Moving.
+	inline const RectangleStuff::RectangleRecord& GetRectangleRecord(
+		const PipelineResources& Resources, uint Index, float Time, RectangleStuff::RectangleRecord& Moving) {
+		if (Resources.RectangleRecords != nullptr) {
+			return Resources.RectangleRecords[Index];
+		}
+
+		Rectangle MovingRectangle;
+		RectangleStuff::CreateRectangleRecord(GetRectangle(Resources, Index, Time, MovingRectangle), Moving);
+		return Moving;
+	}
+
+	// A Triangle's record as it is at a given time, which is its precomputed one while the shutter is closed, otherwise derived into Moving.
+	inline const TriangleStuff::TriangleRecord& GetTriangleRecord(
+		const PipelineResources& Resources, uint Index, float Time, TriangleStuff::TriangleRecord& Moving) {
+		if (Resources.TriangleRecords != nullptr) {
+			return Resources.TriangleRecords[Index];
+		}
+
+		Triangle MovingTriangle;
+		TriangleStuff::CreateTriangleRecord(GetTriangle(Resources, Index, Time, MovingTriangle), Moving);
+		return Moving;
+	}
+
+	// Calculates normalized thread-space coordinates with randomized pixel-offset enabled.
+	// 0.0f <= (x,y) <= +1.0f
+	inline void GetNormalizedTSCoords(const PipelineResources& Resources, uint2 GridThreadId, float2 RandomOffset, float2& NormalizedTSCoord) {
+		float2 ThreadId{ ( float )GridThreadId.x + RandomOffset.x, ( float )GridThreadId.y + RandomOffset.y };
+		float2 ThreadDims{ ( float )Resources.RootConstants.TSGridDimensions.x, ( float )Resources.RootConstants.TSGridDimensions.y };
+
+		NormalizedTSCoord.x = ThreadId.x / ThreadDims.x;
+		NormalizedTSCoord.y = (ThreadDims.y - ThreadId.y) / ThreadDims.y;
+	}
+
+	// Calculates the world-space coordinates of current thread's camera path origin.
+	inline void GetWSCamPathOrigin(const PipelineResources& Resources, float2 NormalizedTSCoords, float3& WSCamPathOrigin) {
+		const InlineRootConstants& RootConstants{ Resources.RootConstants };
+
+		WSCamPathOrigin.x = NormalizedTSCoords.x * RootConstants.WSViewPortDimensions.x - (RootConstants.WSViewPortDimensions.x / 2.0f);
+		WSCamPathOrigin.y = NormalizedTSCoords.y * RootConstants.WSViewPortDimensions.y - (RootConstants.WSViewPortDimensions.y / 2.0f);
+		WSCamPathOrigin.z = RootConstants.WSViewPortZCoord;
+	}
+
+	// Calculates the world-space components of the current thread's camera path direction.
+	inline void GetWSCamPathDirection(const PipelineResources& Resources, float3 WSCamPathOrigin, float3& WSCamPathDirection) {
+		WSCamPathDirection = normalize(WSCamPathOrigin - Resources.RootConstants.WSCameraFocalOrigin);
+	}
+
+	// Generates the camera path of the current thread's pixel for the current sample.
+	inline void CreateCameraPath(const PipelineResources& Resources, uint2 GridThreadId, Path& CameraPath) {
+		float2 RandomPixelOffset;
+		GetRandomOffsetIntoPixel(Resources, GridThreadId, RandomPixelOffset);
+
+		float2 NormalizedTSCoords;
+		GetNormalizedTSCoords(Resources, GridThreadId, RandomPixelOffset, NormalizedTSCoords);
+
+		float3 WSCamPathOrigin;
+		GetWSCamPathOrigin(Resources, NormalizedTSCoords, WSCamPathOrigin);
+
+		float3 WSCamPathDirection;
+		GetWSCamPathDirection(Resources, WSCamPathOrigin, WSCamPathDirection);
+
+		CameraPath.WSOrigin = WSCamPathOrigin;
+		CameraPath.WSDirection = WSCamPathDirection;
+		CameraPath.Time = GetPathTime(Resources, GridThreadId);
+	}
+
+	// Distance along a given Path to a Sphere, valid if the Path hits it past PathMinDistance.
+	inline bool IntersectSphere(const PipelineResources& Resources, const Sphere& CurrentSphere, const Path& CurrentPath, float& t) {
+		float a = dot(CurrentPath.WSDirection, CurrentPath.WSDirection);
+		float b = 2.0f * dot(CurrentPath.WSDirection, (CurrentPath.WSOrigin - CurrentSphere.WSOrigin));
+		float c = dot((CurrentPath.WSOrigin - CurrentSphere.WSOrigin), (CurrentPath.WSOrigin - CurrentSphere.WSOrigin)) -
+			(CurrentSphere.WSRadius * CurrentSphere.WSRadius);
+		float Discriminant = (b * b) - 4.0f * a * c;
+
+		if (Discriminant >= 0.0f) {
+			float xPos, xNeg;
+
+			xPos = ((-1.0f * b) + sqrtf(Discriminant)) / (2.0f * a);
+			xNeg = ((-1.0f * b) - sqrtf(Discriminant)) / (2.0f * a);
+
+			// Only the nearer root is considered, so a Path that starts inside a Sphere past PathMinDistance of its surface misses it.
+			t = (xPos <= xNeg) ? xPos : xNeg;
+
+			return t > Resources.RootConstants.PathMinDistance;
+		}
+
+		return false;
+	}
+
+	// Distance along a given Path to a Rectangle, valid if the Path hits it at or past PathMinDistance.
+	inline bool IntersectRectangle(const PipelineResources& Resources, const RectangleStuff::RectangleRecord& Record, const Path& CurrentPath, float& t) {
+		return RectangleStuff::IntersectRectangle(Record, CurrentPath.WSOrigin, CurrentPath.WSDirection, Resources.RootConstants.PathMinDistance, t);
+	}
+
+	// Distance along a given Path to a Triangle, valid if the Path hits either of its faces at or past PathMinDistance.
+	inline bool IntersectTriangle(const PipelineResources& Resources, const TriangleStuff::TriangleRecord& Record, const Path& CurrentPath, float& t) {
+		return TriangleStuff::IntersectTriangle(
+			Resources.TriangleIntersector, Record, CurrentPath.WSOrigin, CurrentPath.WSDirection, Resources.RootConstants.PathMinDistance, t);
+	}
+
+	// Distance along a given Path to a mesh triangle, valid if the Path hits either of its faces at or past PathMinDistance.
+	// The watertight test runs straight off the vertex buffer, while the legacy test needs the normal and plane derived first.
+	inline bool IntersectTriangleVertices(const PipelineResources& Resources, const float3& V1, const float3& V2, const float3& V3, const Path& CurrentPath,
+		float& t) {
+		if (Resources.TriangleIntersector == TriangleStuff::TriangleIntersector::Watertight) {
+			return TriangleStuff::IntersectTriangleWatertight(
+				V1, V2, V3, CurrentPath.WSOrigin, CurrentPath.WSDirection, Resources.RootConstants.PathMinDistance, t);
+		}
+
+		TriangleStuff::TriangleRecord Record;
+		TriangleStuff::CreateTriangleRecord(V1, V2, V3, Record);
+		return IntersectTriangle(Resources, Record, CurrentPath, t);
+	}
+
+	inline bool IntersectMeshTriangle(const PipelineResources& Resources, uint Index, const Path& CurrentPath, float& t) {
+		float3 V1, V2, V3;
+		GetMeshTriangle(Resources, Index, CurrentPath.Time, V1, V2, V3);
+		return IntersectTriangleVertices(Resources, V1, V2, V3, CurrentPath, t);
+	}
+
+	// Bounds of a BVH node, for a path at a given fraction of the way through the shutter. Motion nodes interpolate between their bounds at the
+	// shutter's open and close, which bounds everything below them at that instant.
+	inline void GetNodeBounds(const BVHStuff::BVHNode& Node, float, float3& BoundsMin, float3& BoundsMax) {
+		BoundsMin = Node.BoundsMin;
+		BoundsMax = Node.BoundsMax;
+	}
+
+	inline void GetNodeBounds(const BVHStuff::MotionBVHNode& Node, float ShutterFraction, float3& BoundsMin, float3& BoundsMax) {
+		BoundsMin = Node.OpenBoundsMin * (1.0f - ShutterFraction) + Node.CloseBoundsMin * ShutterFraction;
+		BoundsMax = Node.OpenBoundsMax * (1.0f - ShutterFraction) + Node.CloseBoundsMax * ShutterFraction;
+	}
+
+	// Whether a given Path passes through a box anywhere within [tMin, tMax].
+	inline bool IntersectBoundingBox(
+		const float3& BoundsMin, const float3& BoundsMax, const Path& CurrentPath, const float3& InverseDirection, float tMin, float tMax) {
+		float3 t0{ (BoundsMin - CurrentPath.WSOrigin) * InverseDirection };
+		float3 t1{ (BoundsMax - CurrentPath.WSOrigin) * InverseDirection };
+
+		float tNear{ std::max(std::max(std::min(t0.x, t1.x), std::min(t0.y, t1.y)), std::max(std::min(t0.z, t1.z), tMin)) };
+		float tFar{ std::min(std::min(std::max(t0.x, t1.x), std::max(t0.y, t1.y)), std::min(std::max(t0.z, t1.z), tMax)) };
+
+		// Widened by a few ulps, so that rounding in the slab distances never culls a hit on the bounds.
+		return tNear <= tFar * 1.00000024f;
+	}
+
+	// Walks the tree below RootNodeIndex nearest child first with a fixed-size stack, handing every leaf that the Path reaches within
+	// [PathMinDistance, ClosestHitDistance] to IntersectLeaf, which tests its references and shrinks ClosestHitDistance as it finds closer hits.
+	template<typename NodeType, typename IntersectLeafFunctionType>
+	inline void WalkBVH(const NodeType* Nodes, uint RootNodeIndex, const Path& CurrentPath, float ShutterFraction, float PathMinDistance,
+		const float& ClosestHitDistance, IntersectLeafFunctionType IntersectLeaf) {
+		const float3 InverseDirection{ 1.0f / CurrentPath.WSDirection.x, 1.0f / CurrentPath.WSDirection.y, 1.0f / CurrentPath.WSDirection.z };
+		const bool DirectionIsNegative[3]{ CurrentPath.WSDirection.x < 0.0f, CurrentPath.WSDirection.y < 0.0f, CurrentPath.WSDirection.z < 0.0f };
+
+		uint NodeStack[BVHStuff::MaxTraversalStackSize];
+		uint NodeStackSize{ 0u };
+		uint NodeIndex{ RootNodeIndex };
+		float3 BoundsMin, BoundsMax;
+
+		GetNodeBounds(Nodes[RootNodeIndex], ShutterFraction, BoundsMin, BoundsMax);
+
+		if (!IntersectBoundingBox(BoundsMin, BoundsMax, CurrentPath, InverseDirection, PathMinDistance, ClosestHitDistance)) {
+			return;
+		}
+
+		while (true) {
+			const NodeType& Node{ Nodes[NodeIndex] };
+
+			if (Node.ReferenceCount > 0u) {
+				IntersectLeaf(Node);
+			} else {
+				// Visit the child on the near side of the split first, which tends to shrink ClosestHitDistance before the far child is tested.
+				uint NearChildIndex{ NodeIndex + 1u }, FarChildIndex{ Node.RightChildOrFirstReference };
+				float3 NearBoundsMin, NearBoundsMax, FarBoundsMin, FarBoundsMax;
+				GetNodeBounds(Nodes[NearChildIndex], ShutterFraction, NearBoundsMin, NearBoundsMax);
+				GetNodeBounds(Nodes[FarChildIndex], ShutterFraction, FarBoundsMin, FarBoundsMax);
+
+				float3 Separation{ FarBoundsMin + FarBoundsMax - NearBoundsMin - NearBoundsMax };
+				float3 AbsoluteSeparation{ fabsf(Separation.x), fabsf(Separation.y), fabsf(Separation.z) };
+				uint Axis{ AbsoluteSeparation.x >= AbsoluteSeparation.y && AbsoluteSeparation.x >= AbsoluteSeparation.z
+						? 0u
+						: (AbsoluteSeparation.y >= AbsoluteSeparation.z ? 1u : 2u) };
+
+				if (DirectionIsNegative[Axis] == (BVHStuff::GetAxis(Separation, Axis) > 0.0f)) {
+					std::swap(NearChildIndex, FarChildIndex);
+					std::swap(NearBoundsMin, FarBoundsMin);
+					std::swap(NearBoundsMax, FarBoundsMax);
+				}
+
+				bool HitsNearChild{ IntersectBoundingBox(NearBoundsMin, NearBoundsMax, CurrentPath, InverseDirection, PathMinDistance, ClosestHitDistance) };
+				bool HitsFarChild{ IntersectBoundingBox(FarBoundsMin, FarBoundsMax, CurrentPath, InverseDirection, PathMinDistance, ClosestHitDistance) };
+
+				if (HitsNearChild) {
+					if (HitsFarChild) {
+						NodeStack[NodeStackSize++] = FarChildIndex;
+					}
+
+					NodeIndex = NearChildIndex;
+
+					continue;
+				} else if (HitsFarChild) {
+					NodeIndex = FarChildIndex;
+
+					continue;
+				}
+			}
+
+			// Pop the next node that still overlaps the shrinking search interval.
+			bool FoundNode{ false };
+
+			while (NodeStackSize > 0u && !FoundNode) {
+				NodeIndex = NodeStack[--NodeStackSize];
+				GetNodeBounds(Nodes[NodeIndex], ShutterFraction, BoundsMin, BoundsMax);
+				FoundNode = IntersectBoundingBox(BoundsMin, BoundsMax, CurrentPath, InverseDirection, PathMinDistance, ClosestHitDistance);
+			}
+
+			if (!FoundNode) {
+				break;
+			}
+		}
+	}
+
+	// Distance along a given Path to an Instance, valid if the Path hits one of its prototype's triangles before MaxDistance (or at it), along with
+	// that triangle. The Path is carried into the prototype's object space without normalizing its direction, so distances along it stay the same,
+	// and walks the prototype's tree there. Equally distant triangles are resolved by their index.
+	inline bool IntersectInstance(
+		const PipelineResources& Resources, uint Index, const Path& CurrentPath, float MaxDistance, float& t, uint& PrototypeTriangleIndex) {
+		const Instance& CurrentInstance{ Resources.Instances[Index] };
+		const uint RootNodeIndex{ Resources.PrototypeBVHRootNodes[CurrentInstance.PrototypeIndex] };
+
+		if (RootNodeIndex == BVHStuff::NoPrototypeRootNode) {
+			return false;
+		}
+
+		const Path ObjectPath{ SceneStuff::TransformPoint(CurrentInstance.ObjectFromWorld, CurrentPath.WSOrigin),
+			SceneStuff::TransformDirection(CurrentInstance.ObjectFromWorld, CurrentPath.WSDirection), CurrentPath.Time };
+		float ClosestHitDistance{ MaxDistance };
+		uint ClosestTriangleIndex{ 0xFFFFFFFFu };
+
+		WalkBVH(Resources.PrototypeBVHNodes, RootNodeIndex, ObjectPath, 0.0f, Resources.RootConstants.PathMinDistance, ClosestHitDistance,
+			[&](const BVHStuff::BVHNode& Node) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					const uint TriangleIndex{ Resources.PrototypeBVHReferences[Node.RightChildOrFirstReference + i] };
+					float3 V1, V2, V3;
+					float TriangleDistance;
+					GetPrototypeTriangle(Resources, TriangleIndex, V1, V2, V3);
+
+					if (IntersectTriangleVertices(Resources, V1, V2, V3, ObjectPath, TriangleDistance) &&
+						(TriangleDistance < ClosestHitDistance || (TriangleDistance == ClosestHitDistance && TriangleIndex < ClosestTriangleIndex))) {
+						ClosestHitDistance = TriangleDistance;
+						ClosestTriangleIndex = TriangleIndex;
+					}
+				}
+			});
+
+		if (ClosestTriangleIndex == 0xFFFFFFFFu) {
+			return false;
+		}
+
+		t = ClosestHitDistance;
+		PrototypeTriangleIndex = ClosestTriangleIndex;
+		return true;
+	}
+
+	// Distance along a given Path to the primitive behind a packed BVH reference, valid if the Path hits it. MaxDistance bounds the search of an
+	// Instance, which also returns the triangle of its prototype that was hit.
+	inline bool IntersectReference(
+		const PipelineResources& Resources, uint Reference, const Path& CurrentPath, float MaxDistance, float& t, uint& PrototypeTriangleIndex) {
+		uint Index{ BVHStuff::GetReferenceIndex(Reference) };
+
+		switch (BVHStuff::GetReferencePrimitiveId(Reference)) {
+			case 0: {
+				Sphere MovingSphere;
+				return IntersectSphere(Resources, GetSphere(Resources, Index, CurrentPath.Time, MovingSphere), CurrentPath, t);
+			}
+			case 1: {
+				RectangleStuff::RectangleRecord MovingRectangle;
+				return IntersectRectangle(Resources, GetRectangleRecord(Resources, Index, CurrentPath.Time, MovingRectangle), CurrentPath, t);
+			}
+			case 2: {
+				TriangleStuff::TriangleRecord MovingTriangle;
+				return IntersectTriangle(Resources, GetTriangleRecord(Resources, Index, CurrentPath.Time, MovingTriangle), CurrentPath, t);
+			}
+			case 3: {
+				return IntersectMeshTriangle(Resources, Index, CurrentPath, t);
+			}
+			default: {
+				return IntersectInstance(Resources, Index, CurrentPath, MaxDistance, t, PrototypeTriangleIndex);
+			}
+		}
+	}
+
+	// Finds the closest hit by testing a given Path against every primitive, in the order Spheres, Rectangles, Triangles, mesh triangles, Instances.
+	// The first of several equally distant hits wins. Returns the closest reference, with ClosestHitDistance left at PathMaxDistance on a miss.
+	inline uint FindClosestHitBruteForce(const PipelineResources& Resources, const Path& CurrentPath, float& ClosestHitDistance,
+		uint& ClosestPrototypeTriangle) {
+		const InlineRootConstants& RootConstants{ Resources.RootConstants };
+		uint ClosestReference{ 0u };
+		float t;
+		Sphere MovingSphere;
+		RectangleStuff::RectangleRecord MovingRectangle;
+		TriangleStuff::TriangleRecord MovingTriangle;
+
+		if (Resources.PackedSpheres != nullptr) {
+			uint SphereIndex{ Resources.FindClosestSphere(
+				*Resources.PackedSpheres, CurrentPath.WSOrigin, CurrentPath.WSDirection, RootConstants.PathMinDistance, ClosestHitDistance) };
+
+			if (SphereIndex != ~0u) {
+				ClosestReference = BVHStuff::CreateReference(0u, SphereIndex);
+			}
+		} else {
+			for (uint CurrentSphereIndex = { 0u }; CurrentSphereIndex < RootConstants.SphereCount; CurrentSphereIndex++) {
+				if (IntersectSphere(Resources, GetSphere(Resources, CurrentSphereIndex, CurrentPath.Time, MovingSphere), CurrentPath, t) &&
+					t < ClosestHitDistance) {
+					ClosestHitDistance = t;
+					ClosestReference = BVHStuff::CreateReference(0u, CurrentSphereIndex);
+				}
+			}
+		}
+
+		for (uint CurrentRectangleIndex = { 0u }; CurrentRectangleIndex < RootConstants.RectangleCount; CurrentRectangleIndex++) {
+			if (IntersectRectangle(Resources, GetRectangleRecord(Resources, CurrentRectangleIndex, CurrentPath.Time, MovingRectangle), CurrentPath, t) &&
+				t < ClosestHitDistance) {
+				ClosestHitDistance = t;
+				ClosestReference = BVHStuff::CreateReference(1u, CurrentRectangleIndex);
+			}
+		}
+
+		for (uint CurrentTriangleIndex = { 0u }; CurrentTriangleIndex < RootConstants.TriangleCount; CurrentTriangleIndex++) {
+			if (IntersectTriangle(Resources, GetTriangleRecord(Resources, CurrentTriangleIndex, CurrentPath.Time, MovingTriangle), CurrentPath, t) &&
+				t < ClosestHitDistance) {
+				ClosestHitDistance = t;
+				ClosestReference = BVHStuff::CreateReference(2u, CurrentTriangleIndex);
+			}
+		}
+
+		for (uint CurrentTriangleIndex = { 0u }; CurrentTriangleIndex < Resources.MeshTriangleCount; CurrentTriangleIndex++) {
+			if (IntersectMeshTriangle(Resources, CurrentTriangleIndex, CurrentPath, t) && t < ClosestHitDistance) {
+				ClosestHitDistance = t;
+				ClosestReference = BVHStuff::CreateReference(3u, CurrentTriangleIndex);
+			}
+		}
+
+		for (uint CurrentInstanceIndex = { 0u }; CurrentInstanceIndex < Resources.InstanceCount; CurrentInstanceIndex++) {
+			uint PrototypeTriangleIndex;
+
+			if (IntersectInstance(Resources, CurrentInstanceIndex, CurrentPath, ClosestHitDistance, t, PrototypeTriangleIndex) && t < ClosestHitDistance) {
+				ClosestHitDistance = t;
+				ClosestReference = BVHStuff::CreateReference(4u, CurrentInstanceIndex);
+				ClosestPrototypeTriangle = PrototypeTriangleIndex;
+			}
+		}
+
+		return ClosestReference;
+	}
+
+	// Finds the same closest hit as the brute-force search, by walking the BVH with WalkBVH().
+	// Equally distant hits are resolved by reference order, which matches the brute-force visiting order.
+	// Walks either the BVH's Nodes, or its motion nodes at the Path's time while the shutter is open.
+	template<typename NodeType>
+	inline uint FindClosestHitBVH(
+		const PipelineResources& Resources, const NodeType* Nodes, const Path& CurrentPath, float& ClosestHitDistance, uint& ClosestPrototypeTriangle) {
+		uint ClosestReference{ 0xFFFFFFFFu };
+
+		WalkBVH(Nodes, 0u, CurrentPath, GetShutterFraction(Resources, CurrentPath.Time), Resources.RootConstants.PathMinDistance, ClosestHitDistance,
+			[&](const NodeType& Node) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					uint Reference{ Resources.BVHReferences[Node.RightChildOrFirstReference + i] };
+					uint PrototypeTriangleIndex;
+					float t;
+
+					if (IntersectReference(Resources, Reference, CurrentPath, ClosestHitDistance, t, PrototypeTriangleIndex) &&
+						(t < ClosestHitDistance || (t == ClosestHitDistance && Reference < ClosestReference))) {
+						ClosestHitDistance = t;
+						ClosestReference = Reference;
+						ClosestPrototypeTriangle = PrototypeTriangleIndex;
+					}
+				}
+			});
+
+		return ClosestReference;
+	}
+
+	// Largest MaxDistance among a packet's paths.
+	inline float GetPacketMaxDistance(const SIMDStuff::RayPacket& Packet) {
+		float MaxDistance{ -INFINITY };
+
+		for (uint i{ 0u }; i < Packet.Count; i++) {
+			MaxDistance = std::max(MaxDistance, Packet.MaxDistance[i]);
+		}
+
+		return MaxDistance;
+	}
+
+	// Finds the closest hits of a packet of coherent Paths, by walking the BVH's Nodes once for all of them, nearest child first by the first
+	// Path's direction. A node is skipped when the packet's interval bounds miss it, otherwise only the Paths that pass through its box test its
+	// primitives or descend below it. Each Path ends up with the same hit as FindClosestHitBVH, in its lane's MaxDistance, ClosestReferences and
+	// ClosestPrototypeTriangles.
+	inline void FindClosestHitsBVH(
+		const PipelineResources& Resources, const Path* Paths, SIMDStuff::RayPacket& Packet, uint* ClosestReferences, uint* ClosestPrototypeTriangles) {
+		const BVHStuff::BVHNode* Nodes{ Resources.BVHNodes };
+		const float PathMinDistance{ Resources.RootConstants.PathMinDistance };
+		const bool DirectionIsNegative[3]{ Paths[0].WSDirection.x < 0.0f, Paths[0].WSDirection.y < 0.0f, Paths[0].WSDirection.z < 0.0f };
+
+		float PacketMaxDistance{ GetPacketMaxDistance(Packet) };
+		uint NodeStack[BVHStuff::MaxTraversalStackSize];
+		uint NodeStackSize{ 0u };
+		float t;
+
+		NodeStack[NodeStackSize++] = 0u;
+
+		while (NodeStackSize > 0u) {
+			const uint NodeIndex{ NodeStack[--NodeStackSize] };
+			const BVHStuff::BVHNode& Node{ Nodes[NodeIndex] };
+
+			if (SIMDStuff::PacketMissesBounds(Packet, Node.BoundsMin, Node.BoundsMax, PathMinDistance, PacketMaxDistance)) {
+				continue;
+			}
+
+			const uint ActiveLanes{ Resources.IntersectRayPacket(Packet, Node.BoundsMin, Node.BoundsMax, PathMinDistance) };
+
+			if (ActiveLanes == 0u) {
+				continue;
+			}
+
+			if (Node.ReferenceCount > 0u) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					uint Reference{ Resources.BVHReferences[Node.RightChildOrFirstReference + i] };
+
+					for (uint Lanes{ ActiveLanes }; Lanes != 0u; Lanes &= Lanes - 1u) {
+						const uint Lane{ SIMDStuff::GetLowestSetBit(Lanes) };
+						uint PrototypeTriangleIndex;
+
+						if (IntersectReference(Resources, Reference, Paths[Lane], Packet.MaxDistance[Lane], t, PrototypeTriangleIndex) &&
+							(t < Packet.MaxDistance[Lane] || (t == Packet.MaxDistance[Lane] && Reference < ClosestReferences[Lane]))) {
+							Packet.MaxDistance[Lane] = t;
+							ClosestReferences[Lane] = Reference;
+							ClosestPrototypeTriangles[Lane] = PrototypeTriangleIndex;
+						}
+					}
+				}
+
+				PacketMaxDistance = GetPacketMaxDistance(Packet);
+
+				continue;
+			}
+
+			// The far child is pushed first, so that the near one is popped next.
+			uint NearChildIndex{ NodeIndex + 1u }, FarChildIndex{ Node.RightChildOrFirstReference };
+			const BVHStuff::BVHNode& NearChild{ Nodes[NearChildIndex] };
+			const BVHStuff::BVHNode& FarChild{ Nodes[FarChildIndex] };
+
+			float3 Separation{ FarChild.BoundsMin + FarChild.BoundsMax - NearChild.BoundsMin - NearChild.BoundsMax };
+			float3 AbsoluteSeparation{ fabsf(Separation.x), fabsf(Separation.y), fabsf(Separation.z) };
+			uint Axis{ AbsoluteSeparation.x >= AbsoluteSeparation.y && AbsoluteSeparation.x >= AbsoluteSeparation.z
+					? 0u
+					: (AbsoluteSeparation.y >= AbsoluteSeparation.z ? 1u : 2u) };
+
+			if (DirectionIsNegative[Axis] == (BVHStuff::GetAxis(Separation, Axis) > 0.0f)) {
+				std::swap(NearChildIndex, FarChildIndex);
+			}
+
+			NodeStack[NodeStackSize++] = FarChildIndex;
+			NodeStack[NodeStackSize++] = NearChildIndex;
+		}
+	}
+
+	// Fills in an IntersectionRecord from the closest hit found along a given Path, or the Sky if its distance is still PathMaxDistance.
+	inline void FillIntersectionRecord(const PipelineResources& Resources, const Path& CurrentPath, uint ClosestReference, uint ClosestPrototypeTriangle,
+		float ClosestHitDistance, IntersectionRecord& HitRecord) {
+		const InlineRootConstants& RootConstants{ Resources.RootConstants };
+
+		HitRecord.Time = CurrentPath.Time;
+		HitRecord.WStDistance = ClosestHitDistance;
+		HitRecord.WSIntersectionPoint = CurrentPath.WSOrigin + (ClosestHitDistance * CurrentPath.WSDirection);
+		HitRecord.WSIncomingPathDirection = CurrentPath.WSDirection;
+
+		if (ClosestHitDistance == RootConstants.PathMaxDistance) {
+			HitRecord.ObjectId = 0;
+			HitRecord.MaterialIndex = NoMaterialIndex;
+			HitRecord.MaterialId = 0;
+
+			return;
+		}
+
+		uint Index{ BVHStuff::GetReferenceIndex(ClosestReference) };
+
+		switch (BVHStuff::GetReferencePrimitiveId(ClosestReference)) {
+			case 0:
+				HitRecord.PrimitiveId = Resources.Spheres[Index].PrimitiveId;
+				HitRecord.ObjectId = Resources.Spheres[Index].ObjectId;
+				HitRecord.MaterialIndex = Resources.Spheres[Index].MaterialIndex;
+
+				break;
+			case 1:
+				HitRecord.PrimitiveId = Resources.Rectangles[Index].PrimitiveId;
+				HitRecord.ObjectId = Resources.Rectangles[Index].ObjectId;
+				HitRecord.MaterialIndex = Resources.Rectangles[Index].MaterialIndex;
+
+				break;
+			case 2:
+				HitRecord.PrimitiveId = Resources.Triangles[Index].PrimitiveId;
+				HitRecord.ObjectId = Resources.Triangles[Index].ObjectId;
+				HitRecord.MaterialIndex = Resources.Triangles[Index].MaterialIndex;
+
+				break;
+			case 3:
+				// Mesh triangles are identified by their own index, rather than their mesh's ObjectId.
+				HitRecord.PrimitiveId = GetMesh(Resources, Index).PrimitiveId;
+				HitRecord.ObjectId = Index;
+				HitRecord.MaterialIndex = GetMesh(Resources, Index).MaterialIndex;
+
+				break;
+			case 4:
+				HitRecord.PrimitiveId = Resources.Instances[Index].PrimitiveId;
+				HitRecord.ObjectId = Resources.Instances[Index].ObjectId;
+				HitRecord.MaterialIndex = Resources.Instances[Index].MaterialIndex;
+				HitRecord.PrototypeTriangleIndex = ClosestPrototypeTriangle;
+
+				break;
+		}
+
+		HitRecord.MaterialId = Resources.Materials[HitRecord.MaterialIndex].MaterialId;
+	}
+
+	// Finds the closest hit along a given Path that is nearer than ClosestHitDistance, with whichever search the Resources are set up for.
+	inline uint FindClosestHit(const PipelineResources& Resources, const Path& CurrentPath, float& ClosestHitDistance, uint& ClosestPrototypeTriangle) {
+		if (Resources.MotionBVHNodes != nullptr) {
+			return FindClosestHitBVH(Resources, Resources.MotionBVHNodes, CurrentPath, ClosestHitDistance, ClosestPrototypeTriangle);
+		} else if (Resources.BVHNodes != nullptr) {
+			return FindClosestHitBVH(Resources, Resources.BVHNodes, CurrentPath, ClosestHitDistance, ClosestPrototypeTriangle);
+		}
+
+		return FindClosestHitBruteForce(Resources, CurrentPath, ClosestHitDistance, ClosestPrototypeTriangle);
+	}
+
+	// Generates an IntersectionRecord, representing an intersection between a given Path and either a primitive or the Sky.
+	inline void CreateIntersectionRecord(const PipelineResources& Resources, const Path& CurrentPath, IntersectionRecord& HitRecord) {
+		float ClosestHitDistance{ Resources.RootConstants.PathMaxDistance };
+		uint ClosestPrototypeTriangle{ 0u };
+		uint ClosestReference{ FindClosestHit(Resources, CurrentPath, ClosestHitDistance, ClosestPrototypeTriangle) };
+
+		FillIntersectionRecord(Resources, CurrentPath, ClosestReference, ClosestPrototypeTriangle, ClosestHitDistance, HitRecord);
+	}
+
+	/*
+		OCCLUSION QUERIES:
+			Shadow paths only ask whether anything lies along them within [PathMinDistance, MaxDistance), not what is nearest, so they take a search
+			of their own that returns at the first hit it finds, without keeping a closest distance, reference or prototype triangle. Instances
+			stop at the first triangle of their prototype that is hit, too. They find a hit exactly when FindClosestHit() would find one before
+			MaxDistance.
+	*/
+
+	// Walks the tree below RootNodeIndex nearest child first, like WalkBVH(), until TestLeaf finds a hit in one of the leaves that the Path reaches
+	// within [PathMinDistance, MaxDistance]. The interval never shrinks, so each child is tested once when its parent is reached, and popped
+	// without a second test.
+	template<typename NodeType, typename TestLeafFunctionType>
+	inline bool WalkBVHAnyHit(const NodeType* Nodes, uint RootNodeIndex, const Path& CurrentPath, float ShutterFraction, float PathMinDistance,
+		float MaxDistance, TestLeafFunctionType TestLeaf) {
+		const float3 InverseDirection{ 1.0f / CurrentPath.WSDirection.x, 1.0f / CurrentPath.WSDirection.y, 1.0f / CurrentPath.WSDirection.z };
+		const bool DirectionIsNegative[3]{ CurrentPath.WSDirection.x < 0.0f, CurrentPath.WSDirection.y < 0.0f, CurrentPath.WSDirection.z < 0.0f };
+
+		uint NodeStack[BVHStuff::MaxTraversalStackSize];
+		uint NodeStackSize{ 0u };
+		uint NodeIndex{ RootNodeIndex };
+		float3 BoundsMin, BoundsMax;
+
+		GetNodeBounds(Nodes[RootNodeIndex], ShutterFraction, BoundsMin, BoundsMax);
+
+		if (!IntersectBoundingBox(BoundsMin, BoundsMax, CurrentPath, InverseDirection, PathMinDistance, MaxDistance)) {
+			return false;
+		}
+
+		while (true) {
+			const NodeType& Node{ Nodes[NodeIndex] };
+
+			if (Node.ReferenceCount > 0u) {
+				if (TestLeaf(Node)) {
+					return true;
+				}
+			} else {
+				uint NearChildIndex{ NodeIndex + 1u }, FarChildIndex{ Node.RightChildOrFirstReference };
+				float3 NearBoundsMin, NearBoundsMax, FarBoundsMin, FarBoundsMax;
+				GetNodeBounds(Nodes[NearChildIndex], ShutterFraction, NearBoundsMin, NearBoundsMax);
+				GetNodeBounds(Nodes[FarChildIndex], ShutterFraction, FarBoundsMin, FarBoundsMax);
+
+				float3 Separation{ FarBoundsMin + FarBoundsMax - NearBoundsMin - NearBoundsMax };
+				float3 AbsoluteSeparation{ fabsf(Separation.x), fabsf(Separation.y), fabsf(Separation.z) };
+				uint Axis{ AbsoluteSeparation.x >= AbsoluteSeparation.y && AbsoluteSeparation.x >= AbsoluteSeparation.z
+						? 0u
+						: (AbsoluteSeparation.y >= AbsoluteSeparation.z ? 1u : 2u) };
+
+				if (DirectionIsNegative[Axis] == (BVHStuff::GetAxis(Separation, Axis) > 0.0f)) {
+					std::swap(NearChildIndex, FarChildIndex);
+					std::swap(NearBoundsMin, FarBoundsMin);
+					std::swap(NearBoundsMax, FarBoundsMax);
+				}
+
+				bool HitsNearChild{ IntersectBoundingBox(NearBoundsMin, NearBoundsMax, CurrentPath, InverseDirection, PathMinDistance, MaxDistance) };
+				bool HitsFarChild{ IntersectBoundingBox(FarBoundsMin, FarBoundsMax, CurrentPath, InverseDirection, PathMinDistance, MaxDistance) };
+
+				if (HitsNearChild) {
+					if (HitsFarChild) {
+						NodeStack[NodeStackSize++] = FarChildIndex;
+					}
+
+					NodeIndex = NearChildIndex;
+
+					continue;
+				} else if (HitsFarChild) {
+					NodeIndex = FarChildIndex;
+
+					continue;
+				}
+			}
+
+			if (NodeStackSize == 0u) {
+				return false;
+			}
+
+			NodeIndex = NodeStack[--NodeStackSize];
+		}
+	}
+
+	// Whether a given Path hits any of an Instance's prototype triangles before MaxDistance, walking the prototype's tree in object space like
+	// IntersectInstance().
+	inline bool HitsInstance(const PipelineResources& Resources, uint Index, const Path& CurrentPath, float MaxDistance) {
+		const Instance& CurrentInstance{ Resources.Instances[Index] };
+		const uint RootNodeIndex{ Resources.PrototypeBVHRootNodes[CurrentInstance.PrototypeIndex] };
+
+		if (RootNodeIndex == BVHStuff::NoPrototypeRootNode) {
+			return false;
+		}
+
+		const Path ObjectPath{ SceneStuff::TransformPoint(CurrentInstance.ObjectFromWorld, CurrentPath.WSOrigin),
+			SceneStuff::TransformDirection(CurrentInstance.ObjectFromWorld, CurrentPath.WSDirection), CurrentPath.Time };
+
+		return WalkBVHAnyHit(Resources.PrototypeBVHNodes, RootNodeIndex, ObjectPath, 0.0f, Resources.RootConstants.PathMinDistance, MaxDistance,
+			[&](const BVHStuff::BVHNode& Node) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					float3 V1, V2, V3;
+					float t;
+					GetPrototypeTriangle(Resources, Resources.PrototypeBVHReferences[Node.RightChildOrFirstReference + i], V1, V2, V3);
+
+					if (IntersectTriangleVertices(Resources, V1, V2, V3, ObjectPath, t) && t < MaxDistance) {
+						return true;
+					}
+				}
+
+				return false;
+			});
+	}
+
+	// Whether a given Path hits the primitive behind a packed BVH reference before MaxDistance.
+	inline bool HitsReference(const PipelineResources& Resources, uint Reference, const Path& CurrentPath, float MaxDistance) {
+		if (BVHStuff::GetReferencePrimitiveId(Reference) == 4u) {
+			return HitsInstance(Resources, BVHStuff::GetReferenceIndex(Reference), CurrentPath, MaxDistance);
+		}
+
+		uint PrototypeTriangleIndex;
+		float t;
+		return IntersectReference(Resources, Reference, CurrentPath, MaxDistance, t, PrototypeTriangleIndex) && t < MaxDistance;
+	}
+
+	// Tests a given Path against every primitive in the brute-force search's order, the cheapest kinds first, until one is hit before MaxDistance.
+	inline bool IsOccludedBruteForce(const PipelineResources& Resources, const Path& CurrentPath, float MaxDistance) {
+		const InlineRootConstants& RootConstants{ Resources.RootConstants };
+		float t;
+		Sphere MovingSphere;
+		RectangleStuff::RectangleRecord MovingRectangle;
+		TriangleStuff::TriangleRecord MovingTriangle;
+
+		if (Resources.PackedSpheres != nullptr) {
+			float ClosestHitDistance{ MaxDistance };
+
+			if (Resources.FindClosestSphere(*Resources.PackedSpheres, CurrentPath.WSOrigin, CurrentPath.WSDirection, RootConstants.PathMinDistance,
+					ClosestHitDistance) != ~0u) {
+				return true;
+			}
+		} else {
+			for (uint CurrentSphereIndex = { 0u }; CurrentSphereIndex < RootConstants.SphereCount; CurrentSphereIndex++) {
+				if (IntersectSphere(Resources, GetSphere(Resources, CurrentSphereIndex, CurrentPath.Time, MovingSphere), CurrentPath, t) && t < MaxDistance) {
+					return true;
+				}
+			}
+		}
+
+		for (uint CurrentRectangleIndex = { 0u }; CurrentRectangleIndex < RootConstants.RectangleCount; CurrentRectangleIndex++) {
+			if (IntersectRectangle(Resources, GetRectangleRecord(Resources, CurrentRectangleIndex, CurrentPath.Time, MovingRectangle), CurrentPath, t) &&
+				t < MaxDistance) {
+				return true;
+			}
+		}
+
+		for (uint CurrentTriangleIndex = { 0u }; CurrentTriangleIndex < RootConstants.TriangleCount; CurrentTriangleIndex++) {
+			if (IntersectTriangle(Resources, GetTriangleRecord(Resources, CurrentTriangleIndex, CurrentPath.Time, MovingTriangle), CurrentPath, t) &&
+				t < MaxDistance) {
+				return true;
+			}
+		}
+
+		for (uint CurrentTriangleIndex = { 0u }; CurrentTriangleIndex < Resources.MeshTriangleCount; CurrentTriangleIndex++) {
+			if (IntersectMeshTriangle(Resources, CurrentTriangleIndex, CurrentPath, t) && t < MaxDistance) {
+				return true;
+			}
+		}
+
+		for (uint CurrentInstanceIndex = { 0u }; CurrentInstanceIndex < Resources.InstanceCount; CurrentInstanceIndex++) {
+			if (HitsInstance(Resources, CurrentInstanceIndex, CurrentPath, MaxDistance)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Walks either the BVH's Nodes, or its motion nodes at the Path's time while the shutter is open, with WalkBVHAnyHit().
+	template<typename NodeType>
+	inline bool IsOccludedBVH(const PipelineResources& Resources, const NodeType* Nodes, const Path& CurrentPath, float MaxDistance) {
+		return WalkBVHAnyHit(Nodes, 0u, CurrentPath, GetShutterFraction(Resources, CurrentPath.Time), Resources.RootConstants.PathMinDistance, MaxDistance,
+			[&](const NodeType& Node) {
+				for (uint i{ 0u }; i < Node.ReferenceCount; i++) {
+					if (HitsReference(Resources, Resources.BVHReferences[Node.RightChildOrFirstReference + i], CurrentPath, MaxDistance)) {
+						return true;
+					}
+				}
+
+				return false;
+			});
+	}
+
+	// Whether anything lies along a given Path before MaxDistance, with whichever search the Resources are set up for.
+	inline bool IsOccluded(const PipelineResources& Resources, const Path& CurrentPath, float MaxDistance) {
+		if (Resources.MotionBVHNodes != nullptr) {
+			return IsOccludedBVH(Resources, Resources.MotionBVHNodes, CurrentPath, MaxDistance);
+		} else if (Resources.BVHNodes != nullptr) {
+			return IsOccludedBVH(Resources, Resources.BVHNodes, CurrentPath, MaxDistance);
+		}
+
+		return IsOccludedBruteForce(Resources, CurrentPath, MaxDistance);
+	}
+
+	// Camera paths are traced as packets of RayPacketTileWidth by RayPacketTileHeight pixels.
+	constexpr uint RayPacketTileWidth{ 4u };
+	constexpr uint RayPacketTileHeight{ SIMDStuff::RayPacketSize / RayPacketTileWidth };
+
+	// A camera path that was traced ahead of its pass, together with its first IntersectionRecord.
+	struct TracedCameraPath {
+		Path CameraPath;
+		IntersectionRecord HitRecord;
+	};
+
+	// Traces up to RayPacketSize coherent camera paths together, as a packet through the BVH's Nodes, and fills in their IntersectionRecords.
+	inline void CreateIntersectionRecords(const PipelineResources& Resources, TracedCameraPath* TracedCameraPaths, uint PathCount) {
+		Path Paths[SIMDStuff::RayPacketSize];
+		float3 Origins[SIMDStuff::RayPacketSize], Directions[SIMDStuff::RayPacketSize];
+		uint ClosestReferences[SIMDStuff::RayPacketSize], ClosestPrototypeTriangles[SIMDStuff::RayPacketSize];
+
+		for (uint i{ 0u }; i < PathCount; i++) {
+			Paths[i] = TracedCameraPaths[i].CameraPath;
+			Origins[i] = Paths[i].WSOrigin;
+			Directions[i] = Paths[i].WSDirection;
+			ClosestReferences[i] = 0xFFFFFFFFu;
+			ClosestPrototypeTriangles[i] = 0u;
+		}
+
+		SIMDStuff::RayPacket Packet;
+		SIMDStuff::CreateRayPacket(Origins, Directions, PathCount, Resources.RootConstants.PathMaxDistance, Packet);
+		FindClosestHitsBVH(Resources, Paths, Packet, ClosestReferences, ClosestPrototypeTriangles);
+
+		for (uint i{ 0u }; i < PathCount; i++) {
+			TracedCameraPaths[i].HitRecord = IntersectionRecord{};
+			FillIntersectionRecord(
+				Resources, Paths[i], ClosestReferences[i], ClosestPrototypeTriangles[i], Packet.MaxDistance[i], TracedCameraPaths[i].HitRecord);
+		}
+	}
+
+	// Calculates the surface normal of the primitive referenced by a given IntersectionRecord, at the time of the intersection.
+	inline float3 GetSurfaceNormal(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		float3 SurfaceNormal{};
+
+		if (HitRecord.PrimitiveId == 0) {
+			Sphere MovingSphere;
+
+			SurfaceNormal = normalize(HitRecord.WSIntersectionPoint - GetSphere(Resources, HitRecord.ObjectId, HitRecord.Time, MovingSphere).WSOrigin);
+		} else if (HitRecord.PrimitiveId == 1) {
+			RectangleStuff::RectangleRecord MovingRectangle;
+			SurfaceNormal = GetRectangleRecord(Resources, HitRecord.ObjectId, HitRecord.Time, MovingRectangle).Normal;
+		} else if (HitRecord.PrimitiveId == 2) {
+			TriangleStuff::TriangleRecord MovingTriangle;
+			SurfaceNormal = GetTriangleRecord(Resources, HitRecord.ObjectId, HitRecord.Time, MovingTriangle).Normal;
+		} else if (HitRecord.PrimitiveId == 3) {
+			float3 V1, V2, V3;
+			GetMeshTriangle(Resources, HitRecord.ObjectId, HitRecord.Time, V1, V2, V3);
+			SurfaceNormal = normalize(cross(V2 - V1, V3 - V1));
+		} else if (HitRecord.PrimitiveId == 4) {
+			float3 V1, V2, V3;
+			GetPrototypeTriangle(Resources, HitRecord.PrototypeTriangleIndex, V1, V2, V3);
+			SurfaceNormal = SceneStuff::TransformNormal(Resources.Instances[HitRecord.ObjectId], cross(V2 - V1, V3 - V1));
+		}
+
+		return SurfaceNormal;
+	}
+
+	// Color of an entry of the material table at a given time.
+	inline float3 GetColor(const PipelineResources& Resources, uint MaterialIndex, float Time) {
+		const Material& CurrentMaterial{ Resources.Materials[MaterialIndex] };
+		return Resources.Shutter.IsOpen() ? LinearInterpolation(Time, CurrentMaterial.ColorStart, CurrentMaterial.ColorEnd) : CurrentMaterial.Color;
+	}
+
+	// Color and MaterialScalar of the material referenced by a given IntersectionRecord, at the time of the intersection.
+	inline float3 GetColor(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		return GetColor(Resources, HitRecord.MaterialIndex, HitRecord.Time);
+	}
+
+	inline float GetMaterialScalar(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		const Material& HitMaterial{ Resources.Materials[HitRecord.MaterialIndex] };
+		return Resources.Shutter.IsOpen() ? LinearInterpolation(HitRecord.Time, HitMaterial.MaterialScalarStart, HitMaterial.MaterialScalarEnd)
+										  : HitMaterial.MaterialScalar;
+	}
+
+	// Updates the current Path's values, as a result of an intersection with the Sky.
+	inline void UpdatePathFromSkyIntersection(const IntersectionRecord&, Path&) {
+	}
+
+	// Updates the current Path's values, as a result of an intersection with a Normal-Mapped Sphere.
+	inline void UpdatePathFromSurfaceNormalIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, Path& CurrentPath) {
+		float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+
+		CurrentPath.WSOrigin = HitRecord.WSIntersectionPoint;
+
+		CurrentPath.WSDirection = SurfaceNormal;
+	}
+
+	// Updates the current Path's values, as a result of an intersection with a Diffuse Sphere.
+	inline void UpdatePathFromDiffuseIntersection(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord,
+		Path& CurrentPath) {
+		float3 RandomDirection{ GetRandomDirection(Resources, GridThreadId, HitRecord.CurrentRecursionDepth) };
+
+		float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+
+		RandomDirection = normalize(RandomDirection);
+		RandomDirection = normalize(SurfaceNormal + RandomDirection);
+
+		CurrentPath.WSOrigin = HitRecord.WSIntersectionPoint;
+
+		CurrentPath.WSDirection = RandomDirection;
+	}
+
+	// Christophe Schlick's approximation for calculating probability of refraction.
+	inline void Schlick(float CosThetaA, float n1, float n2, float& RefractionProbability) {
+		float R0 = (n1 - n2) / (n1 + n2);
+
+		R0 = R0 * R0;
+		R0 = R0 + (1.0f - R0) * powf((1.0f - CosThetaA), 5.0f);
+
+		RefractionProbability = R0;
+	}
+
+	// Updates the current Path's values, as a result of an intersection with a Dielectric Sphere.
+	inline void UpdatePathFromDielectricIntersection(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord,
+		Path& CurrentPath) {
+		float n1{ 1.0f }, n2{ GetMaterialScalar(Resources, HitRecord) };
+		float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+		bool OutwardNormal = dot(HitRecord.WSIncomingPathDirection, SurfaceNormal) < 0.0f;
+
+		if (HitRecord.PrimitiveId == 0 && !OutwardNormal) {
+			n1 = GetMaterialScalar(Resources, HitRecord);
+			n2 = 1.0f;
+
+			SurfaceNormal = -SurfaceNormal;
+		}
+
+		float CosThetaA = dot(-HitRecord.WSIncomingPathDirection, SurfaceNormal);
+		float ThetaA = acosf(CosThetaA);
+		float ThetaB;
+		float SinThetaA = sqrtf(1.0f - CosThetaA * CosThetaA);
+
+		float RefractionRatio;
+		bool CannotRefract;
+		float RefractionProbability;
+
+		RefractionRatio = n1 / n2;
+		CannotRefract = RefractionRatio * SinThetaA > 1.0f;
+		ThetaB = asinf(sinf(ThetaA) * (n1 / n2));
+		Schlick(CosThetaA, n1, n2, RefractionProbability);
+
+		float RefractionChance =
+			(GetRandomFloat(Resources, GridThreadId, GetBounceDimension(HitRecord.CurrentRecursionDepth) + 3u) * 2.0f - 1.0f) * 0.50f + 0.50f * 100.0f;
+
+		float3 C = SurfaceNormal * CosThetaA;
+		float3 M = (HitRecord.WSIncomingPathDirection + C) / SinThetaA;
+		float3 A = M * sinf(ThetaB);
+		float3 B = -SurfaceNormal * cosf(ThetaB);
+
+		float3 RefractedDirection = normalize(A + B);
+
+		if (RefractionChance < RefractionProbability || (CannotRefract == true) || isnan(RefractedDirection)) {
+			float3 ReflectedDirection =
+				normalize(HitRecord.WSIncomingPathDirection - 2.0f * dot(HitRecord.WSIncomingPathDirection, SurfaceNormal) * SurfaceNormal);
+
+			CurrentPath.WSDirection = ReflectedDirection;
+			CurrentPath.WSOrigin = HitRecord.WSIntersectionPoint;
+		} else {
+			CurrentPath.WSDirection = RefractedDirection;
+			CurrentPath.WSOrigin = HitRecord.WSIntersectionPoint;
+		}
+	}
+
+	// Updates the current Path's values, as a result of an intersection with a Metallic Sphere.
+	inline void UpdatePathFromMetallicIntersection(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord,
+		Path& CurrentPath) {
+		float3 RandomDirection{ GetRandomDirection(Resources, GridThreadId, HitRecord.CurrentRecursionDepth) };
+
+		float3 FuzzVector{ normalize(RandomDirection) * GetMaterialScalar(Resources, HitRecord) };
+
+		float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+
+		float3 ReflectedDirection = normalize(HitRecord.WSIncomingPathDirection - 2.0f * dot(HitRecord.WSIncomingPathDirection, SurfaceNormal) * SurfaceNormal);
+
+		CurrentPath.WSDirection = normalize(ReflectedDirection + FuzzVector);
+
+		CurrentPath.WSOrigin = HitRecord.WSIntersectionPoint;
+	}
+
+	// Updates the current Path's values, as a result of an intersection with a Diffuse Light Sphere.
+	inline void UpdatePathFromDiffuseLightIntersection(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord,
+		Path& CurrentPath) {
+		UpdatePathFromDiffuseIntersection(Resources, GridThreadId, HitRecord, CurrentPath);
+	}
+
+	// Updates a Path's Payload, given an intersection with the "Sky".
+	inline void UpdatePayloadFromSkyIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		const InlineRootConstants& RootConstants{ Resources.RootConstants };
+
+		float t = HitRecord.WSIncomingPathDirection.y * 0.50f + 0.50f;
+
+		Payload.r = ((1.0f - t) * RootConstants.SkyBottomColor.x) + (t * RootConstants.SkyTopColor.x);
+		Payload.g = ((1.0f - t) * RootConstants.SkyBottomColor.y) + (t * RootConstants.SkyTopColor.y);
+		Payload.b = ((1.0f - t) * RootConstants.SkyBottomColor.z) + (t * RootConstants.SkyTopColor.z);
+	}
+
+	// Updates a Path's Payload, given an intersection with a Normal-Mapped Sphere.
+	inline void UpdatePayloadFromSurfaceNormalIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+
+		Payload.r = SurfaceNormal.x * 0.50f + 0.50f;
+		Payload.g = SurfaceNormal.y * 0.50f + 0.50f;
+		Payload.b = SurfaceNormal.z * 0.50f + 0.50f;
+	}
+
+	// Updates a Path's Payload, given an intersection with an attenuating (Diffuse, Dielectric or Metallic) primitive.
+	inline void UpdatePayloadFromAttenuatingIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		if (HitRecord.CurrentRecursionDepth < (Resources.RootConstants.MaxRecursionDepth - 1)) {
+			float3 Color{ GetColor(Resources, HitRecord) };
+
+			Payload.r = Color.x * Payload.r;
+			Payload.g = Color.y * Payload.g;
+			Payload.b = Color.z * Payload.b;
+		} else {
+			Payload.r = 0.0f;
+			Payload.g = 0.0f;
+			Payload.b = 0.0f;
+		}
+	}
+
+	// Updates a Path's Payload, given an intersection with a Diffuse Sphere.
+	inline void UpdatePayloadFromDiffuseIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		UpdatePayloadFromAttenuatingIntersection(Resources, HitRecord, Payload);
+	}
+
+	// Updates a Path's Payload, given an intersection with a Dielectric Sphere.
+	inline void UpdatePayloadFromDielectricIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		UpdatePayloadFromAttenuatingIntersection(Resources, HitRecord, Payload);
+	}
+
+	// Updates a Path's Payload, given an intersection with a Metallic Sphere.
+	inline void UpdatePayloadFromMetallicIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		UpdatePayloadFromAttenuatingIntersection(Resources, HitRecord, Payload);
+	}
+
+	// Updates a Path's Payload, given an intersection with a Diffuse Light Sphere.
+	inline void UpdatePayloadFromDiffuseLightIntersection(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		if (HitRecord.CurrentRecursionDepth < (Resources.RootConstants.MaxRecursionDepth - 1)) {
+			float3 Color{ GetColor(Resources, HitRecord) };
+
+			Payload.r = Color.x;
+			Payload.g = Color.y;
+			Payload.b = Color.z;
+		} else {
+			Payload.r = 0.0f;
+			Payload.g = 0.0f;
+			Payload.b = 0.0f;
+		}
+	}
+
+	// Accumulates the attenuation of a hit into a Path's throughput, and decides whether the Path ends at that hit.
+	// The Sky, Surface Normal Map and Diffuse Light materials replace the Payload of everything behind them, so the Path ends there.
+	// Otherwise, past RussianRouletteDepth the Path survives with a probability based on its throughput, and is re-weighted to stay unbiased.
+	inline bool UpdateThroughput(
+		const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord, float3& Throughput, float& RussianRouletteWeight) {
+		if (HitRecord.MaterialId == 0 || HitRecord.MaterialId == 1 || HitRecord.MaterialId == 5) {
+			return true;
+		}
+
+		Throughput = Throughput * GetColor(Resources, HitRecord);
+
+		if (HitRecord.CurrentRecursionDepth >= Resources.RootConstants.RussianRouletteDepth) {
+			float SurvivalProbability{ std::min(std::max(Throughput.x, std::max(Throughput.y, Throughput.z)), 1.0f) };
+
+			if (GetRussianRouletteChance(Resources, GridThreadId, HitRecord.CurrentRecursionDepth) < SurvivalProbability) {
+				RussianRouletteWeight = 1.0f / SurvivalProbability;
+				Throughput = Throughput * RussianRouletteWeight;
+			} else {
+				return true;
+			}
+		}
+
+		return HitRecord.CurrentRecursionDepth == Resources.RootConstants.MaxRecursionDepth - 1;
+	}
+
+	/*
+		NEXT-EVENT ESTIMATION:
+			At each Diffuse hit, one light of the LightList is chosen by power and a point on it is sampled, a Rectangle or Triangle uniformly by
+			area and a Sphere uniformly within the cone that it subtends. Unless a shadow path towards that point is blocked, its light is weighted
+			by the density that the hit would have scattered the Path into that direction with over the density it was sampled with.
+			The Diffuse scattering direction, normalize(N + normalize(r)) for r uniform in the cube [-1, +1)^3, is what the hit's Color is
+			implicitly multiplied with, so that density stands in for the surface's reflectance times its cosine, and the estimate converges to
+			the same image as waiting for the bounce to hit the light.
+	*/
+	constexpr float ShadowPathDistanceScale{ 0.999f };// Shadow paths stop just short of the sampled point, so that its own light never blocks it.
+
+	// A point sampled on a light, as it is seen from a shading point.
+	struct LightSample {
+		float3 WSDirection;// Towards the point, normalized.
+		float WSDistance;
+		float3 Radiance;// Light that the point emits, at the Path's time.
+		float PDF;// Density that the direction was sampled with, over solid angle.
+	};
+
+	// Density over solid angle of the directions that UpdatePathFromDiffuseIntersection() scatters into, around a given surface normal.
+	// normalize(r) is 2 cos(theta) w - N for the direction w, and covers the sphere with density 1 / (24 max|r_i|^3) there, which the
+	// half-angle map from it onto w scales by 4 cos(theta).
+	inline float GetDiffusePDF(const float3& SurfaceNormal, const float3& WSDirection) {
+		const float CosTheta{ dot(SurfaceNormal, WSDirection) };
+
+		if (CosTheta <= 0.0f) {
+			return 0.0f;
+		}
+
+		const float3 CubeDirection{ WSDirection * (2.0f * CosTheta) - SurfaceNormal };
+		const float MaxComponent{ std::max(std::max(fabsf(CubeDirection.x), fabsf(CubeDirection.y)), fabsf(CubeDirection.z)) };
+
+		return CosTheta / (6.0f * MaxComponent * MaxComponent * MaxComponent);
+	}
+
+	/*
+		MULTIPLE IMPORTANCE SAMPLING:
+			Under MultipleImportance, fuzzy Metallic hits sample the lights too, and the bounce from a hit that sampled them keeps the light of a
+			sampled light that it reaches. Both estimates of that light are weighted by the power heuristic, p^2 / (p_light^2 + p_scatter^2) for
+			the density p of their own strategy, where p_light is the selection probability of the light times the density of its point over solid
+			angle, and p_scatter the density that the hit scatters into the direction with. A Metallic hit's Color stands in for its reflectance
+			times its cosine over that density, like a Diffuse hit's, so the same weighting applies to both. Metallic hits with no fuzz reflect
+			into a single direction, which light sampling can never pick, and are left to their bounce.
+	*/
+	// Density over solid angle of the directions that UpdatePathFromMetallicIntersection() scatters into, normalize(R + Fuzz normalize(r)) around
+	// a reflected direction R. The direction w is reached by the points t w of the fuzz sphere around R at the roots t > 0 of
+	// t^2 - 2t (w . R) + 1 - Fuzz^2 = 0, each with the density 1 / (24 max|d_i|^3) of its fuzz direction d = (t w - R) / Fuzz, which the
+	// projection from the sphere onto w scales by t^2 / (Fuzz^2 |d . w|). Zero without any fuzz, where the hit only reflects into R.
+	inline float GetMetallicPDF(const float3& ReflectedDirection, float Fuzz, const float3& WSDirection) {
+		if (!(Fuzz > 0.0f)) {
+			return 0.0f;
+		}
+
+		// cos^2 - (1 - Fuzz^2) is taken as Fuzz^2 - sin^2, which keeps its precision near the edge of a narrow cone, where most directions are.
+		const float CosTheta{ dot(WSDirection, ReflectedDirection) };
+		const float3 Sine{ cross(WSDirection, ReflectedDirection) };
+		const float Discriminant{ Fuzz * Fuzz - dot(Sine, Sine) };
+
+		if (Discriminant < 0.0f) {
+			return 0.0f;
+		}
+
+		const float SquareRoot{ sqrtf(Discriminant) };
+		float PDF{ 0.0f };
+
+		for (float t: { CosTheta - SquareRoot, CosTheta + SquareRoot }) {
+			if (t <= 0.0f) {
+				continue;
+			}
+
+			const float3 FuzzDirection{ (WSDirection * t - ReflectedDirection) / Fuzz };
+			const float MaxComponent{ std::max(std::max(fabsf(FuzzDirection.x), fabsf(FuzzDirection.y)), fabsf(FuzzDirection.z)) };
+
+			PDF += t * t / (24.0f * MaxComponent * MaxComponent * MaxComponent * Fuzz * Fuzz * fabsf(dot(FuzzDirection, WSDirection)));
+		}
+
+		return PDF;
+	}
+
+	// Density over solid angle that a hit scatters its Path into a given direction with, zero for materials that light sampling skips.
+	inline float GetScatteringPDF(const PipelineResources& Resources, const IntersectionRecord& HitRecord, const float3& WSDirection) {
+		const float3 SurfaceNormal{ GetSurfaceNormal(Resources, HitRecord) };
+
+		if (HitRecord.MaterialId == 2u) {
+			return GetDiffusePDF(SurfaceNormal, WSDirection);
+		} else if (HitRecord.MaterialId == 4u) {
+			const float3 ReflectedDirection{ normalize(
+				HitRecord.WSIncomingPathDirection - 2.0f * dot(HitRecord.WSIncomingPathDirection, SurfaceNormal) * SurfaceNormal) };
+			return GetMetallicPDF(ReflectedDirection, GetMaterialScalar(Resources, HitRecord), WSDirection);
+		}
+
+		return 0.0f;
+	}
+
+	// Power heuristic weight of a sampling strategy with a given density, against another strategy with OtherPDF.
+	inline float PowerHeuristic(float PDF, float OtherPDF) {
+		if (!(PDF > 0.0f)) {
+			return 0.0f;
+		}
+
+		const float Ratio{ OtherPDF / PDF };
+		return 1.0f / (1.0f + Ratio * Ratio);
+	}
+
+	// Turns a point sampled on a light's surface by area into a LightSample, seen from a shading point.
+	inline bool CreateAreaLightSample(const float3& WSPoint, const float3& WSLightPoint, const float3& LightNormal, float LightArea, LightSample& Sample) {
+		const float3 ToLight{ WSLightPoint - WSPoint };
+		const float DistanceSquared{ dot(ToLight, ToLight) };
+
+		Sample.WSDistance = sqrtf(DistanceSquared);
+		Sample.WSDirection = ToLight / Sample.WSDistance;
+
+		const float CosLight{ fabsf(dot(LightNormal, Sample.WSDirection)) };
+
+		if (!(CosLight > 0.0f) || !(LightArea > 0.0f)) {
+			return false;
+		}
+
+		Sample.PDF = DistanceSquared / (LightArea * CosLight);
+		return true;
+	}
+
+	// 1 - cos(ThetaMax) of the cone that a Sphere subtends, taken from sin^2(ThetaMax) so that it keeps its precision for small or distant Spheres.
+	inline float GetOneMinusCosThetaMax(float DistanceSquared, float RadiusSquared) {
+		const float SinThetaMaxSquared{ RadiusSquared / DistanceSquared };
+		return SinThetaMaxSquared / (1.0f + sqrtf(std::max(1.0f - SinThetaMaxSquared, 0.0f)));
+	}
+
+	// Samples a point on the light behind a packed reference, as seen from a shading point at a given time. Returns false if there is none to be
+	// seen, such as from inside a Sphere, which paths that start inside it never hit either.
+	inline bool SampleLight(
+		const PipelineResources& Resources, uint Reference, const float3& WSPoint, float Time, float2 RandomValues, LightSample& Sample) {
+		const uint Index{ BVHStuff::GetReferenceIndex(Reference) };
+		uint MaterialIndex;
+
+		switch (BVHStuff::GetReferencePrimitiveId(Reference)) {
+			case 0: {
+				Sphere MovingSphere;
+				const Sphere& LightSphere{ GetSphere(Resources, Index, Time, MovingSphere) };
+				const float3 ToCenter{ LightSphere.WSOrigin - WSPoint };
+				const float DistanceSquared{ dot(ToCenter, ToCenter) }, RadiusSquared{ LightSphere.WSRadius * LightSphere.WSRadius };
+
+				if (DistanceSquared <= RadiusSquared) {
+					return false;
+				}
+
+				const float OneMinusCosThetaMax{ GetOneMinusCosThetaMax(DistanceSquared, RadiusSquared) };
+				const float CosTheta{ 1.0f - RandomValues.x * OneMinusCosThetaMax };
+				const float SinTheta{ sqrtf(std::max(1.0f - CosTheta * CosTheta, 0.0f)) };
+				const float Phi{ 2.0f * ( float )M_PI * RandomValues.y };
+				const float Distance{ sqrtf(DistanceSquared) };
+
+				// Orthonormal basis around the direction of the Sphere's center, after Duff et al.
+				const float3 W{ ToCenter / Distance };
+				const float Sign{ copysignf(1.0f, W.z) };
+				const float a{ -1.0f / (Sign + W.z) }, b{ W.x * W.y * a };
+				const float3 U{ 1.0f + Sign * W.x * W.x * a, Sign * b, -Sign * W.x }, V{ b, Sign + W.y * W.y * a, -W.y };
+
+				Sample.WSDirection = normalize(U * (cosf(Phi) * SinTheta) + V * (sinf(Phi) * SinTheta) + W * CosTheta);
+				Sample.WSDistance = Distance * CosTheta - sqrtf(std::max(RadiusSquared - DistanceSquared * SinTheta * SinTheta, 0.0f));
+				Sample.PDF = 1.0f / (2.0f * ( float )M_PI * OneMinusCosThetaMax);
+				MaterialIndex = Resources.Spheres[Index].MaterialIndex;
+
+				break;
+			}
+			case 1: {
+				RectangleStuff::RectangleRecord MovingRectangle;
+				const RectangleStuff::RectangleRecord& Record{ GetRectangleRecord(Resources, Index, Time, MovingRectangle) };
+
+				if (!CreateAreaLightSample(WSPoint, RectangleStuff::GetRectanglePoint(Record, RandomValues.x, RandomValues.y), Record.Normal,
+						RectangleStuff::GetRectangleArea(Record), Sample)) {
+					return false;
+				}
+
+				MaterialIndex = Resources.Rectangles[Index].MaterialIndex;
+
+				break;
+			}
+			default: {
+				TriangleStuff::TriangleRecord MovingTriangle;
+				const TriangleStuff::TriangleRecord& Record{ GetTriangleRecord(Resources, Index, Time, MovingTriangle) };
+
+				if (!CreateAreaLightSample(WSPoint, TriangleStuff::GetTrianglePoint(Record, RandomValues.x, RandomValues.y), Record.Normal,
+						TriangleStuff::GetTriangleArea(Record), Sample)) {
+					return false;
+				}
+
+				MaterialIndex = Resources.Triangles[Index].MaterialIndex;
+
+				break;
+			}
+		}
+
+		Sample.Radiance = GetColor(Resources, MaterialIndex, Time);
+		return std::isfinite(Sample.PDF) && Sample.PDF > 0.0f;
+	}
+
+	// Whether a hit is on one of the Lights, whose light was already gathered, at least in part, if the previous hit sampled the lights.
+	inline bool IsSampledLight(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		return HitRecord.MaterialId == 5u &&
+			LightStuff::GetLightIndex(*Resources.Lights, HitRecord.PrimitiveId, HitRecord.ObjectId) != LightStuff::NoLightIndex;
+	}
+
+	// Whether a hit samples the Lights: Diffuse hits, and under MultipleImportance, Metallic hits with any fuzz.
+	inline bool SamplesLights(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		if (Resources.Lights == nullptr) {
+			return false;
+		}
+
+		return HitRecord.MaterialId == 2u ||
+			(HitRecord.MaterialId == 4u && Resources.LightSampling == LightStuff::LightSamplingType::MultipleImportance &&
+				GetMaterialScalar(Resources, HitRecord) > 0.0f);
+	}
+
+	// Density over solid angle that light sampling picks the point of a sampled light that a hit is on with, from where its Path started.
+	inline float GetLightPDF(const PipelineResources& Resources, const IntersectionRecord& HitRecord) {
+		const float3 WSPathOrigin{ HitRecord.WSIntersectionPoint - HitRecord.WSIncomingPathDirection * HitRecord.WStDistance };
+		const float SelectionProbability{ LightStuff::GetSelectionProbability(*Resources.Lights, WSPathOrigin, HitRecord.PrimitiveId, HitRecord.ObjectId) };
+		float PDF{ 0.0f };
+
+		if (HitRecord.PrimitiveId == 0) {
+			Sphere MovingSphere;
+			const Sphere& LightSphere{ GetSphere(Resources, HitRecord.ObjectId, HitRecord.Time, MovingSphere) };
+			const float3 ToCenter{ LightSphere.WSOrigin - WSPathOrigin };
+			const float DistanceSquared{ dot(ToCenter, ToCenter) }, RadiusSquared{ LightSphere.WSRadius * LightSphere.WSRadius };
+
+			if (DistanceSquared > RadiusSquared) {
+				PDF = 1.0f / (2.0f * ( float )M_PI * GetOneMinusCosThetaMax(DistanceSquared, RadiusSquared));
+			}
+		} else if (HitRecord.PrimitiveId == 1) {
+			RectangleStuff::RectangleRecord MovingRectangle;
+			const RectangleStuff::RectangleRecord& Record{ GetRectangleRecord(Resources, HitRecord.ObjectId, HitRecord.Time, MovingRectangle) };
+			PDF = HitRecord.WStDistance * HitRecord.WStDistance /
+				(RectangleStuff::GetRectangleArea(Record) * fabsf(dot(Record.Normal, HitRecord.WSIncomingPathDirection)));
+		} else {
+			TriangleStuff::TriangleRecord MovingTriangle;
+			const TriangleStuff::TriangleRecord& Record{ GetTriangleRecord(Resources, HitRecord.ObjectId, HitRecord.Time, MovingTriangle) };
+			PDF = HitRecord.WStDistance * HitRecord.WStDistance /
+				(TriangleStuff::GetTriangleArea(Record) * fabsf(dot(Record.Normal, HitRecord.WSIncomingPathDirection)));
+		}
+
+		return std::isfinite(PDF) ? SelectionProbability * PDF : 0.0f;
+	}
+
+	// Weight of the light that a hit supplies, given whether the previous hit sampled the lights and the density that it scattered the Path with.
+	// 1 unless the hit is on one of the Lights that the previous hit sampled, zero under NextEvent, and the power heuristic under MultipleImportance.
+	inline float GetEmissionWeight(const PipelineResources& Resources, const IntersectionRecord& HitRecord, bool LightsSampled, float ScatteringPDF) {
+		if (!LightsSampled || !IsSampledLight(Resources, HitRecord)) {
+			return 1.0f;
+		}
+
+		if (Resources.LightSampling != LightStuff::LightSamplingType::MultipleImportance) {
+			return 0.0f;
+		}
+
+		return PowerHeuristic(ScatteringPDF, GetLightPDF(Resources, HitRecord));
+	}
+
+	/*
+		RESERVOIR SAMPLING:
+			Under Reservoir, every sample starts with two passes over the frame while the shutter is closed. The first traces each pixel's camera
+			path to its first hit, and if that is Diffuse, streams ReservoirCandidateCount points through a LightReservoir, each on a light chosen
+			like SampleDirectLight() chooses one and sampled uniformly over its area, weighted by its unshadowed contribution to the hit over the
+			density that it was sampled with. It then takes in the pixel's reservoir from the previous sample, which carries over between frames,
+			with its count capped at MaxReservoirHistory samples' worth of candidates so that it keeps following the scene. The second takes in
+			the reservoirs of ReservoirNeighborCount pixels within ReservoirNeighborRadius whose first hits face the same way at about the same
+			depth. Reservoirs are combined after Bitterli et al.'s unbiased reuse, which normalizes the point kept by the counts of only those
+			inputs whose surface it lights, so that neighbors that cannot see a light never darken the pixels that do. The first Diffuse hit of
+			the camera path then casts a single shadow path towards its pixel's point, weighted by the reservoir's ContributionWeight. Visibility
+			is left out of the resampling, so the image converges to NextEvent's, though shadowed surfaces keep more of their noise.
+	*/
+	constexpr uint ReservoirCandidateCount{ 32u };// Points sampled on the lights for each pixel by every sample.
+	constexpr uint ReservoirNeighborCount{ 4u };
+	constexpr float ReservoirNeighborRadius{ 16.0f };// In pixels.
+	constexpr float MaxReservoirHistory{ 20.0f };
+	constexpr float ReservoirNormalThreshold{ 0.9f };// Least cosine between the normals of first hits that share their reservoirs.
+	constexpr float ReservoirDepthThreshold{ 0.1f };// Largest difference between the depths of first hits that share their reservoirs, relative to either.
+	constexpr uint DimensionsPerReservoirPass{ 4u * (ReservoirCandidateCount + 1u + ReservoirNeighborCount) };
+
+	// First dimension of the random values consumed by the reservoir passes of the current frame. Candidate j takes 4j + 0 for its light,
+	// + 1, 2 for its point and + 3 to be kept, the previous sample's reservoir 4C + 0 to be kept, and neighbor n 4(C + 1 + n) + 0, 1 for its
+	// offset and + 2 to be kept.
+	inline uint GetReservoirDimension(const PipelineResources& Resources) {
+		return GetBounceDimension(Resources.RootConstants.MaxRecursionDepth) + Resources.ReservoirFrameIndex * DimensionsPerReservoirPass;
+	}
+
+	// Unshadowed light that the point of a light behind a packed reference, at given coordinates, sends off a Diffuse surface, weighted like a
+	// sample of SampleDirectLight(), per unit of the light's area. The Sample's Radiance holds that contribution, and its PDF the density over
+	// area that the point is sampled with. Returns false if there is none, such as from the far side of a Sphere, or from a light not in the list.
+	inline bool GetReservoirContribution(const PipelineResources& Resources, const LightStuff::ReservoirSurface& Surface, uint Reference,
+		float2 Coordinates, LightSample& Sample) {
+		const uint PrimitiveId{ BVHStuff::GetReferencePrimitiveId(Reference) }, Index{ BVHStuff::GetReferenceIndex(Reference) };
+
+		if (Reference == LightStuff::NoLightReference || LightStuff::GetLightIndex(*Resources.Lights, PrimitiveId, Index) == LightStuff::NoLightIndex) {
+			return false;
+		}
+
+		const float Time{ Resources.Shutter.Open };
+		float3 WSLightPoint, LightNormal;
+		float LightArea;
+		uint MaterialIndex;
+
+		switch (PrimitiveId) {
+			case 0: {
+				Sphere MovingSphere;
+				const Sphere& LightSphere{ GetSphere(Resources, Index, Time, MovingSphere) };
+				const float CosTheta{ 1.0f - 2.0f * Coordinates.x };
+				const float SinTheta{ sqrtf(std::max(1.0f - CosTheta * CosTheta, 0.0f)) };
+				const float Phi{ 2.0f * ( float )M_PI * Coordinates.y };
+
+				LightNormal = float3{ cosf(Phi) * SinTheta, sinf(Phi) * SinTheta, CosTheta };
+				WSLightPoint = LightSphere.WSOrigin + LightNormal * fabsf(LightSphere.WSRadius);
+				LightArea = 4.0f * ( float )M_PI * LightSphere.WSRadius * LightSphere.WSRadius;
+				MaterialIndex = Resources.Spheres[Index].MaterialIndex;
+
+				break;
+			}
+			case 1: {
+				RectangleStuff::RectangleRecord MovingRectangle;
+				const RectangleStuff::RectangleRecord& Record{ GetRectangleRecord(Resources, Index, Time, MovingRectangle) };
+
+				WSLightPoint = RectangleStuff::GetRectanglePoint(Record, Coordinates.x, Coordinates.y);
+				LightNormal = Record.Normal;
+				LightArea = RectangleStuff::GetRectangleArea(Record);
+				MaterialIndex = Resources.Rectangles[Index].MaterialIndex;
+
+				break;
+			}
+			default: {
+				TriangleStuff::TriangleRecord MovingTriangle;
+				const TriangleStuff::TriangleRecord& Record{ GetTriangleRecord(Resources, Index, Time, MovingTriangle) };
+
+				WSLightPoint = TriangleStuff::GetTrianglePoint(Record, Coordinates.x, Coordinates.y);
+				LightNormal = Record.Normal;
+				LightArea = TriangleStuff::GetTriangleArea(Record);
+				MaterialIndex = Resources.Triangles[Index].MaterialIndex;
+
+				break;
+			}
+		}
+
+		const float3 ToLight{ WSLightPoint - Surface.WSPoint };
+		const float DistanceSquared{ dot(ToLight, ToLight) };
+
+		Sample.WSDistance = sqrtf(DistanceSquared);
+		Sample.WSDirection = ToLight / Sample.WSDistance;
+
+		// Rectangles and Triangles are seen from both sides, a point of a Sphere only from the side that faces away from its center.
+		const float CosLight{ PrimitiveId == 0u ? -dot(LightNormal, Sample.WSDirection) : fabsf(dot(LightNormal, Sample.WSDirection)) };
+		const float DiffusePDF{ GetDiffusePDF(Surface.WSNormal, Sample.WSDirection) };
+
+		if (!(CosLight > 0.0f) || !(DiffusePDF > 0.0f) || !(LightArea > 0.0f)) {
+			return false;
+		}
+
+		Sample.Radiance = GetColor(Resources, MaterialIndex, Time) * (DiffusePDF * CosLight / DistanceSquared);
+		Sample.PDF = 1.0f / LightArea;
+
+		return std::isfinite(Sample.Radiance.x + Sample.Radiance.y + Sample.Radiance.z);
+	}
+
+	// Density, up to its normalization, that the reservoirs resample points on the lights with, from their contribution.
+	inline float GetReservoirTarget(const float3& Contribution) {
+		return (Contribution.x + Contribution.y + Contribution.z) / 3.0f;
+	}
+
+	// Whether the first hits of two pixels, or of one pixel in two samples, are alike enough to share their reservoirs.
+	inline bool AreSimilarSurfaces(const LightStuff::ReservoirSurface& Surface, const LightStuff::ReservoirSurface& OtherSurface) {
+		return OtherSurface.IsValid != 0u && dot(Surface.WSNormal, OtherSurface.WSNormal) >= ReservoirNormalThreshold &&
+			fabsf(OtherSurface.WStDistance - Surface.WStDistance) <= ReservoirDepthThreshold * std::min(Surface.WStDistance, OtherSurface.WStDistance);
+	}
+
+	// Resamples a light point for a pixel's first hit from ReservoirCandidateCount fresh candidates, each on a light chosen like SampleDirectLight()
+	// chooses one and sampled uniformly over its area.
+	inline void SampleReservoirCandidates(
+		const PipelineResources& Resources, uint2 GridThreadId, const LightStuff::ReservoirSurface& Surface, LightStuff::LightReservoir& Reservoir) {
+		const LightStuff::LightList& Lights{ *Resources.Lights };
+		const uint FirstDimension{ GetReservoirDimension(Resources) };
+		float KeptTarget{ 0.0f };
+
+		Reservoir = LightStuff::LightReservoir{};
+
+		for (uint i{ 0u }; i < ReservoirCandidateCount; i++) {
+			const uint Dimension{ FirstDimension + i * 4u };
+			float SelectionProbability;
+			const uint LightIndex{
+				LightStuff::SelectLight(Lights, Surface.WSPoint, GetRandomFloat(Resources, GridThreadId, Dimension), SelectionProbability) };
+			const uint Reference{ LightIndex != LightStuff::NoLightIndex ? Lights.References[LightIndex] : LightStuff::NoLightReference };
+			const float2 Coordinates{ GetRandomFloat(Resources, GridThreadId, Dimension + 1u), GetRandomFloat(Resources, GridThreadId, Dimension + 2u) };
+			float Target{ 0.0f }, Weight{ 0.0f };
+			LightSample Sample;
+
+			if (GetReservoirContribution(Resources, Surface, Reference, Coordinates, Sample)) {
+				Target = GetReservoirTarget(Sample.Radiance);
+				Weight = Target / (SelectionProbability * Sample.PDF);
+			}
+
+			if (LightStuff::UpdateReservoir(Reservoir, Reference, Coordinates, std::isfinite(Weight) ? Weight : 0.0f, 1.0f,
+					GetRandomFloat(Resources, GridThreadId, Dimension + 3u))) {
+				KeptTarget = Target;
+			}
+		}
+
+		Reservoir.ContributionWeight = KeptTarget > 0.0f ? Reservoir.WeightSum / (Reservoir.SampleCount * KeptTarget) : 0.0f;
+	}
+
+	// Combines reservoirs resampled for the first hits of other pixels or samples into one for a given surface. Each takes its point in with its
+	// count as a weight, and the point kept is normalized by the counts of only those inputs whose own surface it lights. RandomValues holds one
+	// value for each input, of which the first's is never needed, as that one is always kept while it has any weight.
+	inline void CombineReservoirs(const PipelineResources& Resources, const LightStuff::ReservoirSurface& Surface,
+		const LightStuff::LightReservoir* const* Inputs, const LightStuff::ReservoirSurface* const* InputSurfaces, const float* RandomValues, uint InputCount,
+		LightStuff::LightReservoir& Reservoir) {
+		LightStuff::LightReservoir Combined{};
+		float KeptTarget{ 0.0f };
+
+		for (uint i{ 0u }; i < InputCount; i++) {
+			LightSample Sample;
+			float Target{ 0.0f };
+
+			if (GetReservoirContribution(Resources, Surface, Inputs[i]->Reference, Inputs[i]->Coordinates, Sample)) {
+				Target = GetReservoirTarget(Sample.Radiance);
+			}
+
+			const float Weight{ Target * Inputs[i]->ContributionWeight * Inputs[i]->SampleCount };
+
+			if (LightStuff::UpdateReservoir(
+					Combined, Inputs[i]->Reference, Inputs[i]->Coordinates, std::isfinite(Weight) ? Weight : 0.0f, Inputs[i]->SampleCount, RandomValues[i])) {
+				KeptTarget = Target;
+			}
+		}
+
+		float SampleCount{ 0.0f };
+
+		for (uint i{ 0u }; i < InputCount && KeptTarget > 0.0f; i++) {
+			LightSample Sample;
+
+			if (GetReservoirContribution(Resources, *InputSurfaces[i], Combined.Reference, Combined.Coordinates, Sample)) {
+				SampleCount += Inputs[i]->SampleCount;
+			}
+		}
+
+		Combined.ContributionWeight = KeptTarget > 0.0f && SampleCount > 0.0f ? Combined.WeightSum / (SampleCount * KeptTarget) : 0.0f;
+		Reservoir = Combined;
+	}
+
+	// Reservoir-pass 1: Trace a pixel's camera path to its first hit, and resample a light point for it from fresh candidates and the pixel's
+	// reservoir from the previous sample, into its Temporal Reservoir. Returns the number of paths that were cast.
+	inline uint64_t ExecuteTemporalReservoirPass(const PipelineResources& Resources, uint2 GridThreadId) {
+		Path CameraPath;
+		CreateCameraPath(Resources, GridThreadId, CameraPath);
+
+		IntersectionRecord HitRecord{};
+		CreateIntersectionRecord(Resources, CameraPath, HitRecord);
+
+		const size_t PixelIndex{ GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u) };
+		const LightStuff::ReservoirSurface PreviousSurface{ Resources.ReservoirSurfaces[PixelIndex] };
+		LightStuff::ReservoirSurface& Surface{ Resources.ReservoirSurfaces[PixelIndex] };
+		LightStuff::LightReservoir& TemporalReservoir{ Resources.TemporalReservoirs[PixelIndex] };
+
+		// Only hits that SampleDirectLight() would gather light for keep a reservoir.
+		Surface = LightStuff::ReservoirSurface{};
+		TemporalReservoir = LightStuff::LightReservoir{};
+
+		if (HitRecord.MaterialId != 2u || Resources.Lights->References.empty() || 2u >= Resources.RootConstants.MaxRecursionDepth) {
+			return 1u;
+		}
+
+		Surface = LightStuff::ReservoirSurface{ HitRecord.WSIntersectionPoint, GetSurfaceNormal(Resources, HitRecord), HitRecord.WStDistance, 1u };
+
+		LightStuff::LightReservoir CandidateReservoir;
+		SampleReservoirCandidates(Resources, GridThreadId, Surface, CandidateReservoir);
+
+		if (!AreSimilarSurfaces(Surface, PreviousSurface)) {
+			TemporalReservoir = CandidateReservoir;
+
+			return 1u;
+		}
+
+		LightStuff::LightReservoir PreviousReservoir{ Resources.Reservoirs[PixelIndex] };
+		PreviousReservoir.SampleCount = std::min(PreviousReservoir.SampleCount, MaxReservoirHistory * ReservoirCandidateCount);
+
+		const LightStuff::LightReservoir* Inputs[2]{ &CandidateReservoir, &PreviousReservoir };
+		const LightStuff::ReservoirSurface* InputSurfaces[2]{ &Surface, &PreviousSurface };
+		const float RandomValues[2]{ 0.0f, GetRandomFloat(Resources, GridThreadId, GetReservoirDimension(Resources) + 4u * ReservoirCandidateCount) };
+
+		CombineReservoirs(Resources, Surface, Inputs, InputSurfaces, RandomValues, 2u, TemporalReservoir);
+
+		return 1u;
+	}
+
+	// Reservoir-pass 2: Resample a light point for a pixel's first hit from its Temporal Reservoir and those of nearby pixels with alike first hits,
+	// into its Reservoir, which the first hit of its camera path then gathers the light of.
+	inline void ExecuteSpatialReservoirPass(const PipelineResources& Resources, uint2 GridThreadId) {
+		const size_t PixelIndex{ GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u) };
+		const LightStuff::ReservoirSurface& Surface{ Resources.ReservoirSurfaces[PixelIndex] };
+
+		if (Surface.IsValid == 0u) {
+			Resources.Reservoirs[PixelIndex] = LightStuff::LightReservoir{};
+
+			return;
+		}
+
+		const LightStuff::LightReservoir* Inputs[ReservoirNeighborCount + 1u]{ &Resources.TemporalReservoirs[PixelIndex] };
+		const LightStuff::ReservoirSurface* InputSurfaces[ReservoirNeighborCount + 1u]{ &Surface };
+		float RandomValues[ReservoirNeighborCount + 1u]{ 0.0f };
+		uint InputCount{ 1u };
+
+		for (uint i{ 0u }; i < ReservoirNeighborCount; i++) {
+			const uint Dimension{ GetReservoirDimension(Resources) + 4u * (ReservoirCandidateCount + 1u + i) };
+			const float Radius{ ReservoirNeighborRadius * sqrtf(GetRandomFloat(Resources, GridThreadId, Dimension)) };
+			const float Phi{ 2.0f * ( float )M_PI * GetRandomFloat(Resources, GridThreadId, Dimension + 1u) };
+			const int x{ ( int )GridThreadId.x + ( int )floorf(Radius * cosf(Phi) + 0.5f) };
+			const int y{ ( int )GridThreadId.y + ( int )floorf(Radius * sinf(Phi) + 0.5f) };
+
+			if (x < 0 || y < 0 || x >= ( int )Resources.RootConstants.TSGridDimensions.x || y >= ( int )Resources.RootConstants.TSGridDimensions.y ||
+				(( uint )x == GridThreadId.x && ( uint )y == GridThreadId.y)) {
+				continue;
+			}
+
+			const size_t NeighborIndex{ GetTexelIndex(Resources, ( uint )x, ( uint )y, 0u) };
+
+			if (!AreSimilarSurfaces(Surface, Resources.ReservoirSurfaces[NeighborIndex])) {
+				continue;
+			}
+
+			Inputs[InputCount] = &Resources.TemporalReservoirs[NeighborIndex];
+			InputSurfaces[InputCount] = &Resources.ReservoirSurfaces[NeighborIndex];
+			RandomValues[InputCount] = GetRandomFloat(Resources, GridThreadId, Dimension + 2u);
+			InputCount++;
+		}
+
+		CombineReservoirs(Resources, Surface, Inputs, InputSurfaces, RandomValues, InputCount, Resources.Reservoirs[PixelIndex]);
+	}
+
+	// Estimate of the light that reaches the first hit of a pixel's camera path from the point kept in the pixel's Reservoir, to be scaled by the
+	// Path's throughput past the hit. Returns whether a shadow path was cast.
+	inline bool GatherReservoirLight(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord, float3& DirectLight) {
+		const LightStuff::LightReservoir& Reservoir{ Resources.Reservoirs[GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u)] };
+		const LightStuff::ReservoirSurface Surface{ HitRecord.WSIntersectionPoint, GetSurfaceNormal(Resources, HitRecord), HitRecord.WStDistance, 1u };
+		LightSample Sample;
+
+		DirectLight = float3{};
+
+		if (!(Reservoir.ContributionWeight > 0.0f) || !GetReservoirContribution(Resources, Surface, Reservoir.Reference, Reservoir.Coordinates, Sample)) {
+			return false;
+		}
+
+		if (IsOccluded(Resources, Path{ HitRecord.WSIntersectionPoint, Sample.WSDirection, HitRecord.Time }, Sample.WSDistance * ShadowPathDistanceScale)) {
+			return true;
+		}
+
+		DirectLight = Sample.Radiance * Reservoir.ContributionWeight;
+
+		return true;
+	}
+
+	// Estimate of the light that reaches a hit straight from the Lights, to be scaled by the Path's throughput past the hit.
+	// Returns whether a shadow path was cast.
+	inline bool SampleDirectLight(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord, float3& DirectLight) {
+		const LightStuff::LightList& Lights{ *Resources.Lights };
+		DirectLight = float3{};
+
+		// A light hit by the next bounce only supplies a Payload below MaxRecursionDepth - 1.
+		if (Lights.References.empty() || HitRecord.CurrentRecursionDepth + 2u >= Resources.RootConstants.MaxRecursionDepth) {
+			return false;
+		}
+
+		if (Resources.Reservoirs != nullptr && HitRecord.CurrentRecursionDepth == 0u) {
+			return GatherReservoirLight(Resources, GridThreadId, HitRecord, DirectLight);
+		}
+
+		const uint Dimension{ GetBounceDimension(HitRecord.CurrentRecursionDepth) };
+		float SelectionProbability;
+		const uint LightIndex{
+			LightStuff::SelectLight(Lights, HitRecord.WSIntersectionPoint, GetRandomFloat(Resources, GridThreadId, Dimension + 7u), SelectionProbability) };
+		LightSample Sample;
+
+		if (LightIndex == LightStuff::NoLightIndex || !SampleLight(Resources, Lights.References[LightIndex], HitRecord.WSIntersectionPoint, HitRecord.Time,
+				float2{ GetRandomFloat(Resources, GridThreadId, Dimension + 5u), GetRandomFloat(Resources, GridThreadId, Dimension + 6u) }, Sample)) {
+			return false;
+		}
+
+		const float ScatteringPDF{ GetScatteringPDF(Resources, HitRecord, Sample.WSDirection) };
+
+		if (!(ScatteringPDF > 0.0f) || !std::isfinite(ScatteringPDF)) {
+			return false;
+		}
+
+		if (IsOccluded(Resources, Path{ HitRecord.WSIntersectionPoint, Sample.WSDirection, HitRecord.Time }, Sample.WSDistance * ShadowPathDistanceScale)) {
+			return true;
+		}
+
+		DirectLight = Sample.Radiance * (ScatteringPDF / (SelectionProbability * Sample.PDF));
+
+		if (Resources.LightSampling == LightStuff::LightSamplingType::MultipleImportance) {
+			DirectLight = DirectLight * PowerHeuristic(SelectionProbability * Sample.PDF, ScatteringPDF);
+		}
+
+		return true;
+	}
+
+	// Updates the current Path's direction, depending on which kind of material it hit.
+	inline void UpdatePath(const PipelineResources& Resources, uint2 GridThreadId, const IntersectionRecord& HitRecord, Path& CurrentPath) {
+		switch (HitRecord.MaterialId) {
+			// Miss/Sky
+			case 0:
+				UpdatePathFromSkyIntersection(HitRecord, CurrentPath);
+
+				break;
+			// Surface Normal Map
+			case 1:
+				UpdatePathFromSurfaceNormalIntersection(Resources, HitRecord, CurrentPath);
+
+				break;
+			// Diffuse
+			case 2:
+				UpdatePathFromDiffuseIntersection(Resources, GridThreadId, HitRecord, CurrentPath);
+
+				break;
+			// Dielectric
+			case 3:
+				UpdatePathFromDielectricIntersection(Resources, GridThreadId, HitRecord, CurrentPath);
+
+				break;
+			// Metallic
+			case 4:
+				UpdatePathFromMetallicIntersection(Resources, GridThreadId, HitRecord, CurrentPath);
+
+				break;
+			// Diffuse Light
+			case 5:
+				UpdatePathFromDiffuseLightIntersection(Resources, GridThreadId, HitRecord, CurrentPath);
+
+				break;
+		}
+	}
+
+	// Updates the current Path's Payload, depending on which kind of material it hit.
+	inline void UpdatePayload(const PipelineResources& Resources, const IntersectionRecord& HitRecord, PathPayload& Payload) {
+		switch (HitRecord.MaterialId) {
+			// Miss/Sky
+			case 0:
+				UpdatePayloadFromSkyIntersection(Resources, HitRecord, Payload);
+
+				break;
+			// Surface Normal Map
+			case 1:
+				UpdatePayloadFromSurfaceNormalIntersection(Resources, HitRecord, Payload);
+
+				break;
+			// Diffuse
+			case 2:
+				UpdatePayloadFromDiffuseIntersection(Resources, HitRecord, Payload);
+
+				break;
+			// Dielectric
+			case 3:
+				UpdatePayloadFromDielectricIntersection(Resources, HitRecord, Payload);
+
+				break;
+			// Metallic
+			case 4:
+				UpdatePayloadFromMetallicIntersection(Resources, HitRecord, Payload);
+
+				break;
+			// Diffuse Light
+			case 5:
+				UpdatePayloadFromDiffuseLightIntersection(Resources, HitRecord, Payload);
+
+				break;
+		}
+	}
+
+	// Paths that a pass cast, with the shadow paths of light sampling kept apart, so that PathCount compares with full-depth paths under any of it.
+	struct PathCounts {
+		uint64_t PathCount{ 0u };// Camera paths and the paths that they scatter into.
+		uint64_t ShadowPathCount{ 0u };// Shadow paths, and the camera paths that the reservoir passes trace ahead of the pass.
+
+		PathCounts& operator+=(const PathCounts& Other) {
+			this->PathCount += Other.PathCount;
+			this->ShadowPathCount += Other.ShadowPathCount;
+			return *this;
+		}
+	};
+
+	// Render-pass 1: Generate the Intersection Map for a single pixel. Returns the number of paths that were cast.
+	// The camera path can be handed in with its first IntersectionRecord, when it was already traced in a packet.
+	inline PathCounts ExecuteRenderPass1(const PipelineResources& Resources, uint2 GridThreadId, const TracedCameraPath* pTracedCameraPath = nullptr) {
+		Path CurrentPath;
+
+		if (pTracedCameraPath != nullptr) {
+			CurrentPath = pTracedCameraPath->CameraPath;
+		} else {
+			CreateCameraPath(Resources, GridThreadId, CurrentPath);
+		}
+
+		float3 Throughput{ 1.0f, 1.0f, 1.0f };
+		uint PathLength{ Resources.RootConstants.MaxRecursionDepth };
+		uint64_t ShadowPathCount{ 0u };
+		bool LightsSampled{ false };// Whether the previous hit already gathered the light of the sampled lights.
+		float ScatteringPDF{ 0.0f };// Density that the previous hit scattered the Path with, under MultipleImportance.
+
+		for (int CurrentRecursionDepth = { 0 }; CurrentRecursionDepth < ( int )Resources.RootConstants.MaxRecursionDepth; CurrentRecursionDepth++) {
+			IntersectionRecord HitRecord{};
+
+			if (CurrentRecursionDepth == 0 && pTracedCameraPath != nullptr) {
+				HitRecord = pTracedCameraPath->HitRecord;
+			} else {
+				HitRecord.CurrentRecursionDepth = CurrentRecursionDepth;
+				CreateIntersectionRecord(Resources, CurrentPath, HitRecord);
+			}
+
+			float RussianRouletteWeight{ 1.0f };
+			bool PathTerminated{ UpdateThroughput(Resources, GridThreadId, HitRecord, Throughput, RussianRouletteWeight) };
+
+			size_t IntersectionMapIndex{ GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, CurrentRecursionDepth) };
+
+			Resources.IntersectionMap01[IntersectionMapIndex] = { HitRecord.WSIntersectionPoint.x, HitRecord.WSIntersectionPoint.y,
+				HitRecord.WSIntersectionPoint.z, HitRecord.WStDistance };
+
+			Resources.IntersectionMap02[IntersectionMapIndex] = { HitRecord.WSIncomingPathDirection.x, HitRecord.WSIncomingPathDirection.y,
+				HitRecord.WSIncomingPathDirection.z, RussianRouletteWeight };
+
+			// The PrimitiveId takes the low three bits of the last channel, and an Instance's prototype triangle the rest.
+			Resources.IntersectionMap03[IntersectionMapIndex] = { HitRecord.ObjectId, HitRecord.MaterialIndex, HitRecord.CurrentRecursionDepth,
+				HitRecord.PrimitiveId | (HitRecord.PrototypeTriangleIndex << 3u) };
+
+			// The light gathered at a surviving hit that samples the lights is kept with its Color applied, and w weights the Payload behind it,
+			// which is a light's own when the previous hit sampled it.
+			if (Resources.IntersectionMap04 != nullptr) {
+				float4 DirectLightTexel{ 0.0f, 0.0f, 0.0f, GetEmissionWeight(Resources, HitRecord, LightsSampled, ScatteringPDF) };
+				LightsSampled = !PathTerminated && SamplesLights(Resources, HitRecord);
+
+				if (LightsSampled) {
+					float3 DirectLight;
+					ShadowPathCount += SampleDirectLight(Resources, GridThreadId, HitRecord, DirectLight) ? 1u : 0u;
+					DirectLight = DirectLight * GetColor(Resources, HitRecord);
+					DirectLightTexel = { DirectLight.x, DirectLight.y, DirectLight.z, 1.0f };
+				}
+
+				Resources.IntersectionMap04[IntersectionMapIndex] = DirectLightTexel;
+			}
+
+			if (PathTerminated) {
+				PathLength = CurrentRecursionDepth + 1;
+
+				break;
+			}
+
+			UpdatePath(Resources, GridThreadId, HitRecord, CurrentPath);
+
+			if (LightsSampled && Resources.LightSampling == LightStuff::LightSamplingType::MultipleImportance) {
+				ScatteringPDF = GetScatteringPDF(Resources, HitRecord, CurrentPath.WSDirection);
+			}
+		}
+
+		// The first record's depth is implicitly zero, so its slot holds the number of records written for this pixel.
+		Resources.IntersectionMap03[GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u)].z = PathLength;
+
+		return PathCounts{ PathLength, ShadowPathCount };
+	}
+
+	// Render-pass 2: Consume the Intersection Map of a single pixel, adding its Payload into the Accumulation Frame.
+	inline void ExecuteRenderPass2(const PipelineResources& Resources, uint2 GridThreadId) {
+		PathPayload CurrentPayload{};
+		// The Intersection Map has no slot for the Path's time, but the sampler hands Render-pass 2 the same one that Render-pass 1 traced at.
+		const float PathTime{ GetPathTime(Resources, GridThreadId) };
+
+		// Records past the Path's length were never written for this sample, so the walk starts at its last one.
+		uint PathLength{ Resources.IntersectionMap03[GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u)].z };
+
+		for (int CurrentRecursionDepth = { ( int )PathLength - 1 }; CurrentRecursionDepth >= 0; CurrentRecursionDepth--) {
+			size_t IntersectionMapIndex{ GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, CurrentRecursionDepth) };
+
+			const float4& IntersectionMap01{ Resources.IntersectionMap01[IntersectionMapIndex] };
+			const float4& IntersectionMap02{ Resources.IntersectionMap02[IntersectionMapIndex] };
+			const uint4& IntersectionMap03{ Resources.IntersectionMap03[IntersectionMapIndex] };
+
+			IntersectionRecord HitRecord;
+			HitRecord.WStDistance = IntersectionMap01.w;
+			HitRecord.WSIntersectionPoint = { IntersectionMap01.x, IntersectionMap01.y, IntersectionMap01.z };
+			HitRecord.WSIncomingPathDirection = { IntersectionMap02.x, IntersectionMap02.y, IntersectionMap02.z };
+			HitRecord.PrimitiveId = IntersectionMap03.w & 7u;
+			HitRecord.PrototypeTriangleIndex = IntersectionMap03.w >> 3u;
+			HitRecord.ObjectId = IntersectionMap03.x;
+			HitRecord.MaterialIndex = IntersectionMap03.y;
+			HitRecord.MaterialId = (HitRecord.MaterialIndex == NoMaterialIndex) ? 0u : Resources.Materials[HitRecord.MaterialIndex].MaterialId;
+			HitRecord.CurrentRecursionDepth = CurrentRecursionDepth;
+			HitRecord.Time = PathTime;
+
+			UpdatePayload(Resources, HitRecord, CurrentPayload);
+
+			if (Resources.IntersectionMap04 != nullptr) {
+				const float4& IntersectionMap04{ Resources.IntersectionMap04[IntersectionMapIndex] };
+
+				CurrentPayload.r = CurrentPayload.r * IntersectionMap04.w + IntersectionMap04.x;
+				CurrentPayload.g = CurrentPayload.g * IntersectionMap04.w + IntersectionMap04.y;
+				CurrentPayload.b = CurrentPayload.b * IntersectionMap04.w + IntersectionMap04.z;
+			}
+
+			// Compensate for the Russian roulette survival probability of this bounce.
+			CurrentPayload.r = CurrentPayload.r * IntersectionMap02.w;
+			CurrentPayload.g = CurrentPayload.g * IntersectionMap02.w;
+			CurrentPayload.b = CurrentPayload.b * IntersectionMap02.w;
+		}
+
+		float4& AccumulationTexel{ Resources.AccumulationFrame[GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u)] };
+		AccumulationTexel.x += CurrentPayload.r;
+		AccumulationTexel.y += CurrentPayload.g;
+		AccumulationTexel.z += CurrentPayload.b;
+	}
+
+	// Fused Render-pass: traces a single pixel's path while carrying its throughput forward, so no Intersection Map is stored.
+	// Produces the same Payload as Render-passes 1 and 2. Returns the number of paths that were cast.
+	inline PathCounts ExecuteFusedRenderPass(const PipelineResources& Resources, uint2 GridThreadId, const TracedCameraPath* pTracedCameraPath = nullptr) {
+		Path CurrentPath;
+
+		if (pTracedCameraPath != nullptr) {
+			CurrentPath = pTracedCameraPath->CameraPath;
+		} else {
+			CreateCameraPath(Resources, GridThreadId, CurrentPath);
+		}
+
+		float3 Throughput{ 1.0f, 1.0f, 1.0f };
+		PathPayload CurrentPayload{};
+		PathCounts Counts{};
+		bool LightsSampled{ false };// Whether the previous hit already gathered the light of the sampled lights.
+		float ScatteringPDF{ 0.0f };// Density that the previous hit scattered the Path with, under MultipleImportance.
+
+		for (int CurrentRecursionDepth = { 0 }; CurrentRecursionDepth < ( int )Resources.RootConstants.MaxRecursionDepth; CurrentRecursionDepth++) {
+			IntersectionRecord HitRecord{};
+
+			if (CurrentRecursionDepth == 0 && pTracedCameraPath != nullptr) {
+				HitRecord = pTracedCameraPath->HitRecord;
+			} else {
+				HitRecord.CurrentRecursionDepth = CurrentRecursionDepth;
+				CreateIntersectionRecord(Resources, CurrentPath, HitRecord);
+			}
+			Counts.PathCount++;
+
+			float3 PreviousThroughput{ Throughput };
+			float RussianRouletteWeight{ 1.0f };
+
+			if (UpdateThroughput(Resources, GridThreadId, HitRecord, Throughput, RussianRouletteWeight)) {
+				// Attenuating hits end the Path with no more energy, any other hit supplies the Payload that the throughput scales.
+				const float EmissionWeight{ GetEmissionWeight(Resources, HitRecord, LightsSampled, ScatteringPDF) };
+
+				if ((HitRecord.MaterialId == 0 || HitRecord.MaterialId == 1 || HitRecord.MaterialId == 5) && EmissionWeight > 0.0f) {
+					PathPayload EmittedPayload{};
+					UpdatePayload(Resources, HitRecord, EmittedPayload);
+
+					CurrentPayload.r += EmittedPayload.r * PreviousThroughput.x * EmissionWeight;
+					CurrentPayload.g += EmittedPayload.g * PreviousThroughput.y * EmissionWeight;
+					CurrentPayload.b += EmittedPayload.b * PreviousThroughput.z * EmissionWeight;
+				}
+
+				break;
+			}
+
+			LightsSampled = SamplesLights(Resources, HitRecord);
+
+			if (LightsSampled) {
+				float3 DirectLight;
+				Counts.ShadowPathCount += SampleDirectLight(Resources, GridThreadId, HitRecord, DirectLight) ? 1u : 0u;
+
+				CurrentPayload.r += DirectLight.x * Throughput.x;
+				CurrentPayload.g += DirectLight.y * Throughput.y;
+				CurrentPayload.b += DirectLight.z * Throughput.z;
+			}
+
+			UpdatePath(Resources, GridThreadId, HitRecord, CurrentPath);
+
+			if (LightsSampled && Resources.LightSampling == LightStuff::LightSamplingType::MultipleImportance) {
+				ScatteringPDF = GetScatteringPDF(Resources, HitRecord, CurrentPath.WSDirection);
+			}
+		}
+
+		float4& AccumulationTexel{ Resources.AccumulationFrame[GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u)] };
+		AccumulationTexel.x += CurrentPayload.r;
+		AccumulationTexel.y += CurrentPayload.g;
+		AccumulationTexel.z += CurrentPayload.b;
+
+		return Counts;
+	}
+
+	/*
+		WAVEFRONT:
+			Traces a band of pixels' paths one stage at a time, rather than each path from start to finish, keeping them in queues between stages.
+			Generate - Creates the camera paths of the band, traced as packets when the Resources test them.
+			Intersect - Finds the next hit of every path that is still active.
+			Shade - Bins the hits by Material ID, and runs each material's kernel over its dense batch, so neighbouring paths run the same code.
+			Accumulate - Adds the Payloads of the band's finished paths into the Accumulation Frame.
+			The paths that survive a bounce are compacted in their original order, so that the next Intersect walks neighbouring pixels together.
+			Produces the same Payloads as the Fused Render-pass.
+	*/
+	constexpr uint MaterialIdCount{ 6u };
+	constexpr uint WavefrontTargetPathCount{ 8192u };// Paths per wavefront, rounded to whole rows of ray packet tiles.
+
+	// Path state of one wavefront, reused by a thread from one wavefront to the next.
+	struct WavefrontQueues {
+		std::vector<Path> Paths{};
+		std::vector<IntersectionRecord> HitRecords{};
+		std::vector<float3> Throughputs{};
+		std::vector<PathPayload> Payloads{};
+		std::vector<uint2> GridThreadIds{};
+		std::vector<uint8_t> PathsTerminated{};
+		std::vector<uint8_t> LightsSampled{};// Whether a path's previous hit already gathered the light of the sampled lights.
+		std::vector<float> ScatteringPDFs{};// Density that a path's previous hit scattered it with, under MultipleImportance.
+		std::vector<uint> ActivePaths{};// Paths that are still being traced.
+		std::vector<uint> MaterialQueues[MaterialIdCount]{};// Active paths, binned by the Material ID of their latest hit.
+	};
+
+	inline uint64_t GetWavefrontQueuesSizeInBytes(const WavefrontQueues& Queues) {
+		uint64_t SizeInBytes{ Queues.Paths.capacity() * sizeof(Path) + Queues.HitRecords.capacity() * sizeof(IntersectionRecord) +
+			Queues.Throughputs.capacity() * sizeof(float3) + Queues.Payloads.capacity() * sizeof(PathPayload) +
+			Queues.GridThreadIds.capacity() * sizeof(uint2) + Queues.PathsTerminated.capacity() + Queues.LightsSampled.capacity() +
+			Queues.ScatteringPDFs.capacity() * sizeof(float) + Queues.ActivePaths.capacity() * sizeof(uint) };
+
+		for (const std::vector<uint>& MaterialQueue: Queues.MaterialQueues) {
+			SizeInBytes += MaterialQueue.capacity() * sizeof(uint);
+		}
+
+		return SizeInBytes;
+	}
+
+	// Generate: starts the camera paths of rows BeginY to EndY. Returns whether their first hits were already found, as packets.
+	inline bool GenerateWavefront(const PipelineResources& Resources, uint Width, uint BeginY, uint EndY, WavefrontQueues& Queues) {
+		const uint PathCount{ Width * (EndY - BeginY) };
+
+		Queues.Paths.resize(PathCount);
+		Queues.HitRecords.resize(PathCount);
+		Queues.Throughputs.assign(PathCount, float3{ 1.0f, 1.0f, 1.0f });
+		Queues.Payloads.assign(PathCount, PathPayload{});
+		Queues.GridThreadIds.resize(PathCount);
+		Queues.PathsTerminated.assign(PathCount, 0u);
+		Queues.LightsSampled.assign(PathCount, 0u);
+		Queues.ScatteringPDFs.assign(PathCount, 0.0f);
+		Queues.ActivePaths.resize(PathCount);
+
+		for (uint i{ 0u }; i < PathCount; i++) {
+			Queues.ActivePaths[i] = i;
+		}
+
+		if (Resources.IntersectRayPacket == nullptr) {
+			for (uint y{ BeginY }, i{ 0u }; y < EndY; y++) {
+				for (uint x{ 0u }; x < Width; x++, i++) {
+					Queues.GridThreadIds[i] = uint2{ x, y };
+					CreateCameraPath(Resources, Queues.GridThreadIds[i], Queues.Paths[i]);
+				}
+			}
+
+			return false;
+		}
+
+		// Paths are laid out tile by tile, so that each packet's paths stay neighbours in the queues.
+		TracedCameraPath TracedCameraPaths[SIMDStuff::RayPacketSize];
+		uint i{ 0u };
+
+		for (uint TileY{ BeginY }; TileY < EndY; TileY += RayPacketTileHeight) {
+			for (uint TileX{ 0u }; TileX < Width; TileX += RayPacketTileWidth) {
+				const uint FirstPath{ i };
+
+				for (uint y{ TileY }; y < std::min(TileY + RayPacketTileHeight, EndY); y++) {
+					for (uint x{ TileX }; x < std::min(TileX + RayPacketTileWidth, Width); x++, i++) {
+						Queues.GridThreadIds[i] = uint2{ x, y };
+						CreateCameraPath(Resources, Queues.GridThreadIds[i], TracedCameraPaths[i - FirstPath].CameraPath);
+					}
+				}
+
+				CreateIntersectionRecords(Resources, TracedCameraPaths, i - FirstPath);
+
+				for (uint j{ FirstPath }; j < i; j++) {
+					Queues.Paths[j] = TracedCameraPaths[j - FirstPath].CameraPath;
+					Queues.HitRecords[j] = TracedCameraPaths[j - FirstPath].HitRecord;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Intersect: finds the hit of every active path at a given path-depth.
+	inline void IntersectWavefront(const PipelineResources& Resources, uint CurrentRecursionDepth, WavefrontQueues& Queues) {
+		for (uint i: Queues.ActivePaths) {
+			IntersectionRecord& HitRecord{ Queues.HitRecords[i] };
+			HitRecord = IntersectionRecord{};
+			HitRecord.CurrentRecursionDepth = CurrentRecursionDepth;
+			CreateIntersectionRecord(Resources, Queues.Paths[i], HitRecord);
+		}
+	}
+
+	// Bins the active paths by the Material ID of their latest hit, keeping their order within each bin.
+	inline void BinWavefrontByMaterial(WavefrontQueues& Queues) {
+		for (std::vector<uint>& MaterialQueue: Queues.MaterialQueues) {
+			MaterialQueue.clear();
+		}
+
+		for (uint i: Queues.ActivePaths) {
+			Queues.MaterialQueues[Queues.HitRecords[i].MaterialId].push_back(i);
+		}
+	}
+
+	// Shade: the hits of a batch on the Sky, a Surface Normal Map or a Diffuse Light end their paths with the Payload that the material supplies.
+	template<void (*UpdatePayloadFunction)(const PipelineResources&, const IntersectionRecord&, PathPayload&)>
+	inline void ShadeEmittingHits(const PipelineResources& Resources, const std::vector<uint>& MaterialQueue, WavefrontQueues& Queues) {
+		for (uint i: MaterialQueue) {
+			Queues.PathsTerminated[i] = 1u;
+
+			const float EmissionWeight{ GetEmissionWeight(Resources, Queues.HitRecords[i], Queues.LightsSampled[i] != 0u, Queues.ScatteringPDFs[i]) };
+
+			if (!(EmissionWeight > 0.0f)) {
+				continue;
+			}
+
+			PathPayload EmittedPayload{};
+			UpdatePayloadFunction(Resources, Queues.HitRecords[i], EmittedPayload);
+
+			PathPayload& Payload{ Queues.Payloads[i] };
+			Payload.r += EmittedPayload.r * Queues.Throughputs[i].x * EmissionWeight;
+			Payload.g += EmittedPayload.g * Queues.Throughputs[i].y * EmissionWeight;
+			Payload.b += EmittedPayload.b * Queues.Throughputs[i].z * EmissionWeight;
+		}
+	}
+
+	// Shade: the hits of a batch on an attenuating material scale their paths' throughput, and scatter those that survive, after sampling the
+	// lights from those that sample them. Returns the number of shadow paths that were cast.
+	template<void (*UpdatePathFunction)(const PipelineResources&, uint2, const IntersectionRecord&, Path&)>
+	inline uint64_t ShadeAttenuatingHits(const PipelineResources& Resources, const std::vector<uint>& MaterialQueue, WavefrontQueues& Queues) {
+		uint64_t ShadowPathCount{ 0u };
+
+		for (uint i: MaterialQueue) {
+			float RussianRouletteWeight{ 1.0f };
+
+			if (UpdateThroughput(Resources, Queues.GridThreadIds[i], Queues.HitRecords[i], Queues.Throughputs[i], RussianRouletteWeight)) {
+				Queues.PathsTerminated[i] = 1u;
+
+				continue;
+			}
+
+			Queues.LightsSampled[i] = SamplesLights(Resources, Queues.HitRecords[i]);
+
+			if (Queues.LightsSampled[i] != 0u) {
+				float3 DirectLight;
+				ShadowPathCount += SampleDirectLight(Resources, Queues.GridThreadIds[i], Queues.HitRecords[i], DirectLight) ? 1u : 0u;
+
+				PathPayload& Payload{ Queues.Payloads[i] };
+				Payload.r += DirectLight.x * Queues.Throughputs[i].x;
+				Payload.g += DirectLight.y * Queues.Throughputs[i].y;
+				Payload.b += DirectLight.z * Queues.Throughputs[i].z;
+			}
+
+			UpdatePathFunction(Resources, Queues.GridThreadIds[i], Queues.HitRecords[i], Queues.Paths[i]);
+
+			if (Queues.LightsSampled[i] != 0u && Resources.LightSampling == LightStuff::LightSamplingType::MultipleImportance) {
+				Queues.ScatteringPDFs[i] = GetScatteringPDF(Resources, Queues.HitRecords[i], Queues.Paths[i].WSDirection);
+			}
+		}
+
+		return ShadowPathCount;
+	}
+
+	// Accumulate: adds the Payload of every path of the wavefront into the Accumulation Frame.
+	inline void AccumulateWavefront(const PipelineResources& Resources, const WavefrontQueues& Queues) {
+		for (size_t i{ 0u }; i < Queues.Paths.size(); i++) {
+			float4& AccumulationTexel{ Resources.AccumulationFrame[GetTexelIndex(Resources, Queues.GridThreadIds[i].x, Queues.GridThreadIds[i].y, 0u)] };
+			AccumulationTexel.x += Queues.Payloads[i].r;
+			AccumulationTexel.y += Queues.Payloads[i].g;
+			AccumulationTexel.z += Queues.Payloads[i].b;
+		}
+	}
+
+	// Wavefront Render-pass: traces the paths of rows BeginY to EndY through every stage. Returns the number of paths that were cast.
+	inline PathCounts ExecuteWavefrontRenderPass(const PipelineResources& Resources, uint Width, uint BeginY, uint EndY, WavefrontQueues& Queues) {
+		const bool CameraHitsFound{ GenerateWavefront(Resources, Width, BeginY, EndY, Queues) };
+		PathCounts Counts{};
+
+		for (uint CurrentRecursionDepth{ 0u }; CurrentRecursionDepth < Resources.RootConstants.MaxRecursionDepth && !Queues.ActivePaths.empty();
+			 CurrentRecursionDepth++) {
+			if (CurrentRecursionDepth > 0u || !CameraHitsFound) {
+				IntersectWavefront(Resources, CurrentRecursionDepth, Queues);
+			}
+
+			Counts.PathCount += Queues.ActivePaths.size();
+
+			BinWavefrontByMaterial(Queues);
+			ShadeEmittingHits<UpdatePayloadFromSkyIntersection>(Resources, Queues.MaterialQueues[0], Queues);
+			ShadeEmittingHits<UpdatePayloadFromSurfaceNormalIntersection>(Resources, Queues.MaterialQueues[1], Queues);
+			Counts.ShadowPathCount += ShadeAttenuatingHits<UpdatePathFromDiffuseIntersection>(Resources, Queues.MaterialQueues[2], Queues);
+			Counts.ShadowPathCount += ShadeAttenuatingHits<UpdatePathFromDielectricIntersection>(Resources, Queues.MaterialQueues[3], Queues);
+			Counts.ShadowPathCount += ShadeAttenuatingHits<UpdatePathFromMetallicIntersection>(Resources, Queues.MaterialQueues[4], Queues);
+			ShadeEmittingHits<UpdatePayloadFromDiffuseLightIntersection>(Resources, Queues.MaterialQueues[5], Queues);
+
+			auto IsPathTerminated = [&](uint i) {
+				return Queues.PathsTerminated[i] != 0u;
+			};
+			Queues.ActivePaths.erase(std::remove_if(Queues.ActivePaths.begin(), Queues.ActivePaths.end(), IsPathTerminated), Queues.ActivePaths.end());
+		}
+
+		AccumulateWavefront(Resources, Queues);
+
+		return Counts;
+	}
+
+	// Render-pass 3: Consume the Accumulation Frame of a single pixel to produce its Final Frame texel.
+	inline void ExecuteRenderPass3(const PipelineResources& Resources, uint2 GridThreadId) {
+		size_t TexelIndex{ GetTexelIndex(Resources, GridThreadId.x, GridThreadId.y, 0u) };
+		float4& AccumulationTexel{ Resources.AccumulationFrame[TexelIndex] };
+		CPUStuff::R8G8B8A8Uint& FinalTexel{ Resources.FinalFrame[TexelIndex] };
+
+		FinalTexel.R = CPUStuff::FloatToUnorm8(sqrtf(AccumulationTexel.x / ( float )Resources.RootConstants.SamplesPerPixel));
+		FinalTexel.G = CPUStuff::FloatToUnorm8(sqrtf(AccumulationTexel.y / ( float )Resources.RootConstants.SamplesPerPixel));
+		FinalTexel.B = CPUStuff::FloatToUnorm8(sqrtf(AccumulationTexel.z / ( float )Resources.RootConstants.SamplesPerPixel));
+		FinalTexel.A = 0u;
+
+		AccumulationTexel.x = 0.0f;
+		AccumulationTexel.y = 0.0f;
+		AccumulationTexel.z = 0.0f;
+	}
+
+	// Statistics gathered over one or more rendered frames.
+	struct RenderStats {
+		double RenderSeconds{ 0.0 };
+		double AccelerationBuildSeconds{ 0.0 };// Part of RenderSeconds spent building acceleration structures.
+		float AccelerationSAHCost{ 0.0f };// SAH cost of the acceleration structure as of the last frame.
+		uint AccelerationRebuildCount{ 0u };
+		uint AccelerationRefitCount{ 0u };
+		uint64_t PathCount{ 0u };// Number of camera paths and of the paths they scatter into, intersected against the scene.
+		uint64_t ShadowPathCount{ 0u };// Number of shadow paths, and of reservoir pass camera paths, that light sampling cast on top of those.
+		uint64_t SampleCount{ 0u };// Number of camera samples taken.
+		uint64_t FullDepthPathCount{ 0u };// Number of paths that would be cast if every sample ran to MaxRecursionDepth.
+		uint ThreadCount{ 1u };
+
+		double GetAveragePathLength() const {
+			return this->SampleCount > 0u ? ( double )this->PathCount / ( double )this->SampleCount : 0.0;
+		}
+
+		// Speedup of early termination and Russian roulette, in paths cast, over tracing every sample to MaxRecursionDepth.
+		double GetPathTerminationSpeedup() const {
+			return this->PathCount > 0u ? ( double )this->FullDepthPathCount / ( double )this->PathCount : 0.0;
+		}
+
+		// Every path traced through the scene, shadow paths included.
+		uint64_t GetRayCount() const {
+			return this->PathCount + this->ShadowPathCount;
+		}
+
+		double GetRaysPerSecond() const {
+			return this->RenderSeconds > 0.0 ? ( double )this->GetRayCount() / this->RenderSeconds : 0.0;
+		}
+
+		double GetRaysPerSecondPerCore() const {
+			return this->GetRaysPerSecond() / ( double )this->ThreadCount;
+		}
+	};
+
+	/*
+		RENDER MODE:
+			ThreePass - RP1 writes the Intersection Map, RP2 consumes it, as on the GPU.
+			Fused - One pass traces and shades each path, only the Accumulation Frame is stored.
+			Wavefront - Bands of paths go through each stage together, with their hits shaded in batches of one material.
+	*/
+	enum class RenderMode { ThreePass, Fused, Wavefront };
+
+	inline const char* GetRenderModeName(RenderMode Mode) {
+		switch (Mode) {
+			case RenderMode::ThreePass: {
+				return "three-pass";
+			}
+			case RenderMode::Fused: {
+				return "fused";
+			}
+			case RenderMode::Wavefront: {
+				return "wavefront";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Render mode of a given name, as GetRenderModeName() names them. Returns false for an unknown name.
+	inline bool GetRenderMode(const char* Name, RenderMode& Mode) {
+		for (RenderMode CurrentMode: { RenderMode::ThreePass, RenderMode::Fused, RenderMode::Wavefront }) {
+			if (strcmp(Name, GetRenderModeName(CurrentMode)) == 0) {
+				Mode = CurrentMode;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*
+		ACCELERATION STRUCTURE:
+			BruteForce - Every path is tested against every primitive, as on the GPU. While the shutter is closed, the Spheres are packed into arrays
+				once per frame and tested several at a time, with the widest SIMD kernel that the RendererConfig and the CPU allow.
+			BVH - Paths walk a BVH, which is refit to the scene's current state for every frame, or rebuilt by the RendererConfig's BVHBuildType once
+				refitting raises its SAH cost past BVHRebuildThreshold times that of its last build. While the shutter is open, its nodes also hold
+				their bounds at the shutter's open and close, which each path interpolates at its own time. Otherwise the camera paths of each tile
+				of RayPacketTileWidth by RayPacketTileHeight pixels are traced together as one packet, and go on as single paths from their first hit.
+	*/
+	enum class AccelerationStructureType { BruteForce, BVH };
+
+	// Options that a Renderer is created with.
+	struct RendererConfig {
+		RenderMode Mode{ RenderMode::ThreePass };
+		SamplerStuff::SamplerType SamplerType{ SamplerStuff::SamplerType::Independent };
+		uint SamplerSeed{ 0u };
+		AccelerationStructureType AccelerationStructure{ AccelerationStructureType::BVH };
+		BVHStuff::BVHBuildType BVHBuildType{ BVHStuff::BVHBuildType::BinnedSAH };
+		float BVHRebuildThreshold{ 1.5f };// Zero rebuilds the BVH for every frame.
+		float ShutterLength{ 0.0f };// Interpolation steps that each frame's shutter stays open for, zero renders a single instant.
+		SIMDStuff::SIMDLevel SIMDLevel{ SIMDStuff::GetSupportedSIMDLevel() };// Widest kernel for spheres of the brute-force search and for ray packets.
+		bool CameraRayPackets{ true };// Traces the camera paths in packets through the BVH, while the shutter is closed.
+		// Watertight by default, Legacy matches the Compute Shaders.
+		TriangleStuff::TriangleIntersector TriangleIntersector{ TriangleStuff::TriangleIntersector::Watertight };
+		LightStuff::LightSamplingType LightSampling{ LightStuff::LightSamplingType::None };// None matches the Compute Shaders.
+		LightStuff::LightSelectionType LightSelection{ LightStuff::LightSelectionType::Power };
+	};
+
+	// Executes the RP1/RP2/RP3 pipeline on the host, spreading each pass's rows across a thread pool.
+	class Renderer {
+	  protected:
+		CPUStuff::ThreadPool& ThreadPool;
+		RenderMode Mode{ RenderMode::ThreePass };
+		SamplerStuff::Sampler Sampler{};
+		AccelerationStructureType AccelerationStructure{ AccelerationStructureType::BVH };
+		BVHStuff::BVHBuildType BVHBuildType{ BVHStuff::BVHBuildType::BinnedSAH };
+		float BVHRebuildThreshold{ 1.5f };
+		float ShutterLength{ 0.0f };
+		SceneStuff::ShutterInterval Shutter{};
+		BVHStuff::BVH BVH{};
+		bool BVHIsPrebuilt{ false };// The BVH was handed over already built for the scene's current state, so the next frame uses it as it is.
+		SIMDStuff::PackedSpheres PackedSpheres{};
+		SIMDStuff::FindClosestSphereFunction FindClosestSphere{ nullptr };
+		bool CameraRayPackets{ true };
+		SIMDStuff::IntersectRayPacketFunction IntersectRayPacket{ nullptr };
+		TriangleStuff::TriangleIntersector TriangleIntersector{ TriangleStuff::TriangleIntersector::Watertight };
+		std::vector<RectangleStuff::RectangleRecord> RectangleRecords{};
+		std::vector<TriangleStuff::TriangleRecord> TriangleRecords{};
+		LightStuff::LightSamplingType LightSampling{ LightStuff::LightSamplingType::None };
+		LightStuff::LightSelectionType LightSelection{ LightStuff::LightSelectionType::Power };
+		LightStuff::LightList Lights{};// Rebuilt for every frame while LightSampling is not None.
+		std::vector<LightStuff::LightReservoir> Reservoirs{};// Kept from frame to frame while LightSampling is Reservoir.
+		std::vector<LightStuff::LightReservoir> TemporalReservoirs{};
+		std::vector<LightStuff::ReservoirSurface> ReservoirSurfaces{};
+		uint ReservoirFrameIndex{ 0u };
+		std::vector<float4> IntersectionMap01{};
+		std::vector<float4> IntersectionMap02{};
+		std::vector<uint4> IntersectionMap03{};
+		std::vector<float4> IntersectionMap04{};
+		std::vector<float4> AccumulationFrame{};
+		std::vector<CPUStuff::R8G8B8A8Uint> FinalFrame{};
+		std::vector<WavefrontQueues> ThreadWavefrontQueues{};// One per thread of the pool, in Wavefront mode.
+
+		PipelineResources GetPipelineResources(const SceneStuff::Scene& Scene) {
+			PipelineResources Resources{};
+			Resources.Spheres = Scene.Spheres.data();
+			Resources.Rectangles = Scene.Rectangles.data();
+			Resources.Triangles = Scene.Triangles.data();
+			Resources.Meshes = Scene.Meshes.data();
+			Resources.MeshIndices = Scene.MeshIndices.data();
+			Resources.MeshVertices = Scene.MeshVertices.data();
+			Resources.MeshVerticesStart = Scene.MeshVerticesStart.empty() ? nullptr : Scene.MeshVerticesStart.data();
+			Resources.MeshVerticesEnd = Scene.MeshVerticesEnd.empty() ? nullptr : Scene.MeshVerticesEnd.data();
+			Resources.MeshCount = ( uint )Scene.Meshes.size();
+			Resources.MeshTriangleCount = ( uint )Scene.MeshIndices.size();
+			Resources.Instances = Scene.Instances.data();
+			Resources.Materials = Scene.Materials.data();
+			Resources.PrototypeIndices = Scene.PrototypeIndices.data();
+			Resources.PrototypeVertices = Scene.PrototypeVertices.data();
+			Resources.InstanceCount = ( uint )Scene.Instances.size();
+			Resources.PrototypeBVHNodes = this->BVH.PrototypeNodes.data();
+			Resources.PrototypeBVHReferences = this->BVH.PrototypeReferences.data();
+			Resources.PrototypeBVHRootNodes = this->BVH.PrototypeRootNodes.data();
+			Resources.IntersectionMap01 = this->IntersectionMap01.data();
+			Resources.IntersectionMap02 = this->IntersectionMap02.data();
+			Resources.IntersectionMap03 = this->IntersectionMap03.data();
+			Resources.IntersectionMap04 = this->IntersectionMap04.empty() ? nullptr : this->IntersectionMap04.data();
+			Resources.AccumulationFrame = this->AccumulationFrame.data();
+			Resources.FinalFrame = this->FinalFrame.data();
+			Resources.RootConstants = Scene.RootConstants;
+			Resources.Sampler = this->Sampler;
+			Resources.Shutter = this->Shutter;
+			Resources.TriangleIntersector = this->TriangleIntersector;
+			Resources.Lights = this->LightSampling != LightStuff::LightSamplingType::None ? &this->Lights : nullptr;
+			Resources.LightSampling = this->LightSampling;
+
+			// While the shutter is open, hits gather the light of the Lights like NextEvent instead.
+			if (this->LightSampling == LightStuff::LightSamplingType::Reservoir && !this->Shutter.IsOpen()) {
+				Resources.Reservoirs = this->Reservoirs.data();
+				Resources.TemporalReservoirs = this->TemporalReservoirs.data();
+				Resources.ReservoirSurfaces = this->ReservoirSurfaces.data();
+				Resources.ReservoirFrameIndex = this->ReservoirFrameIndex;
+			}
+
+			if (!this->Shutter.IsOpen()) {
+				Resources.RectangleRecords = this->RectangleRecords.data();
+				Resources.TriangleRecords = this->TriangleRecords.data();
+			}
+
+			if (this->AccelerationStructure == AccelerationStructureType::BVH && !this->BVH.Nodes.empty()) {
+				if (this->Shutter.IsOpen()) {
+					Resources.MotionBVHNodes = this->BVH.MotionNodes.data();
+				} else {
+					Resources.BVHNodes = this->BVH.Nodes.data();
+					Resources.IntersectRayPacket = this->CameraRayPackets ? this->IntersectRayPacket : nullptr;
+				}
+
+				Resources.BVHReferences = this->BVH.References.data();
+			} else if (this->AccelerationStructure == AccelerationStructureType::BruteForce && !this->Shutter.IsOpen()) {
+				Resources.PackedSpheres = &this->PackedSpheres;
+				Resources.FindClosestSphere = this->FindClosestSphere;
+			}
+
+			return Resources;
+		}
+
+		// Runs a pass that starts each pixel's camera path, RP1 or the Fused Render-pass, over the whole frame and returns the paths it cast.
+		// When the Resources test ray packets, the frame is walked in tiles whose camera paths are traced together before the pass continues them.
+		template<typename CameraPassType> PathCounts ExecuteCameraPass(const PipelineResources& Resources, uint Width, uint Height, CameraPassType CameraPass) {
+			std::atomic<uint64_t> PathCount{ 0u }, ShadowPathCount{ 0u };
+
+			if (Resources.IntersectRayPacket == nullptr) {
+				this->ThreadPool.ParallelFor(Height, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+					PathCounts LocalCounts{};
+
+					for (uint y{ ( uint )BeginIndex }; y < ( uint )EndIndex; y++) {
+						for (uint x{ 0u }; x < Width; x++) {
+							LocalCounts += CameraPass(Resources, uint2{ x, y }, nullptr);
+						}
+					}
+
+					PathCount += LocalCounts.PathCount;
+					ShadowPathCount += LocalCounts.ShadowPathCount;
+				});
+
+				return PathCounts{ PathCount, ShadowPathCount };
+			}
+
+			const uint TileRowCount{ (Height + RayPacketTileHeight - 1u) / RayPacketTileHeight };
+
+			this->ThreadPool.ParallelFor(TileRowCount, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				PathCounts LocalCounts{};
+				TracedCameraPath TracedCameraPaths[SIMDStuff::RayPacketSize];
+				uint2 GridThreadIds[SIMDStuff::RayPacketSize];
+
+				for (uint TileY{ ( uint )BeginIndex * RayPacketTileHeight }; TileY < std::min(( uint )EndIndex * RayPacketTileHeight, Height);
+					 TileY += RayPacketTileHeight) {
+					for (uint TileX{ 0u }; TileX < Width; TileX += RayPacketTileWidth) {
+						uint TilePathCount{ 0u };
+
+						for (uint y{ TileY }; y < std::min(TileY + RayPacketTileHeight, Height); y++) {
+							for (uint x{ TileX }; x < std::min(TileX + RayPacketTileWidth, Width); x++) {
+								GridThreadIds[TilePathCount] = uint2{ x, y };
+								CreateCameraPath(Resources, GridThreadIds[TilePathCount], TracedCameraPaths[TilePathCount].CameraPath);
+								TilePathCount++;
+							}
+						}
+
+						CreateIntersectionRecords(Resources, TracedCameraPaths, TilePathCount);
+
+						for (uint i{ 0u }; i < TilePathCount; i++) {
+							LocalCounts += CameraPass(Resources, GridThreadIds[i], &TracedCameraPaths[i]);
+						}
+					}
+				}
+
+				PathCount += LocalCounts.PathCount;
+				ShadowPathCount += LocalCounts.ShadowPathCount;
+			});
+
+			return PathCounts{ PathCount, ShadowPathCount };
+		}
+
+		// Runs the Wavefront Render-pass over the whole frame, in bands of whole rows of ray packet tiles, and returns the paths it cast.
+		PathCounts ExecuteWavefrontPass(const PipelineResources& Resources, uint Width, uint Height) {
+			const uint RowsPerWavefront{ std::max(WavefrontTargetPathCount / (Width * RayPacketTileHeight), 1u) * RayPacketTileHeight };
+			const uint WavefrontCount{ (Height + RowsPerWavefront - 1u) / RowsPerWavefront };
+			std::atomic<uint64_t> PathCount{ 0u }, ShadowPathCount{ 0u };
+
+			this->ThreadPool.ParallelFor(WavefrontCount, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint ThreadIndex) {
+				PathCounts LocalCounts{};
+
+				for (uint i{ ( uint )BeginIndex }; i < ( uint )EndIndex; i++) {
+					LocalCounts += ExecuteWavefrontRenderPass(
+						Resources, Width, i * RowsPerWavefront, std::min((i + 1u) * RowsPerWavefront, Height), this->ThreadWavefrontQueues[ThreadIndex]);
+				}
+
+				PathCount += LocalCounts.PathCount;
+				ShadowPathCount += LocalCounts.ShadowPathCount;
+			});
+
+			return PathCounts{ PathCount, ShadowPathCount };
+		}
+
+		// Runs both reservoir passes over the whole frame, and returns the paths they cast.
+		uint64_t ExecuteReservoirPasses(const PipelineResources& Resources, uint Width, uint Height) {
+			std::atomic<uint64_t> PathCount{ 0u };
+
+			this->ThreadPool.ParallelFor(Height, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				uint64_t LocalPathCount{ 0u };
+
+				for (uint y{ ( uint )BeginIndex }; y < ( uint )EndIndex; y++) {
+					for (uint x{ 0u }; x < Width; x++) {
+						LocalPathCount += ExecuteTemporalReservoirPass(Resources, uint2{ x, y });
+					}
+				}
+
+				PathCount += LocalPathCount;
+			});
+
+			this->ThreadPool.ParallelFor(Height, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (uint y{ ( uint )BeginIndex }; y < ( uint )EndIndex; y++) {
+					for (uint x{ 0u }; x < Width; x++) {
+						ExecuteSpatialReservoirPass(Resources, uint2{ x, y });
+					}
+				}
+			});
+
+			return PathCount;
+		}
+
+		void ResizeResources(const InlineRootConstants& RootConstants) {
+			const size_t PixelCount{ ( size_t )RootConstants.TSGridDimensions.x * RootConstants.TSGridDimensions.y };
+			const size_t IntersectionMapTexelCount{ this->Mode == RenderMode::ThreePass ? PixelCount * RootConstants.MaxRecursionDepth : 0u };
+
+			this->IntersectionMap01.resize(IntersectionMapTexelCount);
+			this->IntersectionMap02.resize(IntersectionMapTexelCount);
+			this->IntersectionMap03.resize(IntersectionMapTexelCount);
+			this->IntersectionMap04.resize(this->LightSampling != LightStuff::LightSamplingType::None ? IntersectionMapTexelCount : 0u);
+			this->IntersectionMap01.shrink_to_fit();
+			this->IntersectionMap02.shrink_to_fit();
+			this->IntersectionMap03.shrink_to_fit();
+			this->IntersectionMap04.shrink_to_fit();
+			this->AccumulationFrame.resize(PixelCount);
+			this->FinalFrame.resize(PixelCount);
+			this->ThreadWavefrontQueues.resize(this->Mode == RenderMode::Wavefront ? this->ThreadPool.GetThreadCount() : 0u);
+
+			// Reservoirs only carry over while the frame keeps its size, as they belong to its pixels.
+			const size_t ReservoirCount{ this->LightSampling == LightStuff::LightSamplingType::Reservoir ? PixelCount : 0u };
+
+			if (this->Reservoirs.size() != ReservoirCount) {
+				this->Reservoirs.assign(ReservoirCount, LightStuff::LightReservoir{});
+				this->TemporalReservoirs.assign(ReservoirCount, LightStuff::LightReservoir{});
+				this->ReservoirSurfaces.assign(ReservoirCount, LightStuff::ReservoirSurface{});
+			}
+		}
+
+	  public:
+		Renderer(CPUStuff::ThreadPool& ThreadPool, const RendererConfig& Config = RendererConfig{})
+			: ThreadPool{ ThreadPool }, Mode{ Config.Mode }, Sampler{ SamplerStuff::CreateSampler(Config.SamplerType, Config.SamplerSeed) },
+			  AccelerationStructure{ Config.AccelerationStructure }, BVHBuildType{ Config.BVHBuildType },
+			  BVHRebuildThreshold{ Config.BVHRebuildThreshold }, ShutterLength{ Config.ShutterLength },
+			  FindClosestSphere{ SIMDStuff::GetFindClosestSphere(std::min(Config.SIMDLevel, SIMDStuff::GetSupportedSIMDLevel())) },
+			  CameraRayPackets{ Config.CameraRayPackets },
+			  IntersectRayPacket{ SIMDStuff::GetIntersectRayPacket(std::min(Config.SIMDLevel, SIMDStuff::GetSupportedSIMDLevel())) },
+			  TriangleIntersector{ Config.TriangleIntersector }, LightSampling{ Config.LightSampling },
+			  LightSelection{ Config.LightSelection } {
+		}
+
+		// Renders all SamplesPerPixel samples of the scene's current state into the Final Frame, or of its motion across the shutter while that is open.
+		void RenderFrame(SceneStuff::Scene& Scene, RenderStats& Stats) {
+			InlineRootConstants& RootConstants{ Scene.RootConstants };
+			const uint Width{ RootConstants.TSGridDimensions.x }, Height{ RootConstants.TSGridDimensions.y };
+
+			this->ResizeResources(RootConstants);
+
+			CPUStuff::Timer RenderTimer{};
+			PathCounts Counts{};
+
+			this->Shutter = SceneStuff::GetShutterInterval(RootConstants.GlobalTickInRadians, this->ShutterLength);
+
+			// Instances are traced through the trees of their prototypes with either acceleration structure, and those only change with the prototypes.
+			BVHStuff::BVHBuildStats PrototypeBuildStats{};
+
+			if (BVHStuff::UpdatePrototypeBVHs(Scene, this->ThreadPool, this->BVHBuildType, this->BVH, PrototypeBuildStats)) {
+				Stats.AccelerationBuildSeconds += PrototypeBuildStats.BuildSeconds;
+			}
+
+			if (this->AccelerationStructure == AccelerationStructureType::BVH && this->BVHIsPrebuilt && !this->Shutter.IsOpen()) {
+				Stats.AccelerationSAHCost = this->BVH.BuildSAHCost;
+			} else if (this->AccelerationStructure == AccelerationStructureType::BVH) {
+				BVHStuff::BVHBuildStats BuildStats{};
+
+				if (BVHStuff::UpdateBVH(Scene, this->Shutter, this->ThreadPool, this->BVHBuildType, this->BVHRebuildThreshold, this->BVH, BuildStats) ==
+					BVHStuff::BVHUpdateType::Refit) {
+					Stats.AccelerationRefitCount++;
+				} else {
+					Stats.AccelerationRebuildCount++;
+				}
+
+				Stats.AccelerationBuildSeconds += BuildStats.BuildSeconds;
+				Stats.AccelerationSAHCost = BuildStats.SAHCost;
+			} else if (!this->Shutter.IsOpen()) {
+				CPUStuff::Timer PackTimer{};
+				SIMDStuff::PackSpheres(Scene.Spheres, this->PackedSpheres);
+				Stats.AccelerationBuildSeconds += PackTimer.GetElapsedSeconds();
+			}
+
+			this->BVHIsPrebuilt = false;
+
+			// While the shutter is open, every path derives the records of the Rectangles and Triangles it tests at its own time instead.
+			if (!this->Shutter.IsOpen()) {
+				CPUStuff::Timer RecordTimer{};
+				RectangleStuff::CreateRectangleRecords(Scene.Rectangles, this->ThreadPool, this->RectangleRecords);
+				TriangleStuff::CreateTriangleRecords(Scene.Triangles, this->ThreadPool, this->TriangleRecords);
+				Stats.AccelerationBuildSeconds += RecordTimer.GetElapsedSeconds();
+			}
+
+			if (this->LightSampling != LightStuff::LightSamplingType::None) {
+				LightStuff::BuildLightList(Scene, this->LightSelection, this->Shutter, this->Lights);
+			}
+
+			for (RootConstants.CurrentSampleIndex = 0u; RootConstants.CurrentSampleIndex <= RootConstants.MaxSampleIndex; RootConstants.CurrentSampleIndex++) {
+				PipelineResources Resources{ this->GetPipelineResources(Scene) };
+
+				if (Resources.Reservoirs != nullptr) {
+					Counts.ShadowPathCount += this->ExecuteReservoirPasses(Resources, Width, Height);
+				}
+
+				if (this->Mode == RenderMode::Fused) {
+					Counts += this->ExecuteCameraPass(Resources, Width, Height, ExecuteFusedRenderPass);
+
+					continue;
+				} else if (this->Mode == RenderMode::Wavefront) {
+					Counts += this->ExecuteWavefrontPass(Resources, Width, Height);
+
+					continue;
+				}
+
+				Counts += this->ExecuteCameraPass(Resources, Width, Height, ExecuteRenderPass1);
+
+				this->ThreadPool.ParallelFor(Height, 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+					for (uint y{ ( uint )BeginIndex }; y < ( uint )EndIndex; y++) {
+						for (uint x{ 0u }; x < Width; x++) {
+							ExecuteRenderPass2(Resources, uint2{ x, y });
+						}
+					}
+				});
+			}
+
+			RootConstants.CurrentSampleIndex = 0u;
+			this->ReservoirFrameIndex++;
+
+			PipelineResources Resources{ this->GetPipelineResources(Scene) };
+
+			this->ThreadPool.ParallelFor(Height, 8, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+				for (uint y{ ( uint )BeginIndex }; y < ( uint )EndIndex; y++) {
+					for (uint x{ 0u }; x < Width; x++) {
+						ExecuteRenderPass3(Resources, uint2{ x, y });
+					}
+				}
+			});
+
+			Stats.RenderSeconds += RenderTimer.GetElapsedSeconds();
+			Stats.PathCount += Counts.PathCount;
+			Stats.ShadowPathCount += Counts.ShadowPathCount;
+			Stats.SampleCount += ( uint64_t )Width * Height * RootConstants.SamplesPerPixel;
+			Stats.FullDepthPathCount += ( uint64_t )Width * Height * RootConstants.SamplesPerPixel * RootConstants.MaxRecursionDepth;
+			Stats.ThreadCount = this->ThreadPool.GetThreadCount();
+		}
+
+		// Hands over a BVH that was built, with the shutter closed, over the scene's state as the next frame renders it, such as one mapped from a
+		// scene cache. That frame traces it as it is, unless its shutter is open, and later frames refit or rebuild it like any other.
+		void SetPrebuiltBVH(BVHStuff::BVH&& PrebuiltBVH) {
+			this->BVH = std::move(PrebuiltBVH);
+			this->BVHIsPrebuilt = true;
+		}
+
+		// Total size of the host-side pipeline resources, in bytes.
+		uint64_t GetResourceSizeInBytes() {
+			uint64_t WavefrontQueuesSizeInBytes{ 0u };
+
+			for (const WavefrontQueues& Queues: this->ThreadWavefrontQueues) {
+				WavefrontQueuesSizeInBytes += GetWavefrontQueuesSizeInBytes(Queues);
+			}
+
+			return WavefrontQueuesSizeInBytes + this->IntersectionMap01.capacity() * sizeof(float4) + this->IntersectionMap02.capacity() * sizeof(float4) +
+				this->IntersectionMap03.capacity() * sizeof(uint4) + this->IntersectionMap04.capacity() * sizeof(float4) +
+				LightStuff::GetLightListSizeInBytes(this->Lights) +
+				(this->Reservoirs.capacity() + this->TemporalReservoirs.capacity()) * sizeof(LightStuff::LightReservoir) +
+				this->ReservoirSurfaces.capacity() * sizeof(LightStuff::ReservoirSurface) +
+				this->AccumulationFrame.capacity() * sizeof(float4) + this->FinalFrame.capacity() * sizeof(CPUStuff::R8G8B8A8Uint) +
+				BVHStuff::GetBVHSizeInBytes(this->BVH) + SIMDStuff::GetPackedSpheresSizeInBytes(this->PackedSpheres) +
+				RectangleStuff::GetRectangleRecordsSizeInBytes(this->RectangleRecords) + TriangleStuff::GetTriangleRecordsSizeInBytes(this->TriangleRecords);
+		}
+
+		const CPUStuff::R8G8B8A8Uint* GetFinalFrame() {
+			return this->FinalFrame.data();
+		}
+	};
+
+}
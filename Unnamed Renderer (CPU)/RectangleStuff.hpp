@@ -0,0 +1,104 @@
+// RectangleStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef RECTANGLE_STUFF
+	#define RECTANGLE_STUFF
+#endif
+
+#include "SceneStuff.hpp"
+
+namespace RectangleStuff {
+
+	/*
+		RECTANGLE RECORD LAYOUT:
+			The plane basis of a Rectangle as it is at the current frame, which every intersection test used to derive from its corners, in one
+			64-byte cache line instead of the Rectangle's 204 bytes of keyframes, colors and materials.
+			00 - 12: Q1, the origin of the basis.
+			12 - 16: LengthSquared21, dot(DS21, DS21).
+			16 - 28: DS21, Q2 - Q1.
+			28 - 32: LengthSquared31, dot(DS31, DS31).
+			32 - 44: DS31, Q3 - Q1.
+			44 - 48: Padding00
+			48 - 60: Normal, normalize(cross(DS21, DS31)).
+			60 - 64: Padding01
+			Q4 is left out, since the rectangle is spanned by Q1, Q2 and Q3 alone.
+			The squared lengths are kept rather than their inverses, and the plane through Q1 rather than its offset from the origin, so that
+			every hit rounds exactly like it does in the Compute Shaders.
+	*/
+	struct alignas(64) RectangleRecord {
+		float3 Q1;
+		float LengthSquared21;
+		float3 DS21;
+		float LengthSquared31;
+		float3 DS31;
+		float Padding00;
+		float3 Normal;
+		float Padding01;
+	};
+
+	// Fills a RectangleRecord in from a Rectangle, deriving its basis exactly like the Compute Shaders do.
+	inline void CreateRectangleRecord(const Rectangle& CurrentRectangle, RectangleRecord& Record) {
+		Record.Q1 = CurrentRectangle.Q1;
+		Record.DS21 = CurrentRectangle.Q2 - CurrentRectangle.Q1;
+		Record.DS31 = CurrentRectangle.Q3 - CurrentRectangle.Q1;
+		Record.LengthSquared21 = dot(Record.DS21, Record.DS21);
+		Record.LengthSquared31 = dot(Record.DS31, Record.DS31);
+		Record.Normal = normalize(cross(Record.DS21, Record.DS31));
+		Record.Padding00 = Record.Padding01 = 0.0f;
+	}
+
+	// Refreshes the RectangleRecords of a frame, in parallel.
+	inline void CreateRectangleRecords(const CPUStuff::MappableVector<Rectangle>& Rectangles, CPUStuff::ThreadPool& ThreadPool,
+		std::vector<RectangleRecord>& Records) {
+		Records.resize(Rectangles.size());
+
+		ThreadPool.ParallelFor(( int64_t )Rectangles.size(), 4096, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				CreateRectangleRecord(Rectangles[i], Records[i]);
+			}
+		});
+	}
+
+	inline uint64_t GetRectangleRecordsSizeInBytes(const std::vector<RectangleRecord>& Records) {
+		return Records.capacity() * sizeof(RectangleRecord);
+	}
+
+	// Area of the region that IntersectRectangle() hits, the points whose projections onto DS21 and DS31 fall within both edges. That is the
+	// parallelogram spanned by the edges only when they are perpendicular, otherwise it is the box of projections scaled by the basis' area.
+	inline float GetRectangleArea(const RectangleRecord& Record) {
+		return Record.LengthSquared21 * Record.LengthSquared31 / length(cross(Record.DS21, Record.DS31));
+	}
+
+	// Point of the region that IntersectRectangle() hits whose projections onto DS21 and DS31 are u and v of their squared lengths, so that
+	// uniform u and v in [0, 1) sample the region uniformly by area.
+	inline float3 GetRectanglePoint(const RectangleRecord& Record, float u, float v) {
+		const float Projection21{ u * Record.LengthSquared21 }, Projection31{ v * Record.LengthSquared31 };
+		const float Dot2131{ dot(Record.DS21, Record.DS31) };
+		const float Determinant{ Record.LengthSquared21 * Record.LengthSquared31 - Dot2131 * Dot2131 };
+
+		return Record.Q1 + Record.DS21 * ((Record.LengthSquared31 * Projection21 - Dot2131 * Projection31) / Determinant) +
+			Record.DS31 * ((Record.LengthSquared21 * Projection31 - Dot2131 * Projection21) / Determinant);
+	}
+
+	// Distance along a path to a rectangle, valid if the path hits it at or past MinDistance.
+	// Every condition is evaluated, and they are combined without short-circuiting, so that the test compiles to no branches.
+	inline bool IntersectRectangle(const RectangleRecord& Record, const float3& Origin, const float3& Direction, float MinDistance, float& t) {
+		float3 dR = Origin - (Direction + Origin);
+
+		float ndotdR = dot(Record.Normal, dR);
+
+		t = dot(Record.Normal, (Origin - Record.Q1)) / ndotdR;
+
+		float3 dMS1 = (Origin + (Direction * t)) - Record.Q1;
+
+		float u = dot(dMS1, Record.DS21);
+		float v = dot(dMS1, Record.DS31);
+
+		return (fabsf(ndotdR) > 1e-8f) & (t >= MinDistance) & (u >= 0.0f) & (u <= Record.LengthSquared21) & (v >= 0.0f) & (v <= Record.LengthSquared31);
+	}
+
+}
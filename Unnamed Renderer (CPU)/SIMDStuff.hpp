@@ -0,0 +1,533 @@
+// SIMDStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef SIMD_STUFF
+	#define SIMD_STUFF
+#endif
+
+#include "SceneStuff.hpp"
+#include <cfloat>
+#include <cstring>
+#include <limits>
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define SIMD_STUFF_X86
+	// GCC 12 reports the _mm512_undefined_ps() of its own AVX-512 intrinsics as uninitialized where they are inlined.
+	#if defined(__GNUC__) && !defined(__clang__)
+		#pragma GCC diagnostic push
+		#pragma GCC diagnostic ignored "-Wuninitialized"
+		#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+		#include <immintrin.h>
+		#pragma GCC diagnostic pop
+	#else
+		#include <immintrin.h>
+	#endif
+	#ifdef _MSC_VER
+		#define SIMD_STUFF_TARGET(Target)
+	#else
+		#define SIMD_STUFF_TARGET(Target) __attribute__((target(Target)))
+	#endif
+#endif
+
+namespace SIMDStuff {
+
+	/*
+		SIMD LEVELS:
+			Scalar - One sphere or ray at a time, on any CPU.
+			AVX2 - Eight spheres or rays per instruction.
+			AVX512 - Sixteen spheres or rays per instruction.
+	*/
+	enum class SIMDLevel : uint { Scalar, AVX2, AVX512 };
+
+	inline const char* GetSIMDLevelName(SIMDLevel Level) {
+		switch (Level) {
+			case SIMDLevel::Scalar: {
+				return "scalar";
+			}
+			case SIMDLevel::AVX2: {
+				return "avx2";
+			}
+			case SIMDLevel::AVX512: {
+				return "avx512";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Looks a SIMD level up by its name, returning false if there is none.
+	inline bool GetSIMDLevel(const char* Name, SIMDLevel& Level) {
+		for (SIMDLevel CurrentLevel: { SIMDLevel::Scalar, SIMDLevel::AVX2, SIMDLevel::AVX512 }) {
+			if (strcmp(Name, GetSIMDLevelName(CurrentLevel)) == 0) {
+				Level = CurrentLevel;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// The widest SIMD level that both the CPU and the operating system (which has to save the wider registers) support.
+	inline SIMDLevel DetectSIMDLevel() {
+#if defined(SIMD_STUFF_X86) && defined(_MSC_VER)
+		int CPUInfo[4]{};
+		__cpuid(CPUInfo, 0);
+
+		if (CPUInfo[0] < 7) {
+			return SIMDLevel::Scalar;
+		}
+
+		__cpuid(CPUInfo, 1);
+		const bool HasOSXSave{ (CPUInfo[2] & (1 << 27)) != 0 };
+		const bool HasAVX{ (CPUInfo[2] & (1 << 28)) != 0 };
+
+		if (!HasOSXSave || !HasAVX) {
+			return SIMDLevel::Scalar;
+		}
+
+		const unsigned long long EnabledRegisters{ _xgetbv(0) };
+		__cpuidex(CPUInfo, 7, 0);
+
+		if ((CPUInfo[1] & (1 << 16)) != 0 && (EnabledRegisters & 0xE6u) == 0xE6u) {
+			return SIMDLevel::AVX512;
+		} else if ((CPUInfo[1] & (1 << 5)) != 0 && (EnabledRegisters & 0x6u) == 0x6u) {
+			return SIMDLevel::AVX2;
+		}
+
+		return SIMDLevel::Scalar;
+#elif defined(SIMD_STUFF_X86)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f")) {
+			return SIMDLevel::AVX512;
+		} else if (__builtin_cpu_supports("avx2")) {
+			return SIMDLevel::AVX2;
+		}
+
+		return SIMDLevel::Scalar;
+#else
+		return SIMDLevel::Scalar;
+#endif
+	}
+
+	inline SIMDLevel GetSupportedSIMDLevel() {
+		static const SIMDLevel SupportedLevel{ DetectSIMDLevel() };
+		return SupportedLevel;
+	}
+
+	/*
+		PACKED SPHERES:
+			The geometry of a scene's Spheres, as they are at the current frame, one array per component.
+			Each array is padded to a multiple of PackedSphereAlignment with NaN centers, which no path can hit, so the kernels never need a tail loop.
+			A sphere's index in the arrays is its index in the scene, and its packed reference (see BVHStuff.hpp) is built from that.
+	*/
+	constexpr uint PackedSphereAlignment{ 16u };
+
+	struct PackedSpheres {
+		std::vector<float> CenterX{};
+		std::vector<float> CenterY{};
+		std::vector<float> CenterZ{};
+		std::vector<float> RadiusSquared{};// Squared exactly like the scalar intersection test does, so both find the same distances.
+		uint Count{ 0u };
+		uint PaddedCount{ 0u };
+	};
+
+	inline void PackSpheres(const CPUStuff::MappableVector<Sphere>& Spheres, PackedSpheres& Packed) {
+		Packed.Count = ( uint )Spheres.size();
+		Packed.PaddedCount = (Packed.Count + PackedSphereAlignment - 1u) / PackedSphereAlignment * PackedSphereAlignment;
+
+		const float NaN{ std::numeric_limits<float>::quiet_NaN() };
+
+		Packed.CenterX.assign(Packed.PaddedCount, NaN);
+		Packed.CenterY.assign(Packed.PaddedCount, NaN);
+		Packed.CenterZ.assign(Packed.PaddedCount, NaN);
+		Packed.RadiusSquared.assign(Packed.PaddedCount, 0.0f);
+
+		for (uint i{ 0u }; i < Packed.Count; i++) {
+			Packed.CenterX[i] = Spheres[i].WSOrigin.x;
+			Packed.CenterY[i] = Spheres[i].WSOrigin.y;
+			Packed.CenterZ[i] = Spheres[i].WSOrigin.z;
+			Packed.RadiusSquared[i] = Spheres[i].WSRadius * Spheres[i].WSRadius;
+		}
+	}
+
+	inline uint64_t GetPackedSpheresSizeInBytes(const PackedSpheres& Packed) {
+		return (Packed.CenterX.capacity() + Packed.CenterY.capacity() + Packed.CenterZ.capacity() + Packed.RadiusSquared.capacity()) * sizeof(float);
+	}
+
+	// Finds the nearest sphere that a path hits past MinDistance and before ClosestHitDistance, which it then lowers to that hit's distance.
+	// Returns the sphere's index, or ~0u on a miss. Every kernel evaluates the scalar intersection test's arithmetic in the same order, so they all
+	// find the same distances, and the first of several equally distant spheres wins, like in the brute-force search.
+	typedef uint (*FindClosestSphereFunction)(
+		const PackedSpheres& Packed, const float3& Origin, const float3& Direction, float MinDistance, float& ClosestHitDistance);
+
+	inline uint FindClosestSphereScalar(
+		const PackedSpheres& Packed, const float3& Origin, const float3& Direction, float MinDistance, float& ClosestHitDistance) {
+		const float a{ dot(Direction, Direction) };
+		uint ClosestIndex{ ~0u };
+
+		for (uint i{ 0u }; i < Packed.Count; i++) {
+			float3 OriginToCenter{ Origin.x - Packed.CenterX[i], Origin.y - Packed.CenterY[i], Origin.z - Packed.CenterZ[i] };
+			float b{ 2.0f * dot(Direction, OriginToCenter) };
+			float c{ dot(OriginToCenter, OriginToCenter) - Packed.RadiusSquared[i] };
+			float Discriminant{ (b * b) - 4.0f * a * c };
+
+			if (Discriminant >= 0.0f) {
+				float xPos{ ((-1.0f * b) + sqrtf(Discriminant)) / (2.0f * a) };
+				float xNeg{ ((-1.0f * b) - sqrtf(Discriminant)) / (2.0f * a) };
+				float t{ (xPos <= xNeg) ? xPos : xNeg };
+
+				if (t > MinDistance && t < ClosestHitDistance) {
+					ClosestHitDistance = t;
+					ClosestIndex = i;
+				}
+			}
+		}
+
+		return ClosestIndex;
+	}
+
+	// Index of the lowest set bit of a non-zero mask.
+	inline uint GetLowestSetBit(uint Mask) {
+#ifdef _MSC_VER
+		unsigned long Index{ 0u };
+		_BitScanForward(&Index, Mask);
+		return ( uint )Index;
+#else
+		return ( uint )__builtin_ctz(Mask);
+#endif
+	}
+
+#ifdef SIMD_STUFF_X86
+
+	SIMD_STUFF_TARGET("avx2") inline uint FindClosestSphereAVX2(
+		const PackedSpheres& Packed, const float3& Origin, const float3& Direction, float MinDistance, float& ClosestHitDistance) {
+		const float a{ dot(Direction, Direction) };
+		const __m256 OriginX{ _mm256_set1_ps(Origin.x) }, OriginY{ _mm256_set1_ps(Origin.y) }, OriginZ{ _mm256_set1_ps(Origin.z) };
+		const __m256 DirectionX{ _mm256_set1_ps(Direction.x) }, DirectionY{ _mm256_set1_ps(Direction.y) }, DirectionZ{ _mm256_set1_ps(Direction.z) };
+		const __m256 Two{ _mm256_set1_ps(2.0f) }, MinusOne{ _mm256_set1_ps(-1.0f) }, Infinity{ _mm256_set1_ps(+INFINITY) };
+		const __m256 FourA{ _mm256_set1_ps(4.0f * a) }, TwoA{ _mm256_set1_ps(2.0f * a) }, Min{ _mm256_set1_ps(MinDistance) };
+		uint ClosestIndex{ ~0u };
+
+		for (uint i{ 0u }; i < Packed.PaddedCount; i += 8u) {
+			__m256 OriginToCenterX{ _mm256_sub_ps(OriginX, _mm256_loadu_ps(&Packed.CenterX[i])) };
+			__m256 OriginToCenterY{ _mm256_sub_ps(OriginY, _mm256_loadu_ps(&Packed.CenterY[i])) };
+			__m256 OriginToCenterZ{ _mm256_sub_ps(OriginZ, _mm256_loadu_ps(&Packed.CenterZ[i])) };
+
+			__m256 b{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(DirectionX, OriginToCenterX), _mm256_mul_ps(DirectionY, OriginToCenterY)),
+				_mm256_mul_ps(DirectionZ, OriginToCenterZ)) };
+			b = _mm256_mul_ps(Two, b);
+
+			__m256 c{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(OriginToCenterX, OriginToCenterX), _mm256_mul_ps(OriginToCenterY, OriginToCenterY)),
+				_mm256_mul_ps(OriginToCenterZ, OriginToCenterZ)) };
+			c = _mm256_sub_ps(c, _mm256_loadu_ps(&Packed.RadiusSquared[i]));
+
+			__m256 Discriminant{ _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(FourA, c)) };
+			__m256 Root{ _mm256_sqrt_ps(Discriminant) };
+			__m256 MinusB{ _mm256_mul_ps(MinusOne, b) };
+			__m256 xPos{ _mm256_div_ps(_mm256_add_ps(MinusB, Root), TwoA) };
+			__m256 xNeg{ _mm256_div_ps(_mm256_sub_ps(MinusB, Root), TwoA) };
+			__m256 t{ _mm256_blendv_ps(xNeg, xPos, _mm256_cmp_ps(xPos, xNeg, _CMP_LE_OQ)) };
+
+			__m256 Hits{ _mm256_and_ps(_mm256_cmp_ps(Discriminant, _mm256_setzero_ps(), _CMP_GE_OQ),
+				_mm256_and_ps(_mm256_cmp_ps(t, Min, _CMP_GT_OQ), _mm256_cmp_ps(t, _mm256_set1_ps(ClosestHitDistance), _CMP_LT_OQ))) };
+
+			if (_mm256_movemask_ps(Hits) == 0) {
+				continue;
+			}
+
+			// Reduce to the nearest hit, then take the lowest lane at that distance.
+			__m256 HitDistances{ _mm256_blendv_ps(Infinity, t, Hits) };
+			__m256 Nearest{ _mm256_min_ps(HitDistances, _mm256_permute2f128_ps(HitDistances, HitDistances, 0x01)) };
+			Nearest = _mm256_min_ps(Nearest, _mm256_shuffle_ps(Nearest, Nearest, _MM_SHUFFLE(1, 0, 3, 2)));
+			Nearest = _mm256_min_ps(Nearest, _mm256_shuffle_ps(Nearest, Nearest, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			uint NearestLanes{ ( uint )_mm256_movemask_ps(_mm256_and_ps(Hits, _mm256_cmp_ps(t, Nearest, _CMP_EQ_OQ))) };
+
+			ClosestIndex = i + GetLowestSetBit(NearestLanes);
+			ClosestHitDistance = _mm256_cvtss_f32(Nearest);
+		}
+
+		return ClosestIndex;
+	}
+
+	SIMD_STUFF_TARGET("avx512f") inline uint FindClosestSphereAVX512(
+		const PackedSpheres& Packed, const float3& Origin, const float3& Direction, float MinDistance, float& ClosestHitDistance) {
+		const float a{ dot(Direction, Direction) };
+		const __m512 OriginX{ _mm512_set1_ps(Origin.x) }, OriginY{ _mm512_set1_ps(Origin.y) }, OriginZ{ _mm512_set1_ps(Origin.z) };
+		const __m512 DirectionX{ _mm512_set1_ps(Direction.x) }, DirectionY{ _mm512_set1_ps(Direction.y) }, DirectionZ{ _mm512_set1_ps(Direction.z) };
+		const __m512 Two{ _mm512_set1_ps(2.0f) }, MinusOne{ _mm512_set1_ps(-1.0f) }, Infinity{ _mm512_set1_ps(+INFINITY) };
+		const __m512 FourA{ _mm512_set1_ps(4.0f * a) }, TwoA{ _mm512_set1_ps(2.0f * a) }, Min{ _mm512_set1_ps(MinDistance) };
+		uint ClosestIndex{ ~0u };
+
+		for (uint i{ 0u }; i < Packed.PaddedCount; i += 16u) {
+			__m512 OriginToCenterX{ _mm512_sub_ps(OriginX, _mm512_loadu_ps(&Packed.CenterX[i])) };
+			__m512 OriginToCenterY{ _mm512_sub_ps(OriginY, _mm512_loadu_ps(&Packed.CenterY[i])) };
+			__m512 OriginToCenterZ{ _mm512_sub_ps(OriginZ, _mm512_loadu_ps(&Packed.CenterZ[i])) };
+
+			__m512 b{ _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(DirectionX, OriginToCenterX), _mm512_mul_ps(DirectionY, OriginToCenterY)),
+				_mm512_mul_ps(DirectionZ, OriginToCenterZ)) };
+			b = _mm512_mul_ps(Two, b);
+
+			__m512 c{ _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(OriginToCenterX, OriginToCenterX), _mm512_mul_ps(OriginToCenterY, OriginToCenterY)),
+				_mm512_mul_ps(OriginToCenterZ, OriginToCenterZ)) };
+			c = _mm512_sub_ps(c, _mm512_loadu_ps(&Packed.RadiusSquared[i]));
+
+			__m512 Discriminant{ _mm512_sub_ps(_mm512_mul_ps(b, b), _mm512_mul_ps(FourA, c)) };
+			__mmask16 Hits{ _mm512_cmp_ps_mask(Discriminant, _mm512_setzero_ps(), _CMP_GE_OQ) };
+			__m512 Root{ _mm512_maskz_sqrt_ps(Hits, Discriminant) };
+			__m512 MinusB{ _mm512_mul_ps(MinusOne, b) };
+			__m512 xPos{ _mm512_div_ps(_mm512_add_ps(MinusB, Root), TwoA) };
+			__m512 xNeg{ _mm512_div_ps(_mm512_sub_ps(MinusB, Root), TwoA) };
+			__m512 t{ _mm512_mask_blend_ps(_mm512_cmp_ps_mask(xPos, xNeg, _CMP_LE_OQ), xNeg, xPos) };
+
+			Hits = _mm512_mask_cmp_ps_mask(Hits, t, Min, _CMP_GT_OQ);
+			Hits = _mm512_mask_cmp_ps_mask(Hits, t, _mm512_set1_ps(ClosestHitDistance), _CMP_LT_OQ);
+
+			if (Hits == 0u) {
+				continue;
+			}
+
+			// Reduce to the nearest hit (halving to 256 bits first), then take the lowest lane at that distance.
+			__m512 HitDistances{ _mm512_mask_blend_ps(Hits, Infinity, t) };
+			__m256 Lower{ _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFu, _mm512_castps_pd(HitDistances), 0)) };
+			__m256 Upper{ _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFu, _mm512_castps_pd(HitDistances), 1)) };
+			__m256 Nearest{ _mm256_min_ps(Lower, Upper) };
+			Nearest = _mm256_min_ps(Nearest, _mm256_permute2f128_ps(Nearest, Nearest, 0x01));
+			Nearest = _mm256_min_ps(Nearest, _mm256_shuffle_ps(Nearest, Nearest, _MM_SHUFFLE(1, 0, 3, 2)));
+			Nearest = _mm256_min_ps(Nearest, _mm256_shuffle_ps(Nearest, Nearest, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			ClosestHitDistance = _mm256_cvtss_f32(Nearest);
+			uint NearestLanes{ ( uint )_mm512_mask_cmp_ps_mask(Hits, t, _mm512_set1_ps(ClosestHitDistance), _CMP_EQ_OQ) };
+			ClosestIndex = i + GetLowestSetBit(NearestLanes);
+		}
+
+		return ClosestIndex;
+	}
+#endif
+
+	// The kernel for a SIMD level, falling back to the scalar one where the level is not compiled in.
+	inline FindClosestSphereFunction GetFindClosestSphere(SIMDLevel Level) {
+#ifdef SIMD_STUFF_X86
+		switch (Level) {
+			case SIMDLevel::AVX2: {
+				return FindClosestSphereAVX2;
+			}
+			case SIMDLevel::AVX512: {
+				return FindClosestSphereAVX512;
+			}
+			default: {
+				break;
+			}
+		}
+#endif
+
+		return FindClosestSphereScalar;
+	}
+
+	/*
+		RAY PACKETS:
+			The origins, inverse directions and closest hit distances of up to RayPacketSize coherent paths, one array per component, so that a box
+			is tested against all of them at once. Lanes past Count never hit anything, since their MaxDistance is -INFINITY.
+			The interval bounds hold each component's range over the packet, which bound every slab distance of its paths at once (see
+			PacketMissesBounds), but only along the axes where all of its directions share a sign.
+	*/
+	constexpr uint RayPacketSize{ 16u };
+
+	struct RayPacket {
+		alignas(64) float OriginX[RayPacketSize];
+		alignas(64) float OriginY[RayPacketSize];
+		alignas(64) float OriginZ[RayPacketSize];
+		alignas(64) float InverseDirectionX[RayPacketSize];
+		alignas(64) float InverseDirectionY[RayPacketSize];
+		alignas(64) float InverseDirectionZ[RayPacketSize];
+		alignas(64) float MaxDistance[RayPacketSize];// Closest hit so far of each path.
+		float OriginMin[3], OriginMax[3];// Interval bounds, by axis.
+		float InverseDirectionMin[3], InverseDirectionMax[3];
+		bool AxisIsCoherent[3];
+		uint Count;
+	};
+
+	// Fills a packet's lanes with paths given by their origins and directions, and sets its interval bounds.
+	inline void CreateRayPacket(const float3* Origins, const float3* Directions, uint Count, float MaxDistance, RayPacket& Packet) {
+		Packet.Count = Count;
+
+		for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+			Packet.OriginMin[Axis] = Packet.InverseDirectionMin[Axis] = +INFINITY;
+			Packet.OriginMax[Axis] = Packet.InverseDirectionMax[Axis] = -INFINITY;
+		}
+
+		for (uint i{ 0u }; i < RayPacketSize; i++) {
+			if (i >= Count) {
+				Packet.OriginX[i] = Packet.OriginY[i] = Packet.OriginZ[i] = 0.0f;
+				Packet.InverseDirectionX[i] = Packet.InverseDirectionY[i] = Packet.InverseDirectionZ[i] = 1.0f;
+				Packet.MaxDistance[i] = -INFINITY;
+
+				continue;
+			}
+
+			const float3 InverseDirection{ 1.0f / Directions[i].x, 1.0f / Directions[i].y, 1.0f / Directions[i].z };
+			Packet.OriginX[i] = Origins[i].x;
+			Packet.OriginY[i] = Origins[i].y;
+			Packet.OriginZ[i] = Origins[i].z;
+			Packet.InverseDirectionX[i] = InverseDirection.x;
+			Packet.InverseDirectionY[i] = InverseDirection.y;
+			Packet.InverseDirectionZ[i] = InverseDirection.z;
+			Packet.MaxDistance[i] = MaxDistance;
+
+			const float LaneOrigin[3]{ Origins[i].x, Origins[i].y, Origins[i].z };
+			const float LaneInverseDirection[3]{ InverseDirection.x, InverseDirection.y, InverseDirection.z };
+
+			for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+				Packet.OriginMin[Axis] = std::min(Packet.OriginMin[Axis], LaneOrigin[Axis]);
+				Packet.OriginMax[Axis] = std::max(Packet.OriginMax[Axis], LaneOrigin[Axis]);
+				Packet.InverseDirectionMin[Axis] = std::min(Packet.InverseDirectionMin[Axis], LaneInverseDirection[Axis]);
+				Packet.InverseDirectionMax[Axis] = std::max(Packet.InverseDirectionMax[Axis], LaneInverseDirection[Axis]);
+			}
+		}
+
+		for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+			const float Min{ Packet.InverseDirectionMin[Axis] }, Max{ Packet.InverseDirectionMax[Axis] };
+			Packet.AxisIsCoherent[Axis] = std::isfinite(Min) && std::isfinite(Max) && (Min > 0.0f || Max < 0.0f);
+		}
+	}
+
+	// Whether no path of a packet can pass through a box within [MinDistance, the packet's largest MaxDistance], from its interval bounds alone.
+	// Along a coherent axis every path's slab distances lie between the extremes of the corner products, which only leaves the others unbounded.
+	inline bool PacketMissesBounds(const RayPacket& Packet, const float3& BoundsMin, const float3& BoundsMax, float MinDistance, float MaxDistance) {
+		const float AxisBoundsMin[3]{ BoundsMin.x, BoundsMin.y, BoundsMin.z }, AxisBoundsMax[3]{ BoundsMax.x, BoundsMax.y, BoundsMax.z };
+		float tNear{ MinDistance }, tFar{ MaxDistance };
+
+		for (uint Axis{ 0u }; Axis < 3u; Axis++) {
+			if (!Packet.AxisIsCoherent[Axis]) {
+				continue;
+			}
+
+			const float InverseDirections[2]{ Packet.InverseDirectionMin[Axis], Packet.InverseDirectionMax[Axis] };
+			const float Offsets[4]{ AxisBoundsMin[Axis] - Packet.OriginMax[Axis], AxisBoundsMin[Axis] - Packet.OriginMin[Axis],
+				AxisBoundsMax[Axis] - Packet.OriginMax[Axis], AxisBoundsMax[Axis] - Packet.OriginMin[Axis] };
+			float SlabMin{ +INFINITY }, SlabMax{ -INFINITY };
+
+			for (float Offset: Offsets) {
+				for (float InverseDirection: InverseDirections) {
+					SlabMin = std::min(SlabMin, Offset * InverseDirection);
+					SlabMax = std::max(SlabMax, Offset * InverseDirection);
+				}
+			}
+
+			tNear = std::max(tNear, SlabMin);
+			tFar = std::min(tFar, SlabMax);
+		}
+
+		// Widened like the per-path test, so that the interval never culls a box that one of the paths hits.
+		return tNear > tFar * 1.00000024f;
+	}
+
+	// Returns a mask of the packet's lanes whose path passes through a box within [MinDistance, MaxDistance of the lane]. Every kernel evaluates the
+	// per-path box test of PathTracerStuff.hpp in the same order, std::min/std::max included, so a lane is set exactly when that test passes.
+	typedef uint (*IntersectRayPacketFunction)(const RayPacket& Packet, const float3& BoundsMin, const float3& BoundsMax, float MinDistance);
+
+	inline uint IntersectRayPacketScalar(const RayPacket& Packet, const float3& BoundsMin, const float3& BoundsMax, float MinDistance) {
+		uint HitLanes{ 0u };
+
+		for (uint i{ 0u }; i < RayPacketSize; i++) {
+			const float t0x{ (BoundsMin.x - Packet.OriginX[i]) * Packet.InverseDirectionX[i] };
+			const float t1x{ (BoundsMax.x - Packet.OriginX[i]) * Packet.InverseDirectionX[i] };
+			const float t0y{ (BoundsMin.y - Packet.OriginY[i]) * Packet.InverseDirectionY[i] };
+			const float t1y{ (BoundsMax.y - Packet.OriginY[i]) * Packet.InverseDirectionY[i] };
+			const float t0z{ (BoundsMin.z - Packet.OriginZ[i]) * Packet.InverseDirectionZ[i] };
+			const float t1z{ (BoundsMax.z - Packet.OriginZ[i]) * Packet.InverseDirectionZ[i] };
+
+			const float tNear{ std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), MinDistance)) };
+			const float tFar{ std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), Packet.MaxDistance[i])) };
+
+			HitLanes |= (tNear <= tFar * 1.00000024f ? 1u : 0u) << i;
+		}
+
+		return HitLanes;
+	}
+
+#ifdef SIMD_STUFF_X86
+	// std::min(a, b) and std::max(a, b) return a unless b compares smaller or larger, which _mm*_min_ps(b, a) and _mm*_max_ps(b, a) match, NaNs included.
+	SIMD_STUFF_TARGET("avx2") inline uint IntersectRayPacketAVX2(const RayPacket& Packet, const float3& BoundsMin, const float3& BoundsMax, float MinDistance) {
+		const __m256 BoundsMinX{ _mm256_set1_ps(BoundsMin.x) }, BoundsMinY{ _mm256_set1_ps(BoundsMin.y) }, BoundsMinZ{ _mm256_set1_ps(BoundsMin.z) };
+		const __m256 BoundsMaxX{ _mm256_set1_ps(BoundsMax.x) }, BoundsMaxY{ _mm256_set1_ps(BoundsMax.y) }, BoundsMaxZ{ _mm256_set1_ps(BoundsMax.z) };
+		const __m256 Min{ _mm256_set1_ps(MinDistance) }, Widening{ _mm256_set1_ps(1.00000024f) };
+		uint HitLanes{ 0u };
+
+		for (uint i{ 0u }; i < RayPacketSize; i += 8u) {
+			const __m256 OriginX{ _mm256_load_ps(&Packet.OriginX[i]) };
+			const __m256 OriginY{ _mm256_load_ps(&Packet.OriginY[i]) };
+			const __m256 OriginZ{ _mm256_load_ps(&Packet.OriginZ[i]) };
+			const __m256 InverseDirectionX{ _mm256_load_ps(&Packet.InverseDirectionX[i]) };
+			const __m256 InverseDirectionY{ _mm256_load_ps(&Packet.InverseDirectionY[i]) };
+			const __m256 InverseDirectionZ{ _mm256_load_ps(&Packet.InverseDirectionZ[i]) };
+
+			const __m256 t0x{ _mm256_mul_ps(_mm256_sub_ps(BoundsMinX, OriginX), InverseDirectionX) };
+			const __m256 t1x{ _mm256_mul_ps(_mm256_sub_ps(BoundsMaxX, OriginX), InverseDirectionX) };
+			const __m256 t0y{ _mm256_mul_ps(_mm256_sub_ps(BoundsMinY, OriginY), InverseDirectionY) };
+			const __m256 t1y{ _mm256_mul_ps(_mm256_sub_ps(BoundsMaxY, OriginY), InverseDirectionY) };
+			const __m256 t0z{ _mm256_mul_ps(_mm256_sub_ps(BoundsMinZ, OriginZ), InverseDirectionZ) };
+			const __m256 t1z{ _mm256_mul_ps(_mm256_sub_ps(BoundsMaxZ, OriginZ), InverseDirectionZ) };
+
+			const __m256 tNear{ _mm256_max_ps(_mm256_max_ps(Min, _mm256_min_ps(t1z, t0z)),
+				_mm256_max_ps(_mm256_min_ps(t1y, t0y), _mm256_min_ps(t1x, t0x))) };
+			const __m256 tFar{ _mm256_min_ps(_mm256_min_ps(_mm256_load_ps(&Packet.MaxDistance[i]), _mm256_max_ps(t1z, t0z)),
+				_mm256_min_ps(_mm256_max_ps(t1y, t0y), _mm256_max_ps(t1x, t0x))) };
+
+			HitLanes |= ( uint )_mm256_movemask_ps(_mm256_cmp_ps(tNear, _mm256_mul_ps(tFar, Widening), _CMP_LE_OQ)) << i;
+		}
+
+		return HitLanes;
+	}
+
+	SIMD_STUFF_TARGET("avx512f")
+	inline uint IntersectRayPacketAVX512(const RayPacket& Packet, const float3& BoundsMin, const float3& BoundsMax, float MinDistance) {
+		const __m512 OriginX{ _mm512_load_ps(Packet.OriginX) }, OriginY{ _mm512_load_ps(Packet.OriginY) }, OriginZ{ _mm512_load_ps(Packet.OriginZ) };
+		const __m512 InverseDirectionX{ _mm512_load_ps(Packet.InverseDirectionX) };
+		const __m512 InverseDirectionY{ _mm512_load_ps(Packet.InverseDirectionY) };
+		const __m512 InverseDirectionZ{ _mm512_load_ps(Packet.InverseDirectionZ) };
+
+		const __m512 t0x{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMin.x), OriginX), InverseDirectionX) };
+		const __m512 t1x{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMax.x), OriginX), InverseDirectionX) };
+		const __m512 t0y{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMin.y), OriginY), InverseDirectionY) };
+		const __m512 t1y{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMax.y), OriginY), InverseDirectionY) };
+		const __m512 t0z{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMin.z), OriginZ), InverseDirectionZ) };
+		const __m512 t1z{ _mm512_mul_ps(_mm512_sub_ps(_mm512_set1_ps(BoundsMax.z), OriginZ), InverseDirectionZ) };
+
+		const __m512 tNear{ _mm512_max_ps(_mm512_max_ps(_mm512_set1_ps(MinDistance), _mm512_min_ps(t1z, t0z)),
+			_mm512_max_ps(_mm512_min_ps(t1y, t0y), _mm512_min_ps(t1x, t0x))) };
+		const __m512 tFar{ _mm512_min_ps(_mm512_min_ps(_mm512_load_ps(Packet.MaxDistance), _mm512_max_ps(t1z, t0z)),
+			_mm512_min_ps(_mm512_max_ps(t1y, t0y), _mm512_max_ps(t1x, t0x))) };
+
+		return ( uint )_mm512_cmp_ps_mask(tNear, _mm512_mul_ps(tFar, _mm512_set1_ps(1.00000024f)), _CMP_LE_OQ);
+	}
+#endif
+
+	inline IntersectRayPacketFunction GetIntersectRayPacket(SIMDLevel Level) {
+#ifdef SIMD_STUFF_X86
+		switch (Level) {
+			case SIMDLevel::AVX2: {
+				return IntersectRayPacketAVX2;
+			}
+			case SIMDLevel::AVX512: {
+				return IntersectRayPacketAVX512;
+			}
+			default: {
+				break;
+			}
+		}
+#endif
+
+		return IntersectRayPacketScalar;
+	}
+
+}
@@ -0,0 +1,374 @@
+// SamplerStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef SAMPLER_STUFF
+	#define SAMPLER_STUFF
+#endif
+
+#include "CPUStuff.hpp"
+#include <array>
+#include <cstring>
+
+namespace SamplerStuff {
+
+	/*
+		SAMPLER TYPES:
+			Independent - White noise, hashed from (pixel, sample index, dimension), the same values as the Compute Shaders use.
+			Stratified - Correlated multi-jittered patterns over each pair of dimensions, which need the sample count up-front.
+			Sobol - Owen-scrambled Sobol points in groups of four dimensions, with the groups decorrelated by shuffling the sample index.
+			BlueNoise - One Owen-scrambled Sobol sequence for every pixel, toroidally shifted by a blue-noise mask, so the error is spread as blue noise.
+	*/
+	enum class SamplerType : uint { Independent, Stratified, Sobol, BlueNoise };
+
+	// Width and height of the tiled blue-noise mask.
+	constexpr uint BlueNoiseMaskSize{ 64u };
+
+	// Selects the samples for every pixel, sample index and dimension, so they can be fetched statelessly from any thread.
+	struct Sampler {
+		SamplerType Type{ SamplerType::Independent };
+		uint Seed{ 0u };// Decorrelates renders that would otherwise use the same samples.
+		const float* BlueNoiseMask{ nullptr };// BlueNoiseMaskSize x BlueNoiseMaskSize values in [0, 1), for the BlueNoise sampler only.
+	};
+
+	inline const char* GetSamplerName(SamplerType Type) {
+		switch (Type) {
+			case SamplerType::Independent: {
+				return "independent";
+			}
+			case SamplerType::Stratified: {
+				return "stratified";
+			}
+			case SamplerType::Sobol: {
+				return "sobol";
+			}
+			case SamplerType::BlueNoise: {
+				return "blue-noise";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Looks a sampler up by its name, returning false if there is none.
+	inline bool GetSamplerType(const char* Name, SamplerType& Type) {
+		const SamplerType SamplerTypes[]{ SamplerType::Independent, SamplerType::Stratified, SamplerType::Sobol, SamplerType::BlueNoise };
+
+		for (SamplerType CurrentType: SamplerTypes) {
+			if (strcmp(Name, GetSamplerName(CurrentType)) == 0) {
+				Type = CurrentType;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// PCG-based hash of four 32-bit counters into four decorrelated 32-bit values.
+	inline uint4 PCG4D(uint4 Value) {
+		Value.x = Value.x * 1664525u + 1013904223u;
+		Value.y = Value.y * 1664525u + 1013904223u;
+		Value.z = Value.z * 1664525u + 1013904223u;
+		Value.w = Value.w * 1664525u + 1013904223u;
+
+		Value.x += Value.y * Value.w;
+		Value.y += Value.z * Value.x;
+		Value.z += Value.x * Value.y;
+		Value.w += Value.y * Value.z;
+
+		Value.x ^= Value.x >> 16u;
+		Value.y ^= Value.y >> 16u;
+		Value.z ^= Value.z >> 16u;
+		Value.w ^= Value.w >> 16u;
+
+		Value.x += Value.y * Value.w;
+		Value.y += Value.z * Value.x;
+		Value.z += Value.x * Value.y;
+		Value.w += Value.y * Value.z;
+
+		return Value;
+	}
+
+	// Maps the top 24 bits of a 32-bit value to a float in [0, 1).
+	inline float GetUnitFloat(uint Value) {
+		return ( float )(Value >> 8u) * (1.0f / 16777216.0f);
+	}
+
+	inline uint ReverseBits(uint Value) {
+		Value = ((Value >> 1u) & 0x55555555u) | ((Value & 0x55555555u) << 1u);
+		Value = ((Value >> 2u) & 0x33333333u) | ((Value & 0x33333333u) << 2u);
+		Value = ((Value >> 4u) & 0x0F0F0F0Fu) | ((Value & 0x0F0F0F0Fu) << 4u);
+		Value = ((Value >> 8u) & 0x00FF00FFu) | ((Value & 0x00FF00FFu) << 8u);
+
+		return (Value >> 16u) | (Value << 16u);
+	}
+
+	// Hash-based Owen scrambling (Burley 2020): a random nested uniform permutation of the bits of Value.
+	inline uint OwenScramble(uint Value, uint Seed) {
+		Value = ReverseBits(Value);
+
+		Value ^= Value * 0x3D20ADEAu;
+		Value += Seed;
+		Value *= (Seed >> 16u) | 1u;
+		Value ^= Value * 0x05526C56u;
+		Value ^= Value * 0x53A22864u;
+
+		return ReverseBits(Value);
+	}
+
+	// Random permutation of Index within [0, Length), from Kensler's "Correlated Multi-Jittered Sampling".
+	inline uint Permute(uint Index, uint Length, uint Seed) {
+		uint Mask{ Length - 1u };
+		Mask |= Mask >> 1u;
+		Mask |= Mask >> 2u;
+		Mask |= Mask >> 4u;
+		Mask |= Mask >> 8u;
+		Mask |= Mask >> 16u;
+
+		do {
+			Index ^= Seed;
+			Index *= 0xE170893Du;
+			Index ^= Seed >> 16u;
+			Index ^= (Index & Mask) >> 4u;
+			Index ^= Seed >> 8u;
+			Index *= 0x0929EB3Fu;
+			Index ^= Seed >> 23u;
+			Index ^= (Index & Mask) >> 1u;
+			Index *= 1u | Seed >> 27u;
+			Index *= 0x6935FA69u;
+			Index ^= (Index & Mask) >> 11u;
+			Index *= 0x74DCB303u;
+			Index ^= (Index & Mask) >> 2u;
+			Index *= 0x9E501CC3u;
+			Index ^= (Index & Mask) >> 2u;
+			Index *= 0xC860A3DFu;
+			Index &= Mask;
+			Index ^= Index >> 5u;
+		} while (Index >= Length);
+
+		return (Index + Seed) % Length;
+	}
+
+	// Direction numbers of the first four Sobol dimensions, from Joe and Kuo's primitive polynomials.
+	inline const std::array<std::array<uint, 32>, 4>& GetSobolDirections() {
+		static const std::array<std::array<uint, 32>, 4> SobolDirections{ [] {
+			const uint Degrees[4]{ 0u, 1u, 2u, 3u };
+			const uint Coefficients[4]{ 0u, 0u, 1u, 1u };
+			const uint InitialNumbers[4][3]{ {}, { 1u }, { 1u, 3u }, { 1u, 3u, 1u } };
+			std::array<std::array<uint, 32>, 4> Directions{};
+
+			for (uint Dimension{ 0u }; Dimension < 4u; Dimension++) {
+				const uint Degree{ Degrees[Dimension] };
+
+				for (uint Bit{ 0u }; Bit < 32u; Bit++) {
+					if (Dimension == 0u) {
+						Directions[Dimension][Bit] = 1u << (31u - Bit);
+					} else if (Bit < Degree) {
+						Directions[Dimension][Bit] = InitialNumbers[Dimension][Bit] << (31u - Bit);
+					} else {
+						uint Direction{ Directions[Dimension][Bit - Degree] ^ (Directions[Dimension][Bit - Degree] >> Degree) };
+
+						for (uint k{ 1u }; k < Degree; k++) {
+							Direction ^= ((Coefficients[Dimension] >> (Degree - 1u - k)) & 1u) * Directions[Dimension][Bit - k];
+						}
+
+						Directions[Dimension][Bit] = Direction;
+					}
+				}
+			}
+
+			return Directions;
+		}() };
+
+		return SobolDirections;
+	}
+
+	// Unscrambled Sobol point Index in one of the first four dimensions, as a 32-bit fixed-point fraction.
+	inline uint GetSobolBits(uint Index, uint Dimension) {
+		const std::array<uint, 32>& Directions{ GetSobolDirections()[Dimension] };
+		uint Bits{ 0u };
+
+		for (uint Bit{ 0u }; Index != 0u; Bit++, Index >>= 1u) {
+			if (Index & 1u) {
+				Bits ^= Directions[Bit];
+			}
+		}
+
+		return Bits;
+	}
+
+	// Owen-scrambled Sobol value in an arbitrary dimension: each group of four dimensions is a scrambled 4D Sobol sequence,
+	// and the groups are padded together by shuffling the sample index with a per-group nested uniform permutation.
+	inline uint GetShuffledScrambledSobolBits(uint SampleIndex, uint Dimension, uint Seed) {
+		const uint GroupSeed{ PCG4D(uint4{ Seed, Dimension / 4u, 0x51633E2Du, 0u }).x };
+		const uint ShuffledIndex{ OwenScramble(SampleIndex, GroupSeed) };
+
+		return OwenScramble(GetSobolBits(ShuffledIndex, Dimension % 4u), PCG4D(uint4{ GroupSeed, Dimension % 4u, 0x68BC21EBu, 0u }).x);
+	}
+
+	// Generates a BlueNoiseMaskSize x BlueNoiseMaskSize dither mask with Ulichney's void-and-cluster method, values in [0, 1).
+	inline std::vector<float> CreateBlueNoiseMask() {
+		const uint Size{ BlueNoiseMaskSize }, PixelCount{ Size * Size };
+		const float Sigma{ 1.50f };
+		std::vector<float> EnergyFilter(PixelCount);
+		std::vector<float> Energy(PixelCount);
+		std::vector<uint8_t> Pattern(PixelCount);
+		std::vector<uint> Ranks(PixelCount);
+
+		// Gaussian energy of a point as seen from every toroidal offset.
+		for (uint y{ 0u }; y < Size; y++) {
+			for (uint x{ 0u }; x < Size; x++) {
+				const float dx{ ( float )std::min(x, Size - x) }, dy{ ( float )std::min(y, Size - y) };
+				EnergyFilter[y * Size + x] = expf(-(dx * dx + dy * dy) / (2.0f * Sigma * Sigma));
+			}
+		}
+
+		auto TogglePoint = [&](uint PixelIndex) {
+			const uint px{ PixelIndex % Size }, py{ PixelIndex / Size };
+			const float Sign{ Pattern[PixelIndex] ? -1.0f : +1.0f };
+			Pattern[PixelIndex] ^= 1u;
+
+			for (uint y{ 0u }; y < Size; y++) {
+				const float* pFilterRow{ EnergyFilter.data() + (( size_t )((y + Size - py) % Size) * Size) };
+				float* pEnergyRow{ Energy.data() + ( size_t )y * Size };
+
+				for (uint x{ 0u }; x < Size; x++) {
+					pEnergyRow[x] += Sign * pFilterRow[(x + Size - px) % Size];
+				}
+			}
+		};
+
+		// Tightest cluster: the set pixel with the highest energy. Largest void: the empty pixel with the lowest energy.
+		auto FindExtremum = [&](uint8_t PatternValue, bool FindMaximum) {
+			uint BestIndex{ 0u };
+			float BestEnergy{ FindMaximum ? -1.0e30f : 1.0e30f };
+
+			for (uint i{ 0u }; i < PixelCount; i++) {
+				if (Pattern[i] == PatternValue && (FindMaximum ? Energy[i] > BestEnergy : Energy[i] < BestEnergy)) {
+					BestEnergy = Energy[i];
+					BestIndex = i;
+				}
+			}
+
+			return BestIndex;
+		};
+
+		// Initial binary pattern: a tenth of the pixels, randomly placed, then relaxed by moving tightest clusters into largest voids.
+		const uint InitialPointCount{ PixelCount / 10u };
+
+		for (uint PointCount{ 0u }, i{ 0u }; PointCount < InitialPointCount; i++) {
+			const uint PixelIndex{ PCG4D(uint4{ i, 0u, 0u, 0u }).x % PixelCount };
+
+			if (!Pattern[PixelIndex]) {
+				TogglePoint(PixelIndex);
+				PointCount++;
+			}
+		}
+
+		while (true) {
+			const uint TightestCluster{ FindExtremum(1u, true) };
+			TogglePoint(TightestCluster);
+			const uint LargestVoid{ FindExtremum(0u, false) };
+			TogglePoint(LargestVoid);
+
+			if (LargestVoid == TightestCluster) {
+				break;
+			}
+		}
+
+		const std::vector<uint8_t> InitialPattern{ Pattern };
+		const std::vector<float> InitialEnergy{ Energy };
+
+		// Phase 1: rank the initial points by repeatedly removing the tightest cluster.
+		for (uint Rank{ InitialPointCount }; Rank-- > 0u;) {
+			const uint TightestCluster{ FindExtremum(1u, true) };
+			TogglePoint(TightestCluster);
+			Ranks[TightestCluster] = Rank;
+		}
+
+		// Phases 2 and 3: rank the remaining pixels by repeatedly filling the largest void.
+		// On a torus, the tightest cluster of empty pixels is also the largest void of set ones, so both phases share one loop.
+		Pattern = InitialPattern;
+		Energy = InitialEnergy;
+
+		for (uint Rank{ InitialPointCount }; Rank < PixelCount; Rank++) {
+			const uint LargestVoid{ FindExtremum(0u, false) };
+			TogglePoint(LargestVoid);
+			Ranks[LargestVoid] = Rank;
+		}
+
+		std::vector<float> Mask(PixelCount);
+
+		for (uint i{ 0u }; i < PixelCount; i++) {
+			Mask[i] = (( float )Ranks[i] + 0.50f) / ( float )PixelCount;
+		}
+
+		return Mask;
+	}
+
+	// Blue-noise mask shared by every BlueNoise sampler, generated on first use.
+	inline const float* GetBlueNoiseMask() {
+		static const std::vector<float> BlueNoiseMask{ CreateBlueNoiseMask() };
+
+		return BlueNoiseMask.data();
+	}
+
+	inline Sampler CreateSampler(SamplerType Type, uint Seed = 0u) {
+		Sampler NewSampler{};
+		NewSampler.Type = Type;
+		NewSampler.Seed = Seed;
+		NewSampler.BlueNoiseMask = Type == SamplerType::BlueNoise ? GetBlueNoiseMask() : nullptr;
+
+		return NewSampler;
+	}
+
+	// Acquires sample SampleIndex of SampleCount for a pixel in a given dimension, as a value in [0, 1).
+	inline float GetSample(const Sampler& CurrentSampler, uint2 Pixel, uint SampleIndex, uint SampleCount, uint Dimension) {
+		switch (CurrentSampler.Type) {
+			case SamplerType::Independent: {
+				return GetUnitFloat(PCG4D(uint4{ Pixel.x + CurrentSampler.Seed * 0x9E3779B9u, Pixel.y, SampleIndex, Dimension }).x);
+			}
+			case SamplerType::Stratified: {
+				// Correlated multi-jittered sampling over the dimension pair, on a Columns x Rows grid that covers SampleCount.
+				// The strata are permuted over the whole grid, so those that SampleCount leaves empty are equally likely to be in any row and column.
+				const uint PatternSeed{ PCG4D(uint4{ Pixel.x, Pixel.y, CurrentSampler.Seed, Dimension / 2u }).x };
+				const uint Columns{ std::max(1u, ( uint )sqrtf(( float )SampleCount)) };
+				const uint Rows{ (SampleCount + Columns - 1u) / Columns };
+				const uint StratumCount{ Columns * Rows };
+				const uint Stratum{ Permute(SampleIndex % StratumCount, StratumCount, PatternSeed * 0x51633E2Du) };
+				const uint Column{ Stratum % Columns }, Row{ Stratum / Columns };
+
+				if (Dimension % 2u == 0u) {
+					const uint SubColumn{ Permute(Row, Rows, PatternSeed * 0x63D83595u) };
+					const float Jitter{ GetUnitFloat(PCG4D(uint4{ Stratum, PatternSeed, 0xA399D265u, 0u }).x) };
+
+					return (( float )Column + (( float )SubColumn + Jitter) / ( float )Rows) / ( float )Columns;
+				}
+
+				const uint SubRow{ Permute(Column, Columns, PatternSeed * 0xA511E9B3u) };
+				const float Jitter{ GetUnitFloat(PCG4D(uint4{ Stratum, PatternSeed, 0x711AD6A5u, 0u }).x) };
+
+				return (( float )Row + (( float )SubRow + Jitter) / ( float )Columns) / ( float )Rows;
+			}
+			case SamplerType::Sobol: {
+				const uint PixelSeed{ PCG4D(uint4{ Pixel.x, Pixel.y, CurrentSampler.Seed, 0x2C1B3C6Du }).x };
+
+				return GetUnitFloat(GetShuffledScrambledSobolBits(SampleIndex, Dimension, PixelSeed));
+			}
+			case SamplerType::BlueNoise: {
+				// Every dimension reads the mask at its own toroidal offset, so the dimensions' dither patterns are uncorrelated.
+				const uint4 MaskOffset{ PCG4D(uint4{ Dimension, CurrentSampler.Seed, 0x297A2D39u, 0u }) };
+				const uint MaskIndex{ ((Pixel.y + MaskOffset.y) % BlueNoiseMaskSize) * BlueNoiseMaskSize + (Pixel.x + MaskOffset.x) % BlueNoiseMaskSize };
+				const uint DitherBits{ ( uint )(CurrentSampler.BlueNoiseMask[MaskIndex] * 4294967296.0) };
+
+				return GetUnitFloat(GetShuffledScrambledSobolBits(SampleIndex, Dimension, CurrentSampler.Seed) + DitherBits);
+			}
+		}
+
+		return 0.0f;
+	}
+
+}
@@ -0,0 +1,374 @@
+// SceneCacheStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef SCENE_CACHE_STUFF
+	#define SCENE_CACHE_STUFF
+#endif
+
+#include "BVHStuff.hpp"
+#include <filesystem>
+#include <string>
+
+namespace SceneCacheStuff {
+
+	/*
+		SCENE CACHE LAYOUT:
+			A scene as the renderer holds it once loaded and interpolated to its first frame, along with the BVH built over it, stored so that
+			mapping the file is all it takes to render it. Every array is stored exactly as it is laid out in memory, and traced from in place.
+			00 - 64: SceneCacheHeader
+			64 - ..: SceneCacheSection table, one per SectionType
+			Then each section's elements, starting on a SectionAlignment boundary.
+			The cache belongs to a single source: its ContentHash covers the bytes of the scene file and of every mesh file that it imports (whose
+			paths the SourcePaths section lists, one per line), along with the BVH builder and the Version. Any change to either means rebuilding it.
+			Changing the layout of the cache, or of any struct in it, must bump Version. Each section also records its element size as a safeguard.
+	*/
+	constexpr uint64_t Magic{ 0x45484341434E5255ull };// "URNCACHE", read as a little-endian uint64_t.
+	constexpr uint Version{ 3u };
+	constexpr uint64_t SectionAlignment{ 64u };
+
+	/*
+		SECTION TYPES:
+			Spheres/Rectangles/Triangles/Meshes/MeshIndices/MeshVertices/MeshVerticesStart/MeshVerticesEnd - The Scene's arrays.
+			Prototypes/PrototypeIndices/PrototypeVertices/Instances - The Scene's instancing arrays.
+			Materials - The Scene's material table.
+			BVHNodes/BVHReferences/BVHSubtreeNodeRanges/BVHTopNodeIndices - The BVH's arrays, built with the shutter closed.
+			BVHPrototypeNodes/BVHPrototypeReferences/BVHPrototypeRootNodes - The trees of the Scene's prototypes.
+			SourcePaths - The mesh files that the ContentHash covers, besides the scene file.
+	*/
+	enum class SectionType : uint {
+		Spheres,
+		Rectangles,
+		Triangles,
+		Meshes,
+		MeshIndices,
+		MeshVertices,
+		MeshVerticesStart,
+		MeshVerticesEnd,
+		Prototypes,
+		PrototypeIndices,
+		PrototypeVertices,
+		Instances,
+		Materials,
+		BVHNodes,
+		BVHReferences,
+		BVHSubtreeNodeRanges,
+		BVHTopNodeIndices,
+		BVHPrototypeNodes,
+		BVHPrototypeReferences,
+		BVHPrototypeRootNodes,
+		SourcePaths,
+		Count
+	};
+
+	constexpr uint SectionCount{ ( uint )SectionType::Count };
+
+	struct SceneCacheHeader {
+		uint64_t Magic;
+		uint Version;
+		uint SectionCount;
+		uint64_t ContentHash;
+		uint64_t FileSizeInBytes;
+		uint BVHBuildType;
+		float BVHBuildSAHCost;
+		uint4 BVHPrimitiveCounts;
+		float GlobalTickInRadians;// Tick that the scene was interpolated to, and the BVH built at.
+		uint BVHInstanceCount;
+	};
+
+	struct SceneCacheSection {
+		uint64_t Offset;
+		uint64_t Count;
+		uint64_t ElementSize;
+	};
+
+	static_assert(sizeof(SceneCacheHeader) == 64u, "The header must stay 64 bytes, for the section table to start aligned.");
+
+	// How long a cache took to validate and map, or to build and write. ErrorMessage is set when it failed, or was stale.
+	struct SceneCacheStats {
+		uint64_t FileSizeInBytes{ 0u };
+		double HashSeconds{ 0.0 };// Hashing the source files, to validate or key the cache.
+		double BuildSeconds{ 0.0 };// Building the BVH and the prototypes' trees, when writing the cache.
+		double Seconds{ 0.0 };
+		const char* ErrorMessage{ nullptr };
+	};
+
+	// Content hash of a scene file and the mesh files it imports, for a given BVH builder. Returns false if any of them cannot be read.
+	inline bool GetContentHash(const char* SceneFilePath, const std::vector<std::string>& MeshFilePaths, BVHStuff::BVHBuildType BuildType, uint64_t& Hash) {
+		Hash = CPUStuff::HashBytes(&Version, sizeof(Version), ( uint64_t )BuildType);
+
+		for (size_t i{ 0u }; i <= MeshFilePaths.size(); i++) {
+			CPUStuff::MappedFile File{};
+
+			if (!File.Open(i == 0u ? SceneFilePath : MeshFilePaths[i - 1u].c_str())) {
+				return false;
+			}
+
+			Hash = CPUStuff::HashBytes(File.GetData(), File.GetSize(), Hash);
+		}
+
+		return true;
+	}
+
+	inline uint64_t AlignSectionOffset(uint64_t Offset) {
+		return (Offset + SectionAlignment - 1u) & ~(SectionAlignment - 1u);
+	}
+
+	// Builds the BVH, and the trees of its prototypes, over a scene, which must be interpolated to the tick its RootConstants hold, and writes both
+	// to a scene cache, keyed by the scene file and mesh files it was loaded from. The cache is written next to its final path and then renamed
+	// over it, so that a render job never maps one that is half written. BVH is left holding the tree, for the caller to render with.
+	inline bool SaveSceneCache(const char* CacheFilePath, const char* SceneFilePath, const std::vector<std::string>& MeshFilePaths,
+		const SceneStuff::Scene& Scene, BVHStuff::BVHBuildType BuildType, CPUStuff::ThreadPool& ThreadPool, BVHStuff::BVH& BVH, SceneCacheStats& Stats) {
+		CPUStuff::Timer SaveTimer{};
+		Stats = {};
+
+		CPUStuff::Timer HashTimer{};
+		SceneCacheHeader Header{};
+
+		if (!GetContentHash(SceneFilePath, MeshFilePaths, BuildType, Header.ContentHash)) {
+			Stats.ErrorMessage = "Could not read the scene's source files";
+			return false;
+		}
+
+		Stats.HashSeconds = HashTimer.GetElapsedSeconds();
+
+		BVHStuff::BVHBuildStats BuildStats{};
+		BVHStuff::BuildBVH(Scene, SceneStuff::ShutterInterval{}, ThreadPool, BuildType, BVH, BuildStats);
+		Stats.BuildSeconds = BuildStats.BuildSeconds;
+
+		if (BVHStuff::UpdatePrototypeBVHs(Scene, ThreadPool, BuildType, BVH, BuildStats)) {
+			Stats.BuildSeconds += BuildStats.BuildSeconds;
+		}
+
+		std::string SourcePaths{};
+
+		for (const std::string& MeshFilePath: MeshFilePaths) {
+			SourcePaths += MeshFilePath + "\n";
+		}
+
+		const std::pair<const void*, SceneCacheSection> Sections[SectionCount]{
+			{ Scene.Spheres.data(), { 0u, Scene.Spheres.size(), sizeof(Sphere) } },
+			{ Scene.Rectangles.data(), { 0u, Scene.Rectangles.size(), sizeof(Rectangle) } },
+			{ Scene.Triangles.data(), { 0u, Scene.Triangles.size(), sizeof(Triangle) } },
+			{ Scene.Meshes.data(), { 0u, Scene.Meshes.size(), sizeof(Mesh) } },
+			{ Scene.MeshIndices.data(), { 0u, Scene.MeshIndices.size(), sizeof(uint3) } },
+			{ Scene.MeshVertices.data(), { 0u, Scene.MeshVertices.size(), sizeof(float3) } },
+			{ Scene.MeshVerticesStart.data(), { 0u, Scene.MeshVerticesStart.size(), sizeof(float3) } },
+			{ Scene.MeshVerticesEnd.data(), { 0u, Scene.MeshVerticesEnd.size(), sizeof(float3) } },
+			{ Scene.Prototypes.data(), { 0u, Scene.Prototypes.size(), sizeof(Prototype) } },
+			{ Scene.PrototypeIndices.data(), { 0u, Scene.PrototypeIndices.size(), sizeof(uint3) } },
+			{ Scene.PrototypeVertices.data(), { 0u, Scene.PrototypeVertices.size(), sizeof(float3) } },
+			{ Scene.Instances.data(), { 0u, Scene.Instances.size(), sizeof(Instance) } },
+			{ Scene.Materials.data(), { 0u, Scene.Materials.size(), sizeof(Material) } },
+			{ BVH.Nodes.data(), { 0u, BVH.Nodes.size(), sizeof(BVHStuff::BVHNode) } },
+			{ BVH.References.data(), { 0u, BVH.References.size(), sizeof(uint) } },
+			{ BVH.SubtreeNodeRanges.data(), { 0u, BVH.SubtreeNodeRanges.size(), sizeof(uint2) } },
+			{ BVH.TopNodeIndices.data(), { 0u, BVH.TopNodeIndices.size(), sizeof(uint) } },
+			{ BVH.PrototypeNodes.data(), { 0u, BVH.PrototypeNodes.size(), sizeof(BVHStuff::BVHNode) } },
+			{ BVH.PrototypeReferences.data(), { 0u, BVH.PrototypeReferences.size(), sizeof(uint) } },
+			{ BVH.PrototypeRootNodes.data(), { 0u, BVH.PrototypeRootNodes.size(), sizeof(uint) } },
+			{ SourcePaths.data(), { 0u, SourcePaths.size(), sizeof(char) } },
+		};
+
+		SceneCacheSection SectionTable[SectionCount]{};
+		uint64_t Offset{ sizeof(SceneCacheHeader) + sizeof(SectionTable) };
+
+		for (uint i{ 0u }; i < SectionCount; i++) {
+			SectionTable[i] = Sections[i].second;
+			SectionTable[i].Offset = Offset = AlignSectionOffset(Offset);
+			Offset += SectionTable[i].Count * SectionTable[i].ElementSize;
+		}
+
+		Header.Magic = Magic;
+		Header.Version = Version;
+		Header.SectionCount = SectionCount;
+		Header.FileSizeInBytes = Offset;
+		Header.BVHBuildType = ( uint )BuildType;
+		Header.BVHBuildSAHCost = BVH.BuildSAHCost;
+		Header.BVHPrimitiveCounts = BVH.PrimitiveCounts;
+		Header.BVHInstanceCount = BVH.InstanceCount;
+		Header.GlobalTickInRadians = Scene.RootConstants.GlobalTickInRadians;
+
+		const std::string TemporaryFilePath{ std::string{ CacheFilePath } + ".tmp" };
+		FILE* pFile{ fopen(TemporaryFilePath.c_str(), "wb") };
+
+		if (pFile == nullptr) {
+			Stats.ErrorMessage = "Could not create the file";
+			return false;
+		}
+
+		bool Written{ fwrite(&Header, sizeof(Header), 1u, pFile) == 1u && fwrite(SectionTable, sizeof(SectionTable), 1u, pFile) == 1u };
+		uint64_t WrittenSize{ sizeof(Header) + sizeof(SectionTable) };
+		const char Padding[SectionAlignment]{};
+
+		for (uint i{ 0u }; i < SectionCount && Written; i++) {
+			const uint64_t SectionSize{ SectionTable[i].Count * SectionTable[i].ElementSize };
+
+			Written = fwrite(Padding, 1u, SectionTable[i].Offset - WrittenSize, pFile) == SectionTable[i].Offset - WrittenSize &&
+				fwrite(Sections[i].first, 1u, SectionSize, pFile) == SectionSize;
+			WrittenSize = SectionTable[i].Offset + SectionSize;
+		}
+
+		std::error_code ErrorCode{};
+
+		if (fclose(pFile) != 0 || !Written) {
+			std::filesystem::remove(TemporaryFilePath, ErrorCode);
+			Stats.ErrorMessage = "Could not write the file";
+			return false;
+		}
+
+		std::filesystem::rename(TemporaryFilePath, CacheFilePath, ErrorCode);
+
+		if (ErrorCode) {
+			std::filesystem::remove(TemporaryFilePath, ErrorCode);
+			Stats.ErrorMessage = "Could not replace the file";
+			return false;
+		}
+
+		Stats.FileSizeInBytes = Header.FileSizeInBytes;
+		Stats.Seconds = SaveTimer.GetElapsedSeconds();
+		return true;
+	}
+
+	// A mapped scene cache, whose pages a Scene's arrays and a BVH are pointed at, so that they are rendered from without being read or copied.
+	// The mapping is copy-on-write: interpolating the scene or refitting the BVH copies only the pages they write to, and never touches the file.
+	// It must outlive the Scene and the BVH it opened, or at least their arrays' next size change, which gives them storage of their own.
+	class SceneCache {
+	  protected:
+		CPUStuff::MappedFile File{};
+
+		template<typename ElementType> bool ViewSection(SectionType Type, CPUStuff::MappableVector<ElementType>& Array) {
+			const SceneCacheSection& Section{ this->GetSections()[( uint )Type] };
+
+			if (Section.ElementSize != sizeof(ElementType)) {
+				return false;
+			}
+
+			Array.View(( ElementType* )(this->File.GetWritableData() + Section.Offset), Section.Count);
+			return true;
+		}
+
+		const SceneCacheHeader& GetHeader() {
+			return *( const SceneCacheHeader* )this->File.GetData();
+		}
+
+		const SceneCacheSection* GetSections() {
+			return ( const SceneCacheSection* )(this->File.GetData() + sizeof(SceneCacheHeader));
+		}
+
+		// Checks that the file is a complete cache of this version, whose sections all lie within it.
+		bool IsValid() {
+			const uint64_t TableEnd{ sizeof(SceneCacheHeader) + SectionCount * sizeof(SceneCacheSection) };
+
+			if (this->File.GetSize() < TableEnd) {
+				return false;
+			}
+
+			const SceneCacheHeader& Header{ this->GetHeader() };
+
+			if (Header.Magic != Magic || Header.Version != Version || Header.SectionCount != SectionCount || Header.FileSizeInBytes != this->File.GetSize()) {
+				return false;
+			}
+
+			for (uint i{ 0u }; i < SectionCount; i++) {
+				const SceneCacheSection& Section{ this->GetSections()[i] };
+
+				if (Section.Offset < TableEnd || Section.Offset % SectionAlignment != 0u || Section.ElementSize == 0u ||
+					Section.Count > (this->File.GetSize() - Section.Offset) / Section.ElementSize) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+	  public:
+		// Maps a cache and points a scene and a BVH at it, if it was written for the scene file (and the mesh files it imports) as they are now,
+		// and for the same BVH builder. Returns false, leaving both untouched, if it is missing, unreadable or stale.
+		// The scene is left interpolated to the tick its RootConstants.GlobalTickInRadians holds, for the caller to fill the rest of them in.
+		bool Open(const char* CacheFilePath, const char* SceneFilePath, BVHStuff::BVHBuildType BuildType, SceneStuff::Scene& Scene, BVHStuff::BVH& BVH,
+			SceneCacheStats& Stats) {
+			CPUStuff::Timer OpenTimer{};
+			Stats = {};
+			this->File.Close();
+
+			if (!this->File.Open(CacheFilePath, true)) {
+				Stats.ErrorMessage = "Could not open or map the file";
+				return false;
+			}
+
+			if (!this->IsValid() || this->GetHeader().BVHBuildType != ( uint )BuildType) {
+				this->File.Close();
+				Stats.ErrorMessage = "Not a scene cache of this version and BVH builder";
+				return false;
+			}
+
+			// The SourcePaths section ends each path with a newline.
+			const SceneCacheSection& SourcePathsSection{ this->GetSections()[( uint )SectionType::SourcePaths] };
+			const char* pSourcePaths{ this->File.GetData() + SourcePathsSection.Offset };
+			std::vector<std::string> MeshFilePaths{};
+
+			for (uint64_t Begin{ 0u }, i{ 0u }; i < SourcePathsSection.Count; i++) {
+				if (pSourcePaths[i] == '\n') {
+					MeshFilePaths.emplace_back(pSourcePaths + Begin, pSourcePaths + i);
+					Begin = i + 1u;
+				}
+			}
+
+			CPUStuff::Timer HashTimer{};
+			uint64_t ContentHash{ 0u };
+			const bool Hashed{ GetContentHash(SceneFilePath, MeshFilePaths, BuildType, ContentHash) };
+			Stats.HashSeconds = HashTimer.GetElapsedSeconds();
+
+			if (!Hashed || ContentHash != this->GetHeader().ContentHash) {
+				this->File.Close();
+				Stats.ErrorMessage = "Stale, the scene has changed since it was written";
+				return false;
+			}
+
+			SceneStuff::Scene NewScene{};
+			BVHStuff::BVH NewBVH{};
+
+			if (!this->ViewSection(SectionType::Spheres, NewScene.Spheres) || !this->ViewSection(SectionType::Rectangles, NewScene.Rectangles) ||
+				!this->ViewSection(SectionType::Triangles, NewScene.Triangles) || !this->ViewSection(SectionType::Meshes, NewScene.Meshes) ||
+				!this->ViewSection(SectionType::MeshIndices, NewScene.MeshIndices) || !this->ViewSection(SectionType::MeshVertices, NewScene.MeshVertices) ||
+				!this->ViewSection(SectionType::MeshVerticesStart, NewScene.MeshVerticesStart) ||
+				!this->ViewSection(SectionType::MeshVerticesEnd, NewScene.MeshVerticesEnd) ||
+				!this->ViewSection(SectionType::Prototypes, NewScene.Prototypes) ||
+				!this->ViewSection(SectionType::PrototypeIndices, NewScene.PrototypeIndices) ||
+				!this->ViewSection(SectionType::PrototypeVertices, NewScene.PrototypeVertices) ||
+				!this->ViewSection(SectionType::Instances, NewScene.Instances) || !this->ViewSection(SectionType::Materials, NewScene.Materials) ||
+				!this->ViewSection(SectionType::BVHNodes, NewBVH.Nodes) ||
+				!this->ViewSection(SectionType::BVHReferences, NewBVH.References) ||
+				!this->ViewSection(SectionType::BVHSubtreeNodeRanges, NewBVH.SubtreeNodeRanges) ||
+				!this->ViewSection(SectionType::BVHTopNodeIndices, NewBVH.TopNodeIndices) ||
+				!this->ViewSection(SectionType::BVHPrototypeNodes, NewBVH.PrototypeNodes) ||
+				!this->ViewSection(SectionType::BVHPrototypeReferences, NewBVH.PrototypeReferences) ||
+				!this->ViewSection(SectionType::BVHPrototypeRootNodes, NewBVH.PrototypeRootNodes)) {
+				this->File.Close();
+				Stats.ErrorMessage = "A section does not match this build's structs";
+				return false;
+			}
+
+			NewBVH.PrimitiveCounts = this->GetHeader().BVHPrimitiveCounts;
+			NewBVH.InstanceCount = this->GetHeader().BVHInstanceCount;
+			NewBVH.BuildSAHCost = this->GetHeader().BVHBuildSAHCost;
+			NewScene.RootConstants.GlobalTickInRadians = this->GetHeader().GlobalTickInRadians;
+
+			Scene = std::move(NewScene);
+			BVH = std::move(NewBVH);
+
+			Stats.FileSizeInBytes = this->File.GetSize();
+			Stats.Seconds = OpenTimer.GetElapsedSeconds();
+			return true;
+		}
+
+		bool IsOpen() {
+			return this->File.GetData() != nullptr;
+		}
+	};
+
+}
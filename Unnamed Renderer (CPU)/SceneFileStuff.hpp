@@ -0,0 +1,761 @@
+// SceneFileStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef SCENE_FILE_STUFF
+	#define SCENE_FILE_STUFF
+#endif
+
+#include "ImportStuff.hpp"
+#include <charconv>
+#include <climits>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace SceneFileStuff {
+
+	/*
+		SCENE FILE FORMAT:
+			Plain text, one statement per line, where blank lines and lines starting with # are ignored. Settings come first, one per line:
+				width <pixels>, height <pixels>, spp <count>, depth <count>, rr-depth <count>, vfov <degrees>,
+				path-min-distance <distance>, path-max-distance <distance>, sky-top <r g b>, sky-bottom <r g b>
+			Any left out keep their RenderSettings default. Primitives follow, one per line, each with its material named as in GetMaterialName(), and
+			the Start and then the End keyframe of every animated value:
+				sphere <material> <origin x y z> <origin x y z> <radius> <radius> <color r g b> <color r g b> <scalar> <scalar>
+				rectangle <material> <q1 x y z> <q1 x y z> <q2 x y z> <q2 x y z> <q3 x y z> <q3 x y z> <q4 x y z> <q4 x y z> <color r g b> <color r g b>
+					<scalar> <scalar>
+				triangle <material> <v1 x y z> <v1 x y z> <v2 x y z> <v2 x y z> <v3 x y z> <v3 x y z> <color r g b> <color r g b> <scalar> <scalar>
+				mesh <material> <color r g b> <color r g b> <scalar> <scalar> <path>
+				prototype <path>
+				instance <material> <prototype> <row 0 x y z w> <row 1 x y z w> <row 2 x y z w> <color r g b> <color r g b> <scalar> <scalar>
+			A mesh's or a prototype's path, which runs to the end of its line, is a binary PLY or OBJ file (see ImportStuff.hpp) relative to the scene
+			file. Prototypes are only traced through their instances, which name them by their place among the file's prototypes, counting from 0, and
+			place them with the rows of an invertible affine transform, whose last column is the translation.
+			Primitives keep the order of the file, and their ObjectIds count up from 0 for each kind of primitive. Their materials go into the scene's
+			material table, where those that several primitives share are stored once.
+	*/
+
+	// What a scene file held, and how long it took to load. ErrorMessage, and the line it refers to if any, are set when it failed.
+	struct SceneFileStats {
+		uint64_t FileSizeInBytes{ 0u };
+		uint SphereCount{ 0u };
+		uint RectangleCount{ 0u };
+		uint TriangleCount{ 0u };
+		uint MeshCount{ 0u };
+		uint MeshTriangleCount{ 0u };
+		uint PrototypeCount{ 0u };
+		uint PrototypeTriangleCount{ 0u };
+		uint InstanceCount{ 0u };
+		uint MaterialCount{ 0u };// Distinct materials among the primitives.
+		std::vector<std::string> MeshFilePaths{};// Files the meshes and prototypes were imported from, as they were opened.
+		double Seconds{ 0.0 };
+		const char* ErrorMessage{ nullptr };
+		uint ErrorLine{ 0u };
+	};
+
+	/*
+		STATEMENT TYPES:
+			Sphere/Rectangle/Triangle/Mesh/Prototype/Instance - Primitives, in the order their arrays are counted in.
+			Setting - A render setting.
+			None - A blank line or a comment.
+			Unknown - Anything else, which is an error.
+	*/
+	enum class StatementType : uint { Sphere, Rectangle, Triangle, Mesh, Prototype, Instance, Setting, None, Unknown };
+
+	inline StatementType GetStatementType(const char* p, const char* LineEnd) {
+		const char* PrimitiveKeywords[]{ "sphere", "rectangle", "triangle", "mesh", "prototype", "instance" };
+		const char* SettingKeywords[]{ "width", "height", "spp", "depth", "rr-depth", "vfov", "path-min-distance", "path-max-distance", "sky-top",
+			"sky-bottom" };
+
+		if (p == LineEnd || *p == '#') {
+			return StatementType::None;
+		}
+
+		for (uint i{ 0u }; i < ( uint )StatementType::Setting; i++) {
+			if (ImportStuff::StartsWithKeyword(p, LineEnd, PrimitiveKeywords[i])) {
+				return ( StatementType )i;
+			}
+		}
+
+		for (const char* Keyword: SettingKeywords) {
+			if (ImportStuff::StartsWithKeyword(p, LineEnd, Keyword)) {
+				return StatementType::Setting;
+			}
+		}
+
+		return StatementType::Unknown;
+	}
+
+	// Value parsing, each skipping the spaces before its value and returning false if there is none.
+
+	inline bool ParseFloats(const char*& p, const char* LineEnd, float* pValues, uint ValueCount) {
+		for (uint i{ 0u }; i < ValueCount; i++) {
+			ImportStuff::SkipSpaces(p, LineEnd);
+
+			if (!ImportStuff::ParseFloat(p, LineEnd, pValues[i])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool ParseFloat3(const char*& p, const char* LineEnd, float3& Value) {
+		float Values[3];
+
+		if (!ParseFloats(p, LineEnd, Values, 3u)) {
+			return false;
+		}
+
+		Value = { Values[0], Values[1], Values[2] };
+		return true;
+	}
+
+	inline bool ParseUnsigned(const char*& p, const char* LineEnd, uint& Value) {
+		int64_t Integer{ 0 };
+		ImportStuff::SkipSpaces(p, LineEnd);
+
+		if (!ImportStuff::ParseInteger(p, LineEnd, Integer) || Integer < 0 || Integer > UINT_MAX) {
+			return false;
+		}
+
+		Value = ( uint )Integer;
+		return true;
+	}
+
+	inline bool ParseMaterialId(const char*& p, const char* LineEnd, uint& MaterialId) {
+		const char* Token;
+		size_t TokenLength;
+		char Name[16]{};
+
+		if (!ImportStuff::ReadToken(p, LineEnd, Token, TokenLength) || TokenLength >= sizeof(Name)) {
+			return false;
+		}
+
+		memcpy(Name, Token, TokenLength);
+		return SceneStuff::GetMaterialId(Name, MaterialId);
+	}
+
+	// Whether nothing but spaces is left of a line.
+	inline bool IsLineComplete(const char* p, const char* LineEnd) {
+		ImportStuff::SkipSpaces(p, LineEnd);
+		return p == LineEnd;
+	}
+
+	// Applies a setting statement, with p at its keyword.
+	inline bool ParseSetting(const char* p, const char* LineEnd, SceneStuff::RenderSettings& Settings) {
+		struct UnsignedSetting {
+			const char* Keyword;
+			uint* pValue;
+		} UnsignedSettings[]{ { "width", &Settings.PSViewPortDimensions.x }, { "height", &Settings.PSViewPortDimensions.y },
+			{ "spp", &Settings.SamplesPerPixel }, { "depth", &Settings.MaxRecursionDepth }, { "rr-depth", &Settings.RussianRouletteDepth } };
+		struct FloatSetting {
+			const char* Keyword;
+			float* pValue;
+			uint ValueCount;
+		} FloatSettings[]{ { "vfov", &Settings.VFoVInDegrees, 1u }, { "path-min-distance", &Settings.PathMinDistance, 1u },
+			{ "path-max-distance", &Settings.PathMaxDistance, 1u }, { "sky-top", &Settings.SkyTopColor.x, 3u },
+			{ "sky-bottom", &Settings.SkyBottomColor.x, 3u } };
+
+		for (const UnsignedSetting& Setting: UnsignedSettings) {
+			if (ImportStuff::StartsWithKeyword(p, LineEnd, Setting.Keyword)) {
+				p += strlen(Setting.Keyword);
+				return ParseUnsigned(p, LineEnd, *Setting.pValue) && IsLineComplete(p, LineEnd);
+			}
+		}
+
+		for (const FloatSetting& Setting: FloatSettings) {
+			if (ImportStuff::StartsWithKeyword(p, LineEnd, Setting.Keyword)) {
+				float Values[3];
+				p += strlen(Setting.Keyword);
+
+				if (!ParseFloats(p, LineEnd, Values, Setting.ValueCount) || !IsLineComplete(p, LineEnd)) {
+					return false;
+				}
+
+				memcpy(Setting.pValue, Values, Setting.ValueCount * sizeof(float));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Parses the color and material scalar keyframes that end every primitive statement, leaving the material at its Start keyframe.
+	inline bool ParseAppearance(const char*& p, const char* LineEnd, Material& CurrentMaterial) {
+		if (!ParseFloat3(p, LineEnd, CurrentMaterial.ColorStart) || !ParseFloat3(p, LineEnd, CurrentMaterial.ColorEnd) ||
+			!ParseFloats(p, LineEnd, &CurrentMaterial.MaterialScalarStart, 1u) || !ParseFloats(p, LineEnd, &CurrentMaterial.MaterialScalarEnd, 1u)) {
+			return false;
+		}
+
+		CurrentMaterial.Color = CurrentMaterial.ColorStart;
+		CurrentMaterial.MaterialScalar = CurrentMaterial.MaterialScalarStart;
+		return true;
+	}
+
+	// Primitive statements, each parsed along with the material written inline in it.
+
+	inline bool ParseSphere(const char* p, const char* LineEnd, Sphere& CurrentSphere, Material& CurrentMaterial) {
+		p += strlen("sphere");
+		return ParseMaterialId(p, LineEnd, CurrentMaterial.MaterialId) && ParseFloat3(p, LineEnd, CurrentSphere.WSOriginStart) &&
+			ParseFloat3(p, LineEnd, CurrentSphere.WSOriginEnd) && ParseFloats(p, LineEnd, &CurrentSphere.WSRadiusStart, 1u) &&
+			ParseFloats(p, LineEnd, &CurrentSphere.WSRadiusEnd, 1u) && ParseAppearance(p, LineEnd, CurrentMaterial) && IsLineComplete(p, LineEnd);
+	}
+
+	inline bool ParseRectangle(const char* p, const char* LineEnd, Rectangle& CurrentRectangle, Material& CurrentMaterial) {
+		p += strlen("rectangle");
+		return ParseMaterialId(p, LineEnd, CurrentMaterial.MaterialId) && ParseFloat3(p, LineEnd, CurrentRectangle.Q1Start) &&
+			ParseFloat3(p, LineEnd, CurrentRectangle.Q1End) && ParseFloat3(p, LineEnd, CurrentRectangle.Q2Start) &&
+			ParseFloat3(p, LineEnd, CurrentRectangle.Q2End) && ParseFloat3(p, LineEnd, CurrentRectangle.Q3Start) &&
+			ParseFloat3(p, LineEnd, CurrentRectangle.Q3End) && ParseFloat3(p, LineEnd, CurrentRectangle.Q4Start) &&
+			ParseFloat3(p, LineEnd, CurrentRectangle.Q4End) && ParseAppearance(p, LineEnd, CurrentMaterial) && IsLineComplete(p, LineEnd);
+	}
+
+	inline bool ParseTriangle(const char* p, const char* LineEnd, Triangle& CurrentTriangle, Material& CurrentMaterial) {
+		p += strlen("triangle");
+		return ParseMaterialId(p, LineEnd, CurrentMaterial.MaterialId) && ParseFloat3(p, LineEnd, CurrentTriangle.V1Start) &&
+			ParseFloat3(p, LineEnd, CurrentTriangle.V1End) && ParseFloat3(p, LineEnd, CurrentTriangle.V2Start) &&
+			ParseFloat3(p, LineEnd, CurrentTriangle.V2End) && ParseFloat3(p, LineEnd, CurrentTriangle.V3Start) &&
+			ParseFloat3(p, LineEnd, CurrentTriangle.V3End) && ParseAppearance(p, LineEnd, CurrentMaterial) && IsLineComplete(p, LineEnd);
+	}
+
+	// Parses an instance statement, whose prototype index must be below PrototypeCount, along with the inverse of its transform.
+	inline bool ParseInstance(const char* p, const char* LineEnd, uint PrototypeCount, Instance& CurrentInstance, Material& CurrentMaterial) {
+		p += strlen("instance");
+		return ParseMaterialId(p, LineEnd, CurrentMaterial.MaterialId) && ParseUnsigned(p, LineEnd, CurrentInstance.PrototypeIndex) &&
+			CurrentInstance.PrototypeIndex < PrototypeCount && ParseFloats(p, LineEnd, &CurrentInstance.WorldFromObject[0].x, 4u) &&
+			ParseFloats(p, LineEnd, &CurrentInstance.WorldFromObject[1].x, 4u) && ParseFloats(p, LineEnd, &CurrentInstance.WorldFromObject[2].x, 4u) &&
+			ParseAppearance(p, LineEnd, CurrentMaterial) && IsLineComplete(p, LineEnd) &&
+			SceneStuff::InvertTransform(CurrentInstance.WorldFromObject, CurrentInstance.ObjectFromWorld);
+	}
+
+	// Leaves the path that ends a mesh or prototype statement, running to the end of its line, in [pPath, pPathEnd).
+	inline bool ParsePath(const char* p, const char* LineEnd, const char*& pPath, const char*& pPathEnd) {
+		ImportStuff::SkipSpaces(p, LineEnd);
+		pPath = p;
+		pPathEnd = LineEnd;
+
+		while (pPathEnd > pPath && ImportStuff::IsSpace(pPathEnd[-1])) {
+			pPathEnd--;
+		}
+
+		return pPathEnd > pPath;
+	}
+
+	// Parses a mesh statement up to its path, which is left in [pPath, pPathEnd).
+	inline bool ParseMesh(const char* p, const char* LineEnd, Material& CurrentMaterial, const char*& pPath, const char*& pPathEnd) {
+		p += strlen("mesh");
+		return ParseMaterialId(p, LineEnd, CurrentMaterial.MaterialId) && ParseAppearance(p, LineEnd, CurrentMaterial) &&
+			ParsePath(p, LineEnd, pPath, pPathEnd);
+	}
+
+	inline bool ParsePrototype(const char* p, const char* LineEnd, const char*& pPath, const char*& pPathEnd) {
+		p += strlen("prototype");
+		return ParsePath(p, LineEnd, pPath, pPathEnd);
+	}
+
+	// Adds materials to a scene's material table, storing each distinct one once, so that primitives that share a material share its entry.
+	class MaterialTableBuilder {
+	  protected:
+		struct MaterialHash {
+			size_t operator()(const Material& CurrentMaterial) const {
+				return ( size_t )CPUStuff::HashBytes(&CurrentMaterial, sizeof(Material), 0u);
+			}
+		};
+
+		struct MaterialEqual {
+			bool operator()(const Material& Left, const Material& Right) const {
+				return memcmp(&Left, &Right, sizeof(Material)) == 0;
+			}
+		};
+
+		std::unordered_map<Material, uint, MaterialHash, MaterialEqual> MaterialIndices{};
+
+	  public:
+		// MaterialIndex of a material in the scene, which is appended to its Materials if it holds no identical one yet.
+		uint AddMaterial(const Material& NewMaterial, SceneStuff::Scene& Scene) {
+			const auto [Entry, Inserted] = this->MaterialIndices.try_emplace(NewMaterial, ( uint )Scene.Materials.size());
+
+			if (Inserted) {
+				Scene.Materials.push_back(NewMaterial);
+			}
+
+			return Entry->second;
+		}
+	};
+
+	// The first error found while parsing in parallel, by its place in the file, so that the same error is reported on every run.
+	struct ParseError {
+		std::mutex Mutex{};
+		const char* pLine{ nullptr };
+		const char* Message{ nullptr };
+
+		void Report(const char* pErrorLine, const char* ErrorMessage) {
+			std::unique_lock<std::mutex> Lock{ this->Mutex };
+
+			if (this->pLine == nullptr || pErrorLine < this->pLine) {
+				this->pLine = pErrorLine;
+				this->Message = ErrorMessage;
+			}
+		}
+	};
+
+	inline void SetError(const char* pData, const char* pLine, const char* ErrorMessage, SceneFileStats& Stats) {
+		Stats.ErrorMessage = ErrorMessage;
+		Stats.ErrorLine = pLine != nullptr ? 1u + ( uint )std::count(pData, pLine, '\n') : 0u;
+	}
+
+	// Reads the settings at the top of a scene file into Settings, leaving those it does not set as they are. Cheap, since it stops at the first
+	// primitive, so that a host can apply its own overrides before loading the rest with LoadScene().
+	inline bool LoadSceneSettings(const char* FilePath, SceneStuff::RenderSettings& Settings, SceneFileStats& Stats) {
+		CPUStuff::MappedFile File{};
+		Stats = {};
+
+		if (!File.Open(FilePath)) {
+			Stats.ErrorMessage = "Could not open or map the file";
+			return false;
+		}
+
+		const char* pData{ File.GetData() };
+		const char* End{ pData + File.GetSize() };
+		SceneStuff::RenderSettings NewSettings{ Settings };
+
+		for (const char* p{ pData }; p < End;) {
+			const char* pLine{ p };
+			const char* LineEnd{ ImportStuff::GetLineEnd(p, End) };
+			ImportStuff::SkipSpaces(p, LineEnd);
+			const StatementType Type{ GetStatementType(p, LineEnd) };
+
+			if (Type == StatementType::Unknown || (Type == StatementType::Setting && !ParseSetting(p, LineEnd, NewSettings))) {
+				SetError(pData, pLine, Type == StatementType::Unknown ? "Unknown statement" : "Malformed setting", Stats);
+				return false;
+			}
+
+			if (Type < StatementType::Setting) {
+				break;
+			}
+
+			p = LineEnd < End ? LineEnd + 1 : End;
+		}
+
+		Settings = NewSettings;
+		Stats.FileSizeInBytes = File.GetSize();
+		return true;
+	}
+
+	// Loads the primitives of a scene file into Scene, replacing what it held, and derives its Root Constants from Settings. Settings statements are
+	// only checked here, see LoadSceneSettings(). Primitives are counted, and then parsed, in parallel across chunks of the file, straight into the
+	// scene's arrays, after which meshes and prototypes are imported one by one.
+	inline bool LoadScene(const char* FilePath, const SceneStuff::RenderSettings& Settings, CPUStuff::ThreadPool& ThreadPool, SceneStuff::Scene& Scene,
+		SceneFileStats& Stats) {
+		CPUStuff::Timer LoadTimer{};
+		CPUStuff::MappedFile File{};
+		Stats = {};
+
+		if (!File.Open(FilePath)) {
+			Stats.ErrorMessage = "Could not open or map the file";
+			return false;
+		}
+
+		const char* pData{ File.GetData() };
+		const char* End{ pData + File.GetSize() };
+		Stats.FileSizeInBytes = File.GetSize();
+
+		// Counting, along with where the first primitive and the last setting are, since settings after a primitive would go unnoticed.
+		constexpr uint PrimitiveTypeCount{ ( uint )StatementType::Setting };
+
+		struct SceneChunk {
+			ImportStuff::TextChunk Text{};
+			uint64_t Counts[PrimitiveTypeCount]{};
+			uint64_t FirstIndices[PrimitiveTypeCount]{};
+			const char* pFirstPrimitive{ nullptr };
+			const char* pLastSetting{ nullptr };
+		};
+
+		const std::vector<ImportStuff::TextChunk> TextChunks{ ImportStuff::SplitIntoTextChunks(pData, End) };
+		std::vector<SceneChunk> Chunks(TextChunks.size());
+		ParseError Error{};
+
+		for (size_t i{ 0u }; i < Chunks.size(); i++) {
+			Chunks[i].Text = TextChunks[i];
+		}
+
+		ThreadPool.ParallelFor(( int64_t )Chunks.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				SceneChunk& Chunk{ Chunks[i] };
+
+				ImportStuff::ForEachLine(Chunk.Text, [&](const char* p, const char* LineEnd) {
+					const StatementType Type{ GetStatementType(p, LineEnd) };
+
+					if (Type < StatementType::Setting) {
+						Chunk.Counts[( uint )Type]++;
+						Chunk.pFirstPrimitive = Chunk.pFirstPrimitive == nullptr ? p : Chunk.pFirstPrimitive;
+					} else if (Type == StatementType::Setting) {
+						Chunk.pLastSetting = p;
+					} else if (Type == StatementType::Unknown) {
+						Error.Report(p, "Unknown statement");
+					}
+				});
+			}
+		});
+
+		uint64_t Counts[PrimitiveTypeCount]{};
+		const char* pFirstPrimitive{ nullptr };
+
+		for (SceneChunk& Chunk: Chunks) {
+			for (uint Type{ 0u }; Type < PrimitiveTypeCount; Type++) {
+				Chunk.FirstIndices[Type] = Counts[Type];
+				Counts[Type] += Chunk.Counts[Type];
+			}
+
+			pFirstPrimitive = pFirstPrimitive == nullptr ? Chunk.pFirstPrimitive : pFirstPrimitive;
+		}
+
+		for (const SceneChunk& Chunk: Chunks) {
+			if (Chunk.pLastSetting != nullptr && pFirstPrimitive != nullptr && Chunk.pLastSetting > pFirstPrimitive) {
+				Error.Report(Chunk.pLastSetting, "Settings must come before every primitive");
+			}
+		}
+
+		if (Error.Message != nullptr) {
+			SetError(pData, Error.pLine, Error.Message, Stats);
+			return false;
+		}
+
+		if (Counts[0] + Counts[1] + Counts[2] + Counts[5] > BVHStuff::ReferenceIndexMask + 1u) {
+			SetError(pData, nullptr, "Too many primitives", Stats);
+			return false;
+		}
+
+		// Parsing.
+		SceneStuff::Scene NewScene{};
+		NewScene.Spheres.resize(Counts[0]);
+		NewScene.Rectangles.resize(Counts[1]);
+		NewScene.Triangles.resize(Counts[2]);
+		NewScene.Instances.resize(Counts[5]);
+		std::vector<const char*> MeshLines(Counts[3]), PrototypeLines(Counts[4]);
+
+		// Each primitive's material, parsed into a slot of its own: Spheres first, then Rectangles, Triangles and Instances, as their MaterialIndex
+		// until the distinct ones have gone into the material table.
+		std::vector<Material> ParsedMaterials(Counts[0] + Counts[1] + Counts[2] + Counts[5]);
+		const uint64_t FirstMaterialSlots[PrimitiveTypeCount]{ 0u, Counts[0], Counts[0] + Counts[1], 0u, 0u, Counts[0] + Counts[1] + Counts[2] };
+
+		ThreadPool.ParallelFor(( int64_t )Chunks.size(), 1, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				const SceneChunk& Chunk{ Chunks[i] };
+				uint64_t Indices[PrimitiveTypeCount]{};
+				std::copy(Chunk.FirstIndices, Chunk.FirstIndices + PrimitiveTypeCount, Indices);
+
+				ImportStuff::ForEachLine(Chunk.Text, [&](const char* p, const char* LineEnd) {
+					switch (GetStatementType(p, LineEnd)) {
+						case StatementType::Sphere: {
+							Sphere& CurrentSphere{ NewScene.Spheres[Indices[0]] };
+							CurrentSphere.PrimitiveId = 0u;
+							CurrentSphere.ObjectId = ( uint )Indices[0]++;
+							CurrentSphere.MaterialIndex = ( uint )(FirstMaterialSlots[0] + CurrentSphere.ObjectId);
+
+							if (!ParseSphere(p, LineEnd, CurrentSphere, ParsedMaterials[CurrentSphere.MaterialIndex])) {
+								Error.Report(p, "Malformed sphere");
+							}
+
+							break;
+						}
+						case StatementType::Rectangle: {
+							Rectangle& CurrentRectangle{ NewScene.Rectangles[Indices[1]] };
+							CurrentRectangle.PrimitiveId = 1u;
+							CurrentRectangle.ObjectId = ( uint )Indices[1]++;
+							CurrentRectangle.MaterialIndex = ( uint )(FirstMaterialSlots[1] + CurrentRectangle.ObjectId);
+
+							if (!ParseRectangle(p, LineEnd, CurrentRectangle, ParsedMaterials[CurrentRectangle.MaterialIndex])) {
+								Error.Report(p, "Malformed rectangle");
+							}
+
+							break;
+						}
+						case StatementType::Triangle: {
+							Triangle& CurrentTriangle{ NewScene.Triangles[Indices[2]] };
+							CurrentTriangle.PrimitiveId = 2u;
+							CurrentTriangle.ObjectId = ( uint )Indices[2]++;
+							CurrentTriangle.MaterialIndex = ( uint )(FirstMaterialSlots[2] + CurrentTriangle.ObjectId);
+
+							if (!ParseTriangle(p, LineEnd, CurrentTriangle, ParsedMaterials[CurrentTriangle.MaterialIndex])) {
+								Error.Report(p, "Malformed triangle");
+							}
+
+							break;
+						}
+						case StatementType::Mesh: {
+							MeshLines[Indices[3]++] = p;
+							break;
+						}
+						case StatementType::Prototype: {
+							PrototypeLines[Indices[4]++] = p;
+							break;
+						}
+						case StatementType::Instance: {
+							Instance& CurrentInstance{ NewScene.Instances[Indices[5]] };
+							CurrentInstance.PrimitiveId = 4u;
+							CurrentInstance.ObjectId = ( uint )Indices[5]++;
+							CurrentInstance.MaterialIndex = ( uint )(FirstMaterialSlots[5] + CurrentInstance.ObjectId);
+
+							if (!ParseInstance(p, LineEnd, ( uint )Counts[4], CurrentInstance, ParsedMaterials[CurrentInstance.MaterialIndex])) {
+								Error.Report(p, "Malformed instance, or one with an unknown prototype or a singular transform");
+							}
+
+							break;
+						}
+						case StatementType::Setting: {
+							SceneStuff::RenderSettings UnusedSettings{};
+
+							if (!ParseSetting(p, LineEnd, UnusedSettings)) {
+								Error.Report(p, "Malformed setting");
+							}
+
+							break;
+						}
+						default: {
+							break;
+						}
+					}
+				});
+			}
+		});
+
+		if (Error.Message != nullptr) {
+			SetError(pData, Error.pLine, Error.Message, Stats);
+			return false;
+		}
+
+		// The material table, in the order of the slots, after which each primitive refers to its material's entry.
+		MaterialTableBuilder MaterialTable{};
+		std::vector<uint> MaterialIndices(ParsedMaterials.size());
+
+		for (size_t i{ 0u }; i < ParsedMaterials.size(); i++) {
+			MaterialIndices[i] = MaterialTable.AddMaterial(ParsedMaterials[i], NewScene);
+		}
+
+		for (Sphere& CurrentSphere: NewScene.Spheres) {
+			CurrentSphere.MaterialIndex = MaterialIndices[CurrentSphere.MaterialIndex];
+		}
+
+		for (Rectangle& CurrentRectangle: NewScene.Rectangles) {
+			CurrentRectangle.MaterialIndex = MaterialIndices[CurrentRectangle.MaterialIndex];
+		}
+
+		for (Triangle& CurrentTriangle: NewScene.Triangles) {
+			CurrentTriangle.MaterialIndex = MaterialIndices[CurrentTriangle.MaterialIndex];
+		}
+
+		for (Instance& CurrentInstance: NewScene.Instances) {
+			CurrentInstance.MaterialIndex = MaterialIndices[CurrentInstance.MaterialIndex];
+		}
+
+		// Meshes, each imported in parallel on its own.
+		const std::filesystem::path SceneDirectory{ std::filesystem::path{ FilePath }.parent_path() };
+
+		for (const char* pMeshLine: MeshLines) {
+			Material MeshMaterial{};
+			const char *pPath, *pPathEnd;
+			ImportStuff::ImportStats ImportStats{};
+
+			if (!ParseMesh(pMeshLine, ImportStuff::GetLineEnd(pMeshLine, End), MeshMaterial, pPath, pPathEnd)) {
+				SetError(pData, pMeshLine, "Malformed mesh", Stats);
+				return false;
+			}
+
+			const std::string MeshPath{ (SceneDirectory / std::string{ pPath, ( size_t )(pPathEnd - pPath) }).string() };
+
+			if (!ImportStuff::ImportMesh(MeshPath.c_str(), MaterialTable.AddMaterial(MeshMaterial, NewScene), ThreadPool, NewScene, ImportStats)) {
+				SetError(pData, pMeshLine, ImportStats.ErrorMessage, Stats);
+				return false;
+			}
+
+			Stats.MeshFilePaths.push_back(MeshPath);
+		}
+
+		// Prototypes, each imported as a mesh of a scene of its own and then copied into the new scene's prototype buffers.
+		for (const char* pPrototypeLine: PrototypeLines) {
+			const char *pPath, *pPathEnd;
+			SceneStuff::Scene PrototypeScene{};
+			ImportStuff::ImportStats ImportStats{};
+
+			if (!ParsePrototype(pPrototypeLine, ImportStuff::GetLineEnd(pPrototypeLine, End), pPath, pPathEnd)) {
+				SetError(pData, pPrototypeLine, "Malformed prototype", Stats);
+				return false;
+			}
+
+			const std::string PrototypePath{ (SceneDirectory / std::string{ pPath, ( size_t )(pPathEnd - pPath) }).string() };
+
+			if (!ImportStuff::ImportMesh(PrototypePath.c_str(), 0u, ThreadPool, PrototypeScene, ImportStats)) {
+				SetError(pData, pPrototypeLine, ImportStats.ErrorMessage, Stats);
+				return false;
+			}
+
+			SceneStuff::AddPrototype(PrototypeScene.MeshVertices.data(), ( uint )PrototypeScene.MeshVertices.size(), PrototypeScene.MeshIndices.data(),
+				( uint )PrototypeScene.MeshIndices.size(), NewScene);
+			Stats.MeshFilePaths.push_back(PrototypePath);
+		}
+
+		if (NewScene.MeshIndices.size() + Counts[0] + Counts[1] + Counts[2] + Counts[5] > BVHStuff::ReferenceIndexMask + 1u ||
+			NewScene.PrototypeIndices.size() > BVHStuff::ReferenceIndexMask + 1u) {
+			SetError(pData, nullptr, "Too many primitives", Stats);
+			return false;
+		}
+
+		Scene = std::move(NewScene);
+		SceneStuff::SetRootConstants(Settings, Scene);
+		SceneStuff::InterpolateScene(0.0f, Scene);
+
+		Stats.SphereCount = ( uint )Scene.Spheres.size();
+		Stats.RectangleCount = ( uint )Scene.Rectangles.size();
+		Stats.TriangleCount = ( uint )Scene.Triangles.size();
+		Stats.MeshCount = ( uint )Scene.Meshes.size();
+		Stats.MeshTriangleCount = ( uint )Scene.MeshIndices.size();
+		Stats.PrototypeCount = ( uint )Scene.Prototypes.size();
+		Stats.PrototypeTriangleCount = ( uint )Scene.PrototypeIndices.size();
+		Stats.InstanceCount = ( uint )Scene.Instances.size();
+		Stats.MaterialCount = ( uint )Scene.Materials.size();
+		Stats.Seconds = LoadTimer.GetElapsedSeconds();
+		return true;
+	}
+
+	// Appends a float to a line with the fewest digits that read back exactly, so that a saved scene loads bit for bit as it was.
+	inline void AppendFloat(float Value, std::string& Line) {
+		char Text[32]{ ' ' };
+		const std::to_chars_result Result{ std::to_chars(Text + 1, Text + sizeof(Text), Value) };
+		Line.append(Text, Result.ptr);
+	}
+
+	inline void AppendFloat3(const float3& Value, std::string& Line) {
+		AppendFloat(Value.x, Line);
+		AppendFloat(Value.y, Line);
+		AppendFloat(Value.z, Line);
+	}
+
+	inline void AppendAppearance(const Material& CurrentMaterial, std::string& Line) {
+		AppendFloat3(CurrentMaterial.ColorStart, Line);
+		AppendFloat3(CurrentMaterial.ColorEnd, Line);
+		AppendFloat(CurrentMaterial.MaterialScalarStart, Line);
+		AppendFloat(CurrentMaterial.MaterialScalarEnd, Line);
+	}
+
+	// Starts a primitive statement with its keyword and the name of its material's Material ID.
+	inline void StartStatement(const char* Keyword, const Material& CurrentMaterial, std::string& Line) {
+		Line = std::string{ Keyword } + " " + SceneStuff::GetMaterialName(CurrentMaterial.MaterialId);
+	}
+
+	// Writes a scene and its settings to a scene file. Meshes are written at their current state, each to a binary PLY file next to it, named after
+	// it: Scene.scene's first mesh goes to Scene.mesh0.ply, and its first prototype to Scene.prototype0.ply.
+	inline bool SaveScene(const char* FilePath, const SceneStuff::RenderSettings& Settings, const SceneStuff::Scene& Scene) {
+		FILE* pFile{ fopen(FilePath, "wb") };
+
+		if (pFile == nullptr) {
+			return false;
+		}
+
+		std::string Line{};
+		Line.reserve(512u);
+
+		fprintf(pFile, "# Unnamed Renderer scene\n");
+		fprintf(pFile, "width %u\nheight %u\nspp %u\ndepth %u\nrr-depth %u\n", Settings.PSViewPortDimensions.x, Settings.PSViewPortDimensions.y,
+			Settings.SamplesPerPixel, Settings.MaxRecursionDepth, Settings.RussianRouletteDepth);
+
+		for (const auto& [Keyword, pValue, ValueCount]: { std::tuple<const char*, const float*, uint>{ "vfov", &Settings.VFoVInDegrees, 1u },
+				 { "path-min-distance", &Settings.PathMinDistance, 1u }, { "path-max-distance", &Settings.PathMaxDistance, 1u },
+				 { "sky-top", &Settings.SkyTopColor.x, 3u }, { "sky-bottom", &Settings.SkyBottomColor.x, 3u } }) {
+			Line = Keyword;
+
+			for (uint i{ 0u }; i < ValueCount; i++) {
+				AppendFloat(pValue[i], Line);
+			}
+
+			Line += '\n';
+			fputs(Line.c_str(), pFile);
+		}
+
+		for (const Sphere& CurrentSphere: Scene.Spheres) {
+			StartStatement("sphere", Scene.Materials[CurrentSphere.MaterialIndex], Line);
+			AppendFloat3(CurrentSphere.WSOriginStart, Line);
+			AppendFloat3(CurrentSphere.WSOriginEnd, Line);
+			AppendFloat(CurrentSphere.WSRadiusStart, Line);
+			AppendFloat(CurrentSphere.WSRadiusEnd, Line);
+			AppendAppearance(Scene.Materials[CurrentSphere.MaterialIndex], Line);
+			Line += '\n';
+			fputs(Line.c_str(), pFile);
+		}
+
+		for (const Rectangle& CurrentRectangle: Scene.Rectangles) {
+			StartStatement("rectangle", Scene.Materials[CurrentRectangle.MaterialIndex], Line);
+
+			for (const float3* pCorner: { &CurrentRectangle.Q1Start, &CurrentRectangle.Q1End, &CurrentRectangle.Q2Start, &CurrentRectangle.Q2End,
+					 &CurrentRectangle.Q3Start, &CurrentRectangle.Q3End, &CurrentRectangle.Q4Start, &CurrentRectangle.Q4End }) {
+				AppendFloat3(*pCorner, Line);
+			}
+
+			AppendAppearance(Scene.Materials[CurrentRectangle.MaterialIndex], Line);
+			Line += '\n';
+			fputs(Line.c_str(), pFile);
+		}
+
+		for (const Triangle& CurrentTriangle: Scene.Triangles) {
+			StartStatement("triangle", Scene.Materials[CurrentTriangle.MaterialIndex], Line);
+
+			for (const float3* pVertex: { &CurrentTriangle.V1Start, &CurrentTriangle.V1End, &CurrentTriangle.V2Start, &CurrentTriangle.V2End,
+					 &CurrentTriangle.V3Start, &CurrentTriangle.V3End }) {
+				AppendFloat3(*pVertex, Line);
+			}
+
+			AppendAppearance(Scene.Materials[CurrentTriangle.MaterialIndex], Line);
+			Line += '\n';
+			fputs(Line.c_str(), pFile);
+		}
+
+		const std::filesystem::path ScenePath{ FilePath };
+		bool Succeeded{ true };
+
+		for (const Mesh& CurrentMesh: Scene.Meshes) {
+			const std::string MeshFileName{ ScenePath.stem().string() + ".mesh" + std::to_string(CurrentMesh.ObjectId) + ".ply" };
+			Succeeded &= ImportStuff::ExportMesh((ScenePath.parent_path() / MeshFileName).string().c_str(), ImportStuff::MeshFileFormat::PLY,
+				Scene.MeshVertices.data() + CurrentMesh.FirstVertex, CurrentMesh.VertexCount, Scene.MeshIndices.data() + CurrentMesh.FirstTriangle,
+				CurrentMesh.TriangleCount, CurrentMesh.FirstVertex);
+
+			StartStatement("mesh", Scene.Materials[CurrentMesh.MaterialIndex], Line);
+			AppendAppearance(Scene.Materials[CurrentMesh.MaterialIndex], Line);
+			Line += " " + MeshFileName + "\n";
+			fputs(Line.c_str(), pFile);
+		}
+
+		for (uint i{ 0u }; i < ( uint )Scene.Prototypes.size(); i++) {
+			const Prototype& CurrentPrototype{ Scene.Prototypes[i] };
+			const std::string PrototypeFileName{ ScenePath.stem().string() + ".prototype" + std::to_string(i) + ".ply" };
+			Succeeded &= ImportStuff::ExportMesh((ScenePath.parent_path() / PrototypeFileName).string().c_str(), ImportStuff::MeshFileFormat::PLY,
+				Scene.PrototypeVertices.data() + CurrentPrototype.FirstVertex, CurrentPrototype.VertexCount,
+				Scene.PrototypeIndices.data() + CurrentPrototype.FirstTriangle, CurrentPrototype.TriangleCount, CurrentPrototype.FirstVertex);
+
+			Line = "prototype " + PrototypeFileName + "\n";
+			fputs(Line.c_str(), pFile);
+		}
+
+		for (const Instance& CurrentInstance: Scene.Instances) {
+			StartStatement("instance", Scene.Materials[CurrentInstance.MaterialIndex], Line);
+			Line += " " + std::to_string(CurrentInstance.PrototypeIndex);
+
+			for (const float4& Row: CurrentInstance.WorldFromObject) {
+				AppendFloat3({ Row.x, Row.y, Row.z }, Line);
+				AppendFloat(Row.w, Line);
+			}
+
+			AppendAppearance(Scene.Materials[CurrentInstance.MaterialIndex], Line);
+			Line += '\n';
+			fputs(Line.c_str(), pFile);
+		}
+
+		return (fclose(pFile) == 0) && Succeeded;
+	}
+
+}
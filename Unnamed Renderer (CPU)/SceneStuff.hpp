@@ -0,0 +1,1155 @@
+// SceneStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef SCENE_STUFF
+	#define SCENE_STUFF
+#endif
+
+#include "CPUStuff.hpp"
+#include <cfloat>
+#include <cstring>
+#include <random>
+
+/*
+	PRIMITIVE ID:
+		0 - Sphere
+		1 - Rectangle
+		2 - Triangle
+		3 - Mesh Triangle
+		4 - Instance
+*/
+
+/*
+	MATERIAL ID:
+		0 - Miss/Sky
+		1 - Surface Normal Map
+		2 - Diffuse
+		3 - Dielectric
+		4 - Metallic
+		5 - Diffuse Light
+*/
+
+// Represents a surface's material, kept once in the Scene's Materials for every primitive that refers to it by its MaterialIndex, so that shading
+// fetches the same small record whatever kind of primitive was hit.
+struct Material {
+	float3 ColorStart;
+	float3 ColorEnd;
+	float3 Color;// Color/Light-Attenuation of the surface.
+	float MaterialScalarStart;
+	float MaterialScalarEnd;
+	float MaterialScalar;// Used for Metallic Fuzziness or Dielectric Refractive Index.
+	uint MaterialId;// Material idenfitier for properly selecting intersection functions.
+};
+
+// Represents a Procedural Sphere.
+struct Sphere {
+	float3 WSOriginStart;
+	float3 WSOriginEnd;
+	float3 WSOrigin;// World-Space origin of the primitive.
+	float WSRadiusStart;
+	float WSRadiusEnd;
+	float WSRadius;// World-Space radius of the primitive.
+	uint PrimitiveId;// Used for identifying the type of primitive.
+	uint ObjectId;// Unique identifier for the given sphere.
+	uint MaterialIndex;// Entry of the Scene's Materials that the primitive is shaded with.
+};
+
+// Represents a Procedural Rectangle.
+struct Rectangle {
+	float3 Q1Start;
+	float3 Q1End;
+	float3 Q1;// First "Corner" of the rectangle as a plane.
+	float3 Q2Start;
+	float3 Q2End;
+	float3 Q2;// Second "Corner" of the rectangle as a plane.
+	float3 Q3Start;
+	float3 Q3End;
+	float3 Q3;
+	float3 Q4Start;
+	float3 Q4End;
+	float3 Q4;
+	uint PrimitiveId;// Used for identifying the type of primitive.
+	uint ObjectId;// Unique identifier for the given rectangle.
+	uint MaterialIndex;// Entry of the Scene's Materials that the primitive is shaded with.
+};
+
+// Represents a Procedural Triangle primitive.
+struct Triangle {
+	float3 V1Start;// First vertex of the triangle.
+	float3 V1End;
+	float3 V1;
+	float3 V2Start;// Second vertex of the triangle.
+	float3 V2End;
+	float3 V2;
+	float3 V3Start;// Third vertex of the triangle.
+	float3 V3End;
+	float3 V3;
+	uint PrimitiveId;
+	uint ObjectId;
+	uint MaterialIndex;
+};
+
+// Represents an indexed Triangle Mesh, whose triangles share the Scene's mesh vertex and index buffers along with a single material.
+// Its triangles are MeshIndices[FirstTriangle, FirstTriangle + TriangleCount), whose vertex indices refer to the whole MeshVertices buffer.
+struct Mesh {
+	uint FirstTriangle;
+	uint TriangleCount;
+	uint FirstVertex;
+	uint VertexCount;
+	uint PrimitiveId;// Used for identifying the type of primitive.
+	uint ObjectId;// Unique identifier for the given mesh.
+	uint MaterialIndex;// Entry of the Scene's Materials that every triangle of the mesh is shaded with.
+};
+
+// Represents shared, indexed triangle geometry in its own object space, which is never traced itself but only through the Instances of it.
+// Its triangles are PrototypeIndices[FirstTriangle, FirstTriangle + TriangleCount), whose vertex indices refer to the whole PrototypeVertices buffer.
+struct Prototype {
+	uint FirstTriangle;
+	uint TriangleCount;
+	uint FirstVertex;
+	uint VertexCount;
+	float3 BoundsMin;// Object-space bounds of the prototype's vertices.
+	float3 BoundsMax;
+};
+
+// Represents a Prototype placed in the world by an affine transform, with a material of its own. Instances are static, though their material
+// may animate.
+struct Instance {
+	float4 WorldFromObject[3];// Rows of the transform from the prototype's object space to world space, with the translation in w.
+	float4 ObjectFromWorld[3];// Rows of its inverse.
+	uint PrototypeIndex;// Prototype whose geometry the instance places.
+	uint PrimitiveId;// Used for identifying the type of primitive.
+	uint ObjectId;// Unique identifier for the given instance.
+	uint MaterialIndex;// Entry of the Scene's Materials that every triangle of the instance is shaded with.
+};
+
+// 32-bit Root Constants, laid out exactly as they are passed to the DX12 Compute Shaders.
+struct InlineRootConstants {
+	uint3 TSGridDimensions;// Total number of threads per grid, along each of the 3 dimensions.
+	float Padding00;
+	float3 WSCameraFocalOrigin;// World-Space coordinates of the camera's focal point.
+	float Padding01;
+	float2 WSViewPortDimensions;// World-Space dimensions of the camera's view port.
+	float WSViewPortZCoord;// Set this based on desired Vertical Field of View.
+	float Padding02;
+	uint MaxRecursionDepth;// Maximum depth/number of paths that can be cast into the scene.
+	uint SamplesPerPixel;// Samples Per Pixel.
+	uint MaxSampleIndex;// Max Sample Index, with Zero-Indexing.
+	uint CurrentSampleIndex;// Current Sample Index.
+	float PathMinDistance;// Minimum distance along a path that an intersection can occur.
+	float PathMaxDistance;// Maximum distance along a path that an intersection can occur.
+	float2 Padding03;
+	float3 SkyTopColor;// Top sky color.
+	float Padding04;
+	float3 SkyBottomColor;// Bottom sky color.
+	float Padding05;
+	uint SphereCount;// Quantity of procedural spheres in the scene.
+	uint RectangleCount;// Quantity of procedural rectangles in the scene.
+	uint TriangleCount;// Quantity of procedural triangles in the scene.
+	float GlobalTickInRadians;// Current cyclical tick value for global system-state.
+	uint RussianRouletteDepth;// Path-depth from which paths are probabilistically terminated, based on their throughput.
+	float3 Padding06;
+};
+
+namespace SceneStuff {
+
+	// Render settings that the DX12 host derives its Inline Root Constants from.
+	struct RenderSettings {
+		uint3 PSViewPortDimensions{ 1280u, 720u, 1u };// View port dimesions, in pixels.
+		uint SamplesPerPixel{ 3000u };
+		uint MaxRecursionDepth{ 30u };// Maximum path-tracing recursion depth.
+		uint RussianRouletteDepth{ 3u };// Path-depth from which Russian roulette applies, MaxRecursionDepth or more disables it.
+		float VFoVInDegrees{ 90.0f };// Vertical Field-of-View, in Degrees.
+		float PathMinDistance{ 0.001f };
+		float PathMaxDistance{ 10'000.0f };
+		float3 SkyTopColor{ 0.99f, 0.99f, 0.99f };
+		float3 SkyBottomColor{ 0.07f, 0.14f, 0.93f };
+	};
+
+	// Names of the Material IDs, as scene files refer to them.
+	inline const char* GetMaterialName(uint MaterialId) {
+		const char* MaterialNames[]{ "sky", "normal", "diffuse", "dielectric", "metallic", "light" };
+		return MaterialId < 6u ? MaterialNames[MaterialId] : "unknown";
+	}
+
+	// Looks the Material ID of a surface up by its name, returning false if there is none.
+	inline bool GetMaterialId(const char* Name, uint& MaterialId) {
+		for (uint CurrentMaterialId{ 1u }; CurrentMaterialId < 6u; CurrentMaterialId++) {
+			if (strcmp(Name, GetMaterialName(CurrentMaterialId)) == 0) {
+				MaterialId = CurrentMaterialId;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Collection of the scene's primitives, along with the Root Constants that describe how to render them.
+	struct Scene {
+		CPUStuff::MappableVector<Sphere> Spheres{};
+		CPUStuff::MappableVector<Rectangle> Rectangles{};
+		CPUStuff::MappableVector<Triangle> Triangles{};
+		CPUStuff::MappableVector<Mesh> Meshes{};// Sorted by FirstTriangle.
+		CPUStuff::MappableVector<uint3> MeshIndices{};// Three vertex indices per mesh triangle, across all meshes.
+		CPUStuff::MappableVector<float3> MeshVertices{};// Positions at the scene's current, interpolated state.
+		CPUStuff::MappableVector<float3> MeshVerticesStart{};// Per-vertex keyframes, empty while every mesh is static.
+		CPUStuff::MappableVector<float3> MeshVerticesEnd{};
+		CPUStuff::MappableVector<Prototype> Prototypes{};
+		CPUStuff::MappableVector<uint3> PrototypeIndices{};// Three vertex indices per prototype triangle, across all prototypes.
+		CPUStuff::MappableVector<float3> PrototypeVertices{};// Object-space positions, across all prototypes.
+		CPUStuff::MappableVector<Instance> Instances{};
+		CPUStuff::MappableVector<Material> Materials{};// Shared by every kind of primitive, through their MaterialIndex.
+		InlineRootConstants RootConstants{};
+	};
+
+	// Appends a material to a scene, at its Start keyframe until the scene is next interpolated. Returns its MaterialIndex.
+	inline uint AddMaterial(uint MaterialId, const float3& ColorStart, const float3& ColorEnd, float MaterialScalarStart, float MaterialScalarEnd,
+		Scene& Scene) {
+		Scene.Materials.push_back(Material{ ColorStart, ColorEnd, ColorStart, MaterialScalarStart, MaterialScalarEnd, MaterialScalarStart, MaterialId });
+
+		return ( uint )Scene.Materials.size() - 1u;
+	}
+
+	// Size of the data in a scene's material table, in bytes.
+	inline uint64_t GetMaterialsSizeInBytes(const Scene& Scene) {
+		return Scene.Materials.size() * sizeof(Material);
+	}
+
+	// Appends a mesh of VertexCount vertices and TriangleCount triangles to a scene, growing the shared buffers for the caller to fill its vertices and
+	// indices (relative to the whole MeshVertices buffer) in place, along with its keyframes if the scene stores them. Returns the new Mesh.
+	inline Mesh& ReserveMesh(uint VertexCount, uint TriangleCount, uint MaterialIndex, Scene& Scene) {
+		Mesh NewMesh{};
+		NewMesh.FirstTriangle = ( uint )Scene.MeshIndices.size();
+		NewMesh.TriangleCount = TriangleCount;
+		NewMesh.FirstVertex = ( uint )Scene.MeshVertices.size();
+		NewMesh.VertexCount = VertexCount;
+		NewMesh.PrimitiveId = 3u;
+		NewMesh.ObjectId = ( uint )Scene.Meshes.size();
+		NewMesh.MaterialIndex = MaterialIndex;
+		Scene.Meshes.push_back(NewMesh);
+
+		Scene.MeshIndices.resize(( size_t )NewMesh.FirstTriangle + TriangleCount);
+		Scene.MeshVertices.resize(( size_t )NewMesh.FirstVertex + VertexCount);
+
+		if (!Scene.MeshVerticesStart.empty()) {
+			Scene.MeshVerticesStart.resize(Scene.MeshVertices.size());
+			Scene.MeshVerticesEnd.resize(Scene.MeshVertices.size());
+		}
+
+		return Scene.Meshes.back();
+	}
+
+	// Appends a mesh to a scene, copying its vertices and its triangles' indices (relative to its own vertices) into the scene's shared buffers.
+	// VerticesEnd is either empty, for a static mesh, or holds the End keyframe of every vertex, with Vertices as their Start keyframe.
+	inline void AddMesh(const std::vector<float3>& Vertices, const std::vector<float3>& VerticesEnd, const std::vector<uint3>& Indices, uint MaterialIndex,
+		Scene& Scene) {
+		// Keyframes are only stored once some mesh animates, and then for every vertex, with those of static meshes equal.
+		if (!VerticesEnd.empty() && Scene.MeshVerticesStart.empty()) {
+			Scene.MeshVerticesStart = Scene.MeshVertices;
+			Scene.MeshVerticesEnd = Scene.MeshVertices;
+		}
+
+		const Mesh& NewMesh{ ReserveMesh(( uint )Vertices.size(), ( uint )Indices.size(), MaterialIndex, Scene) };
+
+		for (uint i{ 0u }; i < NewMesh.TriangleCount; i++) {
+			Scene.MeshIndices[NewMesh.FirstTriangle + i] = { NewMesh.FirstVertex + Indices[i].x, NewMesh.FirstVertex + Indices[i].y,
+				NewMesh.FirstVertex + Indices[i].z };
+		}
+
+		std::copy(Vertices.begin(), Vertices.end(), Scene.MeshVertices.begin() + NewMesh.FirstVertex);
+
+		if (!Scene.MeshVerticesStart.empty()) {
+			std::copy(Vertices.begin(), Vertices.end(), Scene.MeshVerticesStart.begin() + NewMesh.FirstVertex);
+			std::copy(VerticesEnd.empty() ? Vertices.begin() : VerticesEnd.begin(), VerticesEnd.empty() ? Vertices.end() : VerticesEnd.end(),
+				Scene.MeshVerticesEnd.begin() + NewMesh.FirstVertex);
+		}
+	}
+
+	// Index of the mesh that a mesh triangle belongs to.
+	inline uint GetMeshIndex(const Mesh* Meshes, uint MeshCount, uint TriangleIndex) {
+		const Mesh* pMesh{ std::upper_bound(Meshes, Meshes + MeshCount, TriangleIndex, [](uint Index, const Mesh& CurrentMesh) {
+			return Index < CurrentMesh.FirstTriangle;
+		}) };
+
+		return ( uint )(pMesh - Meshes) - 1u;
+	}
+
+	// Size of the data in a scene's mesh buffers, in bytes.
+	inline uint64_t GetMeshesSizeInBytes(const Scene& Scene) {
+		return Scene.Meshes.size() * sizeof(Mesh) + Scene.MeshIndices.size() * sizeof(uint3) +
+			(Scene.MeshVertices.size() + Scene.MeshVerticesStart.size() + Scene.MeshVerticesEnd.size()) * sizeof(float3);
+	}
+
+	// A point, or a direction that ignores the translation, carried through the rows of an affine transform.
+	inline float3 TransformPoint(const float4* Rows, const float3& Point) {
+		return float3{ Rows[0].x * Point.x + Rows[0].y * Point.y + Rows[0].z * Point.z + Rows[0].w,
+			Rows[1].x * Point.x + Rows[1].y * Point.y + Rows[1].z * Point.z + Rows[1].w,
+			Rows[2].x * Point.x + Rows[2].y * Point.y + Rows[2].z * Point.z + Rows[2].w };
+	}
+
+	inline float3 TransformDirection(const float4* Rows, const float3& Direction) {
+		return float3{ Rows[0].x * Direction.x + Rows[0].y * Direction.y + Rows[0].z * Direction.z,
+			Rows[1].x * Direction.x + Rows[1].y * Direction.y + Rows[1].z * Direction.z,
+			Rows[2].x * Direction.x + Rows[2].y * Direction.y + Rows[2].z * Direction.z };
+	}
+
+	// An object-space normal of an instance's prototype in world space, carried through the transpose of its ObjectFromWorld transform.
+	inline float3 TransformNormal(const Instance& CurrentInstance, const float3& Normal) {
+		const float4* Rows{ CurrentInstance.ObjectFromWorld };
+		return normalize(float3{ Rows[0].x * Normal.x + Rows[1].x * Normal.y + Rows[2].x * Normal.z,
+			Rows[0].y * Normal.x + Rows[1].y * Normal.y + Rows[2].y * Normal.z, Rows[0].z * Normal.x + Rows[1].z * Normal.y + Rows[2].z * Normal.z });
+	}
+
+	// Inverts the rows of an affine transform, returning false if it is singular.
+	inline bool InvertTransform(const float4* Rows, float4* InverseRows) {
+		const float3 Row0{ Rows[0].x, Rows[0].y, Rows[0].z }, Row1{ Rows[1].x, Rows[1].y, Rows[1].z }, Row2{ Rows[2].x, Rows[2].y, Rows[2].z };
+		const float3 Cofactors0{ cross(Row1, Row2) }, Cofactors1{ cross(Row2, Row0) }, Cofactors2{ cross(Row0, Row1) };
+		const float Determinant{ dot(Row0, Cofactors0) };
+
+		if (!(fabsf(Determinant) > 0.0f) || !std::isfinite(Determinant)) {
+			return false;
+		}
+
+		// The inverse of the linear part has the cofactors as its columns, over the determinant, and the translation is undone through it.
+		const float3 Translation{ Rows[0].w, Rows[1].w, Rows[2].w };
+		const float3 InverseRows3[3]{ float3{ Cofactors0.x, Cofactors1.x, Cofactors2.x } / Determinant,
+			float3{ Cofactors0.y, Cofactors1.y, Cofactors2.y } / Determinant, float3{ Cofactors0.z, Cofactors1.z, Cofactors2.z } / Determinant };
+
+		for (uint i{ 0u }; i < 3u; i++) {
+			InverseRows[i] = { InverseRows3[i].x, InverseRows3[i].y, InverseRows3[i].z, -dot(InverseRows3[i], Translation) };
+		}
+
+		return true;
+	}
+
+	// Appends a prototype to a scene, copying its vertices and its triangles' indices (relative to its own vertices) into the scene's prototype
+	// buffers. Returns the new prototype's index.
+	inline uint AddPrototype(const float3* Vertices, uint VertexCount, const uint3* Indices, uint TriangleCount, Scene& Scene) {
+		Prototype NewPrototype{ ( uint )Scene.PrototypeIndices.size(), TriangleCount, ( uint )Scene.PrototypeVertices.size(), VertexCount,
+			float3{ +FLT_MAX, +FLT_MAX, +FLT_MAX }, float3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+
+		for (uint i{ 0u }; i < VertexCount; i++) {
+			const float3& Vertex{ Vertices[i] };
+			NewPrototype.BoundsMin = { std::min(NewPrototype.BoundsMin.x, Vertex.x), std::min(NewPrototype.BoundsMin.y, Vertex.y),
+				std::min(NewPrototype.BoundsMin.z, Vertex.z) };
+			NewPrototype.BoundsMax = { std::max(NewPrototype.BoundsMax.x, Vertex.x), std::max(NewPrototype.BoundsMax.y, Vertex.y),
+				std::max(NewPrototype.BoundsMax.z, Vertex.z) };
+			Scene.PrototypeVertices.push_back(Vertex);
+		}
+
+		for (uint i{ 0u }; i < TriangleCount; i++) {
+			Scene.PrototypeIndices.push_back(
+				{ NewPrototype.FirstVertex + Indices[i].x, NewPrototype.FirstVertex + Indices[i].y, NewPrototype.FirstVertex + Indices[i].z });
+		}
+
+		Scene.Prototypes.push_back(NewPrototype);
+
+		return ( uint )Scene.Prototypes.size() - 1u;
+	}
+
+	// Appends an instance of a prototype to a scene, placed by the rows of WorldFromObject and shaded with a given material.
+	// Returns false, leaving the scene as it was, if the transform is singular.
+	inline bool AddInstance(uint PrototypeIndex, const float4* WorldFromObject, uint MaterialIndex, Scene& Scene) {
+		Instance NewInstance{};
+
+		if (!InvertTransform(WorldFromObject, NewInstance.ObjectFromWorld)) {
+			return false;
+		}
+
+		std::copy(WorldFromObject, WorldFromObject + 3, NewInstance.WorldFromObject);
+		NewInstance.PrototypeIndex = PrototypeIndex;
+		NewInstance.PrimitiveId = 4u;
+		NewInstance.ObjectId = ( uint )Scene.Instances.size();
+		NewInstance.MaterialIndex = MaterialIndex;
+		Scene.Instances.push_back(NewInstance);
+
+		return true;
+	}
+
+	// Size of the data in a scene's prototype and instance buffers, in bytes.
+	inline uint64_t GetInstancesSizeInBytes(const Scene& Scene) {
+		return Scene.Prototypes.size() * sizeof(Prototype) + Scene.PrototypeIndices.size() * sizeof(uint3) + Scene.PrototypeVertices.size() * sizeof(float3) +
+			Scene.Instances.size() * sizeof(Instance);
+	}
+
+	// Fills the Inline Root Constants from a set of render settings, the same way wWinMain does.
+	inline void SetRootConstants(const RenderSettings& Settings, Scene& Scene) {
+		// World-Space View Port Values.
+		const float WSViewPortAspectRatio{ ( float )Settings.PSViewPortDimensions.x / ( float )Settings.PSViewPortDimensions.y };
+		const float WSViewPortHeight{ 2.0f };
+		const float WSViewPortWidth{ WSViewPortHeight * WSViewPortAspectRatio };
+		const float WSViewPortZCoord{ 0.0f };
+
+		// Camera definition values.
+		const float VFoVInRadians{ (Settings.VFoVInDegrees / 180.0f) * ( float )M_PI };// Vertical Field-of-View, in Radians.
+		const float WSCameraFocalZCoord{ -1.0f *
+			(1.0f / ( float )tan((VFoVInRadians / 2.0f))) };// World-Space camera focal origin, z-coordinate. Based on the desired field-of-view.
+
+		InlineRootConstants& RootConstants{ Scene.RootConstants };
+
+		RootConstants.TSGridDimensions = Settings.PSViewPortDimensions;
+		RootConstants.WSCameraFocalOrigin = { 0.0f, 0.0f, WSCameraFocalZCoord };
+		RootConstants.WSViewPortDimensions.x = WSViewPortWidth;
+		RootConstants.WSViewPortDimensions.y = WSViewPortHeight;
+		RootConstants.WSViewPortZCoord = WSViewPortZCoord;
+		RootConstants.MaxRecursionDepth = Settings.MaxRecursionDepth;
+		RootConstants.SamplesPerPixel = Settings.SamplesPerPixel;
+		RootConstants.MaxSampleIndex = Settings.SamplesPerPixel - 1u;
+		RootConstants.CurrentSampleIndex = 0u;
+		RootConstants.PathMinDistance = Settings.PathMinDistance;
+		RootConstants.PathMaxDistance = Settings.PathMaxDistance;
+		RootConstants.SkyTopColor = Settings.SkyTopColor;
+		RootConstants.SkyBottomColor = Settings.SkyBottomColor;
+		RootConstants.SphereCount = ( uint )Scene.Spheres.size();
+		RootConstants.RectangleCount = ( uint )Scene.Rectangles.size();
+		RootConstants.TriangleCount = ( uint )Scene.Triangles.size();
+		RootConstants.GlobalTickInRadians = 0.0f;
+		RootConstants.RussianRouletteDepth = Settings.RussianRouletteDepth;
+	}
+
+	// Interpolation step between the Start (0) and End (1) keyframes of the primitives, for a given global tick.
+	inline float GetInterpolationStep(float GlobalTickInRadians) {
+		return GlobalTickInRadians / 2.0f;
+	}
+
+	// Interpolation of a primitive's geometry for a given step, from Keyframes into Interpolated (which may be the same).
+	inline void InterpolateSphereGeometry(float CurrentStep, const Sphere& Keyframes, Sphere& Interpolated) {
+		Interpolated.WSOrigin = LinearInterpolation(CurrentStep, Keyframes.WSOriginStart, Keyframes.WSOriginEnd);
+		Interpolated.WSRadius = LinearInterpolation(CurrentStep, Keyframes.WSRadiusStart, Keyframes.WSRadiusEnd);
+	}
+
+	inline void InterpolateRectangleGeometry(float CurrentStep, const Rectangle& Keyframes, Rectangle& Interpolated) {
+		Interpolated.Q1 = LinearInterpolation(CurrentStep, Keyframes.Q1Start, Keyframes.Q1End);
+		Interpolated.Q2 = LinearInterpolation(CurrentStep, Keyframes.Q2Start, Keyframes.Q2End);
+		Interpolated.Q3 = LinearInterpolation(CurrentStep, Keyframes.Q3Start, Keyframes.Q3End);
+		Interpolated.Q4 = LinearInterpolation(CurrentStep, Keyframes.Q4Start, Keyframes.Q4End);
+	}
+
+	inline void InterpolateTriangleGeometry(float CurrentStep, const Triangle& Keyframes, Triangle& Interpolated) {
+		Interpolated.V1 = LinearInterpolation(CurrentStep, Keyframes.V1Start, Keyframes.V1End);
+		Interpolated.V2 = LinearInterpolation(CurrentStep, Keyframes.V2Start, Keyframes.V2End);
+		Interpolated.V3 = LinearInterpolation(CurrentStep, Keyframes.V3Start, Keyframes.V3End);
+	}
+
+	// A mesh vertex's position for a given step, which is its current one while every mesh is static.
+	inline float3 InterpolateMeshVertex(float CurrentStep, const Scene& Scene, uint VertexIndex) {
+		if (Scene.MeshVerticesStart.empty()) {
+			return Scene.MeshVertices[VertexIndex];
+		}
+
+		return LinearInterpolation(CurrentStep, Scene.MeshVerticesStart[VertexIndex], Scene.MeshVerticesEnd[VertexIndex]);
+	}
+
+	// Interpolation of a material's color and scalar for a given step.
+	inline void InterpolateMaterial(float CurrentStep, const Material& Keyframes, Material& Interpolated) {
+		Interpolated.Color = LinearInterpolation(CurrentStep, Keyframes.ColorStart, Keyframes.ColorEnd);
+		Interpolated.MaterialScalar = LinearInterpolation(CurrentStep, Keyframes.MaterialScalarStart, Keyframes.MaterialScalarEnd);
+	}
+
+	// Interpolation of the geometry values for spheres, then rectangles, then triangles, then mesh vertices, and then of the materials, for the given
+	// global tick. Instances are static.
+	inline void InterpolateScene(float GlobalTickInRadians, Scene& Scene) {
+		const float CurrentStep{ GetInterpolationStep(GlobalTickInRadians) };
+
+		Scene.RootConstants.GlobalTickInRadians = GlobalTickInRadians;
+
+		for (Sphere& CurrentSphere: Scene.Spheres) {
+			InterpolateSphereGeometry(CurrentStep, CurrentSphere, CurrentSphere);
+		}
+
+		for (Rectangle& CurrentRectangle: Scene.Rectangles) {
+			InterpolateRectangleGeometry(CurrentStep, CurrentRectangle, CurrentRectangle);
+		}
+
+		for (Triangle& CurrentTriangle: Scene.Triangles) {
+			InterpolateTriangleGeometry(CurrentStep, CurrentTriangle, CurrentTriangle);
+		}
+
+		for (uint i{ 0u }; i < ( uint )Scene.MeshVerticesStart.size(); i++) {
+			Scene.MeshVertices[i] = InterpolateMeshVertex(CurrentStep, Scene, i);
+		}
+
+		for (Material& CurrentMaterial: Scene.Materials) {
+			InterpolateMaterial(CurrentStep, CurrentMaterial, CurrentMaterial);
+		}
+	}
+
+	// The interpolation steps over which a frame's camera paths are spread, for motion blur.
+	// A closed shutter (Close <= Open) renders every path at the scene's current, interpolated state.
+	struct ShutterInterval {
+		float Open{ 0.0f };
+		float Close{ 0.0f };
+
+		bool IsOpen() const {
+			return this->Close > this->Open;
+		}
+	};
+
+	// Shutter interval centered on the step of a given global tick, ShutterLength steps long, and clamped to the keyframes.
+	inline ShutterInterval GetShutterInterval(float GlobalTickInRadians, float ShutterLength) {
+		const float CurrentStep{ GetInterpolationStep(GlobalTickInRadians) };
+
+		if (ShutterLength <= 0.0f) {
+			return ShutterInterval{ CurrentStep, CurrentStep };
+		}
+
+		return ShutterInterval{ std::max(CurrentStep - ShutterLength * 0.50f, 0.0f), std::min(CurrentStep + ShutterLength * 0.50f, 1.0f) };
+	}
+
+	// Global tick of a given frame within an animation, matching the DX12 event loop.
+	inline float GetGlobalTickInRadians(uint CurrentRenderIndex, uint FinalFrameCount) {
+		if (FinalFrameCount <= 1u) {
+			return 0.0f;
+		}
+
+		return 2.0f * (( float )CurrentRenderIndex / (( float )(FinalFrameCount - 1u)));
+	}
+
+	// The stock scene that wWinMain renders.
+	inline void CreateDefaultScene(const RenderSettings& Settings, Scene& Scene) {
+		Scene.Materials.clear();
+
+		// Array of Spheres for the scene.
+		CPUStuff::MappableVector<Sphere>& Spheres{ Scene.Spheres };
+		Spheres.assign(11u, Sphere{});
+		uint SphereIndex{ 0u };
+
+		Spheres[0].WSOriginStart = { 0.0f, -10010.0f, +20.0f };
+		Spheres[0].WSOriginEnd = { 0.0f, -10010.0f, +20.0f };
+		Spheres[0].WSRadiusStart = 10000.0f;
+		Spheres[0].WSRadiusEnd = 10000.0f;
+		Spheres[0].PrimitiveId = 0u;
+		Spheres[0].ObjectId = SphereIndex;
+		Spheres[0].MaterialIndex = AddMaterial(2u, { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }, 0.0f, 0.0f, Scene);
+
+		SphereIndex++;
+
+		Spheres[1].WSOriginStart = { +12.0f, 6.0f, +40.0f };
+		Spheres[1].WSOriginEnd = { -15.0f, -2.0f, +40.0f };
+		Spheres[1].WSRadiusStart = 7.0f;
+		Spheres[1].WSRadiusEnd = 7.0f;
+		Spheres[1].PrimitiveId = 0u;
+		Spheres[1].ObjectId = SphereIndex;
+		Spheres[1].MaterialIndex = AddMaterial(3u, { 0.99f, 0.99f, 0.99f }, { 0.99f, 0.99f, 0.99f }, 2.4f, 2.4f, Scene);
+
+		SphereIndex++;
+
+		Spheres[2].WSOriginStart = { +17.0f, 14.0f, +15.0f };
+		Spheres[2].WSOriginEnd = { +14.0f, 12.0f, +15.0f };
+		Spheres[2].WSRadiusStart = 7.0f;
+		Spheres[2].WSRadiusEnd = 7.0f;
+		Spheres[2].PrimitiveId = 0u;
+		Spheres[2].ObjectId = SphereIndex;
+		Spheres[2].MaterialIndex = AddMaterial(4u, { 0.16f, 0.86f, 0.66f }, { 0.66f, 0.56f, 0.96f }, 0.00f, 0.00f, Scene);
+
+		SphereIndex++;
+
+		Spheres[3].WSOriginStart = { +16.0f, +4.0f, +15.0f };
+		Spheres[3].WSOriginEnd = { +16.0f, -3.0f, +15.0f };
+		Spheres[3].WSRadiusStart = 3.0f;
+		Spheres[3].WSRadiusEnd = 3.0f;
+		Spheres[3].PrimitiveId = 0u;
+		Spheres[3].ObjectId = SphereIndex;
+		Spheres[3].MaterialIndex = AddMaterial(2u, { 0.79f, 0.19f, 0.99f }, { 0.79f, 0.19f, 0.19f }, 0.0f, 0.0f, Scene);
+
+		SphereIndex++;
+
+		Spheres[4].WSOriginStart = { -22.0f, +0.0f, +19.0f };
+		Spheres[4].WSOriginEnd = { -22.0f, +0.0f, +19.0f };
+		Spheres[4].WSRadiusStart = 10.0f;
+		Spheres[4].WSRadiusEnd = 10.0f;
+		Spheres[4].PrimitiveId = 0u;
+		Spheres[4].ObjectId = SphereIndex;
+		Spheres[4].MaterialIndex = AddMaterial(2u, { 0.12f, 0.11f, 0.81f }, { 0.12f, 0.76f, 0.26f }, 0.0f, 0.0f, Scene);
+
+		SphereIndex++;
+
+		Spheres[5].WSOriginStart = { 5.0f, -4.0f, +2.0f };
+		Spheres[5].WSOriginEnd = { 4.0f, 1.0f, +3.0f };
+		Spheres[5].WSRadiusStart = 1.0f;
+		Spheres[5].WSRadiusEnd = 1.0f;
+		Spheres[5].PrimitiveId = 0u;
+		Spheres[5].ObjectId = SphereIndex;
+		Spheres[5].MaterialIndex = AddMaterial(3u, { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }, 2.4f, 2.4f, Scene);
+
+		SphereIndex++;
+
+		Spheres[6].WSOriginStart = { -7.3f, +3.0f, +5.0f };
+		Spheres[6].WSOriginEnd = { -7.3f, 1.0f, +5.0f };
+		Spheres[6].WSRadiusStart = 2.0f;
+		Spheres[6].WSRadiusEnd = 2.0f;
+		Spheres[6].PrimitiveId = 0u;
+		Spheres[6].ObjectId = SphereIndex;
+		Spheres[6].MaterialIndex = AddMaterial(3u, { 0.34f, 0.65f, 0.98f }, { 0.34f, 0.65f, 0.98f }, 2.4f, 2.4f, Scene);
+
+		SphereIndex++;
+
+		Spheres[7].WSOriginStart = { +4.0f, +100.0f, -70.0f };
+		Spheres[7].WSOriginEnd = { +4.0f, +80.0f, -70.0f };
+		Spheres[7].WSRadiusStart = 90.0f;
+		Spheres[7].WSRadiusEnd = 90.0f;
+		Spheres[7].PrimitiveId = 0u;
+		Spheres[7].ObjectId = SphereIndex;
+		Spheres[7].MaterialIndex = AddMaterial(4u, { 0.46f, 0.36f, 0.38f }, { 0.46f, 0.36f, 0.38f }, 0.0f, 0.0f, Scene);
+
+		SphereIndex++;
+
+		Spheres[8].WSOriginStart = { +0.0f, +90.0f, +120.0f };
+		Spheres[8].WSOriginEnd = { +0.0f, +70.0f, +120.0f };
+		Spheres[8].WSRadiusStart = 80.0f;
+		Spheres[8].WSRadiusEnd = 80.0f;
+		Spheres[8].PrimitiveId = 0u;
+		Spheres[8].ObjectId = SphereIndex;
+		Spheres[8].MaterialIndex = AddMaterial(4u, { 0.56f, 0.56f, 0.56f }, { 0.56f, 0.56f, 0.56f }, 0.0f, 0.0f, Scene);
+
+		SphereIndex++;
+
+		Spheres[9].WSOriginStart = { 0.0f, +9.0f, +12.0f };
+		Spheres[9].WSOriginEnd = { 6.0f, 3.0f, +34.0f };
+		Spheres[9].WSRadiusStart = 7.0f;
+		Spheres[9].WSRadiusEnd = 9.0f;
+		Spheres[9].PrimitiveId = 0u;
+		Spheres[9].ObjectId = SphereIndex;
+		Spheres[9].MaterialIndex = AddMaterial(3u, { 0.99f, 0.99f, 0.99f }, { 0.99f, 0.99f, 0.99f }, 2.4f, 2.4f, Scene);
+
+		SphereIndex++;
+
+		Spheres[10].WSOriginStart = { -2.0f, -3.0f, +12.0f };
+		Spheres[10].WSOriginEnd = { -2.0f, -3.0f, +12.0f };
+		Spheres[10].WSRadiusStart = 7.0f;
+		Spheres[10].WSRadiusEnd = 4.0f;
+		Spheres[10].PrimitiveId = 0u;
+		Spheres[10].ObjectId = SphereIndex;
+		Spheres[10].MaterialIndex = AddMaterial(4u, { 0.69f, 0.19f, 0.29f }, { 0.69f, 0.19f, 0.29f }, 0.09f, 0.09f, Scene);
+
+		SphereIndex++;
+
+		// Array of Rectangles for the scene.
+		CPUStuff::MappableVector<Rectangle>& Rectangles{ Scene.Rectangles };
+		Rectangles.assign(5u, Rectangle{});
+		uint RectangleIndex{ 0u };
+
+		Rectangles[0].Q1Start = { -8.0f, +2.0f, +5.0f };
+		Rectangles[0].Q1End = { -8.0f, +4.0f, +9.0f };
+		Rectangles[0].Q2Start = { -8.0f, +2.0f, +10.0f };
+		Rectangles[0].Q2End = { -8.0f, +4.0f, +14.0f };
+		Rectangles[0].Q3Start = { -8.0f, -2.0f, +5.0f };
+		Rectangles[0].Q3End = { -8.0f, -4.0f, +10.0f };
+		Rectangles[0].Q4Start = { -8.0f, -2.0f, +12.0f };
+		Rectangles[0].Q4End = { -8.0f, -4.0f, +14.0f };
+		Rectangles[0].PrimitiveId = 1u;
+		Rectangles[0].ObjectId = RectangleIndex;
+		Rectangles[0].MaterialIndex = AddMaterial(5u, { 0.0, 16.0, 0.0 }, { 0.0, 16.0, 0.0 }, 0.0f, 0.0f, Scene);
+
+		RectangleIndex++;
+
+		Rectangles[1].Q1Start = { +8.0f, +2.0f, +5.0f };
+		Rectangles[1].Q1End = { +8.0f, +4.0f, +9.0f };
+		Rectangles[1].Q2Start = { +8.0f, +2.0f, +10.0f };
+		Rectangles[1].Q2End = { +8.0f, +4.0f, +14.0f };
+		Rectangles[1].Q3Start = { +8.0f, -2.0f, +5.0f };
+		Rectangles[1].Q3End = { +8.0f, -4.0f, +10.0f };
+		Rectangles[1].Q4Start = { +8.0f, -2.0f, +12.0f };
+		Rectangles[1].Q4End = { +8.0f, -4.0f, +14.0f };
+		Rectangles[1].PrimitiveId = 1u;
+		Rectangles[1].ObjectId = RectangleIndex;
+		Rectangles[1].MaterialIndex = AddMaterial(5u, { 16.0, 0.0, 0.0 }, { 16.0, 0.0, 0.0 }, 0.0f, 0.0f, Scene);
+
+		RectangleIndex++;
+
+		Rectangles[2].Q1Start = { -8.0f, +0.0f, -8.0f };
+		Rectangles[2].Q1End = { -8.0f, +0.0f, -3.0f };
+		Rectangles[2].Q2Start = { +8.0f, +0.0f, -8.0f };
+		Rectangles[2].Q2End = { +8.0f, +0.0f, -3.0f };
+		Rectangles[2].Q3Start = { -8.0f, +8.0f, -8.0f };
+		Rectangles[2].Q3End = { -8.0f, 8.0f, -3.0f };
+		Rectangles[2].Q4Start = { +8.0f, 8.0f, -8.0f };
+		Rectangles[2].Q4End = { +8.0f, 8.0f, -3.0f };
+		Rectangles[2].PrimitiveId = 1u;
+		Rectangles[2].ObjectId = RectangleIndex;
+		Rectangles[2].MaterialIndex = AddMaterial(5u, { +0.0, +0.0, 16.0 }, { +0.0f, +0.0f, +16.0f }, 0.0f, 0.0f, Scene);
+
+		RectangleIndex++;
+
+		Rectangles[3].Q1Start = { -18.0f, -6.0f, -10.0f };
+		Rectangles[3].Q1End = { -22.0f, -6.0f, -8.0f };
+		Rectangles[3].Q2Start = { +18.0f, -6.0f, -10.0f };
+		Rectangles[3].Q2End = { +22.0f, -6.0f, -8.0f };
+		Rectangles[3].Q3Start = { -18.0f, +18.0f, -12.0f };
+		Rectangles[3].Q3End = { -22.0f, +14.0f, -10.0f };
+		Rectangles[3].Q4Start = { +18.0f, +18.0f, -12.0f };
+		Rectangles[3].Q4End = { +22.0f, +14.0f, -10.0f };
+		Rectangles[3].PrimitiveId = 1u;
+		Rectangles[3].ObjectId = RectangleIndex;
+		Rectangles[3].MaterialIndex = AddMaterial(3u, { +0.97f, +0.99f, +0.99f }, { +0.97f, +0.99f, +0.99f }, 0.0f, 0.0, Scene);
+
+		RectangleIndex++;
+
+		Rectangles[4].Q1Start = { 30.0f, -6.0f, 38.0f };
+		Rectangles[4].Q1End = { 30.0f, -6.0f, 38.0f };
+		Rectangles[4].Q2Start = { 30.0f, +16.0f, 38.0f };
+		Rectangles[4].Q2End = { 30.0f, +16.0f, 38.0f };
+		Rectangles[4].Q3Start = { 60.0f, -6.0f, 30.0f };
+		Rectangles[4].Q3End = { 60.0f, -6.0f, 30.0f };
+		Rectangles[4].Q4Start = { 60.0f, +16.0f, 30.0f };
+		Rectangles[4].Q4End = { 60.0f, +16.0f, 30.0f };
+		Rectangles[4].PrimitiveId = 1u;
+		Rectangles[4].ObjectId = RectangleIndex;
+		Rectangles[4].MaterialIndex = AddMaterial(5u, { +1.80f, +1.80f, +1.80f }, { 0.0f, +8.00f, +8.00f }, 0.4f, 0.4, Scene);
+
+		RectangleIndex++;
+
+		// Triangle procedural primitives.
+		CPUStuff::MappableVector<Triangle>& Triangles{ Scene.Triangles };
+		Triangles.assign(5u, Triangle{});
+		uint TriangleIndex{ 0u };
+
+		Triangles[0].V1Start = { -50.0f, -10.0f, +28.0f };
+		Triangles[0].V1End = { -50.0f, -10.0f, +28.0f };
+		Triangles[0].V2Start = { -20.0f, +36.0f, +34.0f };
+		Triangles[0].V2End = { -20.0f, +45.0f, +34.0f };
+		Triangles[0].V3Start = { -10.0f, -10.0f, +30.0f };
+		Triangles[0].V3End = { -10.0f, -10.0f, +30.0f };
+		Triangles[0].PrimitiveId = 2u;
+		Triangles[0].ObjectId = TriangleIndex;
+		Triangles[0].MaterialIndex = AddMaterial(4u, { +0.97f, +0.85f, +0.13f }, { +0.65f, +0.85f, +0.65f }, 0.0f, 0.0f, Scene);
+
+		TriangleIndex++;
+
+		Triangles[1].V1Start = { +6.0f, 15.0f, 65.0f };
+		Triangles[1].V1End = { +6.0f, 15.0f, 65.0f };
+		Triangles[1].V2Start = { 0.0f, 12.0f, 65.0f };
+		Triangles[1].V2End = { 0.0f, 12.0f, 65.0f };
+		Triangles[1].V3Start = { -6.0f, 150.0f, 65.0f };
+		Triangles[1].V3End = { -6.0f, 15.0f, 65.0f };
+		Triangles[1].PrimitiveId = 2u;
+		Triangles[1].ObjectId = TriangleIndex;
+		Triangles[1].MaterialIndex = AddMaterial(4u, { 0.15f, +0.43f, +1.0f }, { +0.15f, +0.43f, +1.0f }, 0.0f, 0.0f, Scene);
+
+		TriangleIndex++;
+
+		Triangles[2].V1Start = { +4.0f, -4.0f, +5.0f };
+		Triangles[2].V1End = { +5.0f, -4.0f, +7.0f };
+		Triangles[2].V2Start = { -4.0f, -4.0f, +1.0f };
+		Triangles[2].V2End = { -1.0f, -4.0f, +3.0f };
+		Triangles[2].V3Start = { +0.0f, -4.0f, +1.0f };
+		Triangles[2].V3End = { +2.0f, -4.0f, +3.0f };
+		Triangles[2].PrimitiveId = 2u;
+		Triangles[2].ObjectId = TriangleIndex;
+		Triangles[2].MaterialIndex = AddMaterial(5u, { +12.0f, +0.0f, +12.0f }, { +12.0f, +0.0f, +12.0f }, 0.0f, 0.0f, Scene);
+
+		TriangleIndex++;
+
+		Triangles[3].V1Start = { -34.0f, 5.0f, +40.0f };
+		Triangles[3].V1End = { -28.0f, 5.0f, +44.0f };
+		Triangles[3].V2Start = { -18.0f, +20.0f, +36.0f };
+		Triangles[3].V2End = { -18.0f, +14.0f, +36.0f };
+		Triangles[3].V3Start = { -8.0f, 5.0f, +36.0f };
+		Triangles[3].V3End = { -14.0f, 5.0f, +32.0f };
+		Triangles[3].PrimitiveId = 2u;
+		Triangles[3].ObjectId = TriangleIndex;
+		Triangles[3].MaterialIndex = AddMaterial(5u, { +12.0f, +12.0f, +12.0f }, { +12.0f, +12.0f, +12.0f }, 0.0f, 0.0f, Scene);
+
+		TriangleIndex++;
+
+		Triangles[4].V1Start = { +34.0f, 5.0f, +40.0f };
+		Triangles[4].V1End = { +28.0f, 5.0f, +44.0f };
+		Triangles[4].V2Start = { +18.0f, +20.0f, +36.0f };
+		Triangles[4].V2End = { +18.0f, +14.0f, +36.0f };
+		Triangles[4].V3Start = { +8.0f, 5.0f, +36.0f };
+		Triangles[4].V3End = { +14.0f, 5.0f, +32.0f };
+		Triangles[4].PrimitiveId = 2u;
+		Triangles[4].ObjectId = TriangleIndex;
+		Triangles[4].MaterialIndex = AddMaterial(5u, { +12.0f, +12.0f, +0.0f }, { +12.0f, +12.0f, +0.0f }, 0.0f, 0.0f, Scene);
+
+		TriangleIndex++;
+
+		SetRootConstants(Settings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+	// A scene of PrimitiveCount randomly placed spheres, rectangles and triangles in equal shares, in front of the camera.
+	// Primitive sizes shrink with the count so that the density of the scene stays roughly constant, and every primitive drifts slightly between its
+	// Start and End keyframes. Mostly diffuse, with some metallic surfaces and lights.
+	inline void CreateRandomScene(const RenderSettings& Settings, uint PrimitiveCount, uint Seed, Scene& Scene) {
+		std::mt19937 MersenneTwisterEngine{ Seed };
+		std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+
+		auto GetRandomFloat = [&](float Minimum, float Maximum) {
+			return Minimum + (Maximum - Minimum) * UnitDistribution(MersenneTwisterEngine);
+		};
+
+		auto GetRandomPoint = [&](const float3& Center, float Extent) {
+			return float3{ Center.x + GetRandomFloat(-Extent, +Extent), Center.y + GetRandomFloat(-Extent, +Extent),
+				Center.z + GetRandomFloat(-Extent, +Extent) };
+		};
+
+		// A static material of a random color and scalar, of which 5% are lights, 20% metallic and the rest diffuse.
+		auto AddRandomMaterial = [&]() {
+			const float3 Color{ GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f) };
+			const float MaterialScalar{ GetRandomFloat(0.0f, 0.3f) };
+			const float Choice{ UnitDistribution(MersenneTwisterEngine) };
+			return AddMaterial(Choice < 0.05f ? 5u : (Choice < 0.25f ? 4u : 2u), Color, Color, MaterialScalar, MaterialScalar, Scene);
+		};
+
+		const float PrimitiveSize{ 16.0f / cbrtf(( float )std::max(PrimitiveCount, 1u)) };
+		const float MotionSize{ PrimitiveSize * 0.25f };
+
+		Scene.Materials.clear();
+		Scene.Materials.reserve(PrimitiveCount);
+		Scene.Spheres.assign(PrimitiveCount / 3u + (PrimitiveCount % 3u > 0u ? 1u : 0u), Sphere{});
+		Scene.Rectangles.assign(PrimitiveCount / 3u + (PrimitiveCount % 3u > 1u ? 1u : 0u), Rectangle{});
+		Scene.Triangles.assign(PrimitiveCount / 3u, Triangle{});
+
+		for (uint i{ 0u }; i < ( uint )Scene.Spheres.size(); i++) {
+			Sphere& CurrentSphere{ Scene.Spheres[i] };
+			CurrentSphere.WSOriginStart = { GetRandomFloat(-20.0f, +20.0f), GetRandomFloat(-12.0f, +12.0f), GetRandomFloat(+8.0f, +48.0f) };
+			CurrentSphere.WSOriginEnd = GetRandomPoint(CurrentSphere.WSOriginStart, MotionSize);
+			CurrentSphere.WSRadiusStart = GetRandomFloat(0.25f, 0.50f) * PrimitiveSize;
+			CurrentSphere.WSRadiusEnd = CurrentSphere.WSRadiusStart;
+			CurrentSphere.PrimitiveId = 0u;
+			CurrentSphere.ObjectId = i;
+			CurrentSphere.MaterialIndex = AddRandomMaterial();
+		}
+
+		for (uint i{ 0u }; i < ( uint )Scene.Rectangles.size(); i++) {
+			Rectangle& CurrentRectangle{ Scene.Rectangles[i] };
+			const float3 Center{ GetRandomFloat(-20.0f, +20.0f), GetRandomFloat(-12.0f, +12.0f), GetRandomFloat(+8.0f, +48.0f) };
+			const float3 Motion{ GetRandomPoint(float3{}, MotionSize) };
+
+			// Two perpendicular edges, from a random direction and its cross product with another.
+			const float3 EdgeA{ normalize(GetRandomPoint(float3{}, 1.0f)) * (PrimitiveSize * 0.50f) };
+			const float3 EdgeB{ normalize(cross(EdgeA, GetRandomPoint(float3{}, 1.0f))) * (PrimitiveSize * 0.50f) };
+
+			CurrentRectangle.Q1Start = Center - EdgeA * 0.50f - EdgeB * 0.50f;
+			CurrentRectangle.Q2Start = CurrentRectangle.Q1Start + EdgeA;
+			CurrentRectangle.Q3Start = CurrentRectangle.Q1Start + EdgeB;
+			CurrentRectangle.Q4Start = CurrentRectangle.Q1Start + EdgeA + EdgeB;
+			CurrentRectangle.Q1End = CurrentRectangle.Q1Start + Motion;
+			CurrentRectangle.Q2End = CurrentRectangle.Q2Start + Motion;
+			CurrentRectangle.Q3End = CurrentRectangle.Q3Start + Motion;
+			CurrentRectangle.Q4End = CurrentRectangle.Q4Start + Motion;
+			CurrentRectangle.PrimitiveId = 1u;
+			CurrentRectangle.ObjectId = i;
+			CurrentRectangle.MaterialIndex = AddRandomMaterial();
+		}
+
+		for (uint i{ 0u }; i < ( uint )Scene.Triangles.size(); i++) {
+			Triangle& CurrentTriangle{ Scene.Triangles[i] };
+			const float3 Center{ GetRandomFloat(-20.0f, +20.0f), GetRandomFloat(-12.0f, +12.0f), GetRandomFloat(+8.0f, +48.0f) };
+			const float3 Motion{ GetRandomPoint(float3{}, MotionSize) };
+
+			CurrentTriangle.V1Start = GetRandomPoint(Center, PrimitiveSize * 0.50f);
+			CurrentTriangle.V2Start = GetRandomPoint(Center, PrimitiveSize * 0.50f);
+			CurrentTriangle.V3Start = GetRandomPoint(Center, PrimitiveSize * 0.50f);
+			CurrentTriangle.V1End = CurrentTriangle.V1Start + Motion;
+			CurrentTriangle.V2End = CurrentTriangle.V2Start + Motion;
+			CurrentTriangle.V3End = CurrentTriangle.V3Start + Motion;
+			CurrentTriangle.PrimitiveId = 2u;
+			CurrentTriangle.ObjectId = i;
+			CurrentTriangle.MaterialIndex = AddRandomMaterial();
+		}
+
+		SetRootConstants(Settings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+	// A scene of two indexed meshes with about TriangleCount triangles between them, in front of the camera: a static, rippled diffuse floor of
+	// three quarters of them, and a metallic sphere of the rest, whose every vertex moves and swells between its Start and End keyframes.
+	inline void CreateMeshScene(const RenderSettings& Settings, uint TriangleCount, uint Seed, Scene& Scene) {
+		std::mt19937 MersenneTwisterEngine{ Seed };
+		std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+		std::vector<float3> Vertices{}, VerticesEnd{};
+		std::vector<uint3> Indices{};
+
+		Scene = SceneStuff::Scene{};
+
+		// Floor, as a grid of quads split in two.
+		const uint GridSize{ std::max(( uint )sqrtf(( float )TriangleCount * 0.375f), 1u) };
+
+		for (uint z{ 0u }; z <= GridSize; z++) {
+			for (uint x{ 0u }; x <= GridSize; x++) {
+				const float u{ ( float )x / ( float )GridSize }, v{ ( float )z / ( float )GridSize };
+				const float Height{ -6.0f + 0.75f * sinf(u * 24.0f) * cosf(v * 18.0f) + 0.05f * UnitDistribution(MersenneTwisterEngine) };
+				Vertices.push_back({ -30.0f + 60.0f * u, Height, +4.0f + 60.0f * v });
+			}
+		}
+
+		for (uint z{ 0u }; z < GridSize; z++) {
+			for (uint x{ 0u }; x < GridSize; x++) {
+				const uint V00{ z * (GridSize + 1u) + x }, V10{ V00 + 1u }, V01{ V00 + GridSize + 1u }, V11{ V01 + 1u };
+				Indices.push_back({ V00, V10, V11 });
+				Indices.push_back({ V00, V11, V01 });
+			}
+		}
+
+		AddMesh(Vertices, {}, Indices, AddMaterial(2u, { +0.75f, +0.70f, +0.60f }, { +0.75f, +0.70f, +0.60f }, 0.0f, 0.0f, Scene), Scene);
+
+		// Sphere, as a latitude-longitude grid whose poles are fans of triangles.
+		const uint SegmentCount{ std::max(( uint )sqrtf(( float )TriangleCount * 0.25f), 4u) };
+		const uint RingCount{ std::max(SegmentCount / 2u, 2u) };
+		const float3 CenterStart{ -4.0f, -1.0f, +24.0f }, CenterEnd{ +4.0f, +1.0f, +20.0f };
+		Vertices.clear();
+		Indices.clear();
+
+		for (uint Ring{ 0u }; Ring <= RingCount; Ring++) {
+			for (uint Segment{ 0u }; Segment < SegmentCount; Segment++) {
+				const float Theta{ ( float )M_PI * ( float )Ring / ( float )RingCount };
+				const float Phi{ 2.0f * ( float )M_PI * ( float )Segment / ( float )SegmentCount };
+				const float3 Direction{ sinf(Theta) * cosf(Phi), cosf(Theta), sinf(Theta) * sinf(Phi) };
+				Vertices.push_back(CenterStart + Direction * 4.0f);
+				VerticesEnd.push_back(CenterEnd + Direction * 5.0f);
+			}
+		}
+
+		for (uint Ring{ 0u }; Ring < RingCount; Ring++) {
+			for (uint Segment{ 0u }; Segment < SegmentCount; Segment++) {
+				const uint V00{ Ring * SegmentCount + Segment }, V10{ Ring * SegmentCount + (Segment + 1u) % SegmentCount };
+				const uint V01{ V00 + SegmentCount }, V11{ V10 + SegmentCount };
+
+				if (Ring > 0u) {
+					Indices.push_back({ V00, V10, V11 });
+				}
+
+				if (Ring + 1u < RingCount) {
+					Indices.push_back({ V00, V11, V01 });
+				}
+			}
+		}
+
+		AddMesh(Vertices, VerticesEnd, Indices, AddMaterial(4u, { +0.95f, +0.64f, +0.54f }, { +0.80f, +0.80f, +0.85f }, 0.05f, 0.05f, Scene), Scene);
+
+		SetRootConstants(Settings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+
+	// A closed room, so that the sky never lights it, holding three Metallic spheres of increasing fuzz and a fuzzy Metallic plate on its Diffuse
+	// floor, lit by four small, bright Diffuse Light quads under its ceiling and a tiny, brighter one on its back wall. Their reflections in the
+	// glossy surfaces are what bounces alone find slowest.
+	inline void CreateGlossyScene(const RenderSettings& Settings, Scene& Scene) {
+		Scene = SceneStuff::Scene{};
+
+		// Rectangle with a corner at Corner and two edges along Edge1 and Edge2, facing along cross(Edge1, Edge2).
+		auto AddRectangle = [&](const float3& Corner, const float3& Edge1, const float3& Edge2, uint MaterialIndex) {
+			Rectangle NewRectangle{};
+			NewRectangle.Q1Start = NewRectangle.Q1End = Corner;
+			NewRectangle.Q2Start = NewRectangle.Q2End = Corner + Edge1;
+			NewRectangle.Q3Start = NewRectangle.Q3End = Corner + Edge2;
+			NewRectangle.Q4Start = NewRectangle.Q4End = Corner + Edge1 + Edge2;
+			NewRectangle.PrimitiveId = 1u;
+			NewRectangle.ObjectId = ( uint )Scene.Rectangles.size();
+			NewRectangle.MaterialIndex = MaterialIndex;
+			Scene.Rectangles.push_back(NewRectangle);
+		};
+
+		auto AddSphere = [&](const float3& Origin, float Radius, uint MaterialIndex) {
+			Sphere NewSphere{};
+			NewSphere.WSOriginStart = NewSphere.WSOriginEnd = Origin;
+			NewSphere.WSRadiusStart = NewSphere.WSRadiusEnd = Radius;
+			NewSphere.PrimitiveId = 0u;
+			NewSphere.ObjectId = ( uint )Scene.Spheres.size();
+			NewSphere.MaterialIndex = MaterialIndex;
+			Scene.Spheres.push_back(NewSphere);
+		};
+
+		// Walls of the room around the camera, from x -24 to +24, y -10 to +22 and z -10 to +60, all facing inward.
+		const uint FloorMaterial{ AddMaterial(2u, { +0.60f, +0.58f, +0.55f }, { +0.60f, +0.58f, +0.55f }, 0.0f, 0.0f, Scene) };
+		const uint WallMaterial{ AddMaterial(2u, { +0.70f, +0.70f, +0.70f }, { +0.70f, +0.70f, +0.70f }, 0.0f, 0.0f, Scene) };
+		const uint BackWallMaterial{ AddMaterial(2u, { +0.45f, +0.50f, +0.60f }, { +0.45f, +0.50f, +0.60f }, 0.0f, 0.0f, Scene) };
+		AddRectangle({ -24.0f, -10.0f, -10.0f }, { +0.0f, +0.0f, +70.0f }, { +48.0f, +0.0f, +0.0f }, FloorMaterial);
+		AddRectangle({ -24.0f, +22.0f, -10.0f }, { +48.0f, +0.0f, +0.0f }, { +0.0f, +0.0f, +70.0f }, WallMaterial);
+		AddRectangle({ -24.0f, -10.0f, +60.0f }, { +0.0f, +32.0f, +0.0f }, { +48.0f, +0.0f, +0.0f }, BackWallMaterial);
+		AddRectangle({ -24.0f, -10.0f, -10.0f }, { +48.0f, +0.0f, +0.0f }, { +0.0f, +32.0f, +0.0f }, WallMaterial);
+		AddRectangle({ -24.0f, -10.0f, -10.0f }, { +0.0f, +32.0f, +0.0f }, { +0.0f, +0.0f, +70.0f }, WallMaterial);
+		AddRectangle({ +24.0f, -10.0f, -10.0f }, { +0.0f, +0.0f, +70.0f }, { +0.0f, +32.0f, +0.0f }, WallMaterial);
+
+		// Fuzzy plate just above the floor, and the spheres on it.
+		AddRectangle({ -20.0f, -9.99f, +14.0f }, { +0.0f, +0.0f, +36.0f }, { +40.0f, +0.0f, +0.0f },
+			AddMaterial(4u, { +0.80f, +0.80f, +0.82f }, { +0.80f, +0.80f, +0.82f }, 0.15f, 0.15f, Scene));
+		AddSphere({ -13.0f, -5.0f, +32.0f }, 5.0f, AddMaterial(4u, { +0.95f, +0.80f, +0.45f }, { +0.95f, +0.80f, +0.45f }, 0.02f, 0.02f, Scene));
+		AddSphere({ +0.0f, -5.0f, +32.0f }, 5.0f, AddMaterial(4u, { +0.90f, +0.90f, +0.92f }, { +0.90f, +0.90f, +0.92f }, 0.08f, 0.08f, Scene));
+		AddSphere({ +13.0f, -5.0f, +32.0f }, 5.0f, AddMaterial(4u, { +0.95f, +0.60f, +0.50f }, { +0.95f, +0.60f, +0.50f }, 0.30f, 0.30f, Scene));
+
+		// Lights, facing down from just under the ceiling, and facing the camera from just in front of the back wall.
+		const uint LightMaterial{ AddMaterial(5u, { +60.0f, +56.0f, +50.0f }, { +60.0f, +56.0f, +50.0f }, 0.0f, 0.0f, Scene) };
+
+		for (float x: { -12.0f, +10.0f }) {
+			for (float z: { +20.0f, +44.0f }) {
+				AddRectangle({ x, +21.5f, z }, { +2.0f, +0.0f, +0.0f }, { +0.0f, +0.0f, +2.0f }, LightMaterial);
+			}
+		}
+
+		AddRectangle({ -0.25f, +5.0f, +59.5f }, { +0.0f, +0.5f, +0.0f }, { +0.5f, +0.0f, +0.0f },
+			AddMaterial(5u, { +200.0f, +240.0f, +400.0f }, { +200.0f, +240.0f, +400.0f }, 0.0f, 0.0f, Scene));
+
+		SetRootConstants(Settings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+	// A dark plain under a black sky, holding some Diffuse and Metallic spheres and scattered with LightCount small Diffuse Light quads and triangles
+	// of random colors, sizes and facings, from just above the ground to well over the camera, and from just in front of it to far away. Every light
+	// only lights its surroundings, so picking them by power alone wastes almost every sample on lights too far to matter.
+	inline void CreateManyLightScene(const RenderSettings& Settings, uint LightCount, uint Seed, Scene& Scene) {
+		std::mt19937 MersenneTwisterEngine{ Seed };
+		std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+
+		auto GetRandomFloat = [&](float Minimum, float Maximum) {
+			return Minimum + (Maximum - Minimum) * UnitDistribution(MersenneTwisterEngine);
+		};
+
+		auto GetRandomDirection = [&]() {
+			return normalize(float3{ GetRandomFloat(-1.0f, +1.0f), GetRandomFloat(-1.0f, +1.0f), GetRandomFloat(-1.0f, +1.0f) });
+		};
+
+		Scene = SceneStuff::Scene{};
+
+		// Ground, facing up, from x -200 to +200 and z -10 to +400.
+		Rectangle Ground{};
+		Ground.Q1Start = Ground.Q1End = { -200.0f, -10.0f, -10.0f };
+		Ground.Q2Start = Ground.Q2End = { -200.0f, -10.0f, +400.0f };
+		Ground.Q3Start = Ground.Q3End = { +200.0f, -10.0f, -10.0f };
+		Ground.Q4Start = Ground.Q4End = { +200.0f, -10.0f, +400.0f };
+		Ground.PrimitiveId = 1u;
+		Ground.MaterialIndex = AddMaterial(2u, { +0.50f, +0.50f, +0.50f }, { +0.50f, +0.50f, +0.50f }, 0.0f, 0.0f, Scene);
+		Scene.Rectangles.push_back(Ground);
+
+		// Spheres resting on the ground, a quarter of them Metallic.
+		for (uint i{ 0u }; i < 64u; i++) {
+			const float Radius{ GetRandomFloat(1.0f, 4.0f) };
+			const float3 Color{ GetRandomFloat(0.3f, 0.9f), GetRandomFloat(0.3f, 0.9f), GetRandomFloat(0.3f, 0.9f) };
+			const float MaterialScalar{ GetRandomFloat(0.0f, 0.2f) };
+			Sphere NewSphere{};
+			NewSphere.WSOriginStart = NewSphere.WSOriginEnd = { GetRandomFloat(-120.0f, +120.0f), -10.0f + Radius, GetRandomFloat(+10.0f, +300.0f) };
+			NewSphere.WSRadiusStart = NewSphere.WSRadiusEnd = Radius;
+			NewSphere.PrimitiveId = 0u;
+			NewSphere.ObjectId = ( uint )Scene.Spheres.size();
+			NewSphere.MaterialIndex = AddMaterial(i % 4u == 0u ? 4u : 2u, Color, Color, MaterialScalar, MaterialScalar, Scene);
+			Scene.Spheres.push_back(NewSphere);
+		}
+
+		// Lights, alternating between quads and triangles, around random centers.
+		for (uint i{ 0u }; i < LightCount; i++) {
+			const float3 Center{ GetRandomFloat(-150.0f, +150.0f), GetRandomFloat(-9.5f, +10.0f), GetRandomFloat(+5.0f, +390.0f) };
+			const float Size{ GetRandomFloat(0.2f, 0.6f) };
+			const float3 EdgeA{ GetRandomDirection() * Size };
+			const float3 EdgeB{ normalize(cross(EdgeA, GetRandomDirection())) * Size };
+			const float3 Color{ float3{ GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f) } * 40.0f };
+			const uint MaterialIndex{ AddMaterial(5u, Color, Color, 0.0f, 0.0f, Scene) };
+
+			if (i % 2u == 0u) {
+				Rectangle NewRectangle{};
+				NewRectangle.Q1Start = NewRectangle.Q1End = Center - EdgeA * 0.50f - EdgeB * 0.50f;
+				NewRectangle.Q2Start = NewRectangle.Q2End = NewRectangle.Q1Start + EdgeA;
+				NewRectangle.Q3Start = NewRectangle.Q3End = NewRectangle.Q1Start + EdgeB;
+				NewRectangle.Q4Start = NewRectangle.Q4End = NewRectangle.Q1Start + EdgeA + EdgeB;
+				NewRectangle.PrimitiveId = 1u;
+				NewRectangle.ObjectId = ( uint )Scene.Rectangles.size();
+				NewRectangle.MaterialIndex = MaterialIndex;
+				Scene.Rectangles.push_back(NewRectangle);
+			} else {
+				Triangle NewTriangle{};
+				NewTriangle.V1Start = NewTriangle.V1End = Center - EdgeA * 0.50f - EdgeB * 0.50f;
+				NewTriangle.V2Start = NewTriangle.V2End = NewTriangle.V1Start + EdgeA;
+				NewTriangle.V3Start = NewTriangle.V3End = NewTriangle.V1Start + EdgeB;
+				NewTriangle.PrimitiveId = 2u;
+				NewTriangle.ObjectId = ( uint )Scene.Triangles.size();
+				NewTriangle.MaterialIndex = MaterialIndex;
+				Scene.Triangles.push_back(NewTriangle);
+			}
+		}
+
+		// The sky is black, so that the lights alone light the plain.
+		RenderSettings DarkSettings{ Settings };
+		DarkSettings.SkyTopColor = float3{};
+		DarkSettings.SkyBottomColor = float3{};
+		SetRootConstants(DarkSettings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+
+	constexpr uint InstancePrototypeTriangleCount{ 10000u };// Size of the torus prototype of the headless renderer's and benchmarks' instance scenes.
+
+	// A scene of InstanceCount randomly placed, rotated and scaled instances of a single torus prototype of about PrototypeTriangleCount triangles,
+	// in front of the camera. Instance sizes shrink with the count like those of CreateRandomScene(), and the torus is stored once, however many
+	// instances there are. Mostly diffuse, with some metallic surfaces and lights.
+	inline void CreateInstanceScene(const RenderSettings& Settings, uint InstanceCount, uint PrototypeTriangleCount, uint Seed, Scene& Scene) {
+		std::mt19937 MersenneTwisterEngine{ Seed };
+		std::uniform_real_distribution<float> UnitDistribution{ 0.0f, 1.0f };
+		std::vector<float3> Vertices{};
+		std::vector<uint3> Indices{};
+
+		auto GetRandomFloat = [&](float Minimum, float Maximum) {
+			return Minimum + (Maximum - Minimum) * UnitDistribution(MersenneTwisterEngine);
+		};
+
+		Scene = SceneStuff::Scene{};
+
+		// Torus of unit outer radius around the y axis, as a grid of quads split in two that wraps around both ways, wound to face outward.
+		const uint MinorSegmentCount{ std::max(( uint )sqrtf(( float )PrototypeTriangleCount * 0.25f), 3u) };
+		const uint MajorSegmentCount{ std::max(PrototypeTriangleCount / (2u * MinorSegmentCount), 3u) };
+
+		for (uint Major{ 0u }; Major < MajorSegmentCount; Major++) {
+			for (uint Minor{ 0u }; Minor < MinorSegmentCount; Minor++) {
+				const float Phi{ 2.0f * ( float )M_PI * ( float )Major / ( float )MajorSegmentCount };
+				const float Theta{ 2.0f * ( float )M_PI * ( float )Minor / ( float )MinorSegmentCount };
+				const float Radius{ 0.70f + 0.30f * cosf(Theta) };
+				Vertices.push_back({ Radius * cosf(Phi), 0.30f * sinf(Theta), Radius * sinf(Phi) });
+			}
+		}
+
+		for (uint Major{ 0u }; Major < MajorSegmentCount; Major++) {
+			for (uint Minor{ 0u }; Minor < MinorSegmentCount; Minor++) {
+				const uint NextMajor{ (Major + 1u) % MajorSegmentCount }, NextMinor{ (Minor + 1u) % MinorSegmentCount };
+				const uint V00{ Major * MinorSegmentCount + Minor }, V10{ NextMajor * MinorSegmentCount + Minor };
+				const uint V01{ Major * MinorSegmentCount + NextMinor }, V11{ NextMajor * MinorSegmentCount + NextMinor };
+				Indices.push_back({ V00, V11, V10 });
+				Indices.push_back({ V00, V01, V11 });
+			}
+		}
+
+		const uint PrototypeIndex{ AddPrototype(Vertices.data(), ( uint )Vertices.size(), Indices.data(), ( uint )Indices.size(), Scene) };
+
+		const float InstanceSize{ 16.0f / cbrtf(( float )std::max(InstanceCount, 1u)) };
+		Scene.Instances.reserve(InstanceCount);
+		Scene.Materials.reserve(InstanceCount);
+
+		while (( uint )Scene.Instances.size() < InstanceCount) {
+			// Rotation about a random axis by a random angle, scaled and moved to a random point.
+			const float3 Axis{ normalize(float3{ GetRandomFloat(-1.0f, +1.0f), GetRandomFloat(-1.0f, +1.0f), GetRandomFloat(-1.0f, +1.0f) }) };
+			const float Angle{ GetRandomFloat(0.0f, 2.0f * ( float )M_PI) }, Scale{ GetRandomFloat(0.25f, 0.50f) * InstanceSize };
+			const float Cosine{ cosf(Angle) }, Sine{ sinf(Angle) }, OneMinusCosine{ 1.0f - Cosine };
+			const float3 Position{ GetRandomFloat(-20.0f, +20.0f), GetRandomFloat(-12.0f, +12.0f), GetRandomFloat(+8.0f, +48.0f) };
+
+			const float4 WorldFromObject[3]{
+				{ Scale * (Cosine + Axis.x * Axis.x * OneMinusCosine), Scale * (Axis.x * Axis.y * OneMinusCosine - Axis.z * Sine),
+					Scale * (Axis.x * Axis.z * OneMinusCosine + Axis.y * Sine), Position.x },
+				{ Scale * (Axis.y * Axis.x * OneMinusCosine + Axis.z * Sine), Scale * (Cosine + Axis.y * Axis.y * OneMinusCosine),
+					Scale * (Axis.y * Axis.z * OneMinusCosine - Axis.x * Sine), Position.y },
+				{ Scale * (Axis.z * Axis.x * OneMinusCosine - Axis.y * Sine), Scale * (Axis.z * Axis.y * OneMinusCosine + Axis.x * Sine),
+					Scale * (Cosine + Axis.z * Axis.z * OneMinusCosine), Position.z },
+			};
+
+			const float3 Color{ GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f), GetRandomFloat(0.2f, 1.0f) };
+			const float MaterialScalar{ GetRandomFloat(0.0f, 0.3f) };
+			const float Choice{ UnitDistribution(MersenneTwisterEngine) };
+
+			AddInstance(PrototypeIndex, WorldFromObject,
+				AddMaterial(Choice < 0.05f ? 5u : (Choice < 0.25f ? 4u : 2u), Color, Color, MaterialScalar, MaterialScalar, Scene), Scene);
+		}
+
+		SetRootConstants(Settings, Scene);
+
+		InterpolateScene(0.0f, Scene);
+	}
+
+}
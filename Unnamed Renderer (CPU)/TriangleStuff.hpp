@@ -0,0 +1,216 @@
+// TriangleStuff.hpp (Header Only)
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#pragma once
+
+#ifndef TRIANGLE_STUFF
+	#define TRIANGLE_STUFF
+#endif
+
+#include "SceneStuff.hpp"
+#include <cstring>
+
+namespace TriangleStuff {
+
+	/*
+		TRIANGLE INTERSECTORS:
+			Legacy - The Compute Shaders' test: intersects the triangle's plane, then checks that the point lies inside all three edges.
+				Rounding differs between the two triangles on either side of an edge, so a path through a shared edge or vertex can slip past both.
+			Watertight - Woop, Benthin and Wald's watertight test: the vertices are sheared into the path's own space, where each edge's signed
+				area is evaluated from exactly the same two vertices by both of its triangles (in double precision when it rounds to zero), so a
+				path through a shared edge hits at least one of them.
+	*/
+	enum class TriangleIntersector : uint { Legacy, Watertight };
+
+	inline const char* GetTriangleIntersectorName(TriangleIntersector Intersector) {
+		switch (Intersector) {
+			case TriangleIntersector::Legacy: {
+				return "legacy";
+			}
+			case TriangleIntersector::Watertight: {
+				return "watertight";
+			}
+		}
+
+		return "unknown";
+	}
+
+	// Looks a triangle intersector up by its name, returning false if there is none.
+	inline bool GetTriangleIntersector(const char* Name, TriangleIntersector& Intersector) {
+		for (TriangleIntersector CurrentIntersector: { TriangleIntersector::Legacy, TriangleIntersector::Watertight }) {
+			if (strcmp(Name, GetTriangleIntersectorName(CurrentIntersector)) == 0) {
+				Intersector = CurrentIntersector;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*
+		TRIANGLE RECORD LAYOUT:
+			The geometry of a Triangle as it is at the current frame, along with what every intersection test used to derive from it, in one
+			64-byte cache line instead of the Triangle's 168 bytes of keyframes, colors and materials.
+			00 - 12: V1
+			12 - 16: PlaneDistance, dot(Normal, V1).
+			16 - 28: V2
+			28 - 32: Padding00
+			32 - 44: V3
+			44 - 48: Padding01
+			48 - 60: Normal, normalize(cross(V2 - V1, V3 - V1)).
+			60 - 64: Padding02
+			The vertices are kept rather than edge vectors, since the watertight test needs the very vertices that neighbouring triangles share.
+	*/
+	struct alignas(64) TriangleRecord {
+		float3 V1;
+		float PlaneDistance;
+		float3 V2;
+		float Padding00;
+		float3 V3;
+		float Padding01;
+		float3 Normal;
+		float Padding02;
+	};
+
+	// Fills a TriangleRecord in from three vertices, deriving the normal and plane exactly like the Compute Shaders do.
+	inline void CreateTriangleRecord(const float3& V1, const float3& V2, const float3& V3, TriangleRecord& Record) {
+		Record.V1 = V1;
+		Record.V2 = V2;
+		Record.V3 = V3;
+		Record.Normal = normalize(cross(V2 - V1, V3 - V1));
+		Record.PlaneDistance = dot(Record.Normal, V1);
+		Record.Padding00 = Record.Padding01 = Record.Padding02 = 0.0f;
+	}
+
+	inline void CreateTriangleRecord(const Triangle& CurrentTriangle, TriangleRecord& Record) {
+		CreateTriangleRecord(CurrentTriangle.V1, CurrentTriangle.V2, CurrentTriangle.V3, Record);
+	}
+
+	// Refreshes the TriangleRecords of a frame, in parallel.
+	inline void CreateTriangleRecords(const CPUStuff::MappableVector<Triangle>& Triangles, CPUStuff::ThreadPool& ThreadPool,
+		std::vector<TriangleRecord>& Records) {
+		Records.resize(Triangles.size());
+
+		ThreadPool.ParallelFor(( int64_t )Triangles.size(), 4096, [&](int64_t BeginIndex, int64_t EndIndex, uint) {
+			for (int64_t i{ BeginIndex }; i < EndIndex; i++) {
+				CreateTriangleRecord(Triangles[i], Records[i]);
+			}
+		});
+	}
+
+	inline uint64_t GetTriangleRecordsSizeInBytes(const std::vector<TriangleRecord>& Records) {
+		return Records.capacity() * sizeof(TriangleRecord);
+	}
+
+	inline float GetTriangleArea(const TriangleRecord& Record) {
+		return 0.5f * length(cross(Record.V2 - Record.V1, Record.V3 - Record.V1));
+	}
+
+	// Point of a triangle at which uniform u and v in [0, 1) sample it uniformly by area.
+	inline float3 GetTrianglePoint(const TriangleRecord& Record, float u, float v) {
+		const float SquareRootU{ sqrtf(u) };
+		return Record.V1 * (1.0f - SquareRootU) + Record.V2 * (SquareRootU * (1.0f - v)) + Record.V3 * (SquareRootU * v);
+	}
+
+	// Distance along a path to a triangle, valid if the path hits it at or past MinDistance, with the Compute Shaders' test.
+	inline bool IntersectTriangleLegacy(const TriangleRecord& Record, const float3& Origin, const float3& Direction, float MinDistance, float& t) {
+		float ndotdR = dot(Record.Normal, Direction);
+
+		t = (-dot(Record.Normal, Origin) + Record.PlaneDistance) / dot(Record.Normal, Direction);
+
+		float3 WSIntersectionPoint = Origin + t * Direction;
+
+		float3 Edge01, Edge02, Edge03;
+		Edge01 = Record.V2 - Record.V1;
+		Edge02 = Record.V3 - Record.V2;
+		Edge03 = Record.V1 - Record.V3;
+
+		float3 C1, C2, C3;
+		C1 = WSIntersectionPoint - Record.V1;
+		C2 = WSIntersectionPoint - Record.V2;
+		C3 = WSIntersectionPoint - Record.V3;
+
+		float NDotCrossProduct1, NDotCrossProduct2, NDotCrossProduct3;
+		NDotCrossProduct1 = dot(Record.Normal, cross(Edge01, C1));
+		NDotCrossProduct2 = dot(Record.Normal, cross(Edge02, C2));
+		NDotCrossProduct3 = dot(Record.Normal, cross(Edge03, C3));
+
+		return fabsf(ndotdR) > 1e-8f && t > 0.0f && t >= MinDistance && NDotCrossProduct1 >= 0.0f && NDotCrossProduct2 >= 0.0f && NDotCrossProduct3 >= 0.0f;
+	}
+
+	// Signed area of the edge from P to Q, in the sheared space of a path, redone in double precision when it rounds to zero so that its sign is exact.
+	inline float GetEdgeFunction(float Px, float Py, float Qx, float Qy) {
+		float Area{ Px * Qy - Py * Qx };
+
+		if (Area == 0.0f) {
+			Area = ( float )(( double )Px * ( double )Qy - ( double )Py * ( double )Qx);
+		}
+
+		return Area;
+	}
+
+	// Distance along a path to a triangle, valid if the path hits either of its faces at or past MinDistance, with the watertight test.
+	// Only needs the vertices, so that indexed meshes can be tested straight from their vertex buffers.
+	inline bool IntersectTriangleWatertight(
+		const float3& V1, const float3& V2, const float3& V3, const float3& Origin, const float3& Direction, float MinDistance, float& t) {
+		const float AbsoluteDirection[3]{ fabsf(Direction.x), fabsf(Direction.y), fabsf(Direction.z) };
+		const float AxisDirection[3]{ Direction.x, Direction.y, Direction.z };
+
+		// The path runs along z of its sheared space, which is its direction's largest axis. Swapping x and y when it points down z keeps the winding.
+		uint kz{ AbsoluteDirection[0] >= AbsoluteDirection[1] ? (AbsoluteDirection[0] >= AbsoluteDirection[2] ? 0u : 2u)
+															   : (AbsoluteDirection[1] >= AbsoluteDirection[2] ? 1u : 2u) };
+		uint kx{ kz == 2u ? 0u : kz + 1u };
+		uint ky{ kx == 2u ? 0u : kx + 1u };
+
+		if (AxisDirection[kz] < 0.0f) {
+			std::swap(kx, ky);
+		}
+
+		const float Sz{ 1.0f / AxisDirection[kz] };
+		const float Sx{ AxisDirection[kx] * Sz };
+		const float Sy{ AxisDirection[ky] * Sz };
+
+		const float3 A3{ V1 - Origin }, B3{ V2 - Origin }, C3{ V3 - Origin };
+		const float A[3]{ A3.x, A3.y, A3.z }, B[3]{ B3.x, B3.y, B3.z }, C[3]{ C3.x, C3.y, C3.z };
+
+		const float Ax{ A[kx] - Sx * A[kz] }, Ay{ A[ky] - Sy * A[kz] };
+		const float Bx{ B[kx] - Sx * B[kz] }, By{ B[ky] - Sy * B[kz] };
+		const float Cx{ C[kx] - Sx * C[kz] }, Cy{ C[ky] - Sy * C[kz] };
+
+		const float U{ GetEdgeFunction(Cx, Cy, Bx, By) };
+		const float V{ GetEdgeFunction(Ax, Ay, Cx, Cy) };
+		const float W{ GetEdgeFunction(Bx, By, Ax, Ay) };
+
+		// Both faces are hit, like with the legacy test, so the edge functions only have to agree in sign.
+		if ((U < 0.0f || V < 0.0f || W < 0.0f) && (U > 0.0f || V > 0.0f || W > 0.0f)) {
+			return false;
+		}
+
+		const float Determinant{ U + V + W };
+
+		if (Determinant == 0.0f) {
+			return false;
+		}
+
+		const float T{ U * (Sz * A[kz]) + V * (Sz * B[kz]) + W * (Sz * C[kz]) };
+		t = T / Determinant;
+
+		return t > 0.0f && t >= MinDistance;
+	}
+
+	inline bool IntersectTriangleWatertight(const TriangleRecord& Record, const float3& Origin, const float3& Direction, float MinDistance, float& t) {
+		return IntersectTriangleWatertight(Record.V1, Record.V2, Record.V3, Origin, Direction, MinDistance, t);
+	}
+
+	inline bool IntersectTriangle(
+		TriangleIntersector Intersector, const TriangleRecord& Record, const float3& Origin, const float3& Direction, float MinDistance, float& t) {
+		if (Intersector == TriangleIntersector::Watertight) {
+			return IntersectTriangleWatertight(Record, Origin, Direction, MinDistance, t);
+		}
+
+		return IntersectTriangleLegacy(Record, Origin, Direction, MinDistance, t);
+	}
+
+}
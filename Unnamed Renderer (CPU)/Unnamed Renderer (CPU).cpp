@@ -0,0 +1,396 @@
+// Unnamed Renderer (CPU).cpp - Headless, multithreaded host port of the path-tracer.
+// Oct 2026
+// Chris M.
+// https://github.com/RealTimeChris
+
+#include "PathTracerStuff.hpp"
+#include "SceneCacheStuff.hpp"
+#include "SceneFileStuff.hpp"
+#include <cstring>
+#include <string>
+
+// Parses an unsigned command-line value, bailing out on malformed input.
+uint ParseUnsignedArgument(const char* ArgumentName, const char* ArgumentValue) {
+	char* pEnd{ nullptr };
+	unsigned long Value{ strtoul(ArgumentValue, &pEnd, 10) };
+
+	if (pEnd == ArgumentValue || *pEnd != '\0') {
+		CPUStuff::FailBail(ArgumentValue, ArgumentName);
+	}
+
+	return ( uint )Value;
+}
+
+// Parses a non-negative decimal command-line value, bailing out on malformed input.
+float ParseFloatArgument(const char* ArgumentName, const char* ArgumentValue) {
+	char* pEnd{ nullptr };
+	float Value{ strtof(ArgumentValue, &pEnd) };
+
+	if (pEnd == ArgumentValue || *pEnd != '\0' || !(Value >= 0.0f)) {
+		CPUStuff::FailBail(ArgumentValue, ArgumentName);
+	}
+
+	return Value;
+}
+
+// Bails out with a scene file's error, and the line it is on.
+void PrintSceneFileError(const char* FilePath, const SceneFileStuff::SceneFileStats& Stats) {
+	char ErrorTitle[1024]{};
+	snprintf(ErrorTitle, sizeof(ErrorTitle), Stats.ErrorLine > 0u ? "%s:%u" : "%s", FilePath, Stats.ErrorLine);
+	CPUStuff::FailBail(Stats.ErrorMessage, ErrorTitle);
+}
+
+void PrintUsage() {
+	printf("Usage: UnnamedRendererHeadless [options]\n");
+	printf("  --width <pixels>        View port width. (Default: 1280)\n");
+	printf("  --height <pixels>       View port height. (Default: 720)\n");
+	printf("  --spp <count>           Samples per pixel. (Default: 3000)\n");
+	printf("  --depth <count>         Maximum path recursion depth. (Default: 30)\n");
+	printf("  --rr-depth <count>      Path-depth from which Russian roulette applies, --depth or more disables it. (Default: 3)\n");
+	printf("  --frames <count>        Number of animation frames to render. (Default: 2)\n");
+	printf("  --threads <count>       Worker thread count, 0 for all cores. (Default: 0)\n");
+	printf("  --mode <name>           three-pass: Intersection Map passes, fused: trace and shade in one pass,\n");
+	printf("                          wavefront: trace bands of paths stage by stage, shading by material. (Default: three-pass)\n");
+	printf("  --sampler <name>        independent, stratified, sobol or blue-noise. (Default: independent)\n");
+	printf("  --light-sampling <name> none: only hit lights by chance, nee: also sample a light at every diffuse hit,\n");
+	printf("                          mis: and at every fuzzy metallic hit, weighting both strategies by the power heuristic,\n");
+	printf("                          restir: like nee, but each pixel's first hit resamples its light from many candidates, reused across\n");
+	printf("                          nearby pixels and from sample to sample, while the shutter is closed. (Default: none)\n");
+	printf("  --light-selection <name>\n");
+	printf("                          power: pick the lights to sample by power alone, tree: walk a light tree towards the lights nearest to\n");
+	printf("                          and facing each hit. (Default: power)\n");
+	printf("  --accel <name>          bvh: per-frame surface area heuristic BVH, brute-force: test every primitive. (Default: bvh)\n");
+	printf("  --bvh-builder <name>    sah: parallel binned SAH, lbvh: parallel Morton-ordered LBVH, faster to build but slower to trace. (Default: sah)\n");
+	printf("  --bvh-rebuild <ratio>   Refit the BVH between frames until its SAH cost grows by this factor, 0 to rebuild every frame. (Default: 1.5)\n");
+	printf("  --simd <name>           Kernel for spheres of the brute-force search and for ray packets: scalar, avx2 or avx512.\n");
+	printf("                          (Default: the widest the CPU supports)\n");
+	printf("  --triangles <name>      watertight: shared edges never leak, legacy: the Compute Shaders' plane and edge test. (Default: watertight)\n");
+	printf("  --no-packets            Trace every camera path on its own, rather than in packets of %u through the BVH.\n", SIMDStuff::RayPacketSize);
+	printf("  --shutter <steps>       Motion blur each frame across this many animation steps (1 spans Start to End), 0 for none. (Default: 0)\n");
+	printf("  --primitives <count>    Render a random scene of this many primitives instead of the stock scene, 0 for the stock scene. (Default: 0)\n");
+	printf("  --mesh <triangles>      Render a scene of two indexed meshes with about this many triangles instead, 0 for none. (Default: 0)\n");
+	printf("  --instances <count>     Render a scene of this many instances of a %u-triangle torus instead, 0 for none. (Default: 0)\n",
+		SceneStuff::InstancePrototypeTriangleCount);
+	printf("  --glossy                Render a closed room of glossy metallic surfaces lit by small, bright quads instead.\n");
+	printf("  --many-lights <count>   Render a dark plain scattered with this many small lights of both sides instead, 0 for none. (Default: 0)\n");
+	printf("  --scene <file>          Render a scene file, whose settings the options above override.\n");
+	printf("  --scene-cache <file>    Map the --scene file's compiled scene and BVH from this cache, or write it there when missing or stale.\n");
+	printf("  --import <file>         Render a binary PLY or OBJ mesh instead, scaled to fit in front of the camera.\n");
+	printf("  --save-scene <file>     Write the scene and its settings to a scene file before rendering it.\n");
+	printf("  --output <prefix>       Final frames are written as <prefix>NNNN.ppm. (Default: Frame)\n");
+	printf("  --no-output             Skip writing the final frames.\n");
+}
+
+int main(int argc, char** argv) {
+	/*
+		GLOBAL APPLICATION/RENDERING STUFF.
+	*/
+
+	SceneStuff::RenderSettings RenderSettings{};
+	uint FinalFrameCount{ 2u };
+	uint ThreadCount{ 0u };
+	uint RandomPrimitiveCount{ 0u };
+	uint MeshTriangleCount{ 0u };
+	uint InstanceCount{ 0u };
+	bool GlossyScene{ false };
+	uint ManyLightCount{ 0u };
+	const char* ImportFilePath{ nullptr };
+	const char* SceneFilePath{ nullptr };
+	const char* SavedSceneFilePath{ nullptr };
+	const char* SceneCacheFilePath{ nullptr };
+	PathTracerStuff::RendererConfig RendererConfig{};
+	std::string OutputPrefix{ "Frame" };
+	bool WriteOutput{ true };
+
+	// A scene file's settings are read first, for the command line to override.
+	for (int i{ 1 }; i + 1 < argc; i++) {
+		if (strcmp(argv[i], "--scene") == 0) {
+			SceneFilePath = argv[i + 1];
+			SceneFileStuff::SceneFileStats SceneFileStats{};
+
+			if (!SceneFileStuff::LoadSceneSettings(SceneFilePath, RenderSettings, SceneFileStats)) {
+				PrintSceneFileError(SceneFilePath, SceneFileStats);
+			}
+		}
+	}
+
+	for (int i{ 1 }; i < argc; i++) {
+		const char* Argument{ argv[i] };
+		const char* Value{ i + 1 < argc ? argv[i + 1] : nullptr };
+
+		if (strcmp(Argument, "--help") == 0) {
+			PrintUsage();
+			return 0;
+		} else if (strcmp(Argument, "--no-output") == 0) {
+			WriteOutput = false;
+			continue;
+		} else if (strcmp(Argument, "--no-packets") == 0) {
+			RendererConfig.CameraRayPackets = false;
+			continue;
+		} else if (strcmp(Argument, "--glossy") == 0) {
+			GlossyScene = true;
+			continue;
+		} else if (Value == nullptr) {
+			PrintUsage();
+			CPUStuff::FailBail("Missing or unknown argument.", Argument);
+		}
+
+		if (strcmp(Argument, "--width") == 0) {
+			RenderSettings.PSViewPortDimensions.x = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--height") == 0) {
+			RenderSettings.PSViewPortDimensions.y = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--spp") == 0) {
+			RenderSettings.SamplesPerPixel = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--depth") == 0) {
+			RenderSettings.MaxRecursionDepth = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--rr-depth") == 0) {
+			RenderSettings.RussianRouletteDepth = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--frames") == 0) {
+			FinalFrameCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--threads") == 0) {
+			ThreadCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--mode") == 0) {
+			if (!PathTracerStuff::GetRenderMode(Value, RendererConfig.Mode)) {
+				CPUStuff::FailBail(Value, "Unknown render mode");
+			}
+		} else if (strcmp(Argument, "--sampler") == 0) {
+			if (!SamplerStuff::GetSamplerType(Value, RendererConfig.SamplerType)) {
+				CPUStuff::FailBail(Value, "Unknown sampler");
+			}
+		} else if (strcmp(Argument, "--light-sampling") == 0) {
+			if (!LightStuff::GetLightSamplingType(Value, RendererConfig.LightSampling)) {
+				CPUStuff::FailBail(Value, "Unknown light sampling");
+			}
+		} else if (strcmp(Argument, "--light-selection") == 0) {
+			if (!LightStuff::GetLightSelectionType(Value, RendererConfig.LightSelection)) {
+				CPUStuff::FailBail(Value, "Unknown light selection");
+			}
+		} else if (strcmp(Argument, "--triangles") == 0) {
+			if (!TriangleStuff::GetTriangleIntersector(Value, RendererConfig.TriangleIntersector)) {
+				CPUStuff::FailBail(Value, "Unknown triangle intersector");
+			}
+		} else if (strcmp(Argument, "--accel") == 0) {
+			if (strcmp(Value, "bvh") == 0) {
+				RendererConfig.AccelerationStructure = PathTracerStuff::AccelerationStructureType::BVH;
+			} else if (strcmp(Value, "brute-force") == 0) {
+				RendererConfig.AccelerationStructure = PathTracerStuff::AccelerationStructureType::BruteForce;
+			} else {
+				CPUStuff::FailBail(Value, "Unknown acceleration structure");
+			}
+		} else if (strcmp(Argument, "--bvh-builder") == 0) {
+			if (!BVHStuff::GetBVHBuildType(Value, RendererConfig.BVHBuildType)) {
+				CPUStuff::FailBail(Value, "Unknown BVH builder");
+			}
+		} else if (strcmp(Argument, "--bvh-rebuild") == 0) {
+			RendererConfig.BVHRebuildThreshold = ParseFloatArgument(Argument, Value);
+		} else if (strcmp(Argument, "--simd") == 0) {
+			if (!SIMDStuff::GetSIMDLevel(Value, RendererConfig.SIMDLevel)) {
+				CPUStuff::FailBail(Value, "Unknown SIMD level");
+			} else if (RendererConfig.SIMDLevel > SIMDStuff::GetSupportedSIMDLevel()) {
+				CPUStuff::FailBail(Value, "SIMD level unsupported by this CPU");
+			}
+		} else if (strcmp(Argument, "--shutter") == 0) {
+			RendererConfig.ShutterLength = ParseFloatArgument(Argument, Value);
+		} else if (strcmp(Argument, "--primitives") == 0) {
+			RandomPrimitiveCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--mesh") == 0) {
+			MeshTriangleCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--instances") == 0) {
+			InstanceCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--many-lights") == 0) {
+			ManyLightCount = ParseUnsignedArgument(Argument, Value);
+		} else if (strcmp(Argument, "--import") == 0) {
+			ImportFilePath = Value;
+		} else if (strcmp(Argument, "--scene") == 0) {
+			SceneFilePath = Value;
+		} else if (strcmp(Argument, "--scene-cache") == 0) {
+			SceneCacheFilePath = Value;
+		} else if (strcmp(Argument, "--save-scene") == 0) {
+			SavedSceneFilePath = Value;
+		} else if (strcmp(Argument, "--output") == 0) {
+			OutputPrefix = Value;
+		} else {
+			PrintUsage();
+			CPUStuff::FailBail("Unknown argument.", Argument);
+		}
+
+		i++;
+	}
+
+	if (RenderSettings.PSViewPortDimensions.x == 0u || RenderSettings.PSViewPortDimensions.y == 0u || RenderSettings.SamplesPerPixel == 0u ||
+		RenderSettings.MaxRecursionDepth == 0u || FinalFrameCount == 0u) {
+		CPUStuff::FailBail("Dimensions, samples, depth and frame count must all be non-zero.", "Render Settings Error");
+	}
+
+	if (SceneCacheFilePath != nullptr && SceneFilePath == nullptr) {
+		CPUStuff::FailBail("A scene cache needs the --scene file it was compiled from.", SceneCacheFilePath);
+	}
+
+	// Declared first, since the scene and the renderer's BVH may be traced straight from its mapping.
+	SceneCacheStuff::SceneCache SceneCache{};
+
+	CPUStuff::ThreadPool ThreadPool{ ThreadCount };
+	PathTracerStuff::Renderer Renderer{ ThreadPool, RendererConfig };
+
+	SceneStuff::Scene Scene{};
+	BVHStuff::BVH PrebuiltBVH{};
+	bool HasPrebuiltBVH{ false };// The scene is already interpolated to its RootConstants' tick, and PrebuiltBVH was built over it.
+
+	if (SceneFilePath != nullptr) {
+		SceneCacheStuff::SceneCacheStats SceneCacheStats{};
+
+		if (SceneCacheFilePath != nullptr &&
+			SceneCache.Open(SceneCacheFilePath, SceneFilePath, RendererConfig.BVHBuildType, Scene, PrebuiltBVH, SceneCacheStats)) {
+			const float CachedGlobalTickInRadians{ Scene.RootConstants.GlobalTickInRadians };
+			SceneStuff::SetRootConstants(RenderSettings, Scene);
+			Scene.RootConstants.GlobalTickInRadians = CachedGlobalTickInRadians;
+			HasPrebuiltBVH = true;
+
+			printf("Mapped %zu spheres, %zu rectangles, %zu triangles, %zu mesh triangles, %zu instances and their BVH from a %.1f MiB scene cache in %.3f "
+				   "s (%.3f s validating it).\n",
+				Scene.Spheres.size(), Scene.Rectangles.size(), Scene.Triangles.size(), Scene.MeshIndices.size(), Scene.Instances.size(),
+				( double )SceneCacheStats.FileSizeInBytes / (1024.0 * 1024.0), SceneCacheStats.Seconds, SceneCacheStats.HashSeconds);
+		} else {
+			if (SceneCacheFilePath != nullptr) {
+				printf("Rebuilding the scene cache %s: %s.\n", SceneCacheFilePath, SceneCacheStats.ErrorMessage);
+			}
+
+			SceneFileStuff::SceneFileStats SceneFileStats{};
+
+			if (!SceneFileStuff::LoadScene(SceneFilePath, RenderSettings, ThreadPool, Scene, SceneFileStats)) {
+				PrintSceneFileError(SceneFilePath, SceneFileStats);
+			}
+
+			printf("Loaded %u spheres, %u rectangles, %u triangles, %u meshes of %u triangles and %u instances of %u prototypes of %u triangles, sharing %u "
+				   "materials, from a %.1f MiB scene file in %.3f s.\n",
+				SceneFileStats.SphereCount, SceneFileStats.RectangleCount, SceneFileStats.TriangleCount, SceneFileStats.MeshCount,
+				SceneFileStats.MeshTriangleCount, SceneFileStats.InstanceCount, SceneFileStats.PrototypeCount, SceneFileStats.PrototypeTriangleCount,
+				SceneFileStats.MaterialCount, ( double )SceneFileStats.FileSizeInBytes / (1024.0 * 1024.0), SceneFileStats.Seconds);
+
+			if (SceneCacheFilePath != nullptr) {
+				if (!SceneCacheStuff::SaveSceneCache(SceneCacheFilePath, SceneFilePath, SceneFileStats.MeshFilePaths, Scene, RendererConfig.BVHBuildType,
+						ThreadPool, PrebuiltBVH, SceneCacheStats)) {
+					CPUStuff::FailBail(SceneCacheStats.ErrorMessage, SceneCacheFilePath);
+				}
+
+				HasPrebuiltBVH = true;
+
+				printf("Wrote a %.1f MiB scene cache in %.3f s (%.3f s building its BVH).\n", ( double )SceneCacheStats.FileSizeInBytes / (1024.0 * 1024.0),
+					SceneCacheStats.Seconds, SceneCacheStats.BuildSeconds);
+			}
+		}
+	} else if (ImportFilePath != nullptr) {
+		const uint MaterialIndex{ SceneStuff::AddMaterial(2u, { +0.75f, +0.75f, +0.75f }, { +0.75f, +0.75f, +0.75f }, 0.0f, 0.0f, Scene) };
+		ImportStuff::ImportStats ImportStats{};
+
+		if (!ImportStuff::ImportMesh(ImportFilePath, MaterialIndex, ThreadPool, Scene, ImportStats)) {
+			CPUStuff::FailBail(ImportStats.ErrorMessage, ImportFilePath);
+		}
+
+		printf("Imported %u vertices and %u triangles from a %.1f MiB %s file in %.3f s.\n", ImportStats.VertexCount, ImportStats.TriangleCount,
+			( double )ImportStats.FileSizeInBytes / (1024.0 * 1024.0), ImportStuff::GetMeshFileFormatName(ImportStats.Format), ImportStats.Seconds);
+
+		ImportStuff::FitMesh(Scene.Meshes.back(), { +0.0f, +0.0f, +20.0f }, 16.0f, Scene);
+		SceneStuff::SetRootConstants(RenderSettings, Scene);
+		SceneStuff::InterpolateScene(0.0f, Scene);
+	} else if (ManyLightCount > 0u) {
+		SceneStuff::CreateManyLightScene(RenderSettings, ManyLightCount, 1u, Scene);
+	} else if (GlossyScene) {
+		SceneStuff::CreateGlossyScene(RenderSettings, Scene);
+	} else if (InstanceCount > 0u) {
+		SceneStuff::CreateInstanceScene(RenderSettings, InstanceCount, SceneStuff::InstancePrototypeTriangleCount, 1u, Scene);
+	} else if (MeshTriangleCount > 0u) {
+		SceneStuff::CreateMeshScene(RenderSettings, MeshTriangleCount, 1u, Scene);
+	} else if (RandomPrimitiveCount > 0u) {
+		SceneStuff::CreateRandomScene(RenderSettings, RandomPrimitiveCount, 1u, Scene);
+	} else {
+		SceneStuff::CreateDefaultScene(RenderSettings, Scene);
+	}
+
+	if (SavedSceneFilePath != nullptr && !SceneFileStuff::SaveScene(SavedSceneFilePath, RenderSettings, Scene)) {
+		CPUStuff::FailBail(SavedSceneFilePath, "Failed to write the scene file");
+	}
+
+	const std::string AccelerationName{ RendererConfig.AccelerationStructure == PathTracerStuff::AccelerationStructureType::BVH
+			? std::string{ BVHStuff::GetBVHBuildTypeName(RendererConfig.BVHBuildType) } +
+				(RendererConfig.CameraRayPackets ? std::string{ ", " } + SIMDStuff::GetSIMDLevelName(RendererConfig.SIMDLevel) + " ray packets" : "")
+			: std::string{ "brute force, " } + SIMDStuff::GetSIMDLevelName(RendererConfig.SIMDLevel) + " spheres" };
+
+	printf("Rendering %u frame(s) at %ux%u, %u SPP, %u bounces, on %u thread(s), %s mode, %s sampler, %s light sampling by %s, %s, %s "
+		   "triangles.\n",
+		FinalFrameCount, RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, RenderSettings.SamplesPerPixel,
+		RenderSettings.MaxRecursionDepth, ThreadPool.GetThreadCount(), PathTracerStuff::GetRenderModeName(RendererConfig.Mode),
+		SamplerStuff::GetSamplerName(RendererConfig.SamplerType), LightStuff::GetLightSamplingName(RendererConfig.LightSampling),
+		LightStuff::GetLightSelectionName(RendererConfig.LightSelection), AccelerationName.c_str(),
+		TriangleStuff::GetTriangleIntersectorName(RendererConfig.TriangleIntersector));
+
+	// A prebuilt BVH is only good for a first frame at the tick it was built at, which then renders the scene as it is rather than interpolate it.
+	HasPrebuiltBVH = HasPrebuiltBVH && RendererConfig.AccelerationStructure == PathTracerStuff::AccelerationStructureType::BVH &&
+		SceneStuff::GetGlobalTickInRadians(0u, FinalFrameCount) == Scene.RootConstants.GlobalTickInRadians;
+
+	if (HasPrebuiltBVH) {
+		Renderer.SetPrebuiltBVH(std::move(PrebuiltBVH));
+	}
+
+	/*
+		RENDER LOOP:
+	*/
+
+	PathTracerStuff::RenderStats TotalStats{};
+
+	for (uint CurrentRenderIndex{ 0u }; CurrentRenderIndex < FinalFrameCount; CurrentRenderIndex++) {
+		if (CurrentRenderIndex > 0u || !HasPrebuiltBVH) {
+			SceneStuff::InterpolateScene(SceneStuff::GetGlobalTickInRadians(CurrentRenderIndex, FinalFrameCount), Scene);
+		}
+
+		PathTracerStuff::RenderStats FrameStats{};
+		Renderer.RenderFrame(Scene, FrameStats);
+
+		TotalStats.RenderSeconds += FrameStats.RenderSeconds;
+		TotalStats.AccelerationBuildSeconds += FrameStats.AccelerationBuildSeconds;
+		TotalStats.AccelerationRebuildCount += FrameStats.AccelerationRebuildCount;
+		TotalStats.AccelerationRefitCount += FrameStats.AccelerationRefitCount;
+		TotalStats.PathCount += FrameStats.PathCount;
+		TotalStats.ShadowPathCount += FrameStats.ShadowPathCount;
+		TotalStats.SampleCount += FrameStats.SampleCount;
+		TotalStats.FullDepthPathCount += FrameStats.FullDepthPathCount;
+		TotalStats.ThreadCount = FrameStats.ThreadCount;
+
+		printf("Frame %u: %.3f s (%.3f s %s, SAH cost %.1f), %.3f MRays/s, %.3f MRays/s/core, %.2f paths/sample.\n", CurrentRenderIndex,
+			FrameStats.RenderSeconds, FrameStats.AccelerationBuildSeconds, FrameStats.AccelerationRefitCount > 0u ? "refitting" : "building",
+			FrameStats.AccelerationSAHCost, FrameStats.GetRaysPerSecond() / 1.0e6, FrameStats.GetRaysPerSecondPerCore() / 1.0e6,
+			FrameStats.GetAveragePathLength());
+
+		if (WriteOutput) {
+			char FilePath[1024]{};
+			snprintf(FilePath, sizeof(FilePath), "%s%04u.ppm", OutputPrefix.c_str(), CurrentRenderIndex);
+
+			if (!CPUStuff::WriteFrameToPPM(FilePath, RenderSettings.PSViewPortDimensions.x, RenderSettings.PSViewPortDimensions.y, Renderer.GetFinalFrame())) {
+				CPUStuff::FailBail(FilePath, "Failed to write the Final Frame");
+			}
+		}
+	}
+
+	/*
+		GLOBAL REPORTING/EXIT:
+	*/
+
+	if (RendererConfig.AccelerationStructure == PathTracerStuff::AccelerationStructureType::BVH) {
+		printf("BVH: %.3f s over %u build(s) and %u refit(s).\n", TotalStats.AccelerationBuildSeconds, TotalStats.AccelerationRebuildCount,
+			TotalStats.AccelerationRefitCount);
+	}
+
+	// Paths/sample only counts camera paths and the paths they scatter into, so that it compares with full depth under any light sampling.
+	if (RendererConfig.LightSampling != LightStuff::LightSamplingType::None) {
+		printf("Shadow paths: %llu, %.2f per sample.\n", ( unsigned long long )TotalStats.ShadowPathCount,
+			TotalStats.SampleCount > 0u ? ( double )TotalStats.ShadowPathCount / ( double )TotalStats.SampleCount : 0.0);
+	}
+
+	printf("Total: %.3f s, %llu rays, %.3f MRays/s, %.3f MRays/s/core, %.2f paths/sample (%.2fx fewer than full depth), peak RSS %.1f MiB.\n",
+		TotalStats.RenderSeconds, ( unsigned long long )TotalStats.GetRayCount(), TotalStats.GetRaysPerSecond() / 1.0e6,
+		TotalStats.GetRaysPerSecondPerCore() / 1.0e6, TotalStats.GetAveragePathLength(), TotalStats.GetPathTerminationSpeedup(),
+		( double )CPUStuff::GetPeakResidentSetSizeInBytes() / (1024.0 * 1024.0));
+
+	int SuccessExitCode{ 0 };
+	return SuccessExitCode;
+}
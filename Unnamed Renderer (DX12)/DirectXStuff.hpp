@@ -24,7 +24,6 @@
 #include <dxgidebug.h>
 #include <dxcapi.h>
 #include <math.h>
-#include <random>
 
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -539,63 +538,6 @@ namespace DirectXStuff {
 		}
 	};
 
-	struct RandomFloatHostBufferConfig {
-		__int32 RandomFloatCount{};
-	};
-
-	class RandomFloatHostBuffer {
-	  protected:
-		__int64 RandomFloatCount{};
-		float* pBuffer{ nullptr };
-		__int64 BufferSizeInBytes{ 0u };
-		std::random_device RandomDevice{};
-		std::mt19937_64 MersenneTwisterEngine{};
-
-	  public:
-		RandomFloatHostBuffer(RandomFloatHostBufferConfig Config) {
-			this->RandomFloatCount = Config.RandomFloatCount;
-			this->pBuffer = new float[Config.RandomFloatCount]{};
-			this->BufferSizeInBytes = Config.RandomFloatCount * sizeof(float);
-
-			for (__int64 i{ 0 }; i < this->RandomFloatCount; i++) {
-				float RandomFloat{};
-
-				RandomFloat = (( float )MersenneTwisterEngine() / ( float )MersenneTwisterEngine._Max) * 2.0f - 1.0f;
-
-				this->pBuffer[i] = RandomFloat;
-			}
-		}
-
-		void RefreshBufferContents() {
-			for (__int64 i{ 0 }; i < this->RandomFloatCount; i++) {
-				float RandomFloat{};
-
-				RandomFloat = (( float )MersenneTwisterEngine() / ( float )MersenneTwisterEngine._Max) * 2.0f - 1.0f;
-
-				this->pBuffer[i] = RandomFloat;
-			}
-		}
-
-		unsigned __int64 GetBufferSizeInBytes() {
-			return this->BufferSizeInBytes;
-		}
-
-		void* GetPointerToBufferStart() {
-			if (this->pBuffer != nullptr) {
-				return reinterpret_cast<void*>(this->pBuffer);
-			} else {
-				return nullptr;
-			}
-		}
-
-		~RandomFloatHostBuffer() {
-			if (this->pBuffer != nullptr) {
-				delete[] this->pBuffer;
-				this->pBuffer = nullptr;
-			}
-		}
-	};
-
 	struct BufferConfig {
 		D3D12_CPU_PAGE_PROPERTY CPUPageProperty{};
 		D3D12_MEMORY_POOL MemoryPool{};
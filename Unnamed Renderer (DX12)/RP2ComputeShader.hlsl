@@ -149,6 +149,8 @@ struct InlineRootConstants {
 	uint RectangleCount;// Quantity of procedural rectangles in the scene.
 	uint TriangleCount;// Quantity of procedural triangles in the scene.
 	float GlobalTickInRadians;// Current cyclical tick value for global system-state.
+	uint RussianRouletteDepth;// Path-depth from which paths are probabilistically terminated, based on their throughput.
+	float3 Padding06;
 };
 
 
@@ -156,22 +158,76 @@ struct InlineRootConstants {
 RWStructuredBuffer<Sphere> Spheres : register(u0);
 RWStructuredBuffer<Rectangle> Rectangles : register(u1);
 RWStructuredBuffer<Triangle> Triangles : register(u2);
-RWTexture3D<float> ChaosTexels : register(u3);
-RWTexture3D<float4> IntersectionMap01 : register(u4);
-RWTexture3D<float4> IntersectionMap02 : register(u5);
-RWTexture3D<uint4> IntersectionMap03 : register(u6);
-RWTexture2D<float4> AccumulationFrame : register(u7);
-RWTexture2D<unorm float4> FinalFrame : register(u8);
+RWTexture3D<float4> IntersectionMap01 : register(u3);
+RWTexture3D<float4> IntersectionMap02 : register(u4);
+RWTexture3D<uint4> IntersectionMap03 : register(u5);
+RWTexture2D<float4> AccumulationFrame : register(u6);
+RWTexture2D<unorm float4> FinalFrame : register(u7);
 ConstantBuffer<InlineRootConstants> RootConstants : register(b0);
 
 
+/*
+	RANDOM DIMENSIONS:
+		Every random value is hashed from (pixel, sample index, dimension) when it is needed, so no random state is stored or uploaded.
+		The layout matches the CPU backend's, whose Sobol samplers stratify each bounce's dimensions together.
+		0, 1 - Pixel offset of the camera path.
+		4 + (Depth * 8) + 0, 1, 2 - Scattering direction at a path-depth.
+		4 + (Depth * 8) + 3 - Reflection/refraction choice at a path-depth.
+		4 + (Depth * 8) + 4 - Russian roulette decision at a path-depth.
+*/
+static const uint PixelOffsetDimension = 0u;
+static const uint FirstBounceDimension = 4u;
+static const uint DimensionsPerBounce = 8u;
+
+
+// PCG-based hash of four 32-bit counters into four decorrelated 32-bit values.
+uint4 PCG4D(in uint4 Value) {
+	Value = Value * 1664525u + 1013904223u;
+
+	Value.x += Value.y * Value.w;
+	Value.y += Value.z * Value.x;
+	Value.z += Value.x * Value.y;
+	Value.w += Value.y * Value.z;
+
+	Value ^= Value >> 16u;
+
+	Value.x += Value.y * Value.w;
+	Value.y += Value.z * Value.x;
+	Value.z += Value.x * Value.y;
+	Value.w += Value.y * Value.z;
+
+	return Value;
+}
+
+
+// Acquires a uniformly distributed value in [0, 1) for the current thread's pixel and sample, in a given dimension.
+float GetRandomFloat(in uint2 GridThreadId, in uint Dimension) {
+	uint4 Counter = { GridThreadId.x, GridThreadId.y, RootConstants.CurrentSampleIndex, Dimension };
+
+	return ( float )(PCG4D(Counter).x >> 8u) * (1.0f / 16777216.0f);
+}
+
+
+// First dimension of the random values consumed by a bounce at a given path-depth.
+uint GetBounceDimension(in uint CurrentRecursionDepth) {
+	return FirstBounceDimension + CurrentRecursionDepth * DimensionsPerBounce;
+}
+
+
+// Acquires a random vector with components in [-1, +1), for scattering a Path at a given path-depth.
+float3 GetRandomDirection(in uint2 GridThreadId, in uint CurrentRecursionDepth) {
+	uint Dimension = GetBounceDimension(CurrentRecursionDepth);
+	float3 RandomDirection = { GetRandomFloat(GridThreadId, Dimension), GetRandomFloat(GridThreadId, Dimension + 1u),
+		GetRandomFloat(GridThreadId, Dimension + 2u) };
+
+	return RandomDirection * 2.0f - 1.0f;
+}
+
+
 // Acquires a random offset value for random distributed multi-sampling.
 void GetRandomOffsetIntoPixel(in uint2 GridThreadId, inout float2 RandomOffset) {
-	uint3 ChaosTexelsIndex00 = { GridThreadId.x, GridThreadId.y, 0 };
-	uint3 ChaosTexelsIndex01 = { GridThreadId.x, GridThreadId.y, 1 };
-
-	RandomOffset.x = ChaosTexels[ChaosTexelsIndex00] * 0.50f + 0.50f;
-	RandomOffset.y = ChaosTexels[ChaosTexelsIndex01] * 0.50f + 0.50f;
+	RandomOffset.x = GetRandomFloat(GridThreadId, PixelOffsetDimension);
+	RandomOffset.y = GetRandomFloat(GridThreadId, PixelOffsetDimension + 1u);
 }
 
 
@@ -368,11 +424,7 @@ void UpdatePathFromSurfaceNormalIntersection(in IntersectionRecord HitRecord, in
 
 // Updates the current Path's values, as a result of an intersection with a Diffuse Sphere.
 void UpdatePathFromDiffuseIntersection(in uint2 GridThreadId, in IntersectionRecord HitRecord, inout Path CurrentPath) {
-	uint3 ChaosTexelsIndex00 = { GridThreadId.x, GridThreadId.y, 0 };
-	uint3 ChaosTexelsIndex01 = { GridThreadId.x, GridThreadId.y, 1 };
-	uint3 ChaosTexelsIndex02 = { GridThreadId.x, GridThreadId.y, 2 };
-
-	float3 RandomDirection = { ChaosTexels[ChaosTexelsIndex00], ChaosTexels[ChaosTexelsIndex01], ChaosTexels[ChaosTexelsIndex02] };
+	float3 RandomDirection = GetRandomDirection(GridThreadId, HitRecord.CurrentRecursionDepth);
 
 	float3 SurfaceNormal;
 
@@ -462,8 +514,7 @@ void UpdatePathFromDielectricIntersection(in uint2 GridThreadId, in Intersection
 	float RefractionProbability;
 	Schlick(ThetaA, n2, RefractionProbability);
 
-	float3 ChaosTexelsIndex = { GridThreadId.x, GridThreadId.y, 0 };
-	float RefractionChance = ChaosTexels[ChaosTexelsIndex] * 0.50f + 0.50f;
+	float RefractionChance = (GetRandomFloat(GridThreadId, GetBounceDimension(HitRecord.CurrentRecursionDepth) + 3u) * 2.0f - 1.0f) * 0.50f + 0.50f;
 
 	if (RefractionChance > RefractionProbability || (isnan(RefractedDirection.x) || isnan(RefractedDirection.y) || isnan(RefractedDirection.z))) {
 		float3 ReflectedDirection = normalize(HitRecord.WSIncomingPathDirection - 2.0f * dot(HitRecord.WSIncomingPathDirection, SurfaceNormal) * SurfaceNormal);
@@ -479,11 +530,7 @@ void UpdatePathFromDielectricIntersection(in uint2 GridThreadId, in Intersection
 
 // Updates the current Path's values, as a result of an intersection with a Metallic Sphere.
 void UpdatePathFromMetallicIntersection(in uint2 GridThreadId, in IntersectionRecord HitRecord, inout Path CurrentPath) {
-	uint3 ChaosTexelsIndex00 = { GridThreadId.x, GridThreadId.y, 0 };
-	uint3 ChaosTexelsIndex01 = { GridThreadId.x, GridThreadId.y, 1 };
-	uint3 ChaosTexelsIndex02 = { GridThreadId.x, GridThreadId.y, 2 };
-
-	float3 RandomDirection = { ChaosTexels[ChaosTexelsIndex00], ChaosTexels[ChaosTexelsIndex01], ChaosTexels[ChaosTexelsIndex02] };
+	float3 RandomDirection = GetRandomDirection(GridThreadId, HitRecord.CurrentRecursionDepth);
 
 	float3 FuzzVector;
 
@@ -519,11 +566,7 @@ void UpdatePathFromMetallicIntersection(in uint2 GridThreadId, in IntersectionRe
 
 // Updates the current Path's values, as a result of an intersection with a Diffuse Light Sphere.
 void UpdatePathFromDiffuseLightIntersection(in uint2 GridThreadId, in IntersectionRecord HitRecord, inout Path CurrentPath) {
-	uint3 ChaosTexelsIndex00 = { GridThreadId.x, GridThreadId.y, 0 };
-	uint3 ChaosTexelsIndex01 = { GridThreadId.x, GridThreadId.y, 1 };
-	uint3 ChaosTexelsIndex02 = { GridThreadId.x, GridThreadId.y, 2 };
-
-	float3 RandomDirection = { ChaosTexels[ChaosTexelsIndex00], ChaosTexels[ChaosTexelsIndex01], ChaosTexels[ChaosTexelsIndex02] };
+	float3 RandomDirection = GetRandomDirection(GridThreadId, HitRecord.CurrentRecursionDepth);
 
 	float3 SurfaceNormal;
 
@@ -730,9 +773,13 @@ void UpdatePayloadFromDiffuseLightIntersection(in IntersectionRecord HitRecord,
 
 [numthreads(128, 8, 1)] void ComputeMain(uint3 GridThreadId
 										 : SV_DispatchThreadID) {
-	PathPayload CurrentPayload;
+	PathPayload CurrentPayload = { 0.0f, 0.0f, 0.0f };
 
-	for (int CurrentRecursionDepth = { ( int )RootConstants.MaxRecursionDepth - 1 }; CurrentRecursionDepth >= 0; CurrentRecursionDepth--) {
+	// Records past the Path's length were never written for this sample, so the walk starts at its last one.
+	uint3 PathLengthIndex = { GridThreadId.x, GridThreadId.y, 0 };
+	uint PathLength = IntersectionMap03[PathLengthIndex].z;
+
+	for (int CurrentRecursionDepth = { ( int )PathLength - 1 }; CurrentRecursionDepth >= 0; CurrentRecursionDepth--) {
 		uint3 IntersectionMapIndex = { GridThreadId.x, GridThreadId.y, CurrentRecursionDepth };
 
 		IntersectionRecord HitRecord;
@@ -742,7 +789,7 @@ void UpdatePayloadFromDiffuseLightIntersection(in IntersectionRecord HitRecord,
 		HitRecord.PrimitiveId = IntersectionMap03[IntersectionMapIndex].w;
 		HitRecord.ObjectId = IntersectionMap03[IntersectionMapIndex].x;
 		HitRecord.MaterialId = IntersectionMap03[IntersectionMapIndex].y;
-		HitRecord.CurrentRecursionDepth = IntersectionMap03[IntersectionMapIndex].z;
+		HitRecord.CurrentRecursionDepth = CurrentRecursionDepth;
 
 		// Update the current Path's Payload.
 		switch (HitRecord.MaterialId) {
@@ -777,6 +824,13 @@ void UpdatePayloadFromDiffuseLightIntersection(in IntersectionRecord HitRecord,
 
 				break;
 		}
+
+		// Compensate for the Russian roulette survival probability of this bounce.
+		float RussianRouletteWeight = IntersectionMap02[IntersectionMapIndex].w;
+
+		CurrentPayload.r = CurrentPayload.r * RussianRouletteWeight;
+		CurrentPayload.g = CurrentPayload.g * RussianRouletteWeight;
+		CurrentPayload.b = CurrentPayload.b * RussianRouletteWeight;
 	}
 
 	AccumulationFrame[GridThreadId.xy].x += CurrentPayload.r;
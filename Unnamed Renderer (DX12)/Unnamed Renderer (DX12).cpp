@@ -126,8 +126,6 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 	const uint MaxRecursionDepth{ 30u };
 
 	// Resource Values.
-	const uint3 ChaosTexelsDimensions{ PSViewPortDimensions.x, PSViewPortDimensions.y, 3u };
-	const uint ChaosTexelCount{ ChaosTexelsDimensions.x * ChaosTexelsDimensions.y * ChaosTexelsDimensions.z };
 	const uint3 IntersectionMapDimensions{ PSViewPortDimensions.x, PSViewPortDimensions.y, MaxRecursionDepth };
 	const uint2 AccumulationFrameDimensions{ PSViewPortDimensions.x, PSViewPortDimensions.y };
 	const uint2 FinalFrameDimensions{ PSViewPortDimensions.x, PSViewPortDimensions.y };
@@ -156,6 +154,8 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 		uint RectangleCount;// Quantity of procedural rectangles in the scene.
 		uint TriangleCount;// Quantity of procedural triangles in the scene.
 		float GlobalTickInRadians;// Current cyclical tick value for global system-state.
+		uint RussianRouletteDepth;// Path-depth from which paths are probabilistically terminated, based on their throughput.
+		float Padding06[3];
 	};
 
 	const uint RootConstantCount{ sizeof(InlineRootConstants) / sizeof(float) };
@@ -179,6 +179,7 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 	InlineRootConstants.RectangleCount = 0u;
 	InlineRootConstants.TriangleCount = 0u;
 	InlineRootConstants.GlobalTickInRadians = 0.0f;
+	InlineRootConstants.RussianRouletteDepth = 3u;
 
 	/*
 		PRIMITIVE ID:
@@ -661,66 +662,6 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 	L1TrianglesBufferUnorderedAccessToCopyDest =
 		DirectXStuff::CreateResourceTransitionBarrier(L1TrianglesBuffer.GetInterface(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST);
 
-	// Chaos Texels Buffer, Host version.
-	DirectXStuff::RandomFloatHostBufferConfig HostChaosTexelsBufferConfig{};
-	HostChaosTexelsBufferConfig.RandomFloatCount = ChaosTexelCount;
-
-	DirectXStuff::RandomFloatHostBuffer HostChaosTexelsBuffer{ HostChaosTexelsBufferConfig };
-
-	// Chaos Texels Buffer, Upload version.
-	DirectXStuff::BufferConfig L0ChaosTexelsBufferConfig{};
-	L0ChaosTexelsBufferConfig.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE;
-	L0ChaosTexelsBufferConfig.MemoryPool = D3D12_MEMORY_POOL_L0;
-	L0ChaosTexelsBufferConfig.InitialResourceState = D3D12_RESOURCE_STATE_COPY_DEST;
-	L0ChaosTexelsBufferConfig.BufferFormat = DXGI_FORMAT_UNKNOWN;
-	L0ChaosTexelsBufferConfig.BufferWidth = ChaosTexelCount * sizeof(float);
-
-	DirectXStuff::Buffer L0ChaosTexelsBuffer{ Device.GetInterface(), L0ChaosTexelsBufferConfig, L"L0ChaosTexelsBuffer" };
-
-	D3D12_RESOURCE_BARRIER L0ChaosTexelsBufferCopyDestToCopySource{};
-	L0ChaosTexelsBufferCopyDestToCopySource =
-		DirectXStuff::CreateResourceTransitionBarrier(L0ChaosTexelsBuffer.GetInterface(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COPY_SOURCE);
-
-	D3D12_RESOURCE_BARRIER L0ChaosTexelsBufferCopySourceToCopyDest{};
-	L0ChaosTexelsBufferCopySourceToCopyDest =
-		DirectXStuff::CreateResourceTransitionBarrier(L0ChaosTexelsBuffer.GetInterface(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
-
-	D3D12_TEXTURE_COPY_LOCATION L0ChaosTexelsBufferTextureCopyLocation{};
-	L0ChaosTexelsBufferTextureCopyLocation.pResource = L0ChaosTexelsBuffer.GetInterface();
-	L0ChaosTexelsBufferTextureCopyLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Offset = 0u;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Footprint.Format = DXGI_FORMAT_R32_FLOAT;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Footprint.Width = ChaosTexelsDimensions.x;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Footprint.Height = ChaosTexelsDimensions.y;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Footprint.Depth = ChaosTexelsDimensions.z;
-	L0ChaosTexelsBufferTextureCopyLocation.PlacedFootprint.Footprint.RowPitch = ChaosTexelsDimensions.x * sizeof(float);
-
-	// Chaos Texels 3DTexture, Device version.
-	DirectXStuff::Texture3DConfig L1ChaosTexels3DTextureConfig{};
-	L1ChaosTexels3DTextureConfig.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE;
-	L1ChaosTexels3DTextureConfig.MemoryPool = D3D12_MEMORY_POOL_L1;
-	L1ChaosTexels3DTextureConfig.NodeMask = 0u;
-	L1ChaosTexels3DTextureConfig.InitialResourceState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-	L1ChaosTexels3DTextureConfig.TextureFormat = DXGI_FORMAT_R32_FLOAT;
-	L1ChaosTexels3DTextureConfig.TextureWidth = ChaosTexelsDimensions.x;
-	L1ChaosTexels3DTextureConfig.TextureHeight = ChaosTexelsDimensions.y;
-	L1ChaosTexels3DTextureConfig.TextureDepth = ChaosTexelsDimensions.z;
-
-	DirectXStuff::Texture3D L1ChaosTexels3DTexture{ Device.GetInterface(), L1ChaosTexels3DTextureConfig, L"L1ChaosTexels3DTexture" };
-
-	D3D12_RESOURCE_BARRIER L1ChaosTexels3DTextureCopyDestToUnorderedAccess{};
-	L1ChaosTexels3DTextureCopyDestToUnorderedAccess = DirectXStuff::CreateResourceTransitionBarrier(
-		L1ChaosTexels3DTexture.GetInterface(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-
-	D3D12_RESOURCE_BARRIER L1ChaosTexels3DTextureUnorderedAccessToCopyDest{};
-	L1ChaosTexels3DTextureUnorderedAccessToCopyDest = DirectXStuff::CreateResourceTransitionBarrier(
-		L1ChaosTexels3DTexture.GetInterface(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST);
-
-	D3D12_TEXTURE_COPY_LOCATION L1ChaosTexels3DTextureTextureCopyLocation{};
-	L1ChaosTexels3DTextureTextureCopyLocation.pResource = L1ChaosTexels3DTexture.GetInterface();
-	L1ChaosTexels3DTextureTextureCopyLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	L1ChaosTexels3DTextureTextureCopyLocation.SubresourceIndex = 0u;
-
 	// Intersection Maps for recording path-object intersections, to be produced during RP1.
 	DirectXStuff::Texture3DConfig L1IntersectionMap013DTextureConfig{};
 	L1IntersectionMap013DTextureConfig.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE;
@@ -856,15 +797,14 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 			Resource 0 - L1SpheresBuffer
 			Resource 1 - L1RectanglesBuffer
 			Resource 2 - L1TrianglesBuffer
-			Resource 3 - L1ChaosTexels3DTexture
-			Resource 4 - L1IntersectionMap013DTexture - WStDistance + WSIntersectionPoint
-			Resource 5 - L1IntersectionMap023DTexture - Unused + WSIncomingDirection
-			Resource 6 - L1IntersectionMap033DTexture - PrimitiveID + ObjectID + MaterialID + CurrentRecursionDepth
-			Resource 7 - L1AccumulationFrame2DTexture
-			Resource 8 - L1FinalFrame2DTexture
+			Resource 3 - L1IntersectionMap013DTexture - WStDistance + WSIntersectionPoint
+			Resource 4 - L1IntersectionMap023DTexture - RussianRouletteWeight + WSIncomingDirection
+			Resource 5 - L1IntersectionMap033DTexture - PrimitiveID + ObjectID + MaterialID + CurrentRecursionDepth
+			Resource 6 - L1AccumulationFrame2DTexture
+			Resource 7 - L1FinalFrame2DTexture
 	*/
 
-	const uint GlobalDescriptorCount{ 9u };
+	const uint GlobalDescriptorCount{ 8u };
 	const unsigned __int64 DescriptorHandleIncrementSize{ Device.GetInterface()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) };
 	uint CurrentDescriptorIndex{ 0u };
 
@@ -924,23 +864,6 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 
 	CurrentDescriptorIndex++;
 
-	D3D12_CPU_DESCRIPTOR_HANDLE L1ChaosTexels3DTextureUAVCPUHandle{};
-
-	D3D12_UNORDERED_ACCESS_VIEW_DESC L1ChaosTexels3DTextureUAVDesc{};
-	L1ChaosTexels3DTextureUAVDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE3D;
-	L1ChaosTexels3DTextureUAVDesc.Format = L1ChaosTexels3DTextureConfig.TextureFormat;
-	L1ChaosTexels3DTextureUAVDesc.Texture3D.FirstWSlice = 0u;
-	L1ChaosTexels3DTextureUAVDesc.Texture3D.MipSlice = 0u;
-	L1ChaosTexels3DTextureUAVDesc.Texture3D.WSize = L1ChaosTexels3DTextureConfig.TextureDepth;
-
-	L1ChaosTexels3DTextureUAVCPUHandle.ptr =
-		GlobalDescriptorHeap.GetInterface()->GetCPUDescriptorHandleForHeapStart().ptr + (CurrentDescriptorIndex * DescriptorHandleIncrementSize);
-
-	Device.GetInterface()->CreateUnorderedAccessView(
-		L1ChaosTexels3DTexture.GetInterface(), nullptr, &L1ChaosTexels3DTextureUAVDesc, L1ChaosTexels3DTextureUAVCPUHandle);
-
-	CurrentDescriptorIndex++;
-
 	D3D12_CPU_DESCRIPTOR_HANDLE L1IntersectionMap013DTextureUAVCPUHandle{};
 
 	D3D12_UNORDERED_ACCESS_VIEW_DESC L1IntersectionMap013DTextureUAVDesc{};
@@ -1329,21 +1252,6 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 			}
 
 			if (InlineRootConstants.CurrentSampleIndex <= InlineRootConstants.MaxSampleIndex) {
-				// Update and copy the Chaos Texels.
-				HostChaosTexelsBuffer.RefreshBufferContents();
-
-				void* pL0ChaosTexelsBuffer{ nullptr };
-
-				L0ChaosTexelsBuffer.GetInterface()->Map(0u, nullptr, &pL0ChaosTexelsBuffer);
-
-				memcpy_s(pL0ChaosTexelsBuffer, L0ChaosTexelsBufferConfig.BufferWidth, HostChaosTexelsBuffer.GetPointerToBufferStart(),
-					HostChaosTexelsBuffer.GetBufferSizeInBytes());
-
-				L0ChaosTexelsBuffer.GetInterface()->Unmap(0u, nullptr);
-
-				pL0ChaosTexelsBuffer = nullptr;
-
-
 				// Render-pass 1: Generate the Intersection Map
 				RP1CommandAllocator.GetInterface()->Reset();
 
@@ -1379,17 +1287,6 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int) {
 
 				RP1GraphicsCommandList.GetInterface()->ResourceBarrier(1u, &L1TrianglesBufferCopyDestToUnorderedAccess);
 
-				RP1GraphicsCommandList.GetInterface()->ResourceBarrier(1u, &L0ChaosTexelsBufferCopyDestToCopySource);
-
-				RP1GraphicsCommandList.GetInterface()->ResourceBarrier(1u, &L1ChaosTexels3DTextureUnorderedAccessToCopyDest);
-
-				RP1GraphicsCommandList.GetInterface()->CopyTextureRegion(
-					&L1ChaosTexels3DTextureTextureCopyLocation, 0u, 0u, 0u, &L0ChaosTexelsBufferTextureCopyLocation, nullptr);
-
-				RP1GraphicsCommandList.GetInterface()->ResourceBarrier(1u, &L0ChaosTexelsBufferCopySourceToCopyDest);
-
-				RP1GraphicsCommandList.GetInterface()->ResourceBarrier(1u, &L1ChaosTexels3DTextureCopyDestToUnorderedAccess);
-
 				RP1GraphicsCommandList.GetInterface()->SetComputeRootSignature(GlobalRootSignature.GetInterface());
 
 				RP1GraphicsCommandList.GetInterface()->SetDescriptorHeaps(1u, &pGlobalDescriptorHeap);